@@ -89,6 +89,14 @@ extern PyObject* _PyEval_BuiltinsFromGlobals(
 
 // Trampoline API
 
+// Source location of the machine code starting at code_addr, up to the next
+// entry or the end of the code.
+typedef struct _PyPerf_JitLineEntry {
+    const void *code_addr;
+    PyCodeObject *code;     // Differs from the outer code for inlined frames
+    int lineno;
+} _PyPerf_JitLineEntry;
+
 typedef struct {
     // Callback to initialize the trampoline state
     void* (*init_state)(void);
@@ -97,6 +105,12 @@ typedef struct {
                         unsigned int code_size, PyCodeObject* code);
     // Callback to free the trampoline state
     int (*free_state)(void* state);
+    // Callback to register the machine code of a JIT executor compiled from
+    // code, with a line table sorted by address (optional)
+    void (*write_jit_code)(void* state, const void *code_addr,
+                           unsigned int code_size, PyCodeObject* code,
+                           const _PyPerf_JitLineEntry *lines,
+                           Py_ssize_t nlines);
 } _PyPerf_Callbacks;
 
 extern int _PyPerfTrampoline_SetCallbacks(_PyPerf_Callbacks *);
@@ -106,6 +120,12 @@ extern int _PyPerfTrampoline_Fini(void);
 extern void _PyPerfTrampoline_FreeArenas(void);
 extern int _PyIsPerfTrampolineActive(void);
 extern PyStatus _PyPerfTrampoline_AfterFork_Child(void);
+// Return non-zero if the machine code of JIT executors should be registered
+// with _PyPerfTrampoline_WriteJitCode().
+extern int _PyPerfTrampoline_IsTrackingJitCode(void);
+extern void _PyPerfTrampoline_WriteJitCode(
+    const void *code_addr, unsigned int code_size, PyCodeObject *code,
+    const _PyPerf_JitLineEntry *lines, Py_ssize_t nlines);
 #ifdef PY_HAVE_PERF_TRAMPOLINE
 extern _PyPerf_Callbacks _Py_perfmap_callbacks;
 extern _PyPerf_Callbacks _Py_perfmap_jit_callbacks;
@@ -68,12 +68,17 @@ typedef enum {
 
 #ifdef PY_HAVE_PERF_TRAMPOLINE
 struct code_arena_st;
+struct _PyPerf_JitLineEntry;
 
 struct trampoline_api_st {
     void* (*init_state)(void);
     void (*write_state)(void* state, const void *code_addr,
                         unsigned int code_size, PyCodeObject* code);
     int (*free_state)(void* state);
+    void (*write_jit_code)(void* state, const void *code_addr,
+                           unsigned int code_size, PyCodeObject* code,
+                           const struct _PyPerf_JitLineEntry *lines,
+                           Py_ssize_t nlines);
     void *state;
     Py_ssize_t code_padding;
 };
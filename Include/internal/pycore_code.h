@@ -11,6 +11,7 @@ extern "C" {
 #include "pycore_stackref.h"    // _PyStackRef
 #include "pycore_lock.h"        // PyMutex
 #include "pycore_backoff.h"     // _Py_BackoffCounter
+#include "pycore_exec_stats.h"  // _Py_EXEC_STAT_INC()
 
 
 /* Each instruction in a code object is a fixed-width value,
@@ -300,7 +301,8 @@ extern PyObject* _PyCode_GetCode(PyCodeObject *);
 extern int _PyCode_InitAddressRange(PyCodeObject* co, PyCodeAddressRange *bounds);
 
 /** Out of process API for initializing the location table. */
-extern void _PyLineTable_InitAddressRange(
+// Export for '_remotesampler' shared extension
+PyAPI_FUNC(void) _PyLineTable_InitAddressRange(
     const char *linetable,
     Py_ssize_t length,
     int firstlineno,
@@ -353,7 +355,11 @@ extern void _Py_Specialize_ContainsOp(_PyStackRef value, _Py_CODEUNIT *instr);
 
 #include "pycore_bitutils.h"  // _Py_bit_length
 
-#define STAT_INC(opname, name) do { if (_Py_stats) _Py_stats->opcode_stats[opname].specialization.name++; } while (0)
+#define STAT_INC(opname, name) \
+    do { \
+        if (_Py_stats) _Py_stats->opcode_stats[opname].specialization.name++; \
+        _Py_EXEC_STAT_INC(_Py_EXEC_STATS_TSTATE, opname, name); \
+    } while (0)
 #define STAT_DEC(opname, name) do { if (_Py_stats) _Py_stats->opcode_stats[opname].specialization.name--; } while (0)
 #define OPCODE_EXE_INC(opname) do { if (_Py_stats) _Py_stats->opcode_stats[opname].execution_count++; } while (0)
 #define CALL_STAT_INC(name) do { if (_Py_stats) _Py_stats->call_stats.name++; } while (0)
@@ -390,7 +396,9 @@ extern void _Py_Specialize_ContainsOp(_PyStackRef value, _Py_CODEUNIT *instr);
 PyAPI_FUNC(PyObject*) _Py_GetSpecializationStats(void);
 
 #else
-#define STAT_INC(opname, name) ((void)0)
+// Only the execution stats (pycore_exec_stats.h) are available
+#define STAT_INC(opname, name) \
+    _Py_EXEC_STAT_INC(_Py_EXEC_STATS_TSTATE, opname, name)
 #define STAT_DEC(opname, name) ((void)0)
 #define OPCODE_EXE_INC(opname) ((void)0)
 #define CALL_STAT_INC(name) ((void)0)
@@ -514,6 +522,22 @@ write_location_entry_start(uint8_t *ptr, int code, int length)
     return 1;
 }
 
+/* Decoded form of co_exceptiontable, sorted by start offset.  Built the
+ * first time an exception unwinds through the code object, if
+ * PY_EXCEPTION_TABLE_CACHE is defined.  Offsets are in code units.
+ */
+typedef struct {
+    int start;
+    int end;
+    int handler;
+    int depth_and_lasti;
+} _PyExceptionTableEntry;
+
+typedef struct _PyCoExceptionTable {
+    Py_ssize_t size;
+    _PyExceptionTableEntry entries[1];
+} _PyCoExceptionTable;
+
 
 /** Counters
  * The first 16-bit value in each inline cache is a counter.
@@ -91,6 +91,10 @@ _PyCriticalSection_Resume(PyThreadState *tstate);
 PyAPI_FUNC(void)
 _PyCriticalSection_BeginSlow(PyCriticalSection *c, PyMutex *m);
 
+// (private) slow path for locking the mutex of an object
+PyAPI_FUNC(void)
+_PyCriticalSection_BeginObjectSlow(PyCriticalSection *c, PyObject *op);
+
 PyAPI_FUNC(void)
 _PyCriticalSection2_BeginSlow(PyCriticalSection2 *c, PyMutex *m1, PyMutex *m2,
                              int is_m1_locked);
@@ -123,7 +127,16 @@ _PyCriticalSection_BeginMutex(PyCriticalSection *c, PyMutex *m)
 static inline void
 _PyCriticalSection_Begin(PyCriticalSection *c, PyObject *op)
 {
-    _PyCriticalSection_BeginMutex(c, &op->ob_mutex);
+    if (PyMutex_LockFast(&op->ob_mutex._bits)) {
+        PyThreadState *tstate = _PyThreadState_GET();
+        c->_cs_mutex = &op->ob_mutex;
+        c->_cs_prev = tstate->critical_section;
+        tstate->critical_section = (uintptr_t)c;
+    }
+    else {
+        // The object is passed to label the lock contention profile
+        _PyCriticalSection_BeginObjectSlow(c, op);
+    }
 }
 #define PyCriticalSection_Begin _PyCriticalSection_Begin
 
@@ -26,6 +26,11 @@ struct _Py_exc_state {
     int memerrors_numfree;
     // The ExceptionGroup type
     PyObject *PyExc_ExceptionGroup;
+    // Lazily captured tracebacks that still refer to an executing frame,
+    // most recent first (see Python/traceback.c)
+    struct _PyLazyTraceBack *lazy_tb_head;
+    struct _PyLazyTraceBack *lazy_tb_tail;
+    Py_ssize_t lazy_tb_count;
 };
 
 extern void _PyExc_ClearExceptionGroupType(PyInterpreterState *);
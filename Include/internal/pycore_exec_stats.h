@@ -0,0 +1,97 @@
+#ifndef Py_INTERNAL_EXEC_STATS_H
+#define Py_INTERNAL_EXEC_STATS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+// Execution stats: a small subset of the specialization and optimization
+// statistics of Include/cpython/pystats.h which is available in all builds.
+//
+// Gathering is off by default and is toggled at runtime with
+// sys._exec_stats_on() and sys._exec_stats_off().  While it is on, every
+// thread state owns a _PyExecStats (_PyThreadStateImpl.exec_stats) which is
+// only written by that thread, so counting is a load, a test and an increment
+// without atomic operations.  When it is off, the pointer is NULL and the
+// cost is a single predictable branch.
+//
+// Counters of exiting threads are added to the interpreter's totals
+// (interp->exec_stats.retired) under HEAD_LOCK.  Reading, clearing and
+// toggling stop the world so that no thread is updating its counters.
+
+typedef struct {
+    uint64_t success;
+    uint64_t failure;
+    uint64_t hit;
+    uint64_t miss;
+    uint64_t deopt;
+} _PyExecSpecializationStats;
+
+typedef struct _Py_exec_stats {
+    // Indexed by opcode: specialized instructions count their hits and
+    // misses, families count specialization attempts and deoptimizations.
+    _PyExecSpecializationStats opcode[256];
+    // Tier 2 optimizer and executors
+    uint64_t optimization_attempts;
+    uint64_t executors_created;
+    uint64_t executors_invalidated;
+    uint64_t executor_entries;      // entered from tier 1
+    uint64_t executor_exits;        // returned to tier 1
+    // Used to chain the counters of all threads when gathering is turned off
+    struct _Py_exec_stats *next;
+} _PyExecStats;
+
+struct _exec_stats_state {
+    // Non-zero while gathering is on.  Written with HEAD_LOCK held, may be
+    // read without it to avoid allocating counters needlessly.
+    int enabled;
+    // Totals of the threads which exited.  Protected by HEAD_LOCK.
+    _PyExecStats retired;
+};
+
+// Thread state whose counters are updated by STAT_INC().  The interpreter
+// loop redefines it to use its local variable.
+#define _Py_EXEC_STATS_TSTATE _PyThreadState_GET()
+
+#define _PyExecStats_GET(tstate) (((_PyThreadStateImpl *)(tstate))->exec_stats)
+
+#define _Py_EXEC_STAT_INC(tstate, opname, name) \
+    do { \
+        _PyExecStats *_exec_stats = _PyExecStats_GET(tstate); \
+        if (_exec_stats) { \
+            _exec_stats->opcode[opname].name++; \
+        } \
+    } while (0)
+
+#define _Py_EXEC_OPT_STAT_INC(tstate, name) \
+    do { \
+        _PyExecStats *_exec_stats = _PyExecStats_GET(tstate); \
+        if (_exec_stats) { \
+            _exec_stats->name++; \
+        } \
+    } while (0)
+
+// Called with HEAD_LOCK held when a thread state is deleted.
+extern void _PyExecStats_MergeThread(PyInterpreterState *interp,
+                                     _PyExecStats *stats);
+
+extern int _PyExecStats_Enable(PyInterpreterState *interp);
+extern void _PyExecStats_Disable(PyInterpreterState *interp);
+extern void _PyExecStats_Clear(PyInterpreterState *interp);
+extern int _PyExecStats_IsEnabled(PyInterpreterState *interp);
+// Return a dict using the same keys as the pystats dump files.
+extern PyObject* _PyExecStats_AsDict(PyInterpreterState *interp);
+// Write the stats to a file in the pystats directory, in the format read by
+// Tools/scripts/summarize_stats.py.  Return 1 if a file was written.
+extern int _PyExecStats_Dump(PyInterpreterState *interp);
+
+#ifdef __cplusplus
+}
+#endif
+#endif   // !Py_INTERNAL_EXEC_STATS_H
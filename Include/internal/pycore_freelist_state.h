@@ -20,6 +20,10 @@ extern "C" {
 #  define Py_async_gen_asends_MAXFREELIST 80
 #  define Py_futureiters_MAXFREELIST 255
 #  define Py_object_stack_chunks_MAXFREELIST 4
+#  define Py_lazy_tracebacks_MAXFREELIST 80
+#  define PyGen_MAXSAVECLASS 8       // Number of size classes of generators to save
+#  define PyGen_SAVECLASS_SLOTS 8    // Frame slots added by each size class
+#  define Py_gens_MAXFREELIST 80     // Maximum number of generators of each size class
 
 // A generic freelist of either PyObjects or other data structures.
 struct _Py_freelist {
@@ -44,6 +48,8 @@ struct _Py_freelists {
     struct _Py_freelist async_gen_asends;
     struct _Py_freelist futureiters;
     struct _Py_freelist object_stack_chunks;
+    struct _Py_freelist lazy_tracebacks;
+    struct _Py_freelist gens[PyGen_MAXSAVECLASS];
 };
 
 #ifdef __cplusplus
@@ -232,8 +232,11 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(_asyncio_future_blocking)
         STRUCT_FOR_ID(_blksize)
         STRUCT_FOR_ID(_bootstrap)
+        STRUCT_FOR_ID(_cancelled)
         STRUCT_FOR_ID(_check_retval_)
+        STRUCT_FOR_ID(_clock_resolution)
         STRUCT_FOR_ID(_dealloc_warn)
+        STRUCT_FOR_ID(_debug)
         STRUCT_FOR_ID(_feature_version)
         STRUCT_FOR_ID(_field_types)
         STRUCT_FOR_ID(_fields_)
@@ -252,10 +255,19 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(_loop)
         STRUCT_FOR_ID(_needs_com_addref_)
         STRUCT_FOR_ID(_only_immortal)
+        STRUCT_FOR_ID(_ready)
+        STRUCT_FOR_ID(_remove_reader)
+        STRUCT_FOR_ID(_remove_writer)
+        STRUCT_FOR_ID(_report_exception)
         STRUCT_FOR_ID(_restype_)
+        STRUCT_FOR_ID(_run)
+        STRUCT_FOR_ID(_run_handle_debug)
+        STRUCT_FOR_ID(_scheduled)
+        STRUCT_FOR_ID(_selector)
         STRUCT_FOR_ID(_showwarnmsg)
         STRUCT_FOR_ID(_shutdown)
         STRUCT_FOR_ID(_slotnames)
+        STRUCT_FOR_ID(_stopping)
         STRUCT_FOR_ID(_strptime)
         STRUCT_FOR_ID(_strptime_datetime_date)
         STRUCT_FOR_ID(_strptime_datetime_datetime)
@@ -263,6 +275,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(_type_)
         STRUCT_FOR_ID(_uninitialized_submodules)
         STRUCT_FOR_ID(_warn_unawaited_coroutine)
+        STRUCT_FOR_ID(_when)
         STRUCT_FOR_ID(_xoptions)
         STRUCT_FOR_ID(abs_tol)
         STRUCT_FOR_ID(access)
@@ -274,6 +287,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(aggregate_class)
         STRUCT_FOR_ID(alias)
         STRUCT_FOR_ID(align)
+        STRUCT_FOR_ID(all_threads)
         STRUCT_FOR_ID(allow_code)
         STRUCT_FOR_ID(append)
         STRUCT_FOR_ID(arg)
@@ -297,6 +311,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(bitwise)
         STRUCT_FOR_ID(block)
         STRUCT_FOR_ID(bound)
+        STRUCT_FOR_ID(branches)
         STRUCT_FOR_ID(buffer)
         STRUCT_FOR_ID(buffer_callback)
         STRUCT_FOR_ID(buffer_size)
@@ -392,6 +407,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(dont_inherit)
         STRUCT_FOR_ID(dst)
         STRUCT_FOR_ID(dst_dir_fd)
+        STRUCT_FOR_ID(duration)
         STRUCT_FOR_ID(eager_start)
         STRUCT_FOR_ID(effective_ids)
         STRUCT_FOR_ID(element_factory)
@@ -404,6 +420,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(endpos)
         STRUCT_FOR_ID(entrypoint)
         STRUCT_FOR_ID(env)
+        STRUCT_FOR_ID(epoll_fd)
         STRUCT_FOR_ID(errors)
         STRUCT_FOR_ID(event)
         STRUCT_FOR_ID(eventmask)
@@ -422,6 +439,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(fanout)
         STRUCT_FOR_ID(fd)
         STRUCT_FOR_ID(fd2)
+        STRUCT_FOR_ID(fd_to_key)
         STRUCT_FOR_ID(fdel)
         STRUCT_FOR_ID(fget)
         STRUCT_FOR_ID(fields)
@@ -549,6 +567,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(manual_reset)
         STRUCT_FOR_ID(mapping)
         STRUCT_FOR_ID(match)
+        STRUCT_FOR_ID(max_depth)
         STRUCT_FOR_ID(max_length)
         STRUCT_FOR_ID(maxdigits)
         STRUCT_FOR_ID(maxevents)
@@ -626,6 +645,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(path)
         STRUCT_FOR_ID(pattern)
         STRUCT_FOR_ID(peek)
+        STRUCT_FOR_ID(per_thread)
         STRUCT_FOR_ID(persistent_id)
         STRUCT_FOR_ID(persistent_load)
         STRUCT_FOR_ID(person)
@@ -680,6 +700,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(security_attributes)
         STRUCT_FOR_ID(seek)
         STRUCT_FOR_ID(seekable)
+        STRUCT_FOR_ID(select)
         STRUCT_FOR_ID(selectors)
         STRUCT_FOR_ID(self)
         STRUCT_FOR_ID(send)
@@ -740,9 +761,11 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(text)
         STRUCT_FOR_ID(threading)
         STRUCT_FOR_ID(throw)
+        STRUCT_FOR_ID(time)
         STRUCT_FOR_ID(timeout)
         STRUCT_FOR_ID(times)
         STRUCT_FOR_ID(timetuple)
+        STRUCT_FOR_ID(tool_id)
         STRUCT_FOR_ID(top)
         STRUCT_FOR_ID(trace_callback)
         STRUCT_FOR_ID(traceback)
@@ -20,6 +20,7 @@ extern "C" {
 #include "pycore_dict_state.h"    // struct _Py_dict_state
 #include "pycore_dtoa.h"          // struct _dtoa_state
 #include "pycore_exceptions.h"    // struct _Py_exc_state
+#include "pycore_exec_stats.h"    // struct _exec_stats_state
 #include "pycore_floatobject.h"   // struct _Py_float_state
 #include "pycore_function.h"      // FUNC_MAX_WATCHERS
 #include "pycore_gc.h"            // struct _gc_runtime_state
@@ -28,6 +29,7 @@ extern "C" {
 #include "pycore_import.h"        // struct _import_state
 #include "pycore_instruments.h"   // _PY_MONITORING_EVENTS
 #include "pycore_list.h"          // struct _Py_list_state
+#include "pycore_lock_contention.h" // struct _lock_contention_state
 #include "pycore_mimalloc.h"      // struct _mimalloc_interp_state
 #include "pycore_object_state.h"  // struct _py_object_state
 #include "pycore_optimizer.h"     // _PyOptimizerObject
@@ -264,6 +266,8 @@ struct _is {
     size_t trace_run_counter;
     _rare_events rare_events;
     PyDict_WatchCallback builtins_dict_watcher;
+    struct _exec_stats_state exec_stats;
+    struct _lock_contention_state lock_contention;
 
     _Py_GlobalMonitors monitors;
     bool sys_profile_initialized;
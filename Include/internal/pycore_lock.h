@@ -51,9 +51,15 @@ typedef enum _PyLockFlags {
 
 // Lock a mutex with an optional timeout and additional options. See
 // _PyLockFlags for details.
-extern PyLockStatus
+// Export for '_sampleprof' shared extension
+PyAPI_FUNC(PyLockStatus)
 _PyMutex_LockTimed(PyMutex *m, PyTime_t timeout_ns, _PyLockFlags flags);
 
+// Lock the mutex of a critical section, detaching while waiting.  'obj' is
+// the object which owns the mutex, or NULL.  It is only used to label the
+// lock contention profile.
+extern void _PyMutex_LockCriticalSection(PyMutex *m, PyObject *obj);
+
 // Lock a mutex with additional options. See _PyLockFlags for details.
 static inline void
 PyMutex_LockFlags(PyMutex *m, _PyLockFlags flags)
@@ -93,6 +99,10 @@ PyAPI_FUNC(void) PyEvent_Wait(PyEvent *evt);
 PyAPI_FUNC(int)
 PyEvent_WaitTimed(PyEvent *evt, PyTime_t timeout_ns, int detach);
 
+// Yields the processor to another thread, for use in spin loops.
+// Export for '_queue' shared extension.
+PyAPI_FUNC(void) _Py_yield(void);
+
 // _PyRawMutex implements a word-sized mutex that that does not depend on the
 // parking lot API, and therefore can be used in the parking lot
 // implementation.
@@ -201,6 +211,52 @@ PyAPI_FUNC(void) _PyRWMutex_RUnlock(_PyRWMutex *rwmutex);
 PyAPI_FUNC(void) _PyRWMutex_Lock(_PyRWMutex *rwmutex);
 PyAPI_FUNC(void) _PyRWMutex_Unlock(_PyRWMutex *rwmutex);
 
+// A "big reader" lock, for data which is read much more often than it is
+// written. Readers increment a counter in one of _Py_BRLOCK_SLOTS slots,
+// picked by thread, instead of a single shared count: readers running on
+// different CPUs do not write to the same cache line, so read locking
+// scales with the number of threads. Writers are expensive: they announce
+// themselves in `writers`, then wait until the counters of all slots drop
+// to zero.
+//
+// Writers only exclude readers, not other writers: if writers need to be
+// serialized, they should hold an additional lock, such as a PyMutex or a
+// critical section, while they hold the write lock. New readers wait while
+// a writer holds the lock or waits for it, which avoids starvation of
+// writers. _PyBRLock_TryRLock() fails instead of waiting.
+//
+// The lock is not reentrant: a thread holding the read lock must not take
+// the write lock. The lock should be zero-initialized.
+#define _Py_BRLOCK_SLOTS 64
+
+typedef struct {
+    Py_ssize_t readers;
+    char __padding[64 - sizeof(Py_ssize_t)];
+} _PyBRLockSlot;
+
+typedef struct {
+    // Number of threads holding or waiting for the write lock
+    Py_ssize_t writers;
+    // Incremented by the readers which leave while there are writers, to
+    // wake up the writers waiting for the readers to leave
+    uint32_t drain_seq;
+    _PyBRLockSlot slots[_Py_BRLOCK_SLOTS];
+} _PyBRLock;
+
+// Read lock (i.e., shared lock)
+PyAPI_FUNC(void) _PyBRLock_RLock(_PyBRLock *lock);
+// Take the read lock if there are no writers: return 1 on success, 0 if
+// the lock is held or requested by a writer.
+PyAPI_FUNC(int) _PyBRLock_TryRLock(_PyBRLock *lock);
+PyAPI_FUNC(void) _PyBRLock_RUnlock(_PyBRLock *lock);
+
+// Write lock (i.e., exclusive lock with respect to readers)
+PyAPI_FUNC(void) _PyBRLock_Lock(_PyBRLock *lock);
+PyAPI_FUNC(void) _PyBRLock_Unlock(_PyBRLock *lock);
+
+// Forget the readers of the other threads in the child process after fork().
+extern void _PyBRLock_AfterFork(_PyBRLock *lock);
+
 // Similar to linux seqlock: https://en.wikipedia.org/wiki/Seqlock
 // We use a sequence number to lock the writer, an even sequence means we're unlocked, an odd
 // sequence means we're locked.  Readers will read the sequence before attempting to read the
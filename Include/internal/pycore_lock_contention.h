@@ -0,0 +1,119 @@
+#ifndef Py_INTERNAL_LOCK_CONTENTION_H
+#define Py_INTERNAL_LOCK_CONTENTION_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+// Lock contention profile: how long threads wait for PyMutex locks, for the
+// locks of critical sections and for the GIL, and where.
+//
+// Profiling is off by default and is toggled at runtime with
+// sys._lock_contention_on() and sys._lock_contention_off().  While it is on,
+// every thread state owns a _PyLockContentionTable
+// (_PyThreadStateImpl.lock_contention) which is only written by that thread,
+// so recording needs neither a lock nor atomic operations.  Only the slow
+// paths of the locks, which are taken when a lock is contended, check the
+// table pointer: uncontended acquisitions and releases are unchanged.
+//
+// Sites are identified by the address of the lock.  Each site has a
+// histogram of the wait times, and the Python stacks of the first waiter
+// and of the first holder which released the lock while threads were
+// waiting for it.
+//
+// Tables of exiting threads are merged into the interpreter's table
+// (interp->lock_contention.retired) in PyThreadState_Clear().  Reading,
+// clearing and toggling stop the world so that no thread is recording.
+
+typedef enum {
+    _Py_LOCK_CONTENTION_MUTEX = 0,
+    _Py_LOCK_CONTENTION_CRITICAL_SECTION = 1,
+    _Py_LOCK_CONTENTION_GIL = 2,
+} _PyLockContentionKind;
+
+// Number of frames kept in a stack sample
+#define _Py_LOCK_CONTENTION_DEPTH 4
+
+// Bucket 0 counts the waits shorter than 1 us and bucket i > 0 the waits
+// in [2**(i-1), 2**i) us.  The last bucket also counts the longer waits.
+#define _Py_LOCK_CONTENTION_BUCKETS 20
+
+typedef struct {
+    PyCodeObject *code;     // strong reference, or NULL
+    int lineno;
+} _PyLockContentionFrame;
+
+typedef struct {
+    const void *lock;       // NULL for a free slot
+    PyTypeObject *type;     // strong reference to the type of the object
+                            // of a critical section, or NULL
+    _PyLockContentionKind kind;
+    uint64_t count;         // contended acquisitions
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t histogram[_Py_LOCK_CONTENTION_BUCKETS];
+    _PyLockContentionFrame waiter[_Py_LOCK_CONTENTION_DEPTH];
+    _PyLockContentionFrame holder[_Py_LOCK_CONTENTION_DEPTH];
+} _PyLockContentionSite;
+
+typedef struct _Py_lock_contention_table {
+    // Open addressing hash table indexed by the address of the lock.  The
+    // sites are allocated on first use and grow up to a limit; the waits on
+    // the sites which don't fit are only counted in 'dropped'.
+    _PyLockContentionSite *sites;
+    Py_ssize_t size;        // used slots
+    Py_ssize_t mask;        // number of slots minus one
+    uint64_t dropped;
+    // Set while recording, to ignore the locks taken by the memory allocator
+    int busy;
+    // Used to chain the tables of all threads when profiling is turned off
+    struct _Py_lock_contention_table *next;
+} _PyLockContentionTable;
+
+struct _lock_contention_state {
+    // Non-zero while profiling is on.  Written with HEAD_LOCK held, may be
+    // read without it to avoid allocating tables needlessly.
+    int enabled;
+    // Sites of the threads which exited.  Protected by 'mutex'.
+    PyMutex mutex;
+    _PyLockContentionTable retired;
+};
+
+#define _PyLockContention_GET(tstate) \
+    (((_PyThreadStateImpl *)(tstate))->lock_contention)
+
+// Record a contended acquisition of 'lock' by the current thread, which
+// started waiting at 'start' (PyTime_MonotonicRaw()).  'obj' is the object
+// of a critical section, or NULL.
+extern void _PyLockContention_RecordWait(PyThreadState *tstate,
+                                         _PyLockContentionKind kind,
+                                         const void *lock, PyObject *obj,
+                                         PyTime_t start);
+// Record the stack of the current thread which releases 'lock' while other
+// threads are waiting for it.
+extern void _PyLockContention_RecordHolder(PyThreadState *tstate,
+                                           _PyLockContentionKind kind,
+                                           const void *lock);
+
+// Called by PyThreadState_Clear().
+extern void _PyLockContention_ClearThread(PyThreadState *tstate);
+// Called by the interpreter finalization, after all threads were cleared.
+extern void _PyLockContention_Fini(PyInterpreterState *interp);
+
+extern int _PyLockContention_Enable(PyInterpreterState *interp);
+extern void _PyLockContention_Disable(PyInterpreterState *interp);
+extern int _PyLockContention_Clear(PyInterpreterState *interp);
+// Return a dict: 'sites' is a list of dicts, one per site, by decreasing
+// total wait time, and 'dropped' counts the waits which were not recorded.
+extern PyObject* _PyLockContention_AsDict(PyInterpreterState *interp);
+
+#ifdef __cplusplus
+}
+#endif
+#endif   // !Py_INTERNAL_LOCK_CONTENTION_H
@@ -117,7 +117,8 @@ extern int _PyMem_SetupAllocators(PyMemAllocatorName allocator);
 extern int _PyMem_DebugEnabled(void);
 
 // Enqueue a pointer to be freed possibly after some delay.
-extern void _PyMem_FreeDelayed(void *ptr);
+// Export for '_queue' shared extension.
+PyAPI_FUNC(void) _PyMem_FreeDelayed(void *ptr);
 
 // Enqueue an object to be freed possibly after some delay
 extern void _PyObject_FreeDelayed(void *ptr);
@@ -97,6 +97,7 @@ typedef struct _Py_DebugOffsets {
         uint64_t thread_id;
         uint64_t native_thread_id;
         uint64_t datastack_chunk;
+        uint64_t datastack_top;
         uint64_t status;
     } thread_state;
 
@@ -194,6 +195,22 @@ typedef struct _Py_DebugOffsets {
     } gc;
 } _Py_DebugOffsets;
 
+/* Offsets used by out of process debuggers to find the task run by each
+   thread.  The _asyncio module stores them in its "AsyncioDebug" data
+   section.  The same caveats as for _Py_DebugOffsets apply. */
+typedef struct _Py_AsyncioModuleDebugOffsets {
+    struct _asyncio_task_object {
+        uint64_t size;
+        uint64_t task_name;
+        uint64_t task_coro;
+    } asyncio_task_object;
+    struct _asyncio_thread_state {
+        uint64_t size;
+        uint64_t asyncio_running_loop;
+        uint64_t asyncio_running_task;
+    } asyncio_thread_state;
+} _Py_AsyncioModuleDebugOffsets;
+
 /* Reference tracer state */
 struct _reftracer_runtime_state {
     PyRefTracer tracer_func;
@@ -64,6 +64,7 @@ extern PyTypeObject _PyExc_MemoryError;
                 .thread_id = offsetof(PyThreadState, thread_id), \
                 .native_thread_id = offsetof(PyThreadState, native_thread_id), \
                 .datastack_chunk = offsetof(PyThreadState, datastack_chunk), \
+                .datastack_top = offsetof(PyThreadState, datastack_top), \
                 .status = offsetof(PyThreadState, _status), \
             }, \
             .interpreter_frame = { \
@@ -741,8 +741,11 @@ extern "C" {
     INIT_ID(_asyncio_future_blocking), \
     INIT_ID(_blksize), \
     INIT_ID(_bootstrap), \
+    INIT_ID(_cancelled), \
     INIT_ID(_check_retval_), \
+    INIT_ID(_clock_resolution), \
     INIT_ID(_dealloc_warn), \
+    INIT_ID(_debug), \
     INIT_ID(_feature_version), \
     INIT_ID(_field_types), \
     INIT_ID(_fields_), \
@@ -761,10 +764,19 @@ extern "C" {
     INIT_ID(_loop), \
     INIT_ID(_needs_com_addref_), \
     INIT_ID(_only_immortal), \
+    INIT_ID(_ready), \
+    INIT_ID(_remove_reader), \
+    INIT_ID(_remove_writer), \
+    INIT_ID(_report_exception), \
     INIT_ID(_restype_), \
+    INIT_ID(_run), \
+    INIT_ID(_run_handle_debug), \
+    INIT_ID(_scheduled), \
+    INIT_ID(_selector), \
     INIT_ID(_showwarnmsg), \
     INIT_ID(_shutdown), \
     INIT_ID(_slotnames), \
+    INIT_ID(_stopping), \
     INIT_ID(_strptime), \
     INIT_ID(_strptime_datetime_date), \
     INIT_ID(_strptime_datetime_datetime), \
@@ -772,6 +784,7 @@ extern "C" {
     INIT_ID(_type_), \
     INIT_ID(_uninitialized_submodules), \
     INIT_ID(_warn_unawaited_coroutine), \
+    INIT_ID(_when), \
     INIT_ID(_xoptions), \
     INIT_ID(abs_tol), \
     INIT_ID(access), \
@@ -783,6 +796,7 @@ extern "C" {
     INIT_ID(aggregate_class), \
     INIT_ID(alias), \
     INIT_ID(align), \
+    INIT_ID(all_threads), \
     INIT_ID(allow_code), \
     INIT_ID(append), \
     INIT_ID(arg), \
@@ -806,6 +820,7 @@ extern "C" {
     INIT_ID(bitwise), \
     INIT_ID(block), \
     INIT_ID(bound), \
+    INIT_ID(branches), \
     INIT_ID(buffer), \
     INIT_ID(buffer_callback), \
     INIT_ID(buffer_size), \
@@ -901,6 +916,7 @@ extern "C" {
     INIT_ID(dont_inherit), \
     INIT_ID(dst), \
     INIT_ID(dst_dir_fd), \
+    INIT_ID(duration), \
     INIT_ID(eager_start), \
     INIT_ID(effective_ids), \
     INIT_ID(element_factory), \
@@ -913,6 +929,7 @@ extern "C" {
     INIT_ID(endpos), \
     INIT_ID(entrypoint), \
     INIT_ID(env), \
+    INIT_ID(epoll_fd), \
     INIT_ID(errors), \
     INIT_ID(event), \
     INIT_ID(eventmask), \
@@ -931,6 +948,7 @@ extern "C" {
     INIT_ID(fanout), \
     INIT_ID(fd), \
     INIT_ID(fd2), \
+    INIT_ID(fd_to_key), \
     INIT_ID(fdel), \
     INIT_ID(fget), \
     INIT_ID(fields), \
@@ -1058,6 +1076,7 @@ extern "C" {
     INIT_ID(manual_reset), \
     INIT_ID(mapping), \
     INIT_ID(match), \
+    INIT_ID(max_depth), \
     INIT_ID(max_length), \
     INIT_ID(maxdigits), \
     INIT_ID(maxevents), \
@@ -1135,6 +1154,7 @@ extern "C" {
     INIT_ID(path), \
     INIT_ID(pattern), \
     INIT_ID(peek), \
+    INIT_ID(per_thread), \
     INIT_ID(persistent_id), \
     INIT_ID(persistent_load), \
     INIT_ID(person), \
@@ -1189,6 +1209,7 @@ extern "C" {
     INIT_ID(security_attributes), \
     INIT_ID(seek), \
     INIT_ID(seekable), \
+    INIT_ID(select), \
     INIT_ID(selectors), \
     INIT_ID(self), \
     INIT_ID(send), \
@@ -1249,9 +1270,11 @@ extern "C" {
     INIT_ID(text), \
     INIT_ID(threading), \
     INIT_ID(throw), \
+    INIT_ID(time), \
     INIT_ID(timeout), \
     INIT_ID(times), \
     INIT_ID(timetuple), \
+    INIT_ID(tool_id), \
     INIT_ID(top), \
     INIT_ID(trace_callback), \
     INIT_ID(traceback), \
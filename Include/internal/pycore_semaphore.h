@@ -20,7 +20,17 @@
 #   error "Require native threads. See https://bugs.python.org/issue31370"
 #endif
 
-#if (defined(_POSIX_SEMAPHORES) && (_POSIX_SEMAPHORES+0) != -1 && \
+// On Linux, wait directly on a futex: a semaphore then is a single counter
+// and waking up a thread is a single system call.
+#if defined(HAVE_LINUX_FUTEX_H) && defined(HAVE_SYS_SYSCALL_H)
+#   include <sys/syscall.h>       // SYS_futex
+#   ifdef SYS_futex
+#       define _Py_USE_FUTEX
+#   endif
+#endif
+
+#if (!defined(_Py_USE_FUTEX) && \
+        defined(_POSIX_SEMAPHORES) && (_POSIX_SEMAPHORES+0) != -1 && \
         defined(HAVE_SEM_TIMEDWAIT))
 #   define _Py_USE_SEMAPHORES
 #   include <semaphore.h>
@@ -34,6 +44,8 @@ extern "C" {
 typedef struct _PySemaphore {
 #if defined(MS_WINDOWS)
     HANDLE platform_sem;
+#elif defined(_Py_USE_FUTEX)
+    uint32_t counter;
 #elif defined(_Py_USE_SEMAPHORES)
     sem_t platform_sem;
 #else
@@ -90,6 +90,34 @@ extern PyObject* _PyTraceBack_FromFrame(
     PyObject *tb_next,
     PyFrameObject *frame);
 
+/* Lazily captured tracebacks.
+
+   While an exception unwinds, the interpreter only records the frame and
+   the offset of the failing instruction into a private object stored in
+   the exception's traceback slot.  Frame and traceback objects are created
+   when the traceback is first requested through PyException_GetTraceback()
+   or __traceback__, or when a recorded frame finishes executing.  The
+   private object never escapes to Python code. */
+
+struct _PyInterpreterFrame;
+
+extern PyTypeObject _PyLazyTraceBack_Type;
+#define _PyLazyTraceBack_Check(v) Py_IS_TYPE((v), &_PyLazyTraceBack_Type)
+
+/* Record the frame in the traceback of the raised exception.
+   Return 0 on success, or chain an error and return -1. */
+extern int _PyTraceBack_AddFrame(
+    PyThreadState *tstate,
+    struct _PyInterpreterFrame *frame);
+
+/* Build the traceback objects for a lazy traceback.
+   Return a new reference, or set an exception and return NULL. */
+extern PyObject* _PyTraceBack_Materialize(PyObject *lazy_tb);
+
+/* Create the frame objects referenced by lazy tracebacks before
+   the frame is cleared.  Called only if frame->lazy_tb is set. */
+extern void _PyTraceBack_ReleaseFrame(struct _PyInterpreterFrame *frame);
+
 #define EXCEPTION_TB_HEADER "Traceback (most recent call last):\n"
 #define EXCEPTION_GROUP_TB_HEADER "Exception Group Traceback (most recent call last):\n"
 
@@ -22,6 +22,33 @@ typedef struct _PyThreadStateImpl {
     PyThreadState base;
 
     PyObject *asyncio_running_loop; // Strong reference
+    // Task currently run by the thread, only set for _asyncio.Task
+    // instances.  Out of process debuggers read it to label samples.
+    PyObject *asyncio_running_task; // Strong reference
+
+    // Execution stats counters, NULL unless sys._exec_stats_on() was called
+    struct _Py_exec_stats *exec_stats;
+
+    // Lock contention profile, NULL unless sys._lock_contention_on() was
+    // called
+    struct _Py_lock_contention_table *lock_contention;
+    // Set by take_gil() to the time at which the thread started to wait for
+    // the GIL, which is recorded in the profile once the thread is attached
+    PyTime_t gil_wait_start;
+
+    // Data stack chunks popped by _PyThreadState_PopFrame() are kept here,
+    // linked through their 'previous' field, instead of being freed, so that
+    // calls which repeatedly cross a chunk boundary don't allocate.
+    struct {
+        _PyStackChunk *spare;
+        int nspare;
+        // Size of the largest chunk allocated by this thread
+        int max_size;
+        // Counters exposed by sys._get_datastack_stats()
+        uint64_t allocated;
+        uint64_t freed;
+        uint64_t reused;
+    } datastack;
 
     struct _qsbr_thread_state *qsbr;  // only used by free-threaded build
     struct llist_node mem_free_queue; // delayed free queue
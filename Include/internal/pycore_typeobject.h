@@ -129,6 +129,12 @@ struct types_state {
         managed_static_type_state initialized[_Py_MAX_MANAGED_STATIC_EXT_TYPES];
     } for_extensions;
     PyMutex mutex;
+#ifdef Py_GIL_DISABLED
+    // Held for writing along with 'mutex' by type mutations, and for
+    // reading by the type cache lookups which miss, so that they can run
+    // concurrently without taking 'mutex'.
+    _PyBRLock lookup_lock;
+#endif
 
     // Borrowed references to type objects whose
     // tp_version_tag % TYPE_VERSION_CACHE_SIZE
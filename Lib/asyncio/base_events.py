@@ -2019,20 +2019,25 @@ def _run_once(self):
             if handle._cancelled:
                 continue
             if self._debug:
-                try:
-                    self._current_handle = handle
-                    t0 = self.time()
-                    handle._run()
-                    dt = self.time() - t0
-                    if dt >= self.slow_callback_duration:
-                        logger.warning('Executing %s took %.3f seconds',
-                                       _format_handle(handle), dt)
-                finally:
-                    self._current_handle = None
+                self._run_handle_debug(handle)
             else:
                 handle._run()
         handle = None  # Needed to break cycles when an exception occurs.
 
+    def _run_handle_debug(self, handle):
+        """Run a handle in debug mode, logging it if it is too slow."""
+        try:
+            self._current_handle = handle
+            t0 = self.time()
+            handle._run()
+            dt = self.time() - t0
+            if dt >= self.slow_callback_duration:
+                logger.warning('Executing %s took %.3f seconds',
+                               _format_handle(handle), dt)
+        finally:
+            self._current_handle = None
+            handle = None  # Needed to break cycles when an exception occurs.
+
     def _set_coroutine_origin_tracking(self, enabled):
         if bool(enabled) == bool(self._coroutine_origin_tracking_enabled):
             return
@@ -89,20 +89,23 @@ def _run(self):
         except (SystemExit, KeyboardInterrupt):
             raise
         except BaseException as exc:
-            cb = format_helpers._format_callback_source(
-                self._callback, self._args,
-                debug=self._loop.get_debug())
-            msg = f'Exception in callback {cb}'
-            context = {
-                'message': msg,
-                'exception': exc,
-                'handle': self,
-            }
-            if self._source_traceback:
-                context['source_traceback'] = self._source_traceback
-            self._loop.call_exception_handler(context)
+            self._report_exception(exc)
         self = None  # Needed to break cycles when an exception occurs.
 
+    def _report_exception(self, exc):
+        cb = format_helpers._format_callback_source(
+            self._callback, self._args,
+            debug=self._loop.get_debug())
+        msg = f'Exception in callback {cb}'
+        context = {
+            'message': msg,
+            'exception': exc,
+            'handle': self,
+        }
+        if self._source_traceback:
+            context['source_traceback'] = self._source_traceback
+        self._loop.call_exception_handler(context)
+
 
 class TimerHandle(Handle):
     """Object returned by timed callback registration methods."""
@@ -6,6 +6,7 @@
 
 __all__ = 'BaseSelectorEventLoop',
 
+import array
 import collections
 import errno
 import functools
@@ -13,6 +14,7 @@
 import os
 import selectors
 import socket
+import struct
 import warnings
 import weakref
 try:
@@ -31,6 +33,8 @@
 from .log import logger
 
 _HAS_SENDMSG = hasattr(socket.socket, 'sendmsg')
+_HAS_MMSG = (hasattr(socket.socket, 'recvmmsg_into') and
+             hasattr(socket.socket, 'sendmmsg'))
 
 if _HAS_SENDMSG:
     try:
@@ -39,6 +43,81 @@
         # Fallback to send
         _HAS_SENDMSG = False
 
+_HAS_ZEROCOPY = (_HAS_SENDMSG and hasattr(socket, 'MSG_ZEROCOPY') and
+                 hasattr(socket, 'SO_EE_ORIGIN_ZEROCOPY'))
+
+if _HAS_ZEROCOPY:
+    # struct sock_extended_err of <linux/errqueue.h>
+    _sock_extended_err = struct.Struct('=IBBBBII')
+    _RECVERR = {(socket.IPPROTO_IP, socket.IP_RECVERR),
+                (socket.IPPROTO_IPV6, socket.IPV6_RECVERR)}
+
+
+def _zerocopy_enabled(sock):
+    # MSG_ZEROCOPY is opt-in: it is only used if SO_ZEROCOPY was set on
+    # the TCP socket.
+    if (not _HAS_ZEROCOPY or sock.type != socket.SOCK_STREAM or
+            sock.family not in (socket.AF_INET, socket.AF_INET6)):
+        return False
+    try:
+        return bool(sock.getsockopt(socket.SOL_SOCKET, socket.SO_ZEROCOPY))
+    except OSError:
+        return False
+
+
+def _zerocopy_release_completed(sock, pinned):
+    """Release the buffers of the MSG_ZEROCOPY sends that completed.
+
+    pinned is a deque of (send id, buffers) pairs, in send order.  The
+    kernel reports the completed ids on the error queue of the socket.
+    Return True if it copied the data rather than using the buffers.
+    """
+    copied = False
+    while pinned:
+        try:
+            _, ancdata, _, _ = sock.recvmsg(0, 128, socket.MSG_ERRQUEUE)
+        except (BlockingIOError, InterruptedError):
+            break
+        for level, type, data in ancdata:
+            if ((level, type) not in _RECVERR or
+                    len(data) < _sock_extended_err.size):
+                continue
+            _, origin, _, code, _, first, last = (
+                _sock_extended_err.unpack_from(data))
+            if origin != socket.SO_EE_ORIGIN_ZEROCOPY:
+                continue
+            if code & socket.SO_EE_CODE_ZEROCOPY_COPIED:
+                copied = True
+            # The ids are 32-bit counters which wrap around.
+            while pinned and (last - pinned[0][0]) & 0xFFFFFFFF < 0x80000000:
+                pinned.popleft()
+    return copied
+
+
+def _zerocopy_linger(loop, sock, pinned, delay=0.001):
+    # The transport closes its socket while the kernel may still read the
+    # pinned buffers.  Keep them alive with a duplicate of the socket, on
+    # which the completions are polled from time to time.  The error
+    # queue is not registered to the selector: the socket may stay
+    # readable once the transport stopped reading it.
+    sock = sock.dup()
+    try:
+        sock.shutdown(socket.SHUT_WR)
+    except OSError:
+        pass
+
+    def release(delay):
+        try:
+            _zerocopy_release_completed(sock, pinned)
+        except OSError:
+            pinned.clear()
+        if pinned:
+            loop.call_later(delay, release, min(delay * 2, 1.0))
+        else:
+            sock.close()
+
+    release(delay)
+
 def _test_selector_event(selector, fd, event):
     # Test if the selector is monitoring 'event' events
     # for the file descriptor 'fd'.
@@ -936,6 +1015,9 @@ def __init__(self, loop, sock, protocol, waiter=None,
             self._write_ready = self._write_sendmsg
         else:
             self._write_ready = self._write_send
+        self._zerocopy = _zerocopy_enabled(sock)
+        self._zerocopy_id = 0  # Id of the next MSG_ZEROCOPY send.
+        self._zerocopy_pinned = collections.deque()
         # Disable the Nagle algorithm -- small writes will be
         # sent without waiting for the TCP ACK.  This generally
         # decreases the latency (in some cases significantly.)
@@ -959,6 +1041,8 @@ def set_protocol(self, protocol):
         super().set_protocol(protocol)
 
     def _read_ready(self):
+        if self._zerocopy_pinned:
+            self._zerocopy_release()
         self._read_ready_cb()
 
     def _read_ready__get_buffer(self):
@@ -1064,7 +1148,10 @@ def write(self, data):
         if not self._buffer:
             # Optimization: try to send now.
             try:
-                n = self._sock.send(data)
+                if self._zerocopy:
+                    n = self._sendmsg_zerocopy([data])
+                else:
+                    n = self._sock.send(data)
             except (BlockingIOError, InterruptedError):
                 pass
             except (SystemExit, KeyboardInterrupt):
@@ -1086,12 +1173,55 @@ def write(self, data):
     def _get_sendmsg_buffer(self):
         return itertools.islice(self._buffer, SC_IOV_MAX)
 
+    # Smaller writes are copied: pinning the pages and reading the
+    # completions costs more than copying them.
+    _zerocopy_threshold = 32 * 1024
+
+    def _sendmsg_zerocopy(self, buffers):
+        # The kernel reads the buffers after sendmsg() returns: only
+        # immutable buffers are sent with MSG_ZEROCOPY, and they are kept
+        # alive until the kernel reports the completion.
+        size = 0
+        for data in buffers:
+            if isinstance(data, memoryview):
+                if not data.readonly:
+                    return self._sock.sendmsg(buffers)
+                size += data.nbytes
+            elif isinstance(data, bytes):
+                size += len(data)
+            else:
+                return self._sock.sendmsg(buffers)
+        if size < self._zerocopy_threshold:
+            return self._sock.sendmsg(buffers)
+        n = self._sock.sendmsg(buffers, (), socket.MSG_ZEROCOPY)
+        self._zerocopy_pinned.append((self._zerocopy_id, buffers))
+        self._zerocopy_id = (self._zerocopy_id + 1) & 0xFFFFFFFF
+        return n
+
+    def _zerocopy_release(self):
+        try:
+            copied = _zerocopy_release_completed(self._sock,
+                                                 self._zerocopy_pinned)
+        except OSError:
+            # Let the send or receive calls report the error.
+            return
+        if copied:
+            # The kernel had to copy the data (e.g. on the loopback
+            # interface): MSG_ZEROCOPY only adds overhead.
+            self._zerocopy = False
+
     def _write_sendmsg(self):
         assert self._buffer, 'Data should not be empty'
         if self._conn_lost:
             return
+        if self._zerocopy_pinned:
+            self._zerocopy_release()
         try:
-            nbytes = self._sock.sendmsg(self._get_sendmsg_buffer())
+            if self._zerocopy:
+                nbytes = self._sendmsg_zerocopy(
+                    list(self._get_sendmsg_buffer()))
+            else:
+                nbytes = self._sock.sendmsg(self._get_sendmsg_buffer())
             self._adjust_leftover_buffer(nbytes)
         except (BlockingIOError, InterruptedError):
             pass
@@ -1180,6 +1310,11 @@ def can_write_eof(self):
         return True
 
     def _call_connection_lost(self, exc):
+        if self._zerocopy_pinned:
+            self._zerocopy_release()
+            if self._zerocopy_pinned:
+                _zerocopy_linger(self._loop, self._sock,
+                                 self._zerocopy_pinned)
         super()._call_connection_lost(exc)
         if self._empty_waiter is not None:
             self._empty_waiter.set_exception(
@@ -1206,11 +1341,25 @@ class _SelectorDatagramTransport(_SelectorTransport, transports.DatagramTranspor
 
     _buffer_factory = collections.deque
 
+    # Number of datagrams transferred by a single recvmmsg_into() or
+    # sendmmsg() call.  IPv4 and IPv6 datagrams are at most 64 KiB long,
+    # so only these sockets use batches: others keep using recvfrom() with
+    # max_size.  The receive buffers are only allocated once _mmsg_batch
+    # datagrams were received, so that short-lived endpoints (such as DNS
+    # queries) do not pay for them.
+    _mmsg_batch = 16
+    _mmsg_size = 64 * 1024
+
     def __init__(self, loop, sock, protocol, address=None,
                  waiter=None, extra=None):
         super().__init__(loop, sock, protocol, extra)
         self._address = address
         self._buffer_size = 0
+        self._mmsg = _HAS_MMSG and sock.family in (socket.AF_INET,
+                                                   socket.AF_INET6)
+        self._mmsg_received = 0
+        self._mmsg_buffers = None
+        self._mmsg_sizes = None
         self._loop.call_soon(self._protocol.connection_made, self)
         # only start reading when connection_made() has been called
         self._loop.call_soon(self._add_reader,
@@ -1226,6 +1375,9 @@ def get_write_buffer_size(self):
     def _read_ready(self):
         if self._conn_lost:
             return
+        if self._mmsg_buffers is not None:
+            self._read_ready__recvmmsg()
+            return
         try:
             data, addr = self._sock.recvfrom(self.max_size)
         except (BlockingIOError, InterruptedError):
@@ -1237,8 +1389,42 @@ def _read_ready(self):
         except BaseException as exc:
             self._fatal_error(exc, 'Fatal read error on datagram transport')
         else:
+            if self._mmsg:
+                self._mmsg_received += 1
+                if self._mmsg_received >= self._mmsg_batch:
+                    self._mmsg_alloc_buffers()
             self._protocol.datagram_received(data, addr)
 
+    def _mmsg_alloc_buffers(self):
+        size = self._mmsg_size
+        view = memoryview(bytearray(self._mmsg_batch * size))
+        self._mmsg_buffers = [view[i:i + size]
+                              for i in range(0, len(view), size)]
+        self._mmsg_sizes = array.array('i', bytes(4 * self._mmsg_batch))
+
+    def _read_ready__recvmmsg(self):
+        buffers = self._mmsg_buffers
+        sizes = self._mmsg_sizes
+        addresses = []
+        try:
+            n = self._sock.recvmmsg_into(buffers, sizes, 0, addresses)
+        except (BlockingIOError, InterruptedError):
+            return
+        except OSError as exc:
+            self._protocol.error_received(exc)
+            return
+        except (SystemExit, KeyboardInterrupt):
+            raise
+        except BaseException as exc:
+            self._fatal_error(exc, 'Fatal read error on datagram transport')
+            return
+        for i in range(n):
+            # datagram_received() may close the transport.
+            if self._conn_lost:
+                break
+            data = bytes(buffers[i][:sizes[i]])
+            self._protocol.datagram_received(data, addresses[i])
+
     def sendto(self, data, addr=None):
         if not isinstance(data, (bytes, bytearray, memoryview)):
             raise TypeError(f'data argument must be a bytes-like object, '
@@ -1283,6 +1469,13 @@ def sendto(self, data, addr=None):
 
     def _sendto_ready(self):
         while self._buffer:
+            if self._mmsg and len(self._buffer) > 1:
+                sent = self._sendto_ready__sendmmsg()
+                if sent is None:
+                    return
+                if not sent:
+                    break  # Try again later.
+                continue
             data, addr = self._buffer.popleft()
             self._buffer_size -= len(data)
             try:
@@ -1309,3 +1502,32 @@ def _sendto_ready(self):
             self._loop._remove_writer(self._sock_fd)
             if self._closing:
                 self._call_connection_lost(None)
+
+    def _sendto_ready__sendmmsg(self):
+        # Return the number of datagrams sent, or None if the caller must
+        # return immediately.
+        batch = list(itertools.islice(self._buffer, self._mmsg_batch))
+        try:
+            if self._extra['peername']:
+                n = self._sock.sendmmsg([data for data, addr in batch])
+            else:
+                n = self._sock.sendmmsg([data for data, addr in batch], 0,
+                                        [addr for data, addr in batch])
+        except (BlockingIOError, InterruptedError):
+            n = 0
+        except OSError as exc:
+            # Like sendto(), drop the datagram which failed.
+            data, addr = self._buffer.popleft()
+            self._buffer_size -= len(data)
+            self._protocol.error_received(exc)
+            return None
+        except (SystemExit, KeyboardInterrupt):
+            raise
+        except BaseException as exc:
+            self._fatal_error(
+                exc, 'Fatal write error on datagram transport')
+            return None
+        for i in range(n):
+            data, addr = self._buffer.popleft()
+            self._buffer_size -= len(data)
+        return n
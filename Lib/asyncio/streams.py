@@ -1,6 +1,6 @@
 __all__ = (
-    'StreamReader', 'StreamWriter', 'StreamReaderProtocol',
-    'open_connection', 'start_server')
+    'StreamReader', 'BufferedStreamReader', 'StreamWriter',
+    'StreamReaderProtocol', 'open_connection', 'start_server')
 
 import collections
 import socket
@@ -24,7 +24,7 @@
 
 
 async def open_connection(host=None, port=None, *,
-                          limit=_DEFAULT_LIMIT, **kwds):
+                          limit=_DEFAULT_LIMIT, buffered=False, **kwds):
     """A wrapper for create_connection() returning a (reader, writer) pair.
 
     The reader returned is a StreamReader instance; the writer is a
@@ -35,16 +35,15 @@ async def open_connection(host=None, port=None, *,
     with various optional keyword arguments following.
 
     Additional optional keyword arguments are loop (to set the event loop
-    instance to use) and limit (to set the buffer limit passed to the
-    StreamReader).
+    instance to use), limit (to set the buffer limit passed to the
+    StreamReader) and buffered (to return a BufferedStreamReader).
 
     (If you want to customize the StreamReader and/or
     StreamReaderProtocol classes, just copy the code -- there's
     really nothing special here except some convenience.)
     """
     loop = events.get_running_loop()
-    reader = StreamReader(limit=limit, loop=loop)
-    protocol = StreamReaderProtocol(reader, loop=loop)
+    reader, protocol = _make_reader(limit, buffered, None, loop)
     transport, _ = await loop.create_connection(
         lambda: protocol, host, port, **kwds)
     writer = StreamWriter(transport, protocol, reader, loop)
@@ -52,7 +51,7 @@ async def open_connection(host=None, port=None, *,
 
 
 async def start_server(client_connected_cb, host=None, port=None, *,
-                       limit=_DEFAULT_LIMIT, **kwds):
+                       limit=_DEFAULT_LIMIT, buffered=False, **kwds):
     """Start a socket server, call back for each client connected.
 
     The first parameter, `client_connected_cb`, takes two parameters:
@@ -67,8 +66,9 @@ async def start_server(client_connected_cb, host=None, port=None, *,
     positional host and port, with various optional keyword arguments
     following.  The return value is the same as loop.create_server().
 
-    Additional optional keyword argument is limit (to set the buffer
-    limit passed to the StreamReader).
+    Additional optional keyword arguments are limit (to set the buffer
+    limit passed to the StreamReader) and buffered (to pass a
+    BufferedStreamReader to client_connected_cb).
 
     The return value is the same as loop.create_server(), i.e. a
     Server object which can be used to stop the service.
@@ -76,9 +76,8 @@ async def start_server(client_connected_cb, host=None, port=None, *,
     loop = events.get_running_loop()
 
     def factory():
-        reader = StreamReader(limit=limit, loop=loop)
-        protocol = StreamReaderProtocol(reader, client_connected_cb,
-                                        loop=loop)
+        reader, protocol = _make_reader(limit, buffered, client_connected_cb,
+                                        loop)
         return protocol
 
     return await loop.create_server(factory, host, port, **kwds)
@@ -88,31 +87,42 @@ def factory():
     # UNIX Domain Sockets are supported on this platform
 
     async def open_unix_connection(path=None, *,
-                                   limit=_DEFAULT_LIMIT, **kwds):
+                                   limit=_DEFAULT_LIMIT, buffered=False,
+                                   **kwds):
         """Similar to `open_connection` but works with UNIX Domain Sockets."""
         loop = events.get_running_loop()
 
-        reader = StreamReader(limit=limit, loop=loop)
-        protocol = StreamReaderProtocol(reader, loop=loop)
+        reader, protocol = _make_reader(limit, buffered, None, loop)
         transport, _ = await loop.create_unix_connection(
             lambda: protocol, path, **kwds)
         writer = StreamWriter(transport, protocol, reader, loop)
         return reader, writer
 
     async def start_unix_server(client_connected_cb, path=None, *,
-                                limit=_DEFAULT_LIMIT, **kwds):
+                                limit=_DEFAULT_LIMIT, buffered=False, **kwds):
         """Similar to `start_server` but works with UNIX Domain Sockets."""
         loop = events.get_running_loop()
 
         def factory():
-            reader = StreamReader(limit=limit, loop=loop)
-            protocol = StreamReaderProtocol(reader, client_connected_cb,
-                                            loop=loop)
+            reader, protocol = _make_reader(limit, buffered,
+                                            client_connected_cb, loop)
             return protocol
 
         return await loop.create_unix_server(factory, path, **kwds)
 
 
+def _make_reader(limit, buffered, client_connected_cb, loop):
+    if buffered:
+        reader = BufferedStreamReader(limit=limit, loop=loop)
+        protocol = _BufferedStreamReaderProtocol(reader, client_connected_cb,
+                                                 loop=loop)
+    else:
+        reader = StreamReader(limit=limit, loop=loop)
+        protocol = StreamReaderProtocol(reader, client_connected_cb,
+                                        loop=loop)
+    return reader, protocol
+
+
 class FlowControlMixin(protocols.Protocol):
     """Reusable flow control logic for StreamWriter.drain().
 
@@ -306,6 +316,23 @@ def __del__(self):
                 closed.exception()
 
 
+class _BufferedStreamReaderProtocol(StreamReaderProtocol,
+                                    protocols.BufferedProtocol):
+    """StreamReaderProtocol receiving into a BufferedStreamReader."""
+
+    def get_buffer(self, sizehint):
+        reader = self._stream_reader
+        if reader is None:
+            # The reader was garbage collected: discard the data.
+            return bytearray(BufferedStreamReader._recv_size)
+        return reader._get_buffer(sizehint)
+
+    def buffer_updated(self, nbytes):
+        reader = self._stream_reader
+        if reader is not None:
+            reader._buffer_updated(nbytes)
+
+
 class StreamWriter:
     """Wraps a Transport.
 
@@ -498,10 +525,12 @@ def feed_data(self, data):
 
         self._buffer.extend(data)
         self._wakeup_waiter()
+        self._maybe_pause_transport(len(self._buffer))
 
+    def _maybe_pause_transport(self, size):
         if (self._transport is not None and
                 not self._paused and
-                len(self._buffer) > 2 * self._limit):
+                size > 2 * self._limit):
             try:
                 self._transport.pause_reading()
             except NotImplementedError:
@@ -785,3 +814,283 @@ async def __anext__(self):
         if val == b'':
             raise StopAsyncIteration
         return val
+
+
+class BufferedStreamReader(StreamReader):
+    """StreamReader which receives the data in place.
+
+    The transport receives the data directly into the internal buffer of
+    the reader (see BufferedProtocol), and the read methods slice their
+    result out of it.  readexactly_view() and readuntil_view() even return
+    memoryview slices of the internal buffer rather than bytes objects:
+    such a view is only valid until the next read call.
+    """
+
+    # Minimum free space offered to the transport for each receive.
+    _recv_size = 64 * 1024
+
+    def __init__(self, limit=_DEFAULT_LIMIT, loop=None):
+        super().__init__(limit=limit, loop=loop)
+        del self._buffer
+        self._buf = bytearray(2 * self._recv_size)
+        self._bufview = memoryview(self._buf)
+        self._start = 0  # Start of the unread data in _buf
+        self._end = 0  # End of the unread data in _buf
+        # Set when the last read call returned a view of _buf, which must
+        # not be overwritten until the next read call.
+        self._views = False
+
+    def __repr__(self):
+        info = ['BufferedStreamReader']
+        if self._end > self._start:
+            info.append(f'{self._end - self._start} bytes')
+        if self._eof:
+            info.append('eof')
+        if self._limit != _DEFAULT_LIMIT:
+            info.append(f'limit={self._limit}')
+        if self._waiter:
+            info.append(f'waiter={self._waiter!r}')
+        if self._exception:
+            info.append(f'exception={self._exception!r}')
+        if self._transport:
+            info.append(f'transport={self._transport!r}')
+        if self._paused:
+            info.append('paused')
+        return '<{}>'.format(' '.join(info))
+
+    def _make_room(self, n):
+        """Make room for at least n bytes after the unread data."""
+        size = self._end - self._start
+        capacity = len(self._buf)
+        if capacity < size + n:
+            capacity = max(size + n, 2 * capacity)
+        if self._views or capacity != len(self._buf):
+            # Views of the buffer may still be in use: move the unread data
+            # to a new buffer.
+            buf = bytearray(capacity)
+            buf[:size] = self._bufview[self._start:self._end]
+            self._buf = buf
+            self._bufview = memoryview(buf)
+            self._views = False
+        elif size:
+            self._bufview[:size] = self._bufview[self._start:self._end]
+        self._start = 0
+        self._end = size
+
+    def _get_buffer(self, sizehint):
+        if len(self._buf) - self._end < self._recv_size:
+            self._make_room(max(sizehint, self._recv_size))
+        return self._bufview[self._end:]
+
+    def _buffer_updated(self, nbytes):
+        assert not self._eof, 'buffer_updated after feed_eof'
+
+        self._end += nbytes
+        self._wakeup_waiter()
+        self._maybe_pause_transport(self._end - self._start)
+
+    def _maybe_resume_transport(self):
+        if self._paused and self._end - self._start <= self._limit:
+            self._paused = False
+            self._transport.resume_reading()
+
+    def at_eof(self):
+        """Return True if the buffer is empty and 'feed_eof' was called."""
+        return self._eof and self._start == self._end
+
+    def feed_data(self, data):
+        assert not self._eof, 'feed_data after feed_eof'
+
+        if not data:
+            return
+
+        data = memoryview(data).cast('B')
+        n = len(data)
+        if len(self._buf) - self._end < n:
+            self._make_room(n)
+        self._bufview[self._end:self._end + n] = data
+        self._buffer_updated(n)
+
+    def _take(self, n):
+        # Consume n bytes of unread data, return their start in _buf.
+        start = self._start
+        self._start = start + n
+        self._maybe_resume_transport()
+        return start
+
+    def _take_all(self):
+        data = bytes(self._bufview[self._start:self._end])
+        self._start = self._end
+        return data
+
+    async def readline(self):
+        """Read chunk of data from the stream until newline (b'\n') is found.
+
+        See StreamReader.readline().
+        """
+        self._views = False
+        sep = b'\n'
+        seplen = len(sep)
+        try:
+            line = await self.readuntil(sep)
+        except exceptions.IncompleteReadError as e:
+            return e.partial
+        except exceptions.LimitOverrunError as e:
+            if self._buf.startswith(sep, self._start + e.consumed, self._end):
+                self._start += e.consumed + seplen
+            else:
+                self._start = self._end
+            self._maybe_resume_transport()
+            raise ValueError(e.args[0])
+        return line
+
+    def _find(self, separator):
+        # Fast path of _readuntil(): return the length of the data up to
+        # the end of a single separator if it is already buffered, or -1.
+        if (self._exception is None and type(separator) is bytes and
+                separator):
+            isep = self._buf.find(separator, self._start, self._end)
+            if isep != -1 and isep - self._start <= self._limit:
+                return isep - self._start + len(separator)
+        return -1
+
+    async def _readuntil(self, separator):
+        # Return the length of the data up to the end of the separator.
+        if isinstance(separator, tuple):
+            # Makes sure shortest matches wins
+            separator = sorted(separator, key=len)
+        else:
+            separator = [separator]
+        if not separator:
+            raise ValueError('Separator should contain at least one element')
+        min_seplen = len(separator[0])
+        max_seplen = len(separator[-1])
+        if min_seplen == 0:
+            raise ValueError('Separator should be at least one-byte string')
+
+        if self._exception is not None:
+            raise self._exception
+
+        # See StreamReader.readuntil() for the search algorithm.  The
+        # separators are searched in place with bytearray.find().
+        offset = 0
+        while True:
+            start = self._start
+            buflen = self._end - start
+
+            if buflen - offset >= min_seplen:
+                match_start = None
+                match_end = None
+                for sep in separator:
+                    isep = self._buf.find(sep, start + offset, self._end)
+
+                    if isep != -1:
+                        isep -= start
+                        end = isep + len(sep)
+                        if match_end is None or end < match_end:
+                            match_end = end
+                            match_start = isep
+                if match_end is not None:
+                    break
+
+                offset = max(0, buflen + 1 - max_seplen)
+                if offset > self._limit:
+                    raise exceptions.LimitOverrunError(
+                        'Separator is not found, and chunk exceed the limit',
+                        offset)
+
+            if self._eof:
+                raise exceptions.IncompleteReadError(self._take_all(), None)
+
+            await self._wait_for_data('readuntil')
+
+        if match_start > self._limit:
+            raise exceptions.LimitOverrunError(
+                'Separator is found, but chunk is longer than limit', match_start)
+        return match_end
+
+    async def readuntil(self, separator=b'\n'):
+        """Read data from the stream until ``separator`` is found.
+
+        See StreamReader.readuntil().
+        """
+        self._views = False
+        n = self._find(separator)
+        if n < 0:
+            n = await self._readuntil(separator)
+        start = self._take(n)
+        return bytes(self._bufview[start:start + n])
+
+    async def readuntil_view(self, separator=b'\n'):
+        """Like readuntil(), but return a memoryview.
+
+        The view is a slice of the internal buffer of the reader: it is only
+        valid until the next read call.
+        """
+        self._views = False
+        n = self._find(separator)
+        if n < 0:
+            n = await self._readuntil(separator)
+        start = self._take(n)
+        self._views = True
+        return self._bufview[start:start + n]
+
+    async def read(self, n=-1):
+        """Read up to `n` bytes from the stream.
+
+        See StreamReader.read().
+        """
+        self._views = False
+        if self._exception is not None:
+            raise self._exception
+
+        if n <= 0:
+            return await super().read(n)
+
+        if self._start == self._end and not self._eof:
+            await self._wait_for_data('read')
+
+        n = min(n, self._end - self._start)
+        start = self._take(n)
+        return bytes(self._bufview[start:start + n])
+
+    async def _readexactly(self, n):
+        if n < 0:
+            raise ValueError('readexactly size can not be less than zero')
+
+        if self._exception is not None:
+            raise self._exception
+
+        while self._end - self._start < n:
+            if self._eof:
+                raise exceptions.IncompleteReadError(self._take_all(), n)
+
+            await self._wait_for_data('readexactly')
+
+        return self._take(n)
+
+    async def readexactly(self, n):
+        """Read exactly `n` bytes.
+
+        See StreamReader.readexactly().
+        """
+        self._views = False
+        if 0 <= n <= self._end - self._start and self._exception is None:
+            start = self._take(n)
+        else:
+            start = await self._readexactly(n)
+        return bytes(self._bufview[start:start + n])
+
+    async def readexactly_view(self, n):
+        """Like readexactly(), but return a memoryview.
+
+        The view is a slice of the internal buffer of the reader: it is only
+        valid until the next read call.
+        """
+        self._views = False
+        if 0 <= n <= self._end - self._start and self._exception is None:
+            start = self._take(n)
+        else:
+            start = await self._readexactly(n)
+        self._views = True
+        return self._bufview[start:start + n]
@@ -25,9 +25,15 @@
 from . import transports
 from .log import logger
 
+try:
+    import _asyncio
+except ImportError:
+    _asyncio = None
+
 
 __all__ = (
     'SelectorEventLoop',
+    'FastSelectorEventLoop',
     'DefaultEventLoopPolicy',
     'EventLoop',
 )
@@ -963,6 +969,62 @@ def can_use_pidfd():
     return True
 
 
+class _FastUnixSelectorEventLoop(_UnixSelectorEventLoop):
+    """Unix event loop running its iterations in C.
+
+    The ready queue, the timer heap and the dispatch of the selector events
+    are implemented by _asyncio._LoopCore.  With an EpollSelector, the epoll
+    object is polled directly.  Outside of debug mode, C futures and tasks
+    schedule their callbacks without creating Handle objects.
+    """
+
+    _core = None
+
+    def __init__(self, selector=None):
+        super().__init__(selector)
+        if type(self._selector) is selectors.EpollSelector:
+            self._core = _asyncio._LoopCore(
+                self, epoll_fd=self._selector.fileno(),
+                fd_to_key=self._selector._fd_to_key)
+        else:
+            self._core = _asyncio._LoopCore(self)
+        self._core.native_callbacks = not self._debug
+        self._ready = self._core
+
+    def set_debug(self, enabled):
+        super().set_debug(enabled)
+        if self._core is not None and not self._closed:
+            # Debug mode checks every call_soon() and needs the Handles.
+            self._core.native_callbacks = not enabled
+
+    def call_at(self, when, callback, *args, context=None):
+        if when is None:
+            raise TypeError("when cannot be None")
+        self._check_closed()
+        if self._debug:
+            self._check_thread()
+            self._check_callback(callback, 'call_at')
+        timer = events.TimerHandle(when, callback, args, self, context)
+        if timer._source_traceback:
+            del timer._source_traceback[-1]
+        self._core.push_timer(timer)
+        timer._scheduled = True
+        return timer
+
+    def _timer_handle_cancelled(self, handle):
+        if handle._scheduled:
+            self._core.timer_cancelled_count += 1
+
+    def close(self):
+        super().close()
+        # Let call_soon() raise once the loop is closed.
+        self._core.native_callbacks = False
+        self._core.clear_timers()
+
+    def _run_once(self):
+        self._core.run_once()
+
+
 class _UnixDefaultEventLoopPolicy(events.BaseDefaultEventLoopPolicy):
     """UNIX event loop policy"""
     _loop_factory = _UnixSelectorEventLoop
@@ -971,3 +1033,7 @@ class _UnixDefaultEventLoopPolicy(events.BaseDefaultEventLoopPolicy):
 SelectorEventLoop = _UnixSelectorEventLoop
 DefaultEventLoopPolicy = _UnixDefaultEventLoopPolicy
 EventLoop = SelectorEventLoop
+if _asyncio is not None:
+    FastSelectorEventLoop = _FastUnixSelectorEventLoop
+else:
+    FastSelectorEventLoop = SelectorEventLoop
@@ -25,13 +25,16 @@ def runctx(statement, globals, locals, filename=None, sort=-1):
 # ____________________________________________________________
 
 class Profile(_lsprof.Profiler):
-    """Profile(timer=None, timeunit=None, subcalls=True, builtins=True)
+    """Profile(timer=None, timeunit=None, subcalls=True, builtins=True,
+               callsites=False)
 
     Builds a profiler object using the specified timer function.
     The default timer is a fast built-in one based on real time.
     For custom timer functions returning integers, timeunit can
     be a float specifying a scale (i.e. how long each integer unit
     is, in seconds).
+    If callsites is true, calls are also aggregated per line of
+    the caller.
     """
 
     # Most of the functionality is in the base class.
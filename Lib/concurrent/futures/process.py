@@ -635,7 +635,8 @@ class BrokenProcessPool(_base.BrokenExecutor):
 
 class ProcessPoolExecutor(_base.Executor):
     def __init__(self, max_workers=None, mp_context=None,
-                 initializer=None, initargs=(), *, max_tasks_per_child=None):
+                 initializer=None, initargs=(), *, max_tasks_per_child=None,
+                 shared_memory_threshold=None):
         """Initializes a new ProcessPoolExecutor instance.
 
         Args:
@@ -653,6 +654,10 @@ def __init__(self, max_workers=None, mp_context=None,
                 live as long as the executor. Requires a non-'fork' mp_context
                 start method. When given, we default to using 'spawn' if no
                 mp_context is supplied.
+            shared_memory_threshold: If not None, the out-of-band buffers of
+                at least this many bytes in the arguments and results
+                (see PEP 574) are passed through shared memory rather than
+                pickled into the pipes.
         """
         _check_system_limits()
 
@@ -699,6 +704,17 @@ def __init__(self, max_workers=None, mp_context=None,
                                  " supply a different mp_context.")
         self._max_tasks_per_child = max_tasks_per_child
 
+        if shared_memory_threshold is not None:
+            if not isinstance(shared_memory_threshold, int):
+                raise TypeError("shared_memory_threshold must be an integer")
+            elif shared_memory_threshold <= 0:
+                raise ValueError("shared_memory_threshold must be >= 1")
+            if sys.platform != 'win32':
+                # The workers must share the resource tracker which
+                # registers the blocks and unregisters them when received.
+                from multiprocessing import resource_tracker
+                resource_tracker.ensure_running()
+
         # Management thread
         self._executor_manager_thread = None
 
@@ -741,7 +757,9 @@ def __init__(self, max_workers=None, mp_context=None,
         # tracebacks in the queue's own worker thread. But we detect killed
         # processes anyway, so silence the tracebacks.
         self._call_queue._ignore_epipe = True
+        self._call_queue._shared_memory_threshold = shared_memory_threshold
         self._result_queue = mp_context.SimpleQueue()
+        self._result_queue._shared_memory_threshold = shared_memory_threshold
         self._work_ids = queue.Queue()
 
     def _start_executor_manager_thread(self):
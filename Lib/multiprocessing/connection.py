@@ -201,6 +201,13 @@ def send_bytes(self, buf, offset=0, size=None):
             raise ValueError("buffer length < offset + size")
         self._send_bytes(m[offset:offset + size])
 
+    def _send_bytes_many(self, bufs):
+        """Send each of the bytes-like objects of a list as a message"""
+        self._check_closed()
+        self._check_writable()
+        for buf in bufs:
+            self._send_bytes(memoryview(buf))
+
     def send(self, obj):
         """Send a (picklable) object"""
         self._check_closed()
@@ -429,6 +436,25 @@ def _send_bytes(self, buf):
                 # to avoid "broken pipe" errors if the other end closed the pipe.
                 self._send(header + buf)
 
+    def _send_bytes_many(self, bufs):
+        self._check_closed()
+        self._check_writable()
+        # Concatenate the small messages with their headers, to send them
+        # with as few system calls as possible.
+        batch = bytearray()
+        for buf in bufs:
+            n = len(buf)
+            if n > 16384:
+                if batch:
+                    self._send(batch)
+                    batch = bytearray()
+                self._send_bytes(buf)
+            else:
+                batch += struct.pack("!i", n)
+                batch += buf
+        if batch:
+            self._send(batch)
+
     def _recv_bytes(self, maxsize=None):
         buf = self._recv(4)
         size, = struct.unpack("!i", buf.getvalue())
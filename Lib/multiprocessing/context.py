@@ -112,12 +112,18 @@ def SimpleQueue(self):
         from .queues import SimpleQueue
         return SimpleQueue(ctx=self.get_context())
 
+    def ShmQueue(self, capacity=1 << 20):
+        '''Returns a queue object backed by a ring buffer in shared memory'''
+        from .queues import ShmQueue
+        return ShmQueue(capacity)
+
     def Pool(self, processes=None, initializer=None, initargs=(),
-             maxtasksperchild=None):
+             maxtasksperchild=None, *, shared_memory_threshold=None):
         '''Returns a process pool object'''
         from .pool import Pool
         return Pool(processes, initializer, initargs, maxtasksperchild,
-                    context=self.get_context())
+                    context=self.get_context(),
+                    shared_memory_threshold=shared_memory_threshold)
 
     def RawValue(self, typecode_or_type, *args):
         '''Returns a shared object'''
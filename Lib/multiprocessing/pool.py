@@ -14,9 +14,11 @@
 #
 
 import collections
+import functools
 import itertools
 import os
 import queue
+import sys
 import threading
 import time
 import traceback
@@ -25,6 +27,7 @@
 
 # If threading is available then ThreadPool should be provided.  Therefore
 # we avoid top-level imports which are liable to fail on some systems.
+from . import reduction
 from . import util
 from . import get_context, TimeoutError
 from .connection import wait
@@ -181,12 +184,19 @@ def Process(ctx, *args, **kwds):
         return ctx.Process(*args, **kwds)
 
     def __init__(self, processes=None, initializer=None, initargs=(),
-                 maxtasksperchild=None, context=None):
+                 maxtasksperchild=None, context=None, *,
+                 shared_memory_threshold=None):
         # Attributes initialized early to make sure that they exist in
         # __del__() if __init__() raises an exception
         self._pool = []
         self._state = INIT
 
+        if shared_memory_threshold is not None:
+            if (not isinstance(shared_memory_threshold, int)
+                    or shared_memory_threshold <= 0):
+                raise ValueError(
+                    "shared_memory_threshold must be a positive int or None")
+        self._shared_memory_threshold = shared_memory_threshold
         self._ctx = context or get_context()
         self._setup_queues()
         self._taskqueue = queue.SimpleQueue()
@@ -345,9 +355,26 @@ def _maintain_pool(ctx, Process, processes, pool, inqueue, outqueue,
     def _setup_queues(self):
         self._inqueue = self._ctx.SimpleQueue()
         self._outqueue = self._ctx.SimpleQueue()
-        self._quick_put = self._inqueue._writer.send
+        threshold = self._shared_memory_threshold
+        if threshold is None:
+            self._quick_put = self._inqueue._writer.send
+        else:
+            if sys.platform != 'win32':
+                # The workers must share the resource tracker which
+                # registers the blocks and unregisters them when received.
+                from . import resource_tracker
+                resource_tracker.ensure_running()
+            self._inqueue._shared_memory_threshold = threshold
+            self._outqueue._shared_memory_threshold = threshold
+            self._quick_put = functools.partial(
+                Pool._send_shared, self._inqueue._writer.send_bytes, threshold)
         self._quick_get = self._outqueue._reader.recv
 
+    @staticmethod
+    def _send_shared(send_bytes, threshold, obj):
+        send_bytes(reduction.ForkingPickler.dumps(
+            obj, shared_memory_threshold=threshold))
+
     def _check_running(self):
         if self._state != RUN:
             raise ValueError("Pool not running")
@@ -7,7 +7,7 @@
 # Licensed to PSF under a Contributor Agreement.
 #
 
-__all__ = ['Queue', 'SimpleQueue', 'JoinableQueue']
+__all__ = ['Queue', 'SimpleQueue', 'JoinableQueue', 'ShmQueue']
 
 import sys
 import os
@@ -47,6 +47,8 @@ def __init__(self, maxsize=0, *, ctx):
         self._sem = ctx.BoundedSemaphore(maxsize)
         # For use by concurrent.futures
         self._ignore_epipe = False
+        # For use by the process pools
+        self._shared_memory_threshold = None
         self._reset()
 
         if sys.platform != 'win32':
@@ -55,11 +57,13 @@ def __init__(self, maxsize=0, *, ctx):
     def __getstate__(self):
         context.assert_spawning(self)
         return (self._ignore_epipe, self._maxsize, self._reader, self._writer,
-                self._rlock, self._wlock, self._sem, self._opid)
+                self._rlock, self._wlock, self._sem, self._opid,
+                self._shared_memory_threshold)
 
     def __setstate__(self, state):
         (self._ignore_epipe, self._maxsize, self._reader, self._writer,
-         self._rlock, self._wlock, self._sem, self._opid) = state
+         self._rlock, self._wlock, self._sem, self._opid,
+         self._shared_memory_threshold) = state
         self._reset()
 
     def _after_fork(self):
@@ -78,6 +82,7 @@ def _reset(self, after_fork=False):
         self._closed = False
         self._close = None
         self._send_bytes = self._writer.send_bytes
+        self._send_bytes_many = self._writer._send_bytes_many
         self._recv_bytes = self._reader.recv_bytes
         self._poll = self._reader.poll
 
@@ -93,6 +98,33 @@ def put(self, obj, block=True, timeout=None):
             self._buffer.append(obj)
             self._notempty.notify()
 
+    def put_many(self, objs, block=True, timeout=None):
+        if self._closed:
+            raise ValueError(f"Queue {self!r} is closed")
+        objs = list(objs)
+        if block and timeout is not None:
+            deadline = time.monotonic() + timeout
+        count = 0
+        try:
+            for obj in objs:
+                if block and timeout is not None:
+                    timeout = max(deadline - time.monotonic(), 0)
+                if not self._sem.acquire(block, timeout):
+                    raise Full
+                count += 1
+        finally:
+            # The items which fitted in the queue are put even if Full
+            # is raised for the next one.
+            if count:
+                self._extend_buffer(objs[:count])
+
+    def _extend_buffer(self, objs):
+        with self._notempty:
+            if self._thread is None:
+                self._start_thread()
+            self._buffer.extend(objs)
+            self._notempty.notify()
+
     def get(self, block=True, timeout=None):
         if self._closed:
             raise ValueError(f"Queue {self!r} is closed")
@@ -119,6 +151,35 @@ def get(self, block=True, timeout=None):
         # unserialize the data after having released the lock
         return _ForkingPickler.loads(res)
 
+    def get_many(self, max_items, block=True, timeout=None):
+        if self._closed:
+            raise ValueError(f"Queue {self!r} is closed")
+        if max_items <= 0:
+            raise ValueError("'max_items' must be positive")
+        if block and timeout is None:
+            self._rlock.acquire()
+        else:
+            if block:
+                deadline = time.monotonic() + timeout
+            if not self._rlock.acquire(block, timeout):
+                raise Empty
+        try:
+            if block and timeout is not None:
+                timeout = deadline - time.monotonic()
+                if not self._poll(timeout):
+                    raise Empty
+            elif not block and not self._poll():
+                raise Empty
+            res = [self._recv_bytes()]
+            while len(res) < max_items and self._poll():
+                res.append(self._recv_bytes())
+        finally:
+            self._rlock.release()
+        for _ in res:
+            self._sem.release()
+        # unserialize the data after having released the lock
+        return [_ForkingPickler.loads(data) for data in res]
+
     def qsize(self):
         # Raises NotImplementedError on Mac OSX because of broken sem_getvalue()
         return self._maxsize - self._sem._semlock._get_value()
@@ -177,10 +238,10 @@ def _start_thread(self):
         self._buffer.clear()
         self._thread = threading.Thread(
             target=Queue._feed,
-            args=(self._buffer, self._notempty, self._send_bytes,
+            args=(self._buffer, self._notempty, self._send_bytes_many,
                   self._wlock, self._reader.close, self._writer.close,
                   self._ignore_epipe, self._on_queue_feeder_error,
-                  self._sem),
+                  self._sem, self._shared_memory_threshold),
             name='QueueFeederThread',
             daemon=True,
         )
@@ -227,8 +288,9 @@ def _finalize_close(buffer, notempty):
             notempty.notify()
 
     @staticmethod
-    def _feed(buffer, notempty, send_bytes, writelock, reader_close,
-              writer_close, ignore_epipe, onerror, queue_sem):
+    def _feed(buffer, notempty, send_bytes_many, writelock, reader_close,
+              writer_close, ignore_epipe, onerror, queue_sem,
+              shared_memory_threshold):
         debug('starting thread to feed data to pipe')
         nacquire = notempty.acquire
         nrelease = notempty.release
@@ -241,35 +303,51 @@ def _feed(buffer, notempty, send_bytes, writelock, reader_close,
         else:
             wacquire = None
 
+        # The items buffered while the previous ones were sent are sent
+        # together, with a single write for the small ones.
+        batch = []
         while 1:
             try:
                 nacquire()
                 try:
-                    if not buffer:
+                    if not buffer and not batch:
                         nwait()
                 finally:
                     nrelease()
+                obj = None
                 try:
-                    while 1:
+                    while len(batch) < _FEED_BATCH_SIZE:
                         obj = bpopleft()
                         if obj is sentinel:
-                            debug('feeder thread got sentinel -- exiting')
-                            reader_close()
-                            writer_close()
-                            return
-
+                            if batch:
+                                # Send the batch on its own first
+                                buffer.appendleft(obj)
+                                obj = None
+                            break
                         # serialize the data before acquiring the lock
-                        obj = _ForkingPickler.dumps(obj)
-                        if wacquire is None:
-                            send_bytes(obj)
-                        else:
-                            wacquire()
-                            try:
-                                send_bytes(obj)
-                            finally:
-                                wrelease()
+                        batch.append(_ForkingPickler.dumps(
+                            obj,
+                            shared_memory_threshold=shared_memory_threshold))
                 except IndexError:
                     pass
+
+                if batch:
+                    obj = batch
+                    if wacquire is None:
+                        send_bytes_many(batch)
+                    else:
+                        wacquire()
+                        try:
+                            send_bytes_many(batch)
+                        finally:
+                            wrelease()
+                    batch = []
+
+                if obj is sentinel:
+                    debug('feeder thread got sentinel -- exiting')
+                    reader_close()
+                    writer_close()
+                    return
             except Exception as e:
                 if ignore_epipe and getattr(e, 'errno', 0) == errno.EPIPE:
                     return
@@ -281,12 +359,18 @@ def _feed(buffer, notempty, send_bytes, writelock, reader_close,
                     info('error in queue thread: %s', e)
                     return
                 else:
-                    # Since the object has not been sent in the queue, we need
-                    # to decrease the size of the queue. The error acts as
-                    # if the object had been silently removed from the queue
-                    # and this step is necessary to have a properly working
-                    # queue.
-                    queue_sem.release()
+                    # Since the objects have not been sent in the queue, we
+                    # need to decrease the size of the queue. The error acts
+                    # as if the objects had been silently removed from the
+                    # queue and this step is necessary to have a properly
+                    # working queue.  If an object failed to be serialized,
+                    # the objects serialized before it are still sent.
+                    if obj is batch:
+                        for _ in batch:
+                            queue_sem.release()
+                        batch = []
+                    else:
+                        queue_sem.release()
                     onerror(e, obj)
 
     @staticmethod
@@ -303,6 +387,9 @@ def _on_queue_feeder_error(e, obj):
 
 _sentinel = object()
 
+# Maximum number of items sent by the feeder thread at once
+_FEED_BATCH_SIZE = 64
+
 #
 # A queue type which also supports join() and task_done() methods
 #
@@ -338,6 +425,15 @@ def put(self, obj, block=True, timeout=None):
             self._unfinished_tasks.release()
             self._notempty.notify()
 
+    def _extend_buffer(self, objs):
+        with self._notempty, self._cond:
+            if self._thread is None:
+                self._start_thread()
+            self._buffer.extend(objs)
+            for _ in objs:
+                self._unfinished_tasks.release()
+            self._notempty.notify()
+
     def task_done(self):
         with self._cond:
             if not self._unfinished_tasks.acquire(False):
@@ -364,6 +460,8 @@ def __init__(self, *, ctx):
             self._wlock = None
         else:
             self._wlock = ctx.Lock()
+        # For use by the process pools
+        self._shared_memory_threshold = None
 
     def close(self):
         self._reader.close()
@@ -374,10 +472,12 @@ def empty(self):
 
     def __getstate__(self):
         context.assert_spawning(self)
-        return (self._reader, self._writer, self._rlock, self._wlock)
+        return (self._reader, self._writer, self._rlock, self._wlock,
+                self._shared_memory_threshold)
 
     def __setstate__(self, state):
-        (self._reader, self._writer, self._rlock, self._wlock) = state
+        (self._reader, self._writer, self._rlock, self._wlock,
+         self._shared_memory_threshold) = state
         self._poll = self._reader.poll
 
     def get(self):
@@ -388,7 +488,8 @@ def get(self):
 
     def put(self, obj):
         # serialize the data before acquiring the lock
-        obj = _ForkingPickler.dumps(obj)
+        obj = _ForkingPickler.dumps(
+            obj, shared_memory_threshold=self._shared_memory_threshold)
         if self._wlock is None:
             # writes to a message oriented win32 pipe are atomic
             self._writer.send_bytes(obj)
@@ -396,4 +497,104 @@ def put(self, obj):
             with self._wlock:
                 self._writer.send_bytes(obj)
 
+    def get_many(self, max_items):
+        if max_items <= 0:
+            raise ValueError("'max_items' must be positive")
+        with self._rlock:
+            res = [self._reader.recv_bytes()]
+            while len(res) < max_items and self._poll():
+                res.append(self._reader.recv_bytes())
+        # unserialize the data after having released the lock
+        return [_ForkingPickler.loads(data) for data in res]
+
+    def put_many(self, objs):
+        # serialize the data before acquiring the lock
+        threshold = self._shared_memory_threshold
+        objs = [_ForkingPickler.dumps(obj, shared_memory_threshold=threshold)
+                for obj in objs]
+        if self._wlock is None:
+            # writes to a message oriented win32 pipe are atomic
+            self._writer._send_bytes_many(objs)
+        else:
+            with self._wlock:
+                self._writer._send_bytes_many(objs)
+
+    __class_getitem__ = classmethod(types.GenericAlias)
+
+#
+# Queue type using a ring buffer in shared memory -- no pipe, no thread
+#
+
+class ShmQueue(object):
+
+    def __init__(self, capacity=1 << 20):
+        # Can raise ImportError if shared memory is not supported
+        from _multiprocessing import RingBuffer
+        from .shared_memory import SharedMemory
+        shm = SharedMemory(create=True, size=RingBuffer.HEADER_SIZE + capacity)
+        try:
+            ring = RingBuffer(shm.buf, create=True)
+        except BaseException:
+            shm.close()
+            shm.unlink()
+            raise
+        self._setup(shm, ring, unlink=True)
+
+    def _setup(self, shm, ring, unlink):
+        self._shm = shm
+        self._ring = ring
+        # The creator unlinks the shared memory; the other processes keep
+        # their mapping until they close the queue.
+        self._close = Finalize(self, ShmQueue._finalize_close,
+                               (shm, ring, unlink), exitpriority=-10)
+        register_after_fork(self, ShmQueue._after_fork)
+
+    def _after_fork(self):
+        debug('ShmQueue._after_fork()')
+        self._ring._after_fork()
+        self._close = Finalize(self, ShmQueue._finalize_close,
+                               (self._shm, self._ring, False),
+                               exitpriority=-10)
+
+    def __getstate__(self):
+        context.assert_spawning(self)
+        return self._shm.name
+
+    def __setstate__(self, name):
+        from _multiprocessing import RingBuffer
+        from .shared_memory import SharedMemory
+        shm = SharedMemory(name, track=False)
+        self._setup(shm, RingBuffer(shm.buf), unlink=False)
+
+    def close(self):
+        self._close()
+
+    def empty(self):
+        return self._ring.empty()
+
+    def put(self, obj, block=True, timeout=None):
+        obj = _ForkingPickler.dumps(obj)
+        if not self._ring.send_bytes(obj, block, timeout):
+            raise Full
+
+    def put_nowait(self, obj):
+        return self.put(obj, False)
+
+    def get(self, block=True, timeout=None):
+        res = self._ring.recv_bytes(block, timeout)
+        if res is None:
+            raise Empty
+        return _ForkingPickler.loads(res)
+
+    def get_nowait(self):
+        return self.get(False)
+
+    @staticmethod
+    def _finalize_close(shm, ring, unlink):
+        debug('closing shared memory queue %s', shm.name)
+        if unlink:
+            shm.unlink()
+        ring.release()
+        shm.close()
+
     __class_getitem__ = classmethod(types.GenericAlias)
@@ -35,8 +35,8 @@ class ForkingPickler(pickle.Pickler):
     _extra_reducers = {}
     _copyreg_dispatch_table = copyreg.dispatch_table
 
-    def __init__(self, *args):
-        super().__init__(*args)
+    def __init__(self, *args, **kwds):
+        super().__init__(*args, **kwds)
         self.dispatch_table = self._copyreg_dispatch_table.copy()
         self.dispatch_table.update(self._extra_reducers)
 
@@ -46,7 +46,9 @@ def register(cls, type, reduce):
         cls._extra_reducers[type] = reduce
 
     @classmethod
-    def dumps(cls, obj, protocol=None):
+    def dumps(cls, obj, protocol=None, *, shared_memory_threshold=None):
+        if shared_memory_threshold is not None and sys.platform != 'win32':
+            return _dumps_shared(cls, obj, protocol, shared_memory_threshold)
         buf = io.BytesIO()
         cls(buf, protocol).dump(obj)
         return buf.getbuffer()
@@ -55,6 +57,84 @@ def dumps(cls, obj, protocol=None):
 
 register = ForkingPickler.register
 
+#
+# Out-of-band buffers passed through shared memory
+#
+# The out-of-band buffers (see PEP 574) of at least shared_memory_threshold
+# bytes are copied into a single shared memory block, and only its name is
+# pickled along with the rest of the object.  The receiving process unlinks
+# the block as soon as it maps it: the memory lives as long as the buffers
+# rebuilt on top of it.  On Windows, where a block cannot outlive its last
+# handle, the buffers are pickled in-band.
+#
+
+_SHARED_BUFFER_ALIGN = 64
+
+class _SharedBuffers(object):
+    '''Pickled object whose out-of-band buffers are in shared memory.'''
+
+    def __init__(self, data, name, layout):
+        self.data = data
+        self.name = name
+        self.layout = layout
+
+    def __reduce__(self):
+        return _rebuild_shared_buffers, (self.data, self.name, self.layout)
+
+def _dumps_shared(cls, obj, protocol, threshold):
+    buffers = []
+    def buffer_callback(buffer):
+        try:
+            raw = buffer.raw()
+        except BufferError:
+            # Not contiguous
+            return True
+        if not raw.nbytes or raw.nbytes < threshold:
+            return True
+        buffers.append(raw)
+        return False
+
+    buf = io.BytesIO()
+    cls(buf, 5 if protocol is None else protocol,
+        buffer_callback=buffer_callback).dump(obj)
+    if not buffers:
+        return buf.getbuffer()
+
+    from .shared_memory import SharedMemory
+    layout = []
+    size = 0
+    for raw in buffers:
+        layout.append((size, raw.nbytes, raw.readonly))
+        size += -(-raw.nbytes // _SHARED_BUFFER_ALIGN) * _SHARED_BUFFER_ALIGN
+    shm = SharedMemory(create=True, size=size)
+    try:
+        for raw, (offset, nbytes, readonly) in zip(buffers, layout):
+            shm.buf[offset:offset + nbytes] = raw
+    except BaseException:
+        shm.unlink()
+        raise
+    finally:
+        shm.close()
+    return cls.dumps(_SharedBuffers(buf.getvalue(), shm._name, layout),
+                     protocol)
+
+def _rebuild_shared_buffers(data, name, layout):
+    import _posixshmem
+    import mmap
+    from . import resource_tracker
+    fd = _posixshmem.shm_open(name, os.O_RDWR, mode=0o600)
+    try:
+        _posixshmem.shm_unlink(name)
+        resource_tracker.unregister(name, "shared_memory")
+        mem = memoryview(mmap.mmap(fd, os.fstat(fd).st_size))
+    finally:
+        os.close(fd)
+    buffers = []
+    for offset, nbytes, readonly in layout:
+        buffer = mem[offset:offset + nbytes]
+        buffers.append(buffer.toreadonly() if readonly else buffer)
+    return ForkingPickler.loads(data, buffers=buffers)
+
 def dump(obj, file, protocol=None):
     '''Replacement for pickle.dump() using ForkingPickler.'''
     ForkingPickler(file, protocol).dump(obj)
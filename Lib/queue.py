@@ -9,6 +9,10 @@
     from _queue import SimpleQueue
 except ImportError:
     SimpleQueue = None
+try:
+    from _queue import FastQueue
+except ImportError:
+    FastQueue = None
 
 __all__ = [
     'Empty',
@@ -18,6 +22,7 @@
     'PriorityQueue',
     'LifoQueue',
     'SimpleQueue',
+    'FastQueue',
 ]
 
 
@@ -28,13 +33,18 @@ class Empty(Exception):
         'Exception raised by Queue.get(block=0)/get_nowait().'
         pass
 
-class Full(Exception):
-    'Exception raised by Queue.put(block=0)/put_nowait().'
-    pass
-
+try:
+    from _queue import Full
+except ImportError:
+    class Full(Exception):
+        'Exception raised by Queue.put(block=0)/put_nowait().'
+        pass
 
-class ShutDown(Exception):
-    '''Raised when put/get with shut-down queue.'''
+try:
+    from _queue import ShutDown
+except ImportError:
+    class ShutDown(Exception):
+        '''Raised when put/get with shut-down queue.'''
 
 
 class Queue:
@@ -353,6 +363,17 @@ def get(self, block=True, timeout=None):
             raise Empty
         return self._queue.popleft()
 
+    def put_many(self, items, /):
+        '''Put all the items of an iterable on the queue.
+
+        This is equivalent to calling put() for each item, but the items
+        are added at once.
+        '''
+        items = list(items)
+        if items:
+            self._queue.extend(items)
+            self._count.release(len(items))
+
     def put_nowait(self, item):
         '''Put an item into the queue without blocking.
 
@@ -369,6 +390,20 @@ def get_nowait(self):
         '''
         return self.get(block=False)
 
+    def get_many(self, max_items, block=True, timeout=None):
+        '''Remove and return a list of up to max_items items from the queue.
+
+        Wait for the first item as get() does, with the same 'block' and
+        'timeout' arguments, then also remove the items that are
+        immediately available, up to max_items items in total.
+        '''
+        if max_items <= 0:
+            raise ValueError("'max_items' must be positive")
+        items = [self.get(block, timeout)]
+        while len(items) < max_items and self._count.acquire(False):
+            items.append(self._queue.popleft())
+        return items
+
     def empty(self):
         '''Return True if the queue is empty, False otherwise (not reliable!).'''
         return len(self._queue) == 0
@@ -382,3 +417,6 @@ def qsize(self):
 
 if SimpleQueue is None:
     SimpleQueue = _PySimpleQueue
+
+if FastQueue is None:
+    FastQueue = Queue
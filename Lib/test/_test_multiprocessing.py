@@ -1332,6 +1332,86 @@ def _on_queue_feeder_error(e, obj):
         self.assertTrue(not_serializable_obj.reduce_was_called)
         self.assertTrue(not_serializable_obj.on_queue_feeder_error_was_called)
 
+    @classmethod
+    def _test_put_many(cls, queue):
+        queue.put_many(range(100))
+        queue.put_many([b'x' * 100_000, None])
+
+    def test_put_many_get_many(self):
+        if self.TYPE != 'processes':
+            self.skipTest('test not appropriate for {}'.format(self.TYPE))
+
+        queue = self.Queue(maxsize=200)
+        proc = self.Process(target=self._test_put_many, args=(queue,))
+        proc.daemon = True
+        proc.start()
+
+        results = []
+        while (batch := queue.get_many(30, timeout=support.SHORT_TIMEOUT)):
+            self.assertLessEqual(len(batch), 30)
+            results.extend(batch)
+            if results[-1] is None:
+                break
+        self.assertEqual(results[:100], list(range(100)))
+        self.assertEqual(results[100:], [b'x' * 100_000, None])
+        self.assertTrue(queue.empty())
+        self.assertRaises(pyqueue.Empty, queue.get_many, 30, False)
+        self.assertRaises(pyqueue.Empty, queue.get_many, 30, True, TIMEOUT1)
+        self.assertRaises(ValueError, queue.get_many, 0)
+
+        proc.join()
+        close_queue(queue)
+
+    def test_put_many_full(self):
+        if self.TYPE != 'processes':
+            self.skipTest('test not appropriate for {}'.format(self.TYPE))
+
+        queue = self.Queue(maxsize=3)
+        self.assertRaises(pyqueue.Full, queue.put_many, range(5), False)
+        # The items which fitted in the queue are put
+        self.assertEqual(queue.get_many(5, timeout=support.SHORT_TIMEOUT),
+                         [0, 1, 2])
+        put_many = TimingWrapper(queue.put_many)
+        self.assertRaises(pyqueue.Full, put_many, range(5), True, TIMEOUT1)
+        self.assertTimingAlmostEqual(put_many.elapsed, TIMEOUT1)
+        close_queue(queue)
+
+    def test_joinable_put_many(self):
+        if self.TYPE != 'processes':
+            self.skipTest('test not appropriate for {}'.format(self.TYPE))
+
+        queue = self.JoinableQueue()
+        queue.put_many(range(3))
+        self.assertEqual(queue.get(timeout=support.SHORT_TIMEOUT), 0)
+        for i in range(3):
+            queue.task_done()
+        self.assertRaises(ValueError, queue.task_done)
+        queue.join()
+        close_queue(queue)
+
+    def test_queue_feeder_batch_onexc(self):
+        # The objects serialized before an unserializable one are still sent
+        # along with the objects that follow it.
+        if self.TYPE != 'processes':
+            self.skipTest('test not appropriate for {}'.format(self.TYPE))
+
+        class NotSerializable(object):
+            def __reduce__(self):
+                raise AttributeError
+        with test.support.captured_stderr():
+            q = self.Queue(maxsize=10)
+            q.put_many([1, 2, NotSerializable(), 3])
+            results = []
+            while len(results) < 3:
+                results += q.get_many(10, timeout=support.SHORT_TIMEOUT)
+            self.assertEqual(results, [1, 2, 3])
+            self.assertTrue(q.empty())
+            try:
+                self.assertEqual(q.qsize(), 0)
+            except NotImplementedError:
+                pass
+            close_queue(q)
+
     def test_closed_queue_empty_exceptions(self):
         # Assert that checking the emptiness of an unused closed queue
         # does not raise an OSError. The rationale is that q.close() is
@@ -2914,6 +2994,59 @@ def errback(exc):
         p.close()
         p.join()
 
+def reverse_buffer(buffer):
+    # Buffers passed through shared memory are rebuilt as memoryviews
+    return (isinstance(buffer, memoryview),
+            pickle.PickleBuffer(bytes(buffer)[::-1]))
+
+@unittest.skipIf(sys.platform == 'win32', "requires POSIX shared memory")
+@unittest.skipUnless(HAS_SHMEM, "requires multiprocessing.shared_memory")
+class _TestPoolSharedMemory(BaseTestCase):
+    ALLOWED_TYPES = ('processes', )
+
+    def test_dumps(self):
+        from multiprocessing.reduction import ForkingPickler
+        big = bytearray(range(256)) * 1000
+        frozen = bytes(big)
+        obj = [pickle.PickleBuffer(big), pickle.PickleBuffer(frozen),
+               pickle.PickleBuffer(b'small'), big]
+        data = ForkingPickler.dumps(obj, shared_memory_threshold=1000)
+        # big is pickled in-band once: it is not a PickleBuffer
+        self.assertLess(len(data), len(big) + 1000)
+        res = ForkingPickler.loads(data)
+        self.assertIsInstance(res[0], memoryview)
+        self.assertFalse(res[0].readonly)
+        self.assertEqual(res[0], big)
+        self.assertIsInstance(res[1], memoryview)
+        self.assertTrue(res[1].readonly)
+        self.assertEqual(res[1], frozen)
+        self.assertEqual(res[2], b'small')
+        self.assertEqual(res[3], big)
+        # the shared memory block was unlinked when loaded
+        self.assertRaises(FileNotFoundError, ForkingPickler.loads, data)
+
+    def test_pool(self):
+        p = multiprocessing.Pool(2, shared_memory_threshold=1000)
+        data = bytes(range(256)) * 100
+        results = [p.apply_async(reverse_buffer, (pickle.PickleBuffer(buf),))
+                   for buf in [data, b'abc'] * 5]
+        for i, res in enumerate(results):
+            in_shm, reversed_buf = res.get(timeout=support.SHORT_TIMEOUT)
+            if i % 2 == 0:
+                self.assertTrue(in_shm)
+                self.assertIsInstance(reversed_buf, memoryview)
+                self.assertEqual(reversed_buf, data[::-1])
+            else:
+                self.assertFalse(in_shm)
+                self.assertEqual(reversed_buf, b'cba')
+        p.close()
+        p.join()
+
+    def test_pool_shared_memory_threshold_invalid(self):
+        for value in [0, -1, 0.5, "12"]:
+            with self.assertRaises(ValueError):
+                multiprocessing.Pool(3, shared_memory_threshold=value)
+
 class _TestPoolWorkerLifetime(BaseTestCase):
     ALLOWED_TYPES = ('processes', )
 
@@ -5879,6 +6012,30 @@ def test_empty(self):
 
         proc.join()
 
+    @classmethod
+    def _test_put_many(cls, queue):
+        queue.put_many(range(10))
+        queue.put_many([b'x' * 100_000, None])
+
+    def test_put_many_get_many(self):
+        queue = multiprocessing.SimpleQueue()
+        proc = multiprocessing.Process(target=self._test_put_many,
+                                       args=(queue,))
+        proc.daemon = True
+        proc.start()
+
+        results = []
+        while not results or results[-1] is not None:
+            batch = queue.get_many(4)
+            self.assertLessEqual(len(batch), 4)
+            results.extend(batch)
+        self.assertEqual(results, [*range(10), b'x' * 100_000, None])
+        self.assertTrue(queue.empty())
+        self.assertRaises(ValueError, queue.get_many, 0)
+
+        proc.join()
+        queue.close()
+
     def test_close(self):
         queue = multiprocessing.SimpleQueue()
         queue.close()
@@ -5894,6 +6051,109 @@ def test_closed(self):
         self.assertTrue(queue._writer.closed)
 
 
+@unittest.skipUnless(HAS_SHMEM, "requires multiprocessing.shared_memory")
+class TestShmQueue(unittest.TestCase):
+
+    def test_put_get(self):
+        queue = multiprocessing.ShmQueue(256)
+        self.addCleanup(queue.close)
+        self.assertTrue(queue.empty())
+        self.assertRaises(pyqueue.Empty, queue.get_nowait)
+        self.assertRaises(pyqueue.Empty, queue.get, timeout=0.01)
+        queue.put([1, 2, 3])
+        queue.put_nowait('abc')
+        self.assertFalse(queue.empty())
+        self.assertEqual(queue.get(), [1, 2, 3])
+        self.assertEqual(queue.get_nowait(), 'abc')
+        self.assertTrue(queue.empty())
+
+        # fill the ring buffer, then make room and check the wraparound
+        count = 0
+        with self.assertRaises(pyqueue.Full):
+            while True:
+                queue.put(b'x' * 20, timeout=0.01)
+                count += 1
+        self.assertRaises(pyqueue.Full, queue.put_nowait, b'x' * 20)
+        self.assertGreater(count, 0)
+        for i in range(count * 3):
+            self.assertEqual(queue.get(), b'x' * 20)
+            queue.put(b'x' * 20)
+        for i in range(count):
+            self.assertEqual(queue.get(), b'x' * 20)
+        self.assertTrue(queue.empty())
+
+        with self.assertRaisesRegex(ValueError, 'does not fit'):
+            queue.put(b'x' * 1000)
+
+    def test_close(self):
+        queue = multiprocessing.ShmQueue(256)
+        name = queue._shm.name
+        queue.put(1)
+        queue.close()
+        # closing a queue twice should not fail
+        queue.close()
+        self.assertRaises(ValueError, queue.put, 2)
+        self.assertRaises(ValueError, queue.get)
+        # the creator unlinks the shared memory
+        with self.assertRaises(FileNotFoundError):
+            shared_memory.SharedMemory(name, track=False)
+
+    @classmethod
+    def _test_producer(cls, queue, ident, count):
+        for i in range(count):
+            queue.put((ident, i, b'x' * (i % 50)))
+        queue.put((ident, None, None))
+
+    def test_processes(self):
+        # a small capacity makes the producers wait for free space
+        queue = multiprocessing.ShmQueue(512)
+        self.addCleanup(queue.close)
+        count = 2000
+        procs = [multiprocessing.Process(target=self._test_producer,
+                                         args=(queue, ident, count))
+                 for ident in range(2)]
+        for proc in procs:
+            proc.daemon = True
+            proc.start()
+
+        received = {0: [], 1: []}
+        done = 0
+        while done < len(procs):
+            ident, i, data = queue.get(timeout=support.SHORT_TIMEOUT)
+            if i is None:
+                done += 1
+            else:
+                self.assertEqual(data, b'x' * (i % 50))
+                received[ident].append(i)
+        self.assertEqual(received, {0: list(range(count)),
+                                    1: list(range(count))})
+        self.assertTrue(queue.empty())
+        for proc in procs:
+            proc.join()
+            self.assertEqual(proc.exitcode, 0)
+
+    @classmethod
+    def _test_echo(cls, requests, replies):
+        while (obj := requests.get()) is not None:
+            replies.put(obj)
+
+    def test_echo(self):
+        requests = multiprocessing.ShmQueue()
+        replies = multiprocessing.ShmQueue()
+        self.addCleanup(requests.close)
+        self.addCleanup(replies.close)
+        proc = multiprocessing.Process(target=self._test_echo,
+                                       args=(requests, replies))
+        proc.daemon = True
+        proc.start()
+        for i in range(100):
+            requests.put(i)
+            self.assertEqual(replies.get(timeout=support.SHORT_TIMEOUT), i)
+        requests.put(None)
+        proc.join()
+        self.assertEqual(proc.exitcode, 0)
+
+
 class TestPoolNotLeakOnFailure(unittest.TestCase):
 
     def test_release_unused_processes(self):
@@ -2258,6 +2258,24 @@ class SelectEventLoopTests(EventLoopTestsMixin,
         def create_event_loop(self):
             return asyncio.SelectorEventLoop(selectors.SelectSelector())
 
+    if asyncio.FastSelectorEventLoop is not asyncio.SelectorEventLoop:
+        if hasattr(selectors, 'EpollSelector'):
+            class FastEPollEventLoopTests(EventLoopTestsMixin,
+                                          SubprocessTestsMixin,
+                                          test_utils.TestCase):
+
+                def create_event_loop(self):
+                    return asyncio.FastSelectorEventLoop(
+                        selectors.EpollSelector())
+
+        class FastSelectEventLoopTests(EventLoopTestsMixin,
+                                       SubprocessTestsMixin,
+                                       test_utils.TestCase):
+
+            def create_event_loop(self):
+                return asyncio.FastSelectorEventLoop(
+                    selectors.SelectSelector())
+
 
 def noop(*args, **kwargs):
     pass
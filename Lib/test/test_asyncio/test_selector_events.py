@@ -3,6 +3,7 @@
 import collections
 import selectors
 import socket
+import struct
 import sys
 import unittest
 from asyncio import selector_events
@@ -18,6 +19,7 @@
                                      _SelectorDatagramTransport,
                                      _SelectorSocketTransport,
                                      _SelectorTransport)
+from test import support
 from test.test_asyncio import utils as test_utils
 
 MOCK_ANY = mock.ANY
@@ -1015,6 +1017,149 @@ def test_transport_close_remove_writer(self, m_log):
         remove_writer.assert_called_with(self.sock_fd)
 
 
+@unittest.skipUnless(selector_events._HAS_ZEROCOPY, 'need MSG_ZEROCOPY')
+class SelectorSocketTransportZeroCopyTests(test_utils.TestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.loop = self.new_test_loop()
+        self.protocol = test_utils.make_test_protocol(asyncio.Protocol)
+        self.sock = mock.Mock(socket.socket)
+        self.sock_fd = self.sock.fileno.return_value = 7
+
+    def socket_transport(self):
+        transport = _SelectorSocketTransport(self.loop, self.sock,
+                                             self.protocol)
+        self.assertFalse(transport._zerocopy)
+        transport._zerocopy = True
+        transport._zerocopy_threshold = 4
+        self.addCleanup(close_transport, transport)
+        return transport
+
+    def completion(self, first, last, copied=False):
+        code = socket.SO_EE_CODE_ZEROCOPY_COPIED if copied else 0
+        data = struct.pack('=IBBBBII', 0, socket.SO_EE_ORIGIN_ZEROCOPY, 0,
+                           code, 0, first, last)
+        return (b'', [(socket.IPPROTO_IP, socket.IP_RECVERR, data)], 0, None)
+
+    def test_write(self):
+        transport = self.socket_transport()
+        data = b'data'
+        self.sock.sendmsg.return_value = 4
+        transport.write(data)
+        self.sock.sendmsg.assert_called_with([data], (), socket.MSG_ZEROCOPY)
+        self.assertEqual(list(transport._zerocopy_pinned), [(0, [data])])
+        self.assertEqual(transport._zerocopy_id, 1)
+
+    def test_write_copied(self):
+        # Small or mutable buffers are copied.
+        transport = self.socket_transport()
+        self.sock.sendmsg.side_effect = lambda buffers: len(buffers[0])
+        for data in (b'abc', bytearray(b'data'), memoryview(bytearray(4))):
+            transport.write(data)
+            self.sock.sendmsg.assert_called_with([data])
+        self.assertFalse(transport._zerocopy_pinned)
+
+    def test_write_sendmsg(self):
+        transport = self.socket_transport()
+        transport._write_ready = transport._write_sendmsg
+        self.loop._add_writer(7, transport._write_ready)
+        transport._buffer.extend([memoryview(b'da'), b'ta', b'more'])
+        self.sock.sendmsg.return_value = 5
+        transport._write_ready()
+        self.sock.sendmsg.assert_called_with(
+            [memoryview(b'da'), b'ta', b'more'], (), socket.MSG_ZEROCOPY)
+        self.assertEqual(list(transport._buffer), [b'ore'])
+        self.assertEqual(len(transport._zerocopy_pinned), 1)
+        self.loop.assert_writer(7, transport._write_ready)
+
+    def test_write_tryagain(self):
+        transport = self.socket_transport()
+        self.sock.sendmsg.side_effect = BlockingIOError
+        transport.write(b'data')
+        self.assertFalse(transport._zerocopy_pinned)
+        self.assertEqual(transport._zerocopy_id, 0)
+
+    def test_release(self):
+        transport = self.socket_transport()
+        transport._zerocopy_pinned.extend([(0, 'a'), (1, 'b'), (2, 'c')])
+        self.sock.recvmsg.side_effect = [self.completion(0, 1),
+                                         BlockingIOError]
+        transport._read_ready_cb = mock.Mock()
+        transport._read_ready()
+        self.sock.recvmsg.assert_called_with(0, mock.ANY,
+                                             socket.MSG_ERRQUEUE)
+        self.assertEqual(list(transport._zerocopy_pinned), [(2, 'c')])
+        self.assertTrue(transport._zerocopy)
+        transport._read_ready_cb.assert_called_once_with()
+
+        self.sock.recvmsg.side_effect = [self.completion(2, 2, copied=True)]
+        transport._read_ready()
+        self.assertFalse(transport._zerocopy_pinned)
+        self.assertFalse(transport._zerocopy)
+
+    def test_release_wraparound(self):
+        transport = self.socket_transport()
+        transport._zerocopy_pinned.extend(
+            [(0xFFFFFFFE, 'a'), (0xFFFFFFFF, 'b'), (0, 'c'), (1, 'd')])
+        self.sock.recvmsg.side_effect = [self.completion(0xFFFFFFFE, 0),
+                                         BlockingIOError]
+        transport._zerocopy_release()
+        self.assertEqual(list(transport._zerocopy_pinned), [(1, 'd')])
+
+    def test_release_error(self):
+        transport = self.socket_transport()
+        transport._zerocopy_pinned.append((0, 'a'))
+        self.sock.recvmsg.side_effect = ConnectionResetError
+        transport._zerocopy_release()
+        self.assertEqual(len(transport._zerocopy_pinned), 1)
+
+    def test_loopback(self):
+        loop = asyncio.new_event_loop()
+        self.addCleanup(loop.close)
+        with socket.create_server(('127.0.0.1', 0)) as lsock:
+            csock = socket.create_connection(lsock.getsockname())
+            ssock, _ = lsock.accept()
+        self.addCleanup(ssock.close)
+        try:
+            csock.setsockopt(socket.SOL_SOCKET, socket.SO_ZEROCOPY, 1)
+        except OSError as exc:
+            csock.close()
+            self.skipTest(f'SO_ZEROCOPY not supported: {exc}')
+        ssock.setblocking(False)
+        data = bytes(range(256)) * 256
+
+        async def main():
+            transport, _ = await loop.connect_accepted_socket(
+                asyncio.Protocol, csock)
+            self.assertTrue(transport._zerocopy)
+            pinned = transport._zerocopy_pinned
+            transport.write(data)
+            transport.write(data)
+            # On the loopback interface, the sends only complete once the
+            # data is received: the buffers outlive the transport socket.
+            transport.close()
+            await asyncio.sleep(0)
+            self.assertIsNone(transport._sock)
+            self.assertTrue(pinned)
+            received = bytearray()
+            while True:
+                chunk = await loop.sock_recv(ssock, 1024 * 1024)
+                if not chunk:
+                    break
+                received += chunk
+            for i in range(100):
+                if not pinned:
+                    break
+                await asyncio.sleep(0.01)
+            return received, pinned
+
+        received, pinned = loop.run_until_complete(main())
+        self.assertEqual(len(received), 2 * len(data))
+        self.assertTrue(received == data + data)
+        self.assertFalse(pinned)
+
+
 class SelectorSocketTransportBufferedProtocolTests(test_utils.TestCase):
 
     def setUp(self):
@@ -1508,5 +1653,160 @@ class MyException(Exception):
             exc_info=(MyException, MOCK_ANY, MOCK_ANY))
 
 
+@unittest.skipUnless(selector_events._HAS_MMSG,
+                     'need socket.recvmmsg_into() and socket.sendmmsg()')
+class SelectorDatagramTransportMmsgTests(test_utils.TestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.loop = self.new_test_loop()
+        self.protocol = test_utils.make_test_protocol(asyncio.DatagramProtocol)
+        self.sock = mock.Mock(spec_set=socket.socket)
+        self.sock.fileno.return_value = 7
+        self.sock.family = socket.AF_INET
+
+    def datagram_transport(self, address=None):
+        self.sock.getpeername.side_effect = None if address else OSError
+        transport = _SelectorDatagramTransport(self.loop, self.sock,
+                                               self.protocol,
+                                               address=address)
+        transport._mmsg_batch = 2
+        transport._mmsg_size = 8
+        self.addCleanup(close_transport, transport)
+        return transport
+
+    def recvmmsg_into(self, *datagrams):
+        def recvmmsg_into(buffers, sizes, flags, addresses):
+            for i, (data, addr) in enumerate(datagrams):
+                buffers[i][:len(data)] = data
+                sizes[i] = len(data)
+                addresses.append(addr)
+            return len(datagrams)
+        return recvmmsg_into
+
+    def test_read_ready_switches_to_recvmmsg(self):
+        transport = self.datagram_transport()
+        self.sock.recvfrom.return_value = (b'data', ('0.0.0.0', 1234))
+        transport._read_ready()
+        self.assertIsNone(transport._mmsg_buffers)
+        transport._read_ready()
+        self.assertEqual(len(transport._mmsg_buffers), 2)
+        self.assertEqual(self.sock.recvfrom.call_count, 2)
+
+        self.sock.recvmmsg_into.side_effect = self.recvmmsg_into(
+            (b'abc', ('0.0.0.0', 1)), (b'12345678', ('0.0.0.0', 2)))
+        self.protocol.datagram_received.reset_mock()
+        transport._read_ready()
+        self.assertEqual(self.sock.recvfrom.call_count, 2)
+        self.assertEqual(self.protocol.datagram_received.call_args_list,
+                         [mock.call(b'abc', ('0.0.0.0', 1)),
+                          mock.call(b'12345678', ('0.0.0.0', 2))])
+
+    def test_read_ready_recvmmsg_closed(self):
+        transport = self.datagram_transport()
+        transport._mmsg_alloc_buffers()
+        self.sock.recvmmsg_into.side_effect = self.recvmmsg_into(
+            (b'abc', ('0.0.0.0', 1)), (b'def', ('0.0.0.0', 2)))
+        self.protocol.datagram_received.side_effect = (
+            lambda data, addr: transport.close())
+        transport._read_ready()
+        self.protocol.datagram_received.assert_called_once_with(
+            b'abc', ('0.0.0.0', 1))
+
+    def test_read_ready_recvmmsg_errors(self):
+        transport = self.datagram_transport()
+        transport._mmsg_alloc_buffers()
+        self.sock.recvmmsg_into.side_effect = BlockingIOError
+        transport._read_ready()
+        self.assertFalse(self.protocol.error_received.called)
+
+        err = self.sock.recvmmsg_into.side_effect = OSError()
+        transport._read_ready()
+        self.protocol.error_received.assert_called_with(err)
+
+        transport._fatal_error = mock.Mock()
+        err = self.sock.recvmmsg_into.side_effect = RuntimeError()
+        transport._read_ready()
+        transport._fatal_error.assert_called_with(
+            err, 'Fatal read error on datagram transport')
+
+    def test_sendto_ready_sendmmsg(self):
+        transport = self.datagram_transport()
+        transport._buffer.extend([(b'a', 1), (b'bc', 2), (b'def', 3)])
+        transport._buffer_size = 6
+        self.loop._add_writer(7, transport._sendto_ready)
+        self.sock.sendmmsg.side_effect = [1, 1]
+        self.sock.sendto.side_effect = BlockingIOError
+        transport._sendto_ready()
+        self.assertEqual(self.sock.sendmmsg.call_args_list,
+                         [mock.call([b'a', b'bc'], 0, [1, 2]),
+                          mock.call([b'bc', b'def'], 0, [2, 3])])
+        self.sock.sendto.assert_called_with(b'def', 3)
+        self.assertEqual(list(transport._buffer), [(b'def', 3)])
+        self.assertEqual(transport.get_write_buffer_size(), 3)
+        self.loop.assert_writer(7, transport._sendto_ready)
+
+    def test_sendto_ready_sendmmsg_connected(self):
+        transport = self.datagram_transport(address=('0.0.0.0', 1))
+        transport._buffer.extend([(b'a', None), (b'bc', None)])
+        self.loop._add_writer(7, transport._sendto_ready)
+        self.sock.sendmmsg.return_value = 2
+        transport._sendto_ready()
+        self.sock.sendmmsg.assert_called_with([b'a', b'bc'])
+        self.assertFalse(transport._buffer)
+        self.assertFalse(self.loop.writers)
+
+    def test_sendto_ready_sendmmsg_tryagain(self):
+        transport = self.datagram_transport()
+        transport._buffer.extend([(b'a', 1), (b'bc', 2)])
+        self.loop._add_writer(7, transport._sendto_ready)
+        self.sock.sendmmsg.side_effect = BlockingIOError
+        transport._sendto_ready()
+        self.assertEqual(len(transport._buffer), 2)
+        self.loop.assert_writer(7, transport._sendto_ready)
+
+    def test_sendto_ready_sendmmsg_error_received(self):
+        transport = self.datagram_transport()
+        transport._buffer.extend([(b'a', 1), (b'bc', 2)])
+        err = self.sock.sendmmsg.side_effect = ConnectionRefusedError()
+        transport._sendto_ready()
+        self.protocol.error_received.assert_called_with(err)
+        self.assertEqual(list(transport._buffer), [(b'bc', 2)])
+
+    def test_loopback(self):
+        # Datagrams are received in batches once the endpoint is busy.
+        loop = asyncio.new_event_loop()
+        self.addCleanup(loop.close)
+        count = 100
+
+        class Server(asyncio.DatagramProtocol):
+            def __init__(self):
+                self.received = []
+                self.done = loop.create_future()
+
+            def datagram_received(self, data, addr):
+                self.received.append(data)
+                if len(self.received) == count:
+                    self.done.set_result(None)
+
+        async def main():
+            server, protocol = await loop.create_datagram_endpoint(
+                Server, local_addr=('127.0.0.1', 0))
+            client, _ = await loop.create_datagram_endpoint(
+                asyncio.DatagramProtocol,
+                remote_addr=server.get_extra_info('sockname'))
+            for i in range(count):
+                client.sendto(b'%d' % i)
+            await asyncio.wait_for(protocol.done, support.SHORT_TIMEOUT)
+            batched = server._mmsg_buffers is not None
+            client.close()
+            server.close()
+            return protocol.received, batched
+
+        received, batched = loop.run_until_complete(main())
+        self.assertEqual(received, [b'%d' % i for i in range(count)])
+        self.assertTrue(batched)
+
+
 if __name__ == '__main__':
     unittest.main()
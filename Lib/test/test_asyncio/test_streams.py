@@ -1219,5 +1219,226 @@ async def main():
         asyncio.run(main())
 
 
+class BufferedStreamReaderTests(test_utils.TestCase):
+
+    DATA = b'line1\nline2\nline3\n'
+
+    def setUp(self):
+        super().setUp()
+        self.loop = asyncio.new_event_loop()
+        self.set_event_loop(self.loop)
+
+    def tearDown(self):
+        test_utils.run_briefly(self.loop)
+        super().tearDown()
+
+    def unread(self, stream):
+        return bytes(stream._buf[stream._start:stream._end])
+
+    def test_ctor_and_repr(self):
+        stream = asyncio.BufferedStreamReader(limit=123, loop=self.loop)
+        self.assertFalse(hasattr(stream, '_buffer'))
+        stream.feed_data(b'data')
+        self.assertEqual(repr(stream),
+                         '<BufferedStreamReader 4 bytes limit=123>')
+        stream.feed_eof()
+        self.assertFalse(stream.at_eof())
+        self.loop.run_until_complete(stream.read(4))
+        self.assertTrue(stream.at_eof())
+
+    def test_readexactly(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop)
+        n = 2 * len(self.DATA)
+        read_task = self.loop.create_task(stream.readexactly(n))
+
+        def cb():
+            stream.feed_data(self.DATA)
+            stream.feed_data(bytearray(self.DATA))
+            stream.feed_data(memoryview(self.DATA))
+        self.loop.call_soon(cb)
+
+        data = self.loop.run_until_complete(read_task)
+        self.assertIs(type(data), bytes)
+        self.assertEqual(self.DATA + self.DATA, data)
+        self.assertEqual(self.DATA, self.unread(stream))
+
+    def test_readexactly_eof(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop)
+        stream.feed_data(self.DATA)
+        stream.feed_eof()
+        with self.assertRaises(asyncio.IncompleteReadError) as cm:
+            self.loop.run_until_complete(stream.readexactly(100))
+        self.assertEqual(cm.exception.partial, self.DATA)
+        self.assertEqual(cm.exception.expected, 100)
+        self.assertEqual(b'', self.unread(stream))
+
+    def test_readuntil(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop)
+        stream.feed_data(b'chunk1\r\nchunk2\n')
+        read = lambda sep: self.loop.run_until_complete(stream.readuntil(sep))
+        self.assertEqual(read((b'\n', b'\r\n')), b'chunk1\r\n')
+        stream.feed_data(b'chunk3!!')
+        self.assertEqual(read(b'\n'), b'chunk2\n')
+        self.assertEqual(read(b'!!'), b'chunk3!!')
+        with self.assertRaisesRegex(ValueError, 'one-byte'):
+            read(b'')
+        with self.assertRaisesRegex(ValueError, 'one element'):
+            read(())
+
+    def test_readuntil_partial_separator(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop)
+        read_task = self.loop.create_task(stream.readuntil(b'aaa'))
+
+        def cb():
+            stream.feed_data(b'QWEaa')
+            stream.feed_data(b'XYaa')
+            stream.feed_data(b'a')
+        self.loop.call_soon(cb)
+        self.assertEqual(self.loop.run_until_complete(read_task),
+                         b'QWEaaXYaaa')
+        stream.feed_data(b'XYAA')
+        stream.feed_eof()
+        with self.assertRaises(asyncio.IncompleteReadError) as cm:
+            self.loop.run_until_complete(stream.readuntil(b'aaa'))
+        self.assertEqual(cm.exception.partial, b'XYAA')
+
+    def test_readuntil_limit(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop, limit=3)
+        stream.feed_data(b'some dataAA')
+        with self.assertRaises(asyncio.LimitOverrunError) as cm:
+            self.loop.run_until_complete(stream.readuntil(b'AA'))
+        self.assertEqual(cm.exception.consumed, 9)
+        # The data is left in the buffer.
+        self.assertEqual(b'some dataAA', self.unread(stream))
+
+    def test_readline(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop, limit=7)
+        stream.feed_data(b'line1\n')
+        stream.feed_data(b'a very long line\nline2')
+        stream.feed_eof()
+        readline = lambda: self.loop.run_until_complete(stream.readline())
+        self.assertEqual(readline(), b'line1\n')
+        with self.assertRaises(ValueError):
+            readline()
+        self.assertEqual(readline(), b'line2')
+        self.assertEqual(readline(), b'')
+
+    def test_read(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop)
+        read_task = self.loop.create_task(stream.read(4))
+        self.loop.call_soon(stream.feed_data, self.DATA)
+        self.assertEqual(self.loop.run_until_complete(read_task), b'line')
+        self.assertEqual(self.loop.run_until_complete(stream.read(0)), b'')
+        stream.feed_data(self.DATA)
+        stream.feed_eof()
+        self.assertEqual(self.loop.run_until_complete(stream.read()),
+                         self.DATA[4:] + self.DATA)
+
+    def test_exception(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop)
+        stream.feed_data(self.DATA)
+        stream.set_exception(ValueError())
+        for coro in (stream.read(2), stream.readexactly(2),
+                     stream.readuntil(), stream.readexactly_view(2),
+                     stream.readuntil_view()):
+            self.assertRaises(ValueError, self.loop.run_until_complete, coro)
+
+    def test_views(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop)
+        stream.feed_data(b'header:payload!')
+        header = self.loop.run_until_complete(stream.readuntil_view(b':'))
+        self.assertIsInstance(header, memoryview)
+        self.assertEqual(header, b'header:')
+        payload = self.loop.run_until_complete(stream.readexactly_view(7))
+        self.assertEqual(payload, b'payload')
+        self.assertIs(payload.obj, stream._buf)
+
+        # Receiving data does not overwrite the view of the last read call,
+        # even when the buffer has to be compacted.
+        for i in range(10):
+            buf = stream._get_buffer(-1)
+            buf[:] = b'x' * len(buf)
+            stream._buffer_updated(len(buf))
+        self.assertEqual(payload, b'payload')
+        self.assertIsNot(payload.obj, stream._buf)
+        self.assertEqual(self.unread(stream)[:2], b'!x')
+
+    def test_compaction(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop,
+                                              limit=2 ** 20)
+        buf = stream._buf
+        chunk = stream._recv_size // 2
+        for i in range(100):
+            stream.feed_data(b'%d' % (i % 10) * chunk)
+            data = self.loop.run_until_complete(stream.readexactly(chunk))
+            self.assertEqual(data, b'%d' % (i % 10) * chunk)
+        # Without views, the buffer is compacted in place.
+        self.assertIs(stream._buf, buf)
+
+        # The buffer grows for large frames.
+        big = b'y' * (10 * len(buf))
+        stream.feed_data(big)
+        self.assertEqual(self.loop.run_until_complete(stream.read(len(big))),
+                         big)
+
+    def test_pause_resume(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop, limit=10)
+        transport = mock.Mock()
+        stream.set_transport(transport)
+        buf = stream._get_buffer(-1)
+        buf[:21] = b'x' * 21
+        stream._buffer_updated(21)
+        transport.pause_reading.assert_called_once_with()
+        self.loop.run_until_complete(stream.readexactly_view(11))
+        transport.resume_reading.assert_called_once_with()
+
+    def test_protocol(self):
+        stream = asyncio.BufferedStreamReader(loop=self.loop)
+        protocol = asyncio.streams._BufferedStreamReaderProtocol(
+            stream, loop=self.loop)
+        self.assertIsInstance(protocol, asyncio.BufferedProtocol)
+        buf = protocol.get_buffer(-1)
+        buf[:4] = b'data'
+        protocol.buffer_updated(4)
+        self.assertEqual(b'data', self.unread(stream))
+        protocol.eof_received()
+        self.assertEqual(
+            self.loop.run_until_complete(stream.read()), b'data')
+
+    def test_start_server_open_connection(self):
+        frames = [b'%d' % i * i for i in range(500)]
+
+        async def handle(reader, writer):
+            self.assertIsInstance(reader, asyncio.BufferedStreamReader)
+            while True:
+                size = await reader.readuntil_view(b':')
+                if size == b'end:':
+                    break
+                frame = await reader.readexactly_view(int(size[:-1]))
+                writer.write(frame)
+            await writer.drain()
+            writer.close()
+
+        async def main():
+            server = await asyncio.start_server(
+                handle, socket_helper.HOSTv4, 0, buffered=True)
+            addr = server.sockets[0].getsockname()
+            reader, writer = await asyncio.open_connection(
+                *addr, buffered=True)
+            self.assertIsInstance(reader, asyncio.BufferedStreamReader)
+            for frame in frames:
+                writer.write(b'%d:%s' % (len(frame), frame))
+            writer.write(b'end:')
+            data = await reader.read()
+            writer.close()
+            await writer.wait_closed()
+            server.close()
+            await server.wait_closed()
+            return data
+
+        data = self.loop.run_until_complete(main())
+        self.assertEqual(data, b''.join(frames))
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -1,11 +1,13 @@
 """Tests for unix_events.py."""
 
 import contextlib
+import contextvars
 import errno
 import io
 import multiprocessing
 from multiprocessing.util import _cleanup_tests as multiprocessing_cleanup_tests
 import os
+import selectors
 import signal
 import socket
 import stat
@@ -1182,6 +1184,163 @@ async def runner():
             wsock.close()
 
 
+@unittest.skipIf(asyncio.FastSelectorEventLoop is asyncio.SelectorEventLoop,
+                 'requires the _asyncio module')
+class FastSelectorEventLoopTests(test_utils.TestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.loop = asyncio.FastSelectorEventLoop()
+        self.set_event_loop(self.loop)
+
+    def test_epoll_is_polled_directly(self):
+        if type(self.loop._selector) is not getattr(selectors,
+                                                    'EpollSelector', None):
+            self.skipTest('requires selectors.EpollSelector')
+        self.loop._selector.select = mock.Mock(side_effect=AssertionError)
+        rsock, wsock = socket.socketpair()
+        self.addCleanup(rsock.close)
+        self.addCleanup(wsock.close)
+        fut = self.loop.create_future()
+
+        def reader():
+            self.loop.remove_reader(rsock)
+            fut.set_result(rsock.recv(1))
+
+        self.loop.add_reader(rsock, reader)
+        self.loop.call_soon(wsock.send, b'x')
+        self.assertEqual(self.loop.run_until_complete(fut), b'x')
+
+    def test_ready_order(self):
+        calls = []
+        for i in range(100):
+            self.loop.call_soon(calls.append, i)
+        self.assertEqual(len(self.loop._ready), 100)
+        self.loop.call_soon(self.loop.stop)
+        self.loop.run_forever()
+        self.assertEqual(calls, list(range(100)))
+        self.assertEqual(len(self.loop._ready), 0)
+
+    def test_timer_order(self):
+        calls = []
+        now = self.loop.time()
+        for i in reversed(range(20)):
+            self.loop.call_at(now + i * 0.001, calls.append, i)
+        self.loop.call_at(now + 0.05, self.loop.stop)
+        self.loop.run_forever()
+        self.assertEqual(calls, list(range(20)))
+        self.assertEqual(self.loop._core.ntimers, 0)
+
+    def test_cancelled_timers_are_removed(self):
+        handles = [self.loop.call_later(3600, lambda: None)
+                   for i in range(200)]
+        for handle in handles[:150]:
+            handle.cancel()
+        self.assertEqual(self.loop._core.timer_cancelled_count, 150)
+        self.loop.call_soon(self.loop.stop)
+        self.loop.run_forever()
+        self.assertEqual(self.loop._core.ntimers, 50)
+        self.assertEqual(self.loop._core.timer_cancelled_count, 0)
+        self.assertFalse(any(h._scheduled for h in handles[:150]))
+        self.assertTrue(all(h._scheduled for h in handles[150:]))
+
+        self.loop.close()
+        self.assertEqual(self.loop._core.ntimers, 0)
+
+    def test_slow_callback_in_debug_mode(self):
+        self.loop.set_debug(True)
+        self.loop.slow_callback_duration = 0.0
+        self.loop.call_soon(self.loop.stop)
+        with mock.patch('asyncio.base_events.logger') as m_logger:
+            self.loop.run_forever()
+        m_logger.warning.assert_called_with(
+            'Executing %s took %.3f seconds', mock.ANY, mock.ANY)
+        self.assertIsNone(self.loop._current_handle)
+
+    def test_native_callbacks(self):
+        self.assertTrue(self.loop._core.native_callbacks)
+        fut = self.loop.create_future()
+        callback = mock.Mock()
+        fut.add_done_callback(callback)
+        fut.set_result(1)
+        self.assertEqual(len(self.loop._ready), 1)
+        handle = self.loop._ready.popleft()
+        self.assertIsInstance(handle, asyncio.Handle)
+        self.assertEqual(handle._callback, callback)
+        self.assertEqual(handle._args, (fut,))
+        handle._run()
+        callback.assert_called_once_with(fut)
+
+        self.loop.set_debug(True)
+        self.assertFalse(self.loop._core.native_callbacks)
+        self.loop.set_debug(False)
+        self.assertTrue(self.loop._core.native_callbacks)
+        self.loop.close()
+        self.assertFalse(self.loop._core.native_callbacks)
+        fut = self.loop.create_future()
+        fut.add_done_callback(callback)
+        with self.assertRaisesRegex(RuntimeError, 'closed'):
+            fut.set_result(1)
+
+    def test_native_callback_context(self):
+        var = contextvars.ContextVar('var', default='default')
+        values = []
+
+        async def task():
+            values.append(var.get())
+            await asyncio.sleep(0)
+            values.append(var.get())
+
+        def schedule():
+            var.set('task')
+            t = self.loop.create_task(task())
+            var.set('other')
+            fut = self.loop.create_future()
+            fut.add_done_callback(lambda f: values.append(var.get()),
+                                  context=contextvars.Context())
+            fut.set_result(None)
+            return t
+
+        t = contextvars.Context().run(schedule)
+        self.loop.run_until_complete(t)
+        self.assertEqual(values, ['task', 'default', 'task'])
+
+    def test_native_callback_exception(self):
+        def callback(fut):
+            raise ZeroDivisionError
+        handler = mock.Mock()
+        self.loop.set_exception_handler(handler)
+        fut = self.loop.create_future()
+        fut.add_done_callback(callback)
+        fut.set_result(None)
+        self.loop.call_soon(self.loop.stop)
+        self.loop.run_forever()
+        handler.assert_called_once()
+        context = handler.call_args.args[1]
+        self.assertIsInstance(context['exception'], ZeroDivisionError)
+        self.assertEqual(context['handle']._callback, callback)
+        self.assertIn('Exception in callback', context['message'])
+
+    def test_native_callback_keyboard_interrupt(self):
+        def callback(fut):
+            raise KeyboardInterrupt
+        fut = self.loop.create_future()
+        fut.add_done_callback(callback)
+        fut.set_result(None)
+        self.loop.call_soon(self.loop.stop)
+        with self.assertRaises(KeyboardInterrupt):
+            self.loop.run_forever()
+
+    def test_callback_exception_propagates(self):
+        def fail():
+            raise ZeroDivisionError
+        self.loop.call_soon(fail)
+        self.loop.call_soon(self.loop.stop)
+        with mock.patch('asyncio.base_events.logger') as m_logger:
+            self.loop.run_forever()
+        m_logger.error.assert_called_once()
+
+
 @support.requires_fork()
 class TestFork(unittest.IsolatedAsyncioTestCase):
 
@@ -525,6 +525,44 @@ def test_code_equal_with_instrumentation(self):
         self.assertNotEqual(code1, code2)
         sys.settrace(None)
 
+    def test_exception_table_lookup(self):
+        # Many sequential and nested handlers, so that the lookup has to
+        # search a large table.
+        lines = ["def f(n):"]
+        for i in range(60):
+            lines += [f"    try:",
+                      f"        try:",
+                      f"            if n == {i}: raise KeyError",
+                      f"            if n == {i} + 100: raise IndexError",
+                      f"        except KeyError:",
+                      f"            return 'inner', {i}",
+                      f"    except IndexError:",
+                      f"        return 'outer', {i}"]
+        lines.append("    return None")
+        ns = {}
+        exec("\n".join(lines), ns)
+        f = ns['f']
+        for i in range(60):
+            self.assertEqual(f(i), ('inner', i))
+            self.assertEqual(f(i + 100), ('outer', i))
+        self.assertIsNone(f(-1))
+
+    @cpython_only
+    def test_exception_table_cache_sizeof(self):
+        import sysconfig
+        if not sysconfig.get_config_var('PY_EXCEPTION_TABLE_CACHE'):
+            self.skipTest('requires the exception table cache')
+        def f():
+            try:
+                raise KeyError
+            except KeyError:
+                pass
+        code = f.__code__.replace()
+        f.__code__ = code
+        size = sys.getsizeof(code)
+        f()
+        self.assertGreater(sys.getsizeof(code), size)
+
 
 def isinterned(s):
     return s is sys.intern(('_' + s + '_')[1:-1])
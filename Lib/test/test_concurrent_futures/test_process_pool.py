@@ -1,4 +1,5 @@
 import os
+import pickle
 import sys
 import threading
 import time
@@ -15,6 +16,11 @@
     create_executor_tests, setup_module)
 
 
+def reverse_buffer(buffer):
+    return (isinstance(buffer, memoryview),
+            pickle.PickleBuffer(bytes(buffer)[::-1]))
+
+
 class EventfulGCObj():
     def __init__(self, mgr):
         self.event = mgr.Event()
@@ -190,6 +196,36 @@ def test_max_tasks_early_shutdown(self):
         for i, future in enumerate(futures):
             self.assertEqual(future.result(), mul(i, i))
 
+    @unittest.skipIf(sys.platform == 'win32', "requires POSIX shared memory")
+    def test_shared_memory_threshold(self):
+        context = self.get_context()
+        with self.assertRaises(ValueError):
+            self.executor_type(1, mp_context=context,
+                               shared_memory_threshold=0)
+        with self.assertRaises(TypeError):
+            self.executor_type(1, mp_context=context,
+                               shared_memory_threshold=1.5)
+
+        # not using self.executor as we need to control construction.
+        executor = self.executor_type(
+                2, mp_context=context, shared_memory_threshold=1000)
+        data = bytes(range(256)) * 100
+        in_shm, result = executor.submit(
+            reverse_buffer, pickle.PickleBuffer(data)).result()
+        self.assertTrue(in_shm)
+        self.assertIsInstance(result, memoryview)
+        self.assertTrue(result.readonly)
+        self.assertEqual(result, data[::-1])
+        in_shm, result = executor.submit(
+            reverse_buffer, pickle.PickleBuffer(b'abc')).result()
+        self.assertFalse(in_shm)
+        self.assertEqual(result, b'cba')
+        results = executor.map(reverse_buffer,
+                               [pickle.PickleBuffer(data)] * 10)
+        for in_shm, result in results:
+            self.assertEqual(result, data[::-1])
+        executor.shutdown()
+
     def test_python_finalization_error(self):
         # gh-109047: Catch RuntimeError on thread creation
         # during Python finalization.
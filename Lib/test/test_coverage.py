@@ -0,0 +1,130 @@
+"""Test suite for the _coverage module."""
+
+import sys
+import threading
+import unittest
+from test.support import import_helper, threading_helper
+
+_coverage = import_helper.import_module('_coverage')
+
+
+def branchy(x):
+    if x:
+        return 1
+    return 2
+
+
+def loop(n):
+    total = 0
+    for i in range(n):
+        if i % 3:
+            total += i
+    return total
+
+
+def first_line(func):
+    return func.__code__.co_firstlineno
+
+
+class CoverageTest(unittest.TestCase):
+    def setUp(self):
+        _coverage.clear()
+        self.addCleanup(_coverage.clear)
+        self.addCleanup(_coverage.stop)
+
+    def test_start_stop(self):
+        self.assertFalse(_coverage.is_running())
+        _coverage.start()
+        self.assertTrue(_coverage.is_running())
+        self.assertEqual(sys.monitoring.get_tool(sys.monitoring.COVERAGE_ID),
+                         "_coverage")
+        with self.assertRaises(RuntimeError):
+            _coverage.start()
+        _coverage.stop()
+        self.assertFalse(_coverage.is_running())
+        self.assertIsNone(sys.monitoring.get_tool(sys.monitoring.COVERAGE_ID))
+        # stop() is idempotent
+        _coverage.stop()
+
+    def test_tool_id_in_use(self):
+        tool_id = sys.monitoring.COVERAGE_ID
+        sys.monitoring.use_tool_id(tool_id, "other")
+        try:
+            with self.assertRaises(ValueError):
+                _coverage.start()
+            self.assertFalse(_coverage.is_running())
+            _coverage.start(tool_id=sys.monitoring.OPTIMIZER_ID - 1)
+            self.assertTrue(_coverage.is_running())
+        finally:
+            _coverage.stop()
+            sys.monitoring.free_tool_id(tool_id)
+
+    def test_lines(self):
+        _coverage.start()
+        branchy(0)
+        _coverage.stop()
+        base = first_line(branchy)
+        lines, branches = _coverage.collect()[branchy.__code__]
+        self.assertEqual(lines, {base + 1, base + 3})
+        self.assertEqual(branches, set())
+
+        # Recording resumes where it stopped
+        _coverage.start()
+        branchy(1)
+        _coverage.stop()
+        lines, branches = _coverage.collect()[branchy.__code__]
+        self.assertEqual(lines, {base + 1, base + 2, base + 3})
+
+    def test_branches(self):
+        _coverage.start(branches=True)
+        branchy(0)
+        first = _coverage.collect()[branchy.__code__][1]
+        self.assertEqual(len(first), 1)
+        branchy(1)
+        _coverage.stop()
+        both = _coverage.collect()[branchy.__code__][1]
+        self.assertEqual(len(both), 2)
+        self.assertLess(first, both)
+        self.assertEqual(len({src for src, dest in both}), 1)
+
+    def test_loop(self):
+        _coverage.start(branches=True)
+        loop(10)
+        loop(10)
+        _coverage.stop()
+        lines, branches = _coverage.collect()[loop.__code__]
+        base = first_line(loop)
+        self.assertEqual(lines, set(range(base + 1, base + 6)))
+        # for loop and if statement, both directions each
+        self.assertEqual(len(branches), 4)
+
+    def test_clear(self):
+        _coverage.start()
+        branchy(0)
+        self.assertIn(branchy.__code__, _coverage.collect())
+        _coverage.clear()
+        self.assertNotIn(branchy.__code__, _coverage.collect())
+        # Disabled lines are reported again after clear()
+        branchy(0)
+        _coverage.stop()
+        lines, _ = _coverage.collect()[branchy.__code__]
+        self.assertEqual(lines, {first_line(branchy) + 1,
+                                 first_line(branchy) + 3})
+
+    @threading_helper.requires_working_threading()
+    def test_threads(self):
+        def worker():
+            branchy(1)
+
+        _coverage.start()
+        t = threading.Thread(target=worker)
+        t.start()
+        t.join()
+        _coverage.stop()
+        data = _coverage.collect()
+        self.assertIn(worker.__code__, data)
+        self.assertIn(first_line(branchy) + 2, data[branchy.__code__][0])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -123,6 +123,59 @@ def test_throw(self):
                 self.assertEqual(cc, 1)
                 self.assertEqual(nc, 1)
 
+    def test_callsites(self):
+        def callee():
+            pass
+
+        def caller():
+            callee()
+            callee()
+            callee()
+
+        def subcalls(prof):
+            for entry in prof.getstats():
+                if entry.code is caller.__code__:
+                    return [sub for sub in entry.calls
+                            if sub.code is callee.__code__]
+            self.fail("caller was not profiled")
+
+        prof = self.profilerclass()
+        prof.runcall(caller)
+        [sub] = subcalls(prof)
+        self.assertEqual(sub.callcount, 3)
+        self.assertIsNone(sub.lineno)
+        self.assertEqual(len(sub), 5)
+
+        prof = self.profilerclass(callsites=True)
+        prof.runcall(caller)
+        subs = subcalls(prof)
+        first = caller.__code__.co_firstlineno
+        self.assertEqual(sorted((sub.lineno, sub.callcount) for sub in subs),
+                         [(first + 1, 1), (first + 2, 1), (first + 3, 1)])
+        self.assertEqual(len(subs[0]), 5)
+
+        # pstats still sees a single caller
+        prof.create_stats()
+        callers = prof.stats[cProfile.label(callee.__code__)][4]
+        self.assertEqual(callers[cProfile.label(caller.__code__)][0], 3)
+
+    def test_callsites_builtins(self):
+        def caller():
+            len(())
+            len(())
+
+        prof = self.profilerclass(callsites=True)
+        prof.runcall(caller)
+        for entry in prof.getstats():
+            if entry.code is caller.__code__:
+                first = caller.__code__.co_firstlineno
+                lines = sorted(sub.lineno for sub in entry.calls
+                               if sub.code == "<built-in method builtins.len>")
+                self.assertEqual(lines, [first + 1, first + 2])
+                break
+        else:
+            self.fail("caller was not profiled")
+
 
 class TestCommandLine(unittest.TestCase):
     def test_sort(self):
@@ -21,6 +21,7 @@
 """
 Tests for epoll wrapper.
 """
+import array
 import errno
 import os
 import select
@@ -213,6 +214,81 @@ def test_control_and_wait(self):
         expected = [(server.fileno(), select.EPOLLOUT)]
         self.assertEqual(events, expected)
 
+    def test_poll_into(self):
+        client, server = self._connected_pair()
+        ep = select.epoll(16)
+        self.addCleanup(ep.close)
+        ep.register(server.fileno(), select.EPOLLIN | select.EPOLLOUT)
+        ep.register(client.fileno(), select.EPOLLIN | select.EPOLLOUT)
+        client.sendall(b"Hello!")
+
+        expected = [(client.fileno(), select.EPOLLOUT),
+                    (server.fileno(), select.EPOLLIN | select.EPOLLOUT)]
+        buf = array.array('i', [-1] * 8)
+        for _ in support.busy_retry(support.SHORT_TIMEOUT):
+            n = ep.poll_into(buf, 1.0)
+            self.assertIn(n, (1, 2))
+            events = list(zip(buf[:2 * n:2], buf[1:2 * n:2]))
+            if sorted(events) == sorted(expected):
+                break
+        self.assertEqual(list(buf[4:]), [-1] * 4)
+
+        # At most len(buffer) // 2 events are reported
+        buf = array.array('i', [-1] * 3)
+        self.assertEqual(ep.poll_into(buf, 0), 1)
+        self.assertIn((buf[0], buf[1]), expected)
+        self.assertEqual(buf[2], -1)
+
+        # Unaligned and byte buffers
+        buf = bytearray(1 + 4 * 4)
+        self.assertEqual(ep.poll_into(memoryview(buf)[1:], 0), 2)
+        events = array.array('i', buf[1:])
+        self.assertEqual(sorted(zip(events[::2], events[1::2])),
+                         sorted(expected))
+
+        self.assertRaises(ValueError, ep.poll_into, bytearray(7), 0)
+        self.assertRaises(TypeError, ep.poll_into, bytes(8), 0)
+        ep.close()
+        self.assertRaises(ValueError, ep.poll_into, bytearray(8), 0)
+
+    def test_dispatch(self):
+        client, server = self._connected_pair()
+        ep = select.epoll(16)
+        self.addCleanup(ep.close)
+        ep.register(server.fileno(), select.EPOLLIN)
+        ep.register(client.fileno(), select.EPOLLOUT)
+
+        calls = []
+        handlers = {server.fileno(): lambda ev: calls.append(('server', ev))}
+        self.assertEqual(ep.dispatch(handlers, 1.0), 1)
+        self.assertEqual(calls, [])  # client is not in handlers
+
+        client.sendall(b"Hello!")
+        handlers[client.fileno()] = lambda ev: calls.append(('client', ev))
+        for _ in support.busy_retry(support.SHORT_TIMEOUT):
+            calls.clear()
+            self.assertEqual(ep.dispatch(handlers, 1.0), len(calls))
+            if len(calls) == 2:
+                break
+        self.assertEqual(sorted(calls), [('client', select.EPOLLOUT),
+                                         ('server', select.EPOLLIN)])
+
+        # A handler can poll the same epoll object
+        def reentrant(ev):
+            calls.append(ep.poll(0))
+        handlers[client.fileno()] = reentrant
+        handlers[server.fileno()] = reentrant
+        calls.clear()
+        ep.dispatch(handlers, 0)
+        self.assertTrue(calls)
+
+        def fail(ev):
+            raise ZeroDivisionError
+        handlers[client.fileno()] = fail
+        handlers[server.fileno()] = fail
+        self.assertRaises(ZeroDivisionError, ep.dispatch, handlers, 0)
+        self.assertRaises(TypeError, ep.dispatch, list(handlers), 0)
+
     def test_errors(self):
         self.assertRaises(ValueError, select.epoll, -2)
         self.assertRaises(ValueError, select.epoll().register, -1,
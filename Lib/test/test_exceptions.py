@@ -2511,5 +2511,116 @@ def after_with():
                 1/0
         self.lineno_after_raise(after_with, 1, 1)
 
+
+class TracebackCaptureTests(unittest.TestCase):
+    # Tracebacks are captured lazily: these tests check that they look the
+    # same as if the frame and traceback objects were created during the
+    # unwinding, in particular after the frames have finished executing.
+
+    def tb_entries(self, tb):
+        entries = []
+        while tb is not None:
+            entries.append((tb.tb_frame.f_code.co_name,
+                            tb.tb_lineno - tb.tb_frame.f_code.co_firstlineno))
+            tb = tb.tb_next
+        return entries
+
+    def test_frames_outlive_unwinding(self):
+        def inner(x):
+            y = x + 1
+            raise ValueError(y)
+        def outer():
+            z = 'outer'
+            try:
+                inner(1)
+            except ValueError as e:
+                return e
+
+        tb = outer().__traceback__
+        self.assertEqual(self.tb_entries(tb), [('outer', 3), ('inner', 2)])
+        self.assertEqual(tb.tb_frame.f_locals['z'], 'outer')
+        self.assertEqual(tb.tb_next.tb_frame.f_locals, {'x': 1, 'y': 2})
+        self.assertIs(tb.tb_next.tb_frame.f_back, tb.tb_frame)
+
+    def test_lasti_recorded_at_raise(self):
+        def f():
+            try:
+                raise KeyError
+            except KeyError as e:
+                exc = e
+            line = sys._getframe().f_lineno
+            return exc, line
+
+        exc, line = f()
+        tb = exc.__traceback__
+        self.assertEqual(self.tb_entries(tb), [('f', 2)])
+        self.assertEqual(tb.tb_frame.f_lineno, line + 1)
+        self.assertIs(exc.__traceback__, tb)
+
+    def test_many_stored_exceptions(self):
+        def f():
+            errors = []
+            for i in range(100):
+                try:
+                    {}[i]
+                except KeyError as e:
+                    errors.append(e)
+            return errors
+
+        errors = f()
+        frames = {id(e.__traceback__.tb_frame) for e in errors}
+        self.assertEqual(len(frames), 1)
+        for e in errors:
+            self.assertEqual(self.tb_entries(e.__traceback__), [('f', 4)])
+        self.assertEqual(errors[0].__traceback__.tb_frame.f_locals['i'], 99)
+
+    def test_generator_frame(self):
+        def gen():
+            try:
+                raise ValueError
+            except ValueError as e:
+                yield e
+            yield 1
+
+        g = gen()
+        exc = next(g)
+        g.close()
+        self.assertEqual(self.tb_entries(exc.__traceback__), [('gen', 2)])
+        del g
+        gc_collect()
+        self.assertEqual(exc.__traceback__.tb_frame.f_code.co_name, 'gen')
+
+    def test_reraise_extends_traceback(self):
+        def inner():
+            raise ValueError
+        def reraise(e):
+            raise e
+        def middle():
+            try:
+                inner()
+            except ValueError as e:
+                exc = e
+            reraise(exc)
+
+        try:
+            middle()
+        except ValueError as e:
+            tb = e.__traceback__
+        entries = self.tb_entries(tb)
+        self.assertEqual(entries[1:], [('middle', 5), ('reraise', 1),
+                                       ('middle', 2), ('inner', 1)])
+        self.assertIs(tb.tb_next.tb_frame, tb.tb_next.tb_next.tb_next.tb_frame)
+
+    def test_traceback_identity(self):
+        try:
+            raise TypeError
+        except TypeError as e:
+            tb = e.__traceback__
+            self.assertIs(sys.exception().__traceback__, tb)
+            self.assertIs(sys.exc_info()[2], tb)
+        e2 = TypeError().with_traceback(tb)
+        self.assertIs(e2.__traceback__, tb)
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -134,6 +134,45 @@ def gen():
         self.assertEqual(len(resurrected), 1)
         self.assertIsInstance(resurrected[0].gi_code, types.CodeType)
 
+    def test_reused_generator_is_finalized(self):
+        # The memory of generators is reused for new generators, coroutines
+        # and asynchronous generators: each of them must be finalized.
+        finalized = []
+
+        def gen():
+            try:
+                yield
+            finally:
+                finalized.append('gen')
+
+        async def coro():
+            try:
+                await types.coroutine(lambda: (yield))()
+            finally:
+                finalized.append('coro')
+
+        async def agen():
+            try:
+                yield
+            finally:
+                finalized.append('agen')
+
+        for i in range(3):
+            g = gen()
+            next(g)
+            del g
+            c = coro()
+            c.send(None)
+            self.assertIs(type(c), types.CoroutineType)
+            del c
+            a = agen()
+            self.assertIs(type(a), types.AsyncGeneratorType)
+            with self.assertRaises(StopIteration):
+                a.asend(None).send(None)
+            del a
+        support.gc_collect()
+        self.assertEqual(finalized, ['gen', 'coro', 'agen'] * 3)
+
 
 class GeneratorTest(unittest.TestCase):
 
@@ -5,6 +5,7 @@
 import sysconfig
 import os
 import pathlib
+import struct
 from test import support
 from test.support.script_helper import (
     make_script,
@@ -28,8 +29,9 @@ def is_jit_build():
     return "_Py_JIT" in cflags
 
 
-if is_jit_build():
-    raise unittest.SkipTest("Perf support is not available in JIT builds")
+skip_if_jit_build = unittest.skipIf(
+    is_jit_build(), "Perf support is not available in JIT builds"
+)
 
 
 def supports_trampoline_profiling():
@@ -43,6 +45,7 @@ def supports_trampoline_profiling():
     raise unittest.SkipTest("perf trampoline profiling not supported")
 
 
+@skip_if_jit_build
 class TestPerfTrampoline(unittest.TestCase):
     def setUp(self):
         super().setUp()
@@ -392,6 +395,7 @@ def baz(n):
             self.assertNotIn(f"py::baz:{script}", stdout)
 
 
+@skip_if_jit_build
 @unittest.skipUnless(perf_command_works(), "perf command doesn't work")
 @unittest.skipUnless(
     is_unwinding_reliable_with_frame_pointers(),
@@ -503,6 +507,7 @@ def _is_perf_version_at_least(major, minor):
     return version >= (major, minor)
 
 
+@skip_if_jit_build
 @unittest.skipUnless(perf_command_works(), "perf command doesn't work")
 @unittest.skipUnless(
     _is_perf_version_at_least(6, 6), "perf command may not work due to a perf bug"
@@ -529,5 +534,94 @@ def tearDown(self) -> None:
             file.unlink()
 
 
+JIT_LOOP_SCRIPT = """if 1:
+    def loop(n):
+        total = 0
+        for i in range(n):
+            total += i
+        return total
+
+    loop(100_000)
+    """
+
+
+def read_jitdump(path):
+    """Return the debug info and code load records of a jitdump file."""
+    data = path.read_bytes()
+    magic, version, header_size = struct.unpack_from("<III", data)
+    assert magic == 0x4A695444, magic
+    debug_infos = []
+    loads = []
+    offset = header_size
+    while offset < len(data):
+        event, size = struct.unpack_from("<II", data, offset)
+        body = offset + 16
+        if event == 0:
+            _, _, _, code_addr, code_size, _ = struct.unpack_from(
+                "<IIQQQQ", data, body
+            )
+            name_start = body + 40
+            name_end = data.index(b"\0", name_start)
+            loads.append((code_addr, code_size, data[name_start:name_end].decode()))
+        elif event == 2:
+            code_addr, nr_entry = struct.unpack_from("<QQ", data, body)
+            entries = []
+            pos = body + 16
+            for _ in range(nr_entry):
+                addr, lineno, _ = struct.unpack_from("<Qii", data, pos)
+                name_end = data.index(b"\0", pos + 16)
+                entries.append((addr, lineno, data[pos + 16 : name_end].decode()))
+                pos = name_end + 1
+            debug_infos.append((code_addr, entries))
+        offset += size
+    return debug_infos, loads
+
+
+@unittest.skipUnless(is_jit_build(), "requires a JIT build")
+class TestPerfJitExecutors(unittest.TestCase):
+    def run_script(self, option):
+        with temp_dir() as script_dir:
+            script = make_script(script_dir, "perftest", JIT_LOOP_SCRIPT)
+            with subprocess.Popen(
+                [sys.executable, option, script],
+                text=True,
+                stderr=subprocess.PIPE,
+                stdout=subprocess.PIPE,
+                env={**os.environ, "PYTHON_JIT": "1"},
+            ) as process:
+                stdout, stderr = process.communicate()
+        self.assertEqual(stderr, "")
+        self.assertEqual(stdout, "")
+        return process.pid, script
+
+    def test_perf_map(self):
+        pid, script = self.run_script("-Xperf")
+        perf_file = pathlib.Path(f"/tmp/perf-{pid}.map")
+        self.addCleanup(perf_file.unlink)
+        perf_lines = perf_file.read_text().splitlines()
+        self.assertIn(f"py::loop:{script}", "\n".join(perf_lines))
+        jit_lines = [line for line in perf_lines if "py::jit::" in line]
+        self.assertTrue(jit_lines)
+        self.assertIn(f"py::jit::loop:{script}", jit_lines[0])
+
+    def test_jitdump_line_table(self):
+        pid, script = self.run_script("-Xperf_jit")
+        dump_file = pathlib.Path(f"/tmp/jit-{pid}.dump")
+        self.addCleanup(dump_file.unlink)
+        debug_infos, loads = read_jitdump(dump_file)
+        executors = [load for load in loads if load[2].startswith("py::jit::")]
+        self.assertTrue(executors)
+        code_addr, code_size, name = executors[0]
+        self.assertEqual(name, f"py::jit::loop:{script}")
+        entries = dict(debug_infos)[code_addr]
+        self.assertTrue(entries)
+        for addr, lineno, filename in entries:
+            self.assertGreaterEqual(addr, code_addr)
+            self.assertLess(addr, code_addr + code_size)
+            self.assertEqual(filename, script)
+        # The body of the loop is on lines 4 and 5
+        self.assertTrue({4, 5} & {lineno for _, lineno, _ in entries})
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -104,6 +104,7 @@ def basic_queue_test(self, q):
         q.put(333)
         q.put(222)
         target_order = dict(Queue = [111, 333, 222],
+                            FastQueue = [111, 333, 222],
                             LifoQueue = [222, 333, 111],
                             PriorityQueue = [111, 222, 333])
         actual_order = [q.get(), q.get(), q.get()]
@@ -700,6 +701,124 @@ class CPriorityQueueTest(PriorityQueueTest, unittest.TestCase):
     queue = c_queue
 
 
+class FastQueueTest(BaseQueueTestMixin):
+
+    def setUp(self):
+        self.type2test = self.queue.FastQueue
+        super().setUp()
+
+
+class PyFastQueueTest(FastQueueTest, unittest.TestCase):
+    queue = py_queue
+
+    def test_is_queue(self):
+        self.assertIs(self.type2test, self.queue.Queue)
+
+
+@need_c_queue
+class CFastQueueTest(FastQueueTest, unittest.TestCase):
+    queue = c_queue
+
+    def test_order_across_segments(self):
+        # Items span several internal segments, while the getters keep up
+        # with the putters or fall behind.
+        q = self.type2test()
+        for i in range(5000):
+            q.put(i)
+        self.assertEqual(q.qsize(), 5000)
+        for i in range(5000):
+            q.put(5000 + i)
+            self.assertEqual(q.get(), i)
+        self.assertEqual([q.get() for i in range(5000)],
+                         list(range(5000, 10000)))
+        self.assertTrue(q.empty())
+        self.assertEqual(q.unfinished_tasks, 10000)
+
+    def test_attributes(self):
+        q = self.type2test(3)
+        self.assertEqual(q.maxsize, 3)
+        self.assertEqual(q.unfinished_tasks, 0)
+        self.assertIs(q.is_shutdown, False)
+        q.put(1)
+        self.assertEqual(q.unfinished_tasks, 1)
+        q.shutdown()
+        self.assertIs(q.is_shutdown, True)
+        with self.assertRaises(AttributeError):
+            q.unfinished_tasks = 0
+        with self.assertRaises(TypeError):
+            q.maxsize = 'spam'
+        self.assertEqual(q.maxsize, 3)
+
+    def test_growing_maxsize_unblocks_put(self):
+        q = self.type2test(1)
+        q.put(1)
+        def grow():
+            q.maxsize = 2
+        self.do_blocking_test(q.put, (2,), grow, ())
+        self.assertEqual([q.get(), q.get()], [1, 2])
+
+    def test_many_threads(self):
+        # Putters outnumber the slots of a small bounded queue.
+        N = 8
+        q = self.type2test(4)
+        results = []
+        def put(start):
+            for i in range(start, start + 1000):
+                q.put(i)
+        def get():
+            while (item := q.get()) is not None:
+                results.append(item)
+                q.task_done()
+            q.task_done()
+        putters = [threading.Thread(target=put, args=(i * 1000,))
+                   for i in range(N)]
+        getters = [threading.Thread(target=get) for i in range(N)]
+        with threading_helper.start_threads(putters + getters):
+            for thread in putters:
+                thread.join()
+            q.join()
+            for thread in getters:
+                q.put(None)
+        self.assertEqual(sorted(results), list(range(N * 1000)))
+        self.assertEqual(q.qsize(), 0)
+        self.assertEqual(q.unfinished_tasks, 0)
+
+    def test_references(self):
+        # The queue should lose references to each item as soon as
+        # it leaves the queue.
+        class C:
+            pass
+
+        q = self.type2test()
+        for i in range(20):
+            q.put(C())
+        for i in range(20):
+            wr = weakref.ref(q.get())
+            gc_collect()  # For PyPy or other GCs.
+            self.assertIsNone(wr())
+        q.put(C())
+        wr = weakref.ref(q.get_nowait())
+        self.assertIsNone(wr())
+
+        items = [C() for i in range(20)]
+        wrs = [weakref.ref(item) for item in items]
+        for item in items:
+            q.put(item)
+        del items, item
+        q.shutdown(immediate=True)
+        self.assertEqual([wr() for wr in wrs], [None] * 20)
+        self.assertEqual(q.qsize(), 0)
+        self.assertEqual(q.unfinished_tasks, 21)
+
+    def test_reference_cycle(self):
+        q = self.type2test()
+        q.put(q)
+        wr = weakref.ref(q)
+        del q
+        gc_collect()
+        self.assertIsNone(wr())
+
+
 # A Queue subclass that can provoke failure at a moment's notice :)
 class FailingQueueException(Exception): pass
 
@@ -984,6 +1103,80 @@ def test_many_threads_nonblock(self):
 
         self.assertEqual(sorted(results), inputs)
 
+    def feed_many(self, q, seq, rnd, sentinel):
+        while True:
+            batch = []
+            try:
+                for i in range(rnd.randint(1, 20)):
+                    batch.append(seq.pop())
+            except IndexError:
+                q.put_many(batch + [sentinel])
+                return
+            q.put_many(batch)
+            if rnd.random() > 0.5:
+                time.sleep(rnd.random() * 1e-3)
+
+    def consume_many(self, q, results, sentinel):
+        while True:
+            batch = q.get_many(10)
+            if sentinel in batch:
+                i = batch.index(sentinel)
+                results.extend(batch[:i])
+                # Leave the items of the other feeders to other consumers
+                q.put_many(batch[i+1:])
+                return
+            results.extend(batch)
+
+    def test_put_many_get_many(self):
+        q = self.q
+        q.put_many([])
+        self.assertTrue(q.empty())
+        q.put_many(range(5))
+        q.put(5)
+        q.put_many(iter([6, 7]))
+        self.assertEqual(q.qsize(), 8)
+        self.assertEqual(q.get_many(3), [0, 1, 2])
+        self.assertEqual(q.get_many(1, block=False), [3])
+        self.assertEqual(q.get_many(10, timeout=0.1), [4, 5, 6, 7])
+        self.assertTrue(q.empty())
+
+        with self.assertRaises(self.queue.Empty):
+            q.get_many(10, block=False)
+        with self.assertRaises(self.queue.Empty):
+            q.get_many(10, timeout=1e-3)
+        with self.assertRaises(ValueError):
+            q.get_many(0)
+        with self.assertRaises(ValueError):
+            q.get_many(10, timeout=-1)
+        with self.assertRaises(TypeError):
+            q.put_many(1)
+        self.assertTrue(q.empty())
+
+        # A large batch grows the buffer at once
+        q.put_many(range(1000))
+        self.assertEqual(q.get_many(2000), list(range(1000)))
+
+    def test_put_many_wakes_up_getters(self):
+        q = self.q
+        results = []
+        def get():
+            results.append(q.get())
+        threads = [threading.Thread(target=get) for i in range(3)]
+        with threading_helper.start_threads(threads):
+            time.sleep(0.01)
+            q.put_many(range(5))
+        self.assertEqual(sorted(results + q.get_many(5)), list(range(5)))
+
+    def test_many_threads_many(self):
+        # Test multiple concurrent put_many() and get_many()
+        N = 50
+        q = self.q
+        inputs = list(range(10000))
+        results = self.run_threads(N, q, inputs,
+                                   self.feed_many, self.consume_many)
+
+        self.assertEqual(sorted(results), inputs)
+
     def test_many_threads_timeout(self):
         # Test multiple concurrent put() and get(timeout=...)
         N = 50
@@ -0,0 +1,145 @@
+"""Test suite for the _remotesampler module."""
+
+import subprocess
+import sys
+import textwrap
+import unittest
+from test.support import import_helper, requires_subprocess, SHORT_TIMEOUT
+
+_remotesampler = import_helper.import_module('_remotesampler')
+
+if sys.platform not in ('linux', 'darwin'):
+    raise unittest.SkipTest("remote sampling is only supported on Linux "
+                            "and macOS")
+
+
+BUSY_SCRIPT = textwrap.dedent("""\
+    import sys, threading
+
+    def leaf():
+        x = 0
+        while True:
+            x += 1
+
+    def outer():
+        leaf()
+
+    if len(sys.argv) > 1:
+        threading.Thread(target=outer, name="worker").start()
+    print("ready", flush=True)
+    outer()
+    """)
+
+ASYNCIO_SCRIPT = textwrap.dedent("""\
+    import asyncio
+
+    async def busy():
+        print("ready", flush=True)
+        x = 0
+        while True:
+            x += 1
+
+    async def main():
+        await asyncio.create_task(busy(), name="busy-task")
+
+    asyncio.run(main())
+    """)
+
+
+@requires_subprocess()
+class RemoteSamplerTest(unittest.TestCase):
+    def spawn(self, script, *args):
+        proc = subprocess.Popen([sys.executable, '-c', script, *args],
+                                stdout=subprocess.PIPE, text=True)
+        self.addCleanup(proc.wait, timeout=SHORT_TIMEOUT)
+        self.addCleanup(proc.stdout.close)
+        self.addCleanup(proc.kill)
+        self.assertEqual(proc.stdout.readline(), "ready\n")
+        return proc
+
+    def attach(self, proc):
+        try:
+            return _remotesampler.Sampler(proc.pid)
+        except PermissionError:
+            self.skipTest("insufficient permissions to read the memory "
+                          "of another process")
+
+    def test_sample(self):
+        proc = self.spawn(BUSY_SCRIPT)
+        sampler = self.attach(proc)
+        self.assertEqual(sampler.pid, proc.pid)
+        threads = sampler.sample()
+        self.assertEqual(len(threads), 1)
+        thread_id, task_name, frames = threads[0]
+        self.assertIsInstance(thread_id, int)
+        self.assertIsNone(task_name)
+        self.assertEqual([f[0] for f in frames], ['leaf', 'outer', '<module>'])
+        self.assertEqual({f[1] for f in frames}, {'<string>'})
+        self.assertIn(frames[0][2], (5, 6))
+        self.assertEqual(frames[1][2], 9)
+        self.assertEqual(sampler.samples, 1)
+
+    def test_threads(self):
+        proc = self.spawn(BUSY_SCRIPT, 'thread')
+        sampler = self.attach(proc)
+        threads = sampler.sample()
+        self.assertEqual(len(threads), 2)
+        self.assertEqual(len({t[0] for t in threads}), 2)
+        roots = sorted(t[2][-1][0] for t in threads)
+        self.assertEqual(roots, ['<module>', 'Thread._bootstrap'])
+
+        stacks = sampler.run(0.1, 0.01, per_thread=True)
+        self.assertEqual(len({s.split(';')[0] for s in stacks}), 2)
+        for stack in stacks:
+            self.assertTrue(stack.startswith('Thread '))
+
+    def test_run(self):
+        proc = self.spawn(BUSY_SCRIPT)
+        sampler = self.attach(proc)
+        stacks = sampler.run(0.2, interval=0.01)
+        self.assertTrue(stacks)
+        for stack, count in stacks.items():
+            self.assertGreater(count, 0)
+            frames = stack.split(';')
+            self.assertEqual(frames[0], '<module> (<string>:14)')
+            self.assertEqual(frames[1], 'outer (<string>:9)')
+            self.assertTrue(frames[2].startswith('leaf (<string>:'))
+        self.assertEqual(sampler.samples, sum(stacks.values()) + sampler.lost)
+
+    def test_asyncio_task(self):
+        proc = self.spawn(ASYNCIO_SCRIPT)
+        sampler = self.attach(proc)
+        thread_id, task_name, frames = sampler.sample()[0]
+        self.assertEqual(task_name, 'busy-task')
+        self.assertEqual(frames[0][0], 'busy')
+
+        stacks = sampler.run(0.1, 0.01)
+        self.assertTrue(stacks)
+        for stack in stacks:
+            self.assertIn(';<Task busy-task>;busy (<string>:', stack)
+
+    def test_process_exit(self):
+        proc = self.spawn(BUSY_SCRIPT)
+        sampler = self.attach(proc)
+        proc.kill()
+        proc.wait(timeout=SHORT_TIMEOUT)
+        # Sampling stops as soon as the process is gone
+        self.assertEqual(sampler.run(60.0), {})
+        with self.assertRaises(ProcessLookupError):
+            sampler.sample()
+
+    def test_invalid_arguments(self):
+        proc = self.spawn(BUSY_SCRIPT)
+        sampler = self.attach(proc)
+        self.assertRaises(ValueError, sampler.run, -1.0)
+        self.assertRaises(ValueError, sampler.run, 1.0, 0.0)
+        self.assertRaises(ValueError, sampler.run, 1.0, float('nan'))
+        self.assertRaises(OverflowError, sampler.run, 1e300)
+
+    def test_not_python(self):
+        with self.assertRaises(Exception):
+            _remotesampler.Sampler(-1)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,138 @@
+"""Test suite for the _sampleprof module."""
+
+import os
+import threading
+import time
+import unittest
+from test.support import import_helper, os_helper, threading_helper
+
+_sampleprof = import_helper.import_module('_sampleprof')
+
+
+def busy_leaf(duration):
+    deadline = time.monotonic() + duration
+    x = 0
+    while time.monotonic() < deadline:
+        for i in range(1000):
+            x += i
+    return x
+
+
+def busy_outer(duration):
+    return busy_leaf(duration)
+
+
+def recurse(depth, duration):
+    if depth:
+        return recurse(depth - 1, duration)
+    return busy_leaf(duration)
+
+
+class SampleProfTest(unittest.TestCase):
+    def setUp(self):
+        _sampleprof.clear()
+        self.addCleanup(_sampleprof.clear)
+        self.addCleanup(_sampleprof.stop)
+
+    def profile(self, func, *args, interval=0.001, **kwargs):
+        _sampleprof.start(interval, **kwargs)
+        try:
+            func(*args)
+        finally:
+            _sampleprof.stop()
+        return _sampleprof.collect()
+
+    def test_start_stop(self):
+        self.assertFalse(_sampleprof.is_running())
+        _sampleprof.start()
+        self.assertTrue(_sampleprof.is_running())
+        with self.assertRaises(RuntimeError):
+            _sampleprof.start()
+        _sampleprof.stop()
+        self.assertFalse(_sampleprof.is_running())
+        # stop() is idempotent
+        _sampleprof.stop()
+
+    def test_invalid_arguments(self):
+        self.assertRaises(ValueError, _sampleprof.start, 0.0)
+        self.assertRaises(ValueError, _sampleprof.start, -1.0)
+        self.assertRaises(ValueError, _sampleprof.start, float('nan'))
+        self.assertRaises(OverflowError, _sampleprof.start, 1e300)
+        self.assertRaises(ValueError, _sampleprof.start, max_depth=0)
+        self.assertFalse(_sampleprof.is_running())
+
+    def test_collect(self):
+        stacks = self.profile(busy_outer, 0.2)
+        self.assertTrue(stacks)
+        leaf_samples = 0
+        for stack, count in stacks.items():
+            self.assertIsInstance(stack, str)
+            self.assertGreater(count, 0)
+            frames = stack.split(';')
+            if frames[-1].startswith('busy_leaf ('):
+                self.assertTrue(frames[-2].startswith('busy_outer ('))
+                self.assertIn(__file__, frames[-1])
+                leaf_samples += count
+        self.assertGreater(leaf_samples, 0)
+
+        stats = _sampleprof.get_stats()
+        self.assertEqual(stats['samples'], sum(stacks.values()))
+        self.assertEqual(stats['lost'], 0)
+        self.assertGreater(stats['stacks'], 0)
+
+    def test_accumulate_and_clear(self):
+        self.profile(busy_outer, 0.1)
+        first = _sampleprof.get_stats()['samples']
+        self.assertGreater(first, 0)
+        self.profile(busy_outer, 0.1)
+        self.assertGreater(_sampleprof.get_stats()['samples'], first)
+        _sampleprof.clear()
+        self.assertEqual(_sampleprof.collect(), {})
+        self.assertEqual(_sampleprof.get_stats(),
+                         {'samples': 0, 'lost': 0, 'stacks': 0})
+
+    def test_max_depth(self):
+        stacks = self.profile(recurse, 50, 0.1, max_depth=5)
+        self.assertTrue(stacks)
+        for stack in stacks:
+            self.assertLessEqual(len(stack.split(';')), 5)
+
+    @threading_helper.requires_working_threading()
+    def test_all_threads(self):
+        started = threading.Barrier(2)
+
+        def worker():
+            started.wait()
+            busy_leaf(0.2)
+
+        def run():
+            t = threading.Thread(target=worker)
+            t.start()
+            started.wait()
+            busy_outer(0.2)
+            t.join()
+
+        stacks = self.profile(run, all_threads=True)
+        roots = {stack.split(';')[0].split(' ')[0] for stack in stacks}
+        self.assertIn('Thread._bootstrap', roots)
+
+    def test_dump(self):
+        self.profile(busy_outer, 0.1)
+        expected = _sampleprof.collect()
+        self.addCleanup(os_helper.unlink, os_helper.TESTFN)
+        _sampleprof.dump(os_helper.TESTFN)
+        with open(os_helper.TESTFN, encoding='utf-8') as f:
+            lines = f.read().splitlines()
+        self.assertEqual(len(lines), len(expected))
+        for line in lines:
+            stack, _, count = line.rpartition(' ')
+            self.assertEqual(expected[stack], int(count))
+
+    def test_dump_error(self):
+        path = os.path.join(os_helper.TESTFN, 'missing', 'file')
+        with self.assertRaises(OSError):
+            _sampleprof.dump(path)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -7032,6 +7032,98 @@ def close_fds(fds):
             self.assertEqual(data,  str(index).encode())
 
 
+@requireAttrs(socket.socket, "recvmmsg_into", "sendmmsg")
+class MultipleDatagramsTests(unittest.TestCase):
+
+    def setUp(self):
+        self.serv = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.addCleanup(self.serv.close)
+        self.serv.bind((HOST, 0))
+        self.serv.settimeout(support.SHORT_TIMEOUT)
+        self.cli = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.addCleanup(self.cli.close)
+        self.cli.bind((HOST, 0))
+
+    def recv_all(self, count, size=64):
+        buffers = [bytearray(size) for i in range(count)]
+        sizes = array.array('i', [0] * count)
+        addresses = []
+        received = []
+        while len(received) < count:
+            n = self.serv.recvmmsg_into(buffers, sizes, 0, addresses)
+            self.assertGreater(n, 0)
+            received.extend(bytes(buffers[i][:sizes[i]]) for i in range(n))
+        self.assertEqual(len(addresses), count)
+        return received, addresses
+
+    def testSendToAddresses(self):
+        data = [b'a', b'', b'bc', b'def' * 10]
+        addr = self.serv.getsockname()
+        self.assertEqual(self.cli.sendmmsg(data, 0, [addr] * len(data)),
+                         len(data))
+        received, addresses = self.recv_all(len(data))
+        self.assertEqual(received, data)
+        self.assertEqual(addresses, [self.cli.getsockname()] * len(data))
+
+    def testSendConnected(self):
+        self.cli.connect(self.serv.getsockname())
+        data = [memoryview(b'xyz'), bytearray(b'uv'), b'w']
+        self.assertEqual(self.cli.sendmmsg(data), 3)
+        self.assertEqual(self.cli.sendmmsg(iter([b'last'])), 1)
+        self.assertEqual(self.cli.sendmmsg([]), 0)
+        received, addresses = self.recv_all(4)
+        self.assertEqual(received, [b'xyz', b'uv', b'w', b'last'])
+
+    def testRecvWaitsForOne(self):
+        # Like recv(), return as soon as a datagram is received.
+        self.cli.sendto(b'one', self.serv.getsockname())
+        buffers = [bytearray(8) for i in range(4)]
+        sizes = array.array('i', [-1] * 4)
+        self.assertEqual(self.serv.recvmmsg_into(buffers, sizes), 1)
+        self.assertEqual(sizes.tolist(), [3, -1, -1, -1])
+        self.assertEqual(buffers[0][:3], b'one')
+
+    def testRecvNonBlocking(self):
+        self.serv.setblocking(False)
+        buffers = [bytearray(8)]
+        sizes = array.array('i', [0])
+        self.assertRaises(BlockingIOError,
+                          self.serv.recvmmsg_into, buffers, sizes)
+
+    def testRecvTimeout(self):
+        self.serv.settimeout(0.01)
+        self.assertRaises(TimeoutError, self.serv.recvmmsg_into,
+                          [bytearray(8)], array.array('i', [0]))
+
+    def testBadArguments(self):
+        addr = self.serv.getsockname()
+        sizes = array.array('i', [0] * 2)
+        self.assertRaises(ValueError, self.serv.recvmmsg_into,
+                          [bytearray(8)] * 3, sizes)
+        self.assertRaises(TypeError, self.serv.recvmmsg_into,
+                          [b'readonly'], sizes)
+        self.assertRaises(TypeError, self.serv.recvmmsg_into,
+                          [bytearray(8)], b'readonly')
+        self.assertRaises(TypeError, self.serv.recvmmsg_into, 1, sizes)
+        self.assertRaises(ValueError, self.serv.recvmmsg_into,
+                          [bytearray(1)] * 2000, array.array('i', [0] * 2000))
+        self.assertRaises(TypeError, self.cli.sendmmsg, ['str'], 0, [addr])
+        self.assertRaises(TypeError, self.cli.sendmmsg, [b'x'], 0, [None])
+        self.assertRaises(ValueError, self.cli.sendmmsg, [b'x'], 0,
+                          [addr, addr])
+        self.assertRaises(ValueError, self.cli.sendmmsg, [b'x'] * 2000, 0,
+                          [addr] * 2000)
+        self.assertRaises(TypeError, self.cli.sendmmsg, 1)
+        self.assertRaises(OSError, self.cli.sendmmsg, [b'x'])
+
+    def testClosed(self):
+        self.serv.close()
+        self.assertRaises(OSError, self.serv.recvmmsg_into,
+                          [bytearray(8)], array.array('i', [0]))
+        self.cli.close()
+        self.assertRaises(OSError, self.cli.sendmmsg, [b'x'])
+
+
 def setUpModule():
     thread_info = threading_helper.threading_setup()
     unittest.addModuleCleanup(threading_helper.threading_cleanup, *thread_info)
@@ -1270,6 +1270,144 @@ def test_pystats(self):
         sys._stats_clear()
         sys._stats_dump()
 
+    @test.support.cpython_only
+    @test.support.requires_specialization
+    @threading_helper.requires_working_threading()
+    def test_exec_stats(self):
+        import threading
+
+        def add(n):
+            total = 0
+            for i in range(n):
+                total += i
+            return total
+
+        def worker():
+            add(1000)
+
+        sys._exec_stats_clear()
+        self.addCleanup(sys._exec_stats_clear)
+        self.addCleanup(sys._exec_stats_off)
+        add(1000)
+        stats = sys._get_exec_stats()
+        self.assertEqual(stats['opcode[BINARY_OP].specializable'], 1)
+        self.assertNotIn('opcode[BINARY_OP].specialization.hit', stats)
+
+        sys._exec_stats_on()
+        add(1000)
+        first = sys._get_exec_stats()['opcode[BINARY_OP].specialization.hit']
+        self.assertGreaterEqual(first, 999)
+        # Counters of threads are kept after they exit
+        t = threading.Thread(target=worker)
+        t.start()
+        t.join()
+        sys._exec_stats_off()
+        add(1000)
+        stats = sys._get_exec_stats()
+        self.assertGreaterEqual(stats['opcode[BINARY_OP].specialization.hit'],
+                                first + 999)
+        self.assertIn('Optimization attempts', stats)
+
+        sys._exec_stats_clear()
+        stats = sys._get_exec_stats()
+        self.assertNotIn('opcode[BINARY_OP].specialization.hit', stats)
+        self.assertEqual(stats['Optimization attempts'], 0)
+
+    @test.support.cpython_only
+    @threading_helper.requires_working_threading()
+    def test_datastack_stats(self):
+        import threading
+
+        def recurse(n):
+            return recurse(n - 1) if n else sys._get_datastack_stats()
+
+        def worker():
+            # Use a new thread to start with an empty data stack
+            results.append(sys._get_datastack_stats())
+            for i in range(10):
+                deepest = recurse(800)
+            results.append(deepest)
+            for i in range(100):
+                recurse(800)
+            results.append(sys._get_datastack_stats())
+
+        results = []
+        t = threading.Thread(target=worker)
+        t.start()
+        t.join()
+        start, warm, end = results
+        self.assertEqual(start['allocated'], 1)
+        self.assertEqual(start['spare'], 0)
+        self.assertGreater(warm['allocated'], start['allocated'])
+        self.assertGreaterEqual(warm['chunk_size'], start['chunk_size'])
+        # Once the chunks are large enough, going deep again and again
+        # reuses the spare chunks instead of allocating.
+        self.assertEqual(end['allocated'], warm['allocated'])
+        self.assertEqual(end['freed'], warm['freed'])
+        self.assertGreater(end['reused'], warm['reused'])
+        self.assertGreater(end['spare'], 0)
+        self.assertLessEqual(end['spare'], 2)
+
+    @test.support.cpython_only
+    @threading_helper.requires_working_threading()
+    def test_lock_contention(self):
+        import threading
+        import time
+
+        def spin(items):
+            deadline = time.monotonic() + 0.2
+            while time.monotonic() < deadline:
+                items.append(1)
+                items.pop()
+
+        def run_threads():
+            items = []
+            threads = [threading.Thread(target=spin, args=(items,))
+                       for i in range(4)]
+            with threading_helper.start_threads(threads):
+                pass
+
+        sys._lock_contention_clear()
+        self.addCleanup(sys._lock_contention_clear)
+        self.addCleanup(sys._lock_contention_off)
+        self.addCleanup(sys.setswitchinterval, sys.getswitchinterval())
+        sys.setswitchinterval(1e-6)
+        run_threads()
+        self.assertEqual(sys._get_lock_contention(),
+                         {'sites': [], 'dropped': 0})
+
+        sys._lock_contention_on()
+        run_threads()
+        sys._lock_contention_off()
+        profile = sys._get_lock_contention()
+        self.assertEqual(profile['dropped'], 0)
+        sites = profile['sites']
+        for site in sites:
+            self.assertIn(site['kind'], ('mutex', 'critical_section', 'gil'))
+            self.assertIsInstance(site['lock'], int)
+            self.assertEqual(sum(site['histogram']), site['count'])
+            self.assertLessEqual(site['max_ns'], site['total_ns'])
+            for frame in site['waiter'] + site['holder']:
+                filename, lineno, qualname = frame
+                self.assertIsInstance(filename, str)
+                self.assertIsInstance(lineno, int)
+                self.assertIsInstance(qualname, str)
+        totals = [site['total_ns'] for site in sites]
+        self.assertEqual(totals, sorted(totals, reverse=True))
+        if sys._is_gil_enabled():
+            # The threads exited: their waits are kept.
+            gil, = [site for site in sites if site['kind'] == 'gil']
+            self.assertGreater(gil['count'], 0)
+            self.assertIsNone(gil['type'])
+            self.assertTrue(gil['waiter'])
+        # Nothing is recorded when the profile is off
+        run_threads()
+        self.assertEqual(sys._get_lock_contention(), profile)
+
+        sys._lock_contention_clear()
+        self.assertEqual(sys._get_lock_contention(),
+                         {'sites': [], 'dropped': 0})
+
     @test.support.cpython_only
     @unittest.skipUnless(hasattr(sys, 'abiflags'), 'need sys.abiflags')
     def test_disable_gil_abi(self):
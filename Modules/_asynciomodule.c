@@ -9,6 +9,7 @@
 #include "pycore_modsupport.h"    // _PyArg_CheckPositional()
 #include "pycore_moduleobject.h"  // _PyModule_GetState()
 #include "pycore_object.h"        // _Py_SetImmortalUntracked
+#include "pycore_pyatomic_ft_wrappers.h" // FT_ATOMIC_LOAD_SSIZE_RELAXED()
 #include "pycore_pyerrors.h"      // _PyErr_ClearExcState()
 #include "pycore_pylifecycle.h"   // _Py_IsInterpreterFinalizing()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
@@ -16,6 +17,14 @@
 
 #include <stddef.h>               // offsetof()
 
+#ifdef HAVE_SYS_EPOLL_H
+#  include <sys/epoll.h>          // epoll_wait()
+#endif
+
+#if defined(__APPLE__)
+#  include <mach-o/loader.h>
+#endif
+
 
 /*[clinic input]
 module _asyncio
@@ -64,12 +73,89 @@ typedef struct TaskObj {
     struct TaskObj *prev;
 } TaskObj;
 
+/* Place the offsets of the task fields in a named data section, so that
+   out of process debuggers can find them (see _Py_DebugOffsets).  It is
+   read by Modules/_remotesampler.c. */
+#if defined(MS_WINDOWS)
+
+#pragma section("AsyncioDebug", read, write)
+__declspec(allocate("AsyncioDebug"))
+
+#elif defined(__APPLE__)
+
+__attribute__((
+    section(SEG_DATA ",AsyncioDebug")
+))
+
+#endif
+
+_Py_AsyncioModuleDebugOffsets _AsyncioDebug
+#if defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+__attribute__ ((section (".AsyncioDebug")))
+#endif
+= {
+    .asyncio_task_object = {
+        .size = sizeof(TaskObj),
+        .task_name = offsetof(TaskObj, task_name),
+        .task_coro = offsetof(TaskObj, task_coro),
+    },
+    .asyncio_thread_state = {
+        .size = sizeof(_PyThreadStateImpl),
+        .asyncio_running_loop = offsetof(_PyThreadStateImpl, asyncio_running_loop),
+        .asyncio_running_task = offsetof(_PyThreadStateImpl, asyncio_running_task),
+    },
+};
+
 typedef struct {
     PyObject_HEAD
     TaskObj *sw_task;
     PyObject *sw_arg;
 } TaskStepMethWrapper;
 
+typedef struct {
+    double when;
+    PyObject *handle;
+} TimerEntry;
+
+/* Kinds of the entries of the ready queue */
+enum {
+    READY_HANDLE,       // cb is an events.Handle
+    READY_CALL,         // cb(arg) or cb() in the context ctx
+    READY_TASK_STEP,    // step of the task cb with the exception arg
+};
+
+typedef struct {
+    PyObject *cb;
+    PyObject *arg;      // NULL if there is no argument
+    PyObject *ctx;      // NULL for READY_HANDLE
+    int kind;
+} ReadyEntry;
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *lc_loop;
+    PyObject *lc_fd_to_key;     // fd-to-key dict of an epoll selector
+    int lc_epoll_fd;            // -1 if the selector is not epoll
+    void *lc_epoll_events;      // struct epoll_event array, reused
+    Py_ssize_t lc_epoll_size;
+    double lc_clock_resolution;
+
+    /* Ready callbacks, in a ring buffer whose size is a power of 2.
+       Callbacks scheduled from C by futures and tasks are stored without
+       creating a Handle, if lc_native_callbacks is set. */
+    ReadyEntry *lc_ready;
+    Py_ssize_t lc_ready_head;
+    Py_ssize_t lc_ready_len;
+    Py_ssize_t lc_ready_size;
+    char lc_native_callbacks;
+
+    /* Timer handles, in a binary heap ordered by their 'when' */
+    TimerEntry *lc_timers;
+    Py_ssize_t lc_ntimers;
+    Py_ssize_t lc_timers_size;
+    Py_ssize_t lc_timer_cancelled_count;
+} LoopCoreObj;
+
 
 #define Future_CheckExact(state, obj) Py_IS_TYPE(obj, state->FutureType)
 #define Task_CheckExact(state, obj) Py_IS_TYPE(obj, state->TaskType)
@@ -96,6 +182,7 @@ typedef struct {
     PyTypeObject *TaskStepMethWrapper_Type;
     PyTypeObject *FutureType;
     PyTypeObject *TaskType;
+    PyTypeObject *LoopCoreType;
 
     PyObject *asyncio_mod;
     PyObject *context_kwname;
@@ -116,6 +203,7 @@ typedef struct {
 
     /* Imports from asyncio.events. */
     PyObject *asyncio_get_event_loop_policy;
+    PyObject *asyncio_events_Handle;
 
     /* Imports from asyncio.base_futures. */
     PyObject *asyncio_future_repr_func;
@@ -339,12 +427,21 @@ get_event_loop(asyncio_state *state)
 }
 
 
+static int loop_core_call_soon(asyncio_state *state, PyObject *loop,
+                               int kind, PyObject *cb, PyObject *arg,
+                               PyObject *ctx);
+
 static int
 call_soon(asyncio_state *state, PyObject *loop, PyObject *func, PyObject *arg,
           PyObject *ctx)
 {
     PyObject *handle;
 
+    int res = loop_core_call_soon(state, loop, READY_CALL, func, arg, ctx);
+    if (res != 0) {
+        return res < 0 ? -1 : 0;
+    }
+
     if (ctx == NULL) {
         PyObject *stack[] = {loop, func, arg};
         size_t nargsf = 3 | PY_VECTORCALL_ARGUMENTS_OFFSET;
@@ -1974,6 +2071,18 @@ unregister_eager_task(asyncio_state *state, PyObject *task)
     return PySet_Discard(state->eager_tasks, task);
 }
 
+// Remember the task run by the current thread, for out of process
+// debuggers.  Only instances of _asyncio.Task have a known layout.
+static void
+set_running_task(asyncio_state *state, PyObject *task)
+{
+    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
+    if (task != NULL && !Task_Check(state, task)) {
+        task = NULL;
+    }
+    Py_XSETREF(ts->asyncio_running_task, Py_XNewRef(task));
+}
+
 static int
 enter_task(asyncio_state *state, PyObject *loop, PyObject *task)
 {
@@ -1992,6 +2101,7 @@ enter_task(asyncio_state *state, PyObject *loop, PyObject *task)
         return -1;
     }
     Py_DECREF(item);
+    set_running_task(state, task);
     return 0;
 }
 
@@ -2024,6 +2134,9 @@ leave_task(asyncio_state *state, PyObject *loop, PyObject *task)
         // task was not found
         return err_leave_task(Py_None, task);
     }
+    if (res > 0) {
+        set_running_task(state, NULL);
+    }
     return res;
 }
 
@@ -2054,6 +2167,7 @@ swap_current_task(asyncio_state *state, PyObject *loop, PyObject *task)
         if (PyDict_Pop(state->current_tasks, loop, &prev_task) < 0) {
             return NULL;
         }
+        set_running_task(state, NULL);
         if (prev_task == NULL) {
             Py_RETURN_NONE;
         }
@@ -2069,6 +2183,9 @@ swap_current_task(asyncio_state *state, PyObject *loop, PyObject *task)
     Py_BEGIN_CRITICAL_SECTION(current_tasks);
     prev_task = swap_current_task_lock_held(current_tasks, loop, hash, task);
     Py_END_CRITICAL_SECTION();
+    if (prev_task != NULL) {
+        set_running_task(state, task);
+    }
     return prev_task;
 }
 
@@ -2729,6 +2846,12 @@ TaskObj_dealloc(PyObject *self)
 static int
 task_call_step_soon(asyncio_state *state, TaskObj *task, PyObject *arg)
 {
+    int res = loop_core_call_soon(state, task->task_loop, READY_TASK_STEP,
+                                  (PyObject *)task, arg, task->task_context);
+    if (res != 0) {
+        return res < 0 ? -1 : 0;
+    }
+
     PyObject *cb = TaskStepMethWrapper_new(task, arg);
     if (cb == NULL) {
         return -1;
@@ -3579,6 +3702,991 @@ add_one_task(asyncio_state *state, PyObject *tasks, PyObject *task, PyObject *lo
     return 0;
 }
 
+/*********************** Event loop core **************************/
+
+/* The core of asyncio.FastSelectorEventLoop: the queue of ready handles,
+   the heap of timer handles and the dispatch of selector events, which
+   BaseEventLoop._run_once() implements in Python with a deque, heapq and
+   the selectors module.  The handles are the usual events.Handle and
+   events.TimerHandle objects, so cancelling them and the rest of the loop
+   work unchanged.
+
+   When the selector of the loop is a selectors.EpollSelector, epoll_wait()
+   is called directly on its file descriptor and the keys are looked up in
+   its fd-to-key dictionary, without creating the lists of events. */
+
+/*[clinic input]
+class _asyncio._LoopCore "LoopCoreObj *" "clinic_state()->LoopCoreType"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=21401723593c8383]*/
+
+// Same values as in Lib/asyncio/base_events.py and Lib/selectors.py
+#define MAXIMUM_SELECT_TIMEOUT (24.0 * 3600)
+#define MIN_SCHEDULED_TIMER_HANDLES 100
+#define SELECTOR_EVENT_READ 1
+#define SELECTOR_EVENT_WRITE 2
+
+#ifdef Py_GIL_DISABLED
+#   define LOOP_CORE_LOCK(self) Py_BEGIN_CRITICAL_SECTION(self)
+#   define LOOP_CORE_UNLOCK(self) Py_END_CRITICAL_SECTION()
+#else
+#   define LOOP_CORE_LOCK(self) ((void)self)
+#   define LOOP_CORE_UNLOCK(self) ((void)self)
+#endif
+
+static int
+loop_core_ready_push(LoopCoreObj *self, int kind, PyObject *cb,
+                     PyObject *arg, PyObject *ctx)
+{
+    if (self->lc_ready_len == self->lc_ready_size) {
+        Py_ssize_t size = self->lc_ready_size ? self->lc_ready_size * 2 : 16;
+        ReadyEntry *items = PyMem_New(ReadyEntry, size);
+        if (items == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        for (Py_ssize_t i = 0; i < self->lc_ready_len; i++) {
+            items[i] = self->lc_ready[(self->lc_ready_head + i) &
+                                      (self->lc_ready_size - 1)];
+        }
+        PyMem_Free(self->lc_ready);
+        self->lc_ready = items;
+        self->lc_ready_head = 0;
+        self->lc_ready_size = size;
+    }
+    Py_ssize_t pos = ((self->lc_ready_head + self->lc_ready_len) &
+                      (self->lc_ready_size - 1));
+    ReadyEntry *entry = &self->lc_ready[pos];
+    entry->kind = kind;
+    entry->cb = Py_NewRef(cb);
+    entry->arg = Py_XNewRef(arg);
+    entry->ctx = Py_XNewRef(ctx);
+    self->lc_ready_len++;
+    return 0;
+}
+
+/* Move the first entry to *entry and return 1, or return 0 if empty. */
+static int
+loop_core_ready_pop(LoopCoreObj *self, ReadyEntry *entry)
+{
+    if (self->lc_ready_len == 0) {
+        return 0;
+    }
+    *entry = self->lc_ready[self->lc_ready_head];
+    self->lc_ready_head = (self->lc_ready_head + 1) & (self->lc_ready_size - 1);
+    self->lc_ready_len--;
+    return 1;
+}
+
+static void
+ready_entry_clear(ReadyEntry *entry)
+{
+    Py_CLEAR(entry->cb);
+    Py_CLEAR(entry->arg);
+    Py_CLEAR(entry->ctx);
+}
+
+static void
+loop_core_timers_up(LoopCoreObj *self, Py_ssize_t pos)
+{
+    TimerEntry *heap = self->lc_timers;
+    TimerEntry item = heap[pos];
+    while (pos > 0) {
+        Py_ssize_t parent = (pos - 1) >> 1;
+        if (item.when >= heap[parent].when) {
+            break;
+        }
+        heap[pos] = heap[parent];
+        pos = parent;
+    }
+    heap[pos] = item;
+}
+
+static void
+loop_core_timers_down(LoopCoreObj *self, Py_ssize_t pos)
+{
+    TimerEntry *heap = self->lc_timers;
+    Py_ssize_t n = self->lc_ntimers;
+    TimerEntry item = heap[pos];
+    for (;;) {
+        Py_ssize_t child = 2 * pos + 1;
+        if (child >= n) {
+            break;
+        }
+        if (child + 1 < n && heap[child + 1].when < heap[child].when) {
+            child++;
+        }
+        if (item.when <= heap[child].when) {
+            break;
+        }
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = item;
+}
+
+static int
+loop_core_timers_push(LoopCoreObj *self, double when, PyObject *handle)
+{
+    if (self->lc_ntimers == self->lc_timers_size) {
+        Py_ssize_t size = self->lc_timers_size ? self->lc_timers_size * 2 : 16;
+        TimerEntry *timers = PyMem_Resize(self->lc_timers, TimerEntry, size);
+        if (timers == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->lc_timers = timers;
+        self->lc_timers_size = size;
+    }
+    self->lc_timers[self->lc_ntimers].when = when;
+    self->lc_timers[self->lc_ntimers].handle = Py_NewRef(handle);
+    loop_core_timers_up(self, self->lc_ntimers++);
+    return 0;
+}
+
+/* Return a new reference to the earliest timer, which must exist. */
+static PyObject *
+loop_core_timers_pop(LoopCoreObj *self)
+{
+    assert(self->lc_ntimers > 0);
+    PyObject *handle = self->lc_timers[0].handle;
+    if (--self->lc_ntimers > 0) {
+        self->lc_timers[0] = self->lc_timers[self->lc_ntimers];
+        loop_core_timers_down(self, 0);
+    }
+    return handle;
+}
+
+static void
+loop_core_clear_ready(LoopCoreObj *self)
+{
+    ReadyEntry entry;
+    while (loop_core_ready_pop(self, &entry)) {
+        ready_entry_clear(&entry);
+    }
+}
+
+static void
+loop_core_clear_timers(LoopCoreObj *self)
+{
+    while (self->lc_ntimers > 0) {
+        Py_DECREF(loop_core_timers_pop(self));
+    }
+    self->lc_timer_cancelled_count = 0;
+}
+
+static int
+handle_is_cancelled(PyObject *handle)
+{
+    PyObject *cancelled = PyObject_GetAttr(handle, &_Py_ID(_cancelled));
+    if (cancelled == NULL) {
+        return -1;
+    }
+    int res = PyObject_IsTrue(cancelled);
+    Py_DECREF(cancelled);
+    return res;
+}
+
+static int
+loop_get_time(PyObject *loop, double *now)
+{
+    PyObject *res = PyObject_CallMethodNoArgs(loop, &_Py_ID(time));
+    if (res == NULL) {
+        return -1;
+    }
+    *now = PyFloat_AsDouble(res);
+    Py_DECREF(res);
+    if (*now == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+    return 0;
+}
+
+/* Return a new reference to an events.Handle running the entry. */
+static PyObject *
+ready_entry_as_handle(asyncio_state *state, LoopCoreObj *self,
+                      ReadyEntry *entry)
+{
+    if (entry->kind == READY_HANDLE) {
+        return Py_NewRef(entry->cb);
+    }
+    PyObject *cb, *args;
+    if (entry->kind == READY_TASK_STEP) {
+        cb = TaskStepMethWrapper_new((TaskObj *)entry->cb, entry->arg);
+        if (cb == NULL) {
+            return NULL;
+        }
+        args = PyTuple_New(0);
+    }
+    else {
+        cb = Py_NewRef(entry->cb);
+        args = entry->arg ? PyTuple_Pack(1, entry->arg) : PyTuple_New(0);
+    }
+    if (args == NULL) {
+        Py_DECREF(cb);
+        return NULL;
+    }
+    PyObject *handle = PyObject_CallFunctionObjArgs(
+        state->asyncio_events_Handle, cb, args, self->lc_loop, entry->ctx,
+        NULL);
+    Py_DECREF(cb);
+    Py_DECREF(args);
+    return handle;
+}
+
+/* Run a callback which was scheduled without a Handle.  Like Handle._run(),
+   report its exception to the exception handler of the loop. */
+static int
+loop_core_run_native(asyncio_state *state, LoopCoreObj *self,
+                     ReadyEntry *entry)
+{
+    PyObject *res = NULL;
+    if (PyContext_Enter(entry->ctx) == 0) {
+        if (entry->kind == READY_TASK_STEP) {
+            res = task_step(state, (TaskObj *)entry->cb, entry->arg);
+        }
+        else if (entry->arg != NULL) {
+            res = PyObject_CallOneArg(entry->cb, entry->arg);
+        }
+        else {
+            res = PyObject_CallNoArgs(entry->cb);
+        }
+        if (PyContext_Exit(entry->ctx) < 0) {
+            Py_CLEAR(res);
+        }
+    }
+    if (res != NULL) {
+        Py_DECREF(res);
+        return 0;
+    }
+    if (PyErr_ExceptionMatches(PyExc_SystemExit) ||
+        PyErr_ExceptionMatches(PyExc_KeyboardInterrupt))
+    {
+        return -1;
+    }
+    PyObject *exc = PyErr_GetRaisedException();
+    PyObject *handle = ready_entry_as_handle(state, self, entry);
+    if (handle == NULL) {
+        Py_DECREF(exc);
+        return -1;
+    }
+    res = PyObject_CallMethodOneArg(handle, &_Py_ID(_report_exception), exc);
+    Py_DECREF(handle);
+    Py_DECREF(exc);
+    if (res == NULL) {
+        return -1;
+    }
+    Py_DECREF(res);
+    return 0;
+}
+
+/* Schedule a callback of a future or a task on a FastSelectorEventLoop
+   without creating a Handle.  Return 1 if it was scheduled, 0 if the loop
+   does not support it, or -1 with an exception set. */
+static int
+loop_core_call_soon(asyncio_state *state, PyObject *loop, int kind,
+                    PyObject *cb, PyObject *arg, PyObject *ctx)
+{
+    PyObject *ready;
+    if (PyObject_GetOptionalAttr(loop, &_Py_ID(_ready), &ready) < 0) {
+        return -1;
+    }
+    if (ready == NULL) {
+        return 0;
+    }
+    if (!Py_IS_TYPE(ready, state->LoopCoreType) ||
+        ((LoopCoreObj *)ready)->lc_loop != loop)
+    {
+        Py_DECREF(ready);
+        return 0;
+    }
+    LoopCoreObj *self = (LoopCoreObj *)ready;
+    if (ctx == NULL) {
+        ctx = PyContext_CopyCurrent();
+        if (ctx == NULL) {
+            Py_DECREF(ready);
+            return -1;
+        }
+    }
+    else {
+        Py_INCREF(ctx);
+    }
+    int res = 0;
+    LOOP_CORE_LOCK(self);
+    if (self->lc_native_callbacks) {
+        res = loop_core_ready_push(self, kind, cb, arg, ctx) < 0 ? -1 : 1;
+    }
+    LOOP_CORE_UNLOCK(self);
+    Py_DECREF(ctx);
+    Py_DECREF(ready);
+    return res;
+}
+
+/* Drop the cancelled timers, all of them if they are more than half of the
+   timers, else those at the head of the heap. */
+static int
+loop_core_remove_cancelled_timers(LoopCoreObj *self)
+{
+    if (self->lc_ntimers > MIN_SCHEDULED_TIMER_HANDLES &&
+        self->lc_timer_cancelled_count * 2 > self->lc_ntimers)
+    {
+        PyObject *removed = PyList_New(0);
+        if (removed == NULL) {
+            return -1;
+        }
+        int err = 0;
+        LOOP_CORE_LOCK(self);
+        Py_ssize_t n = 0;
+        for (Py_ssize_t i = 0; i < self->lc_ntimers; i++) {
+            TimerEntry entry = self->lc_timers[i];
+            int cancelled = err ? 0 : handle_is_cancelled(entry.handle);
+            if (cancelled < 0) {
+                err = 1;
+                cancelled = 0;
+            }
+            if (cancelled) {
+                if (PyList_Append(removed, entry.handle) < 0) {
+                    err = 1;
+                }
+                Py_DECREF(entry.handle);
+            }
+            else {
+                self->lc_timers[n++] = entry;
+            }
+        }
+        self->lc_ntimers = n;
+        for (Py_ssize_t i = n / 2 - 1; i >= 0; i--) {
+            loop_core_timers_down(self, i);
+        }
+        self->lc_timer_cancelled_count = 0;
+        LOOP_CORE_UNLOCK(self);
+        for (Py_ssize_t i = 0; !err && i < PyList_GET_SIZE(removed); i++) {
+            if (PyObject_SetAttr(PyList_GET_ITEM(removed, i),
+                                 &_Py_ID(_scheduled), Py_False) < 0)
+            {
+                err = 1;
+            }
+        }
+        Py_DECREF(removed);
+        return err ? -1 : 0;
+    }
+
+    for (;;) {
+        PyObject *handle = NULL;
+        int cancelled = 0;
+        LOOP_CORE_LOCK(self);
+        if (self->lc_ntimers > 0) {
+            cancelled = handle_is_cancelled(self->lc_timers[0].handle);
+            if (cancelled > 0) {
+                self->lc_timer_cancelled_count--;
+                handle = loop_core_timers_pop(self);
+            }
+        }
+        LOOP_CORE_UNLOCK(self);
+        if (cancelled < 0) {
+            return -1;
+        }
+        if (handle == NULL) {
+            return 0;
+        }
+        int res = PyObject_SetAttr(handle, &_Py_ID(_scheduled), Py_False);
+        Py_DECREF(handle);
+        if (res < 0) {
+            return -1;
+        }
+    }
+}
+
+/* Queue the reader or the writer of a ready file, or unregister it if
+   the handle was cancelled, like BaseSelectorEventLoop._process_events(). */
+static int
+loop_core_process_key(LoopCoreObj *self, PyObject *key, long mask)
+{
+    // key is a selectors.SelectorKey: (fileobj, fd, events, data)
+    if (!PyTuple_Check(key) || PyTuple_GET_SIZE(key) != 4 ||
+        !PyTuple_Check(PyTuple_GET_ITEM(key, 3)) ||
+        PyTuple_GET_SIZE(PyTuple_GET_ITEM(key, 3)) != 2)
+    {
+        PyErr_Format(PyExc_TypeError, "invalid selector key: %R", key);
+        return -1;
+    }
+    long events = PyLong_AsLong(PyTuple_GET_ITEM(key, 2));
+    if (events == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    mask &= events;
+    PyObject *fileobj = PyTuple_GET_ITEM(key, 0);
+    PyObject *data = PyTuple_GET_ITEM(key, 3);
+    for (int i = 0; i < 2; i++) {
+        PyObject *handle = PyTuple_GET_ITEM(data, i);
+        if (handle == Py_None ||
+            !(mask & (i == 0 ? SELECTOR_EVENT_READ : SELECTOR_EVENT_WRITE)))
+        {
+            continue;
+        }
+        int cancelled = handle_is_cancelled(handle);
+        if (cancelled < 0) {
+            return -1;
+        }
+        if (cancelled) {
+            PyObject *res = PyObject_CallMethodOneArg(
+                self->lc_loop,
+                i == 0 ? &_Py_ID(_remove_reader) : &_Py_ID(_remove_writer),
+                fileobj);
+            if (res == NULL) {
+                return -1;
+            }
+            Py_DECREF(res);
+            continue;
+        }
+        int res;
+        LOOP_CORE_LOCK(self);
+        res = loop_core_ready_push(self, READY_HANDLE, handle, NULL, NULL);
+        LOOP_CORE_UNLOCK(self);
+        if (res < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+#ifdef HAVE_EPOLL
+static void
+loop_core_release_epoll_events(LoopCoreObj *self, struct epoll_event *evs,
+                               Py_ssize_t size)
+{
+    if (self->lc_epoll_events == NULL) {
+        self->lc_epoll_events = evs;
+        self->lc_epoll_size = size;
+    }
+    else {
+        PyMem_Free(evs);
+    }
+}
+
+static int
+loop_core_epoll(LoopCoreObj *self, double timeout)
+{
+    int ms;
+    if (timeout < 0) {
+        ms = -1;
+    }
+    else {
+        // epoll_wait() has a resolution of 1 millisecond, round away
+        // from zero to wait *at least* timeout seconds.
+        ms = (int)ceil(timeout * 1e3);
+    }
+    Py_ssize_t maxevents = PyDict_GET_SIZE(self->lc_fd_to_key);
+    if (maxevents == 0) {
+        maxevents = 1;
+    }
+    else if (maxevents > INT_MAX) {
+        maxevents = INT_MAX;
+    }
+    // Take the buffer, in case a callback runs the loop recursively
+    struct epoll_event *evs = self->lc_epoll_events;
+    if (evs == NULL || self->lc_epoll_size < maxevents) {
+        PyMem_Free(evs);
+        self->lc_epoll_size = 0;
+        evs = PyMem_New(struct epoll_event, maxevents);
+        if (evs == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    else {
+        maxevents = self->lc_epoll_size;
+    }
+    self->lc_epoll_events = NULL;
+    int n;
+    Py_BEGIN_ALLOW_THREADS
+    n = epoll_wait(self->lc_epoll_fd, evs, (int)maxevents, ms);
+    Py_END_ALLOW_THREADS
+    if (n < 0) {
+        int saved_errno = errno;
+        loop_core_release_epoll_events(self, evs, maxevents);
+        errno = saved_errno;
+        if (errno == EINTR) {
+            // Like selectors: return no event, after running the signal
+            // handlers
+            return PyErr_CheckSignals();
+        }
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+    int err = 0;
+    for (int i = 0; i < n && !err; i++) {
+        PyObject *fd = PyLong_FromLong(evs[i].data.fd);
+        if (fd == NULL) {
+            err = 1;
+            break;
+        }
+        PyObject *key;
+        int found = PyDict_GetItemRef(self->lc_fd_to_key, fd, &key);
+        Py_DECREF(fd);
+        if (found <= 0) {
+            err = found < 0;
+            continue;
+        }
+        uint32_t event = evs[i].events;
+        long mask = (((event & ~EPOLLIN) ? SELECTOR_EVENT_WRITE : 0) |
+                     ((event & ~EPOLLOUT) ? SELECTOR_EVENT_READ : 0));
+        err = loop_core_process_key(self, key, mask) < 0;
+        Py_DECREF(key);
+    }
+    loop_core_release_epoll_events(self, evs, maxevents);
+    return err ? -1 : 0;
+}
+#endif
+
+static int
+loop_core_select(LoopCoreObj *self, double timeout)
+{
+    PyObject *selector = PyObject_GetAttr(self->lc_loop, &_Py_ID(_selector));
+    if (selector == NULL) {
+        return -1;
+    }
+    PyObject *arg = timeout < 0 ? Py_None : PyFloat_FromDouble(timeout);
+    if (arg == NULL) {
+        Py_DECREF(selector);
+        return -1;
+    }
+    PyObject *event_list = PyObject_CallMethodOneArg(selector,
+                                                     &_Py_ID(select), arg);
+    Py_DECREF(arg);
+    Py_DECREF(selector);
+    if (event_list == NULL) {
+        return -1;
+    }
+    PyObject *seq = PySequence_Fast(event_list, "select() must return a list");
+    Py_DECREF(event_list);
+    if (seq == NULL) {
+        return -1;
+    }
+    int err = 0;
+    for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq) && !err; i++) {
+        PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+        if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+            PyErr_SetString(PyExc_TypeError,
+                            "select() must return (key, events) tuples");
+            err = 1;
+            break;
+        }
+        long mask = PyLong_AsLong(PyTuple_GET_ITEM(item, 1));
+        if (mask == -1 && PyErr_Occurred()) {
+            err = 1;
+            break;
+        }
+        err = loop_core_process_key(self, PyTuple_GET_ITEM(item, 0), mask) < 0;
+    }
+    Py_DECREF(seq);
+    return err ? -1 : 0;
+}
+
+/*[clinic input]
+_asyncio._LoopCore.__init__
+
+    loop: object
+    epoll_fd: int = -1
+    fd_to_key: object(subclass_of='&PyDict_Type') = NULL
+
+The ready queue, timers and I/O dispatch of an event loop.
+
+If epoll_fd is given, it must be the file descriptor of the
+selectors.EpollSelector of the loop, and fd_to_key its dictionary of keys.
+[clinic start generated code]*/
+
+static int
+_asyncio__LoopCore___init___impl(LoopCoreObj *self, PyObject *loop,
+                                 int epoll_fd, PyObject *fd_to_key)
+/*[clinic end generated code: output=fec28b3b8a2f6f32 input=59629f93d863ecfe]*/
+{
+#ifndef HAVE_EPOLL
+    if (epoll_fd >= 0) {
+        PyErr_SetString(PyExc_ValueError, "epoll is not supported");
+        return -1;
+    }
+#endif
+    if (epoll_fd >= 0 && fd_to_key == NULL) {
+        PyErr_SetString(PyExc_TypeError, "epoll_fd requires fd_to_key");
+        return -1;
+    }
+    PyObject *resolution = PyObject_GetAttr(loop, &_Py_ID(_clock_resolution));
+    if (resolution == NULL) {
+        return -1;
+    }
+    double clock_resolution = PyFloat_AsDouble(resolution);
+    Py_DECREF(resolution);
+    if (clock_resolution == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+    Py_XSETREF(self->lc_loop, Py_NewRef(loop));
+    Py_XSETREF(self->lc_fd_to_key, Py_XNewRef(fd_to_key));
+    self->lc_epoll_fd = epoll_fd;
+    self->lc_clock_resolution = clock_resolution;
+    return 0;
+}
+
+/*[clinic input]
+@critical_section
+_asyncio._LoopCore.append
+
+    handle: object
+    /
+
+Add a handle to the ready queue.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__LoopCore_append_impl(LoopCoreObj *self, PyObject *handle)
+/*[clinic end generated code: output=c51c8eb07cc9a011 input=1a6e59680f812e97]*/
+{
+    if (loop_core_ready_push(self, READY_HANDLE, handle, NULL, NULL) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_asyncio._LoopCore.popleft
+
+    cls: defining_class
+
+Remove and return the first handle of the ready queue.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__LoopCore_popleft_impl(LoopCoreObj *self, PyTypeObject *cls)
+/*[clinic end generated code: output=c9338b4b6fad350a input=d4ce0fdf3b3b0432]*/
+{
+    ReadyEntry entry;
+    if (!loop_core_ready_pop(self, &entry)) {
+        PyErr_SetString(PyExc_IndexError, "pop from an empty ready queue");
+        return NULL;
+    }
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    PyObject *handle = ready_entry_as_handle(state, self, &entry);
+    ready_entry_clear(&entry);
+    return handle;
+}
+
+/*[clinic input]
+@critical_section
+_asyncio._LoopCore.clear
+
+Remove all the handles of the ready queue.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__LoopCore_clear_impl(LoopCoreObj *self)
+/*[clinic end generated code: output=2570e5a2831f3d0b input=2ca1fcc4a4e5d661]*/
+{
+    loop_core_clear_ready(self);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_asyncio._LoopCore.push_timer
+
+    handle: object
+    /
+
+Schedule a TimerHandle at its 'when' time.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__LoopCore_push_timer_impl(LoopCoreObj *self, PyObject *handle)
+/*[clinic end generated code: output=e08c5531ee73a013 input=dffdb8b832ed5278]*/
+{
+    PyObject *when_obj = PyObject_GetAttr(handle, &_Py_ID(_when));
+    if (when_obj == NULL) {
+        return NULL;
+    }
+    double when = PyFloat_AsDouble(when_obj);
+    Py_DECREF(when_obj);
+    if (when == -1.0 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (loop_core_timers_push(self, when, handle) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_asyncio._LoopCore.clear_timers
+
+Remove all the scheduled timers.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__LoopCore_clear_timers_impl(LoopCoreObj *self)
+/*[clinic end generated code: output=a7ddb0f3f868d14e input=54ff6bfc900f0c53]*/
+{
+    loop_core_clear_timers(self);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio._LoopCore.run_once
+
+    cls: defining_class
+
+Run one full iteration of the event loop.
+
+Like BaseEventLoop._run_once(): call all the ready callbacks, poll for
+I/O, schedule the resulting callbacks and the expired timers.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__LoopCore_run_once_impl(LoopCoreObj *self, PyTypeObject *cls)
+/*[clinic end generated code: output=5a1cf2ee7cc46014 input=fcbc8a702315f8d0]*/
+{
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    PyObject *loop = self->lc_loop;
+    if (loop == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "uninitialized loop core");
+        return NULL;
+    }
+    if (loop_core_remove_cancelled_timers(self) < 0) {
+        return NULL;
+    }
+
+    PyObject *stopping_obj = PyObject_GetAttr(loop, &_Py_ID(_stopping));
+    if (stopping_obj == NULL) {
+        return NULL;
+    }
+    int stopping = PyObject_IsTrue(stopping_obj);
+    Py_DECREF(stopping_obj);
+    if (stopping < 0) {
+        return NULL;
+    }
+
+    double timeout = -1.0;
+    double first_when = 0.0;
+    Py_ssize_t ready_len, ntimers;
+    LOOP_CORE_LOCK(self);
+    ready_len = self->lc_ready_len;
+    ntimers = self->lc_ntimers;
+    if (ntimers > 0) {
+        first_when = self->lc_timers[0].when;
+    }
+    LOOP_CORE_UNLOCK(self);
+    if (ready_len > 0 || stopping) {
+        timeout = 0.0;
+    }
+    else if (ntimers > 0) {
+        double now;
+        if (loop_get_time(loop, &now) < 0) {
+            return NULL;
+        }
+        timeout = first_when - now;
+        if (timeout > MAXIMUM_SELECT_TIMEOUT) {
+            timeout = MAXIMUM_SELECT_TIMEOUT;
+        }
+        else if (timeout < 0) {
+            timeout = 0.0;
+        }
+    }
+
+    int res;
+#ifdef HAVE_EPOLL
+    if (self->lc_epoll_fd >= 0) {
+        res = loop_core_epoll(self, timeout);
+    }
+    else
+#endif
+    {
+        res = loop_core_select(self, timeout);
+    }
+    if (res < 0) {
+        return NULL;
+    }
+
+    // Handle 'later' callbacks that are ready.
+    if (ntimers > 0 || self->lc_ntimers > 0) {
+        double end_time;
+        if (loop_get_time(loop, &end_time) < 0) {
+            return NULL;
+        }
+        end_time += self->lc_clock_resolution;
+        for (;;) {
+            PyObject *handle = NULL;
+            LOOP_CORE_LOCK(self);
+            if (self->lc_ntimers > 0 && self->lc_timers[0].when < end_time) {
+                handle = loop_core_timers_pop(self);
+                res = loop_core_ready_push(self, READY_HANDLE, handle,
+                                           NULL, NULL);
+            }
+            LOOP_CORE_UNLOCK(self);
+            if (handle == NULL) {
+                break;
+            }
+            if (res == 0) {
+                res = PyObject_SetAttr(handle, &_Py_ID(_scheduled), Py_False);
+            }
+            Py_DECREF(handle);
+            if (res < 0) {
+                return NULL;
+            }
+        }
+    }
+
+    // Run the callbacks which are ready, but not those which they schedule.
+    PyObject *debug_obj = PyObject_GetAttr(loop, &_Py_ID(_debug));
+    if (debug_obj == NULL) {
+        return NULL;
+    }
+    int debug = PyObject_IsTrue(debug_obj);
+    Py_DECREF(debug_obj);
+    if (debug < 0) {
+        return NULL;
+    }
+    LOOP_CORE_LOCK(self);
+    ready_len = self->lc_ready_len;
+    LOOP_CORE_UNLOCK(self);
+    for (Py_ssize_t i = 0; i < ready_len; i++) {
+        ReadyEntry entry;
+        int popped;
+        LOOP_CORE_LOCK(self);
+        popped = loop_core_ready_pop(self, &entry);
+        LOOP_CORE_UNLOCK(self);
+        if (!popped) {
+            break;
+        }
+        if (entry.kind != READY_HANDLE && !debug) {
+            res = loop_core_run_native(state, self, &entry);
+            ready_entry_clear(&entry);
+            if (res < 0) {
+                return NULL;
+            }
+            continue;
+        }
+        PyObject *handle = ready_entry_as_handle(state, self, &entry);
+        ready_entry_clear(&entry);
+        if (handle == NULL) {
+            return NULL;
+        }
+        int cancelled = handle_is_cancelled(handle);
+        if (cancelled != 0) {
+            Py_DECREF(handle);
+            if (cancelled < 0) {
+                return NULL;
+            }
+            continue;
+        }
+        PyObject *ret;
+        if (debug) {
+            ret = PyObject_CallMethodOneArg(loop, &_Py_ID(_run_handle_debug),
+                                            handle);
+        }
+        else {
+            ret = PyObject_CallMethodNoArgs(handle, &_Py_ID(_run));
+        }
+        Py_DECREF(handle);
+        if (ret == NULL) {
+            return NULL;
+        }
+        Py_DECREF(ret);
+    }
+    Py_RETURN_NONE;
+}
+
+static Py_ssize_t
+LoopCoreObj_len(LoopCoreObj *self)
+{
+    return FT_ATOMIC_LOAD_SSIZE_RELAXED(self->lc_ready_len);
+}
+
+static int
+LoopCoreObj_traverse(LoopCoreObj *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(self->lc_loop);
+    Py_VISIT(self->lc_fd_to_key);
+    for (Py_ssize_t i = 0; i < self->lc_ready_len; i++) {
+        ReadyEntry *entry = &self->lc_ready[(self->lc_ready_head + i) &
+                                            (self->lc_ready_size - 1)];
+        Py_VISIT(entry->cb);
+        Py_VISIT(entry->arg);
+        Py_VISIT(entry->ctx);
+    }
+    for (Py_ssize_t i = 0; i < self->lc_ntimers; i++) {
+        Py_VISIT(self->lc_timers[i].handle);
+    }
+    return 0;
+}
+
+static int
+LoopCoreObj_clear(LoopCoreObj *self)
+{
+    Py_CLEAR(self->lc_loop);
+    Py_CLEAR(self->lc_fd_to_key);
+    loop_core_clear_ready(self);
+    loop_core_clear_timers(self);
+    return 0;
+}
+
+static void
+LoopCoreObj_dealloc(LoopCoreObj *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    (void)LoopCoreObj_clear(self);
+    PyMem_Free(self->lc_ready);
+    PyMem_Free(self->lc_timers);
+    PyMem_Free(self->lc_epoll_events);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyMemberDef LoopCore_members[] = {
+    {"timer_cancelled_count", Py_T_PYSSIZET,
+     offsetof(LoopCoreObj, lc_timer_cancelled_count), 0,
+     "Number of cancelled timers which are still scheduled."},
+    {"ntimers", Py_T_PYSSIZET, offsetof(LoopCoreObj, lc_ntimers), Py_READONLY,
+     "Number of scheduled timers."},
+    {"native_callbacks", Py_T_BOOL,
+     offsetof(LoopCoreObj, lc_native_callbacks), 0,
+     "Whether futures and tasks schedule their callbacks without Handles."},
+    {NULL},
+};
+
+static PyMethodDef LoopCore_methods[] = {
+    _ASYNCIO__LOOPCORE_APPEND_METHODDEF
+    _ASYNCIO__LOOPCORE_POPLEFT_METHODDEF
+    _ASYNCIO__LOOPCORE_CLEAR_METHODDEF
+    _ASYNCIO__LOOPCORE_PUSH_TIMER_METHODDEF
+    _ASYNCIO__LOOPCORE_CLEAR_TIMERS_METHODDEF
+    _ASYNCIO__LOOPCORE_RUN_ONCE_METHODDEF
+    {NULL, NULL}
+};
+
+static PyType_Slot LoopCore_slots[] = {
+    {Py_tp_dealloc, LoopCoreObj_dealloc},
+    {Py_tp_doc, (void *)_asyncio__LoopCore___init____doc__},
+    {Py_tp_traverse, (traverseproc)LoopCoreObj_traverse},
+    {Py_tp_clear, (inquiry)LoopCoreObj_clear},
+    {Py_tp_methods, LoopCore_methods},
+    {Py_tp_members, LoopCore_members},
+    {Py_tp_init, (initproc)_asyncio__LoopCore___init__},
+    {Py_tp_new, PyType_GenericNew},
+    {Py_sq_length, (lenfunc)LoopCoreObj_len},
+    {0, NULL},
+};
+
+static PyType_Spec LoopCore_spec = {
+    .name = "_asyncio._LoopCore",
+    .basicsize = sizeof(LoopCoreObj),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = LoopCore_slots,
+};
+
+
 /*********************** Module **************************/
 
 /*[clinic input]
@@ -3682,11 +4790,13 @@ module_traverse(PyObject *mod, visitproc visit, void *arg)
     Py_VISIT(state->TaskStepMethWrapper_Type);
     Py_VISIT(state->FutureType);
     Py_VISIT(state->TaskType);
+    Py_VISIT(state->LoopCoreType);
 
     Py_VISIT(state->asyncio_mod);
     Py_VISIT(state->traceback_extract_stack);
     Py_VISIT(state->asyncio_future_repr_func);
     Py_VISIT(state->asyncio_get_event_loop_policy);
+    Py_VISIT(state->asyncio_events_Handle);
     Py_VISIT(state->asyncio_iscoroutine_func);
     Py_VISIT(state->asyncio_task_get_stack_func);
     Py_VISIT(state->asyncio_task_print_stack_func);
@@ -3713,11 +4823,13 @@ module_clear(PyObject *mod)
     Py_CLEAR(state->TaskStepMethWrapper_Type);
     Py_CLEAR(state->FutureType);
     Py_CLEAR(state->TaskType);
+    Py_CLEAR(state->LoopCoreType);
 
     Py_CLEAR(state->asyncio_mod);
     Py_CLEAR(state->traceback_extract_stack);
     Py_CLEAR(state->asyncio_future_repr_func);
     Py_CLEAR(state->asyncio_get_event_loop_policy);
+    Py_CLEAR(state->asyncio_events_Handle);
     Py_CLEAR(state->asyncio_iscoroutine_func);
     Py_CLEAR(state->asyncio_task_get_stack_func);
     Py_CLEAR(state->asyncio_task_print_stack_func);
@@ -3782,6 +4894,7 @@ module_init(asyncio_state *state)
 
     WITH_MOD("asyncio.events")
     GET_MOD_ATTR(state->asyncio_get_event_loop_policy, "get_event_loop_policy")
+    GET_MOD_ATTR(state->asyncio_events_Handle, "Handle")
 
     WITH_MOD("asyncio.base_futures")
     GET_MOD_ATTR(state->asyncio_future_repr_func, "_future_repr")
@@ -3866,6 +4979,7 @@ module_exec(PyObject *mod)
     CREATE_TYPE(mod, state->FutureIterType, &FutureIter_spec, NULL);
     CREATE_TYPE(mod, state->FutureType, &Future_spec, NULL);
     CREATE_TYPE(mod, state->TaskType, &Task_spec, state->FutureType);
+    CREATE_TYPE(mod, state->LoopCoreType, &LoopCore_spec, NULL);
 
 #undef CREATE_TYPE
 
@@ -3876,6 +4990,10 @@ module_exec(PyObject *mod)
     if (PyModule_AddType(mod, state->TaskType) < 0) {
         return -1;
     }
+
+    if (PyModule_AddType(mod, state->LoopCoreType) < 0) {
+        return -1;
+    }
     // Must be done after types are added to avoid a circular dependency
     if (module_init(state) < 0) {
         return -1;
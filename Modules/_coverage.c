@@ -0,0 +1,722 @@
+/* Line and branch coverage on top of sys.monitoring.
+ *
+ * The LINE and BRANCH callbacks are C functions which set a bit in a
+ * bitmap attached to the code object, then return sys.monitoring.DISABLE
+ * so that the location is never reported again.  Once every executed
+ * line and branch was reported, the instrumented code runs at the same
+ * speed as uninstrumented code.
+ *
+ * A BRANCH event is disabled for both directions at once, so a branch
+ * stays enabled until both of its destinations were seen.
+ *
+ * The data is kept until clear() is called, and holds a strong reference
+ * to every code object which was executed.
+ *
+ * The mutex protecting the data is never held while calling code which
+ * could run Python code (such as a finalizer triggering a LINE event on
+ * the same thread): errors are raised and objects are created after it
+ * is released.
+ */
+
+#ifndef Py_BUILD_CORE_BUILTIN
+#  define Py_BUILD_CORE_MODULE 1
+#endif
+
+#include "Python.h"
+#include "pycore_hashtable.h"     // _Py_hashtable_t
+#include "pycore_import.h"        // _PyImport_GetModuleAttrString()
+#include "pycore_instruments.h"   // PY_MONITORING_COVERAGE_ID
+#include "pycore_lock.h"          // PyMutex
+
+/*[clinic input]
+module _coverage
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=16fa165a202f155d]*/
+
+#define NO_DESTINATION (-1)
+
+/* Coverage of a code object.  Lines are stored relative to `base`, which
+   is moved down if a line smaller than the first line of the code object
+   is reported.  Branches are indexed by the code unit of the branch
+   instruction, and store up to two destinations. */
+typedef struct {
+    int base;
+    int nlines;                 // number of bits in `lines`
+    uint8_t *lines;
+    Py_ssize_t ncodeunits;
+    int32_t (*branches)[2];     // destinations in code units, or -1
+} code_coverage;
+
+typedef struct {
+    PyMutex mutex;
+    _Py_hashtable_t *codes;     // PyCodeObject* (strong) => code_coverage*
+    PyObject *disable;          // sys.monitoring.DISABLE
+    int tool_id;                // -1 if not running
+} coverage_state;
+
+static inline coverage_state *
+get_coverage_state(PyObject *module)
+{
+    void *state = PyModule_GetState(module);
+    assert(state != NULL);
+    return (coverage_state *)state;
+}
+
+#include "clinic/_coverage.c.h"
+
+
+/* Coverage data */
+
+static void
+code_coverage_free(void *ptr)
+{
+    code_coverage *cov = (code_coverage *)ptr;
+    PyMem_RawFree(cov->lines);
+    PyMem_RawFree(cov->branches);
+    PyMem_RawFree(cov);
+}
+
+static void
+code_decref(void *code)
+{
+    Py_DECREF((PyObject *)code);
+}
+
+static _Py_hashtable_t *
+codes_table_new(void)
+{
+    return _Py_hashtable_new_full(_Py_hashtable_hash_ptr,
+                                  _Py_hashtable_compare_direct,
+                                  code_decref, code_coverage_free, NULL);
+}
+
+// Return NULL if there is no memory left.  Called with the mutex held.
+static code_coverage *
+get_code_coverage(coverage_state *state, PyCodeObject *code)
+{
+    code_coverage *cov = _Py_hashtable_get(state->codes, code);
+    if (cov != NULL) {
+        return cov;
+    }
+    cov = PyMem_RawCalloc(1, sizeof(code_coverage));
+    if (cov == NULL) {
+        return NULL;
+    }
+    cov->base = code->co_firstlineno;
+    if (_Py_hashtable_set(state->codes, code, cov) < 0) {
+        code_coverage_free(cov);
+        return NULL;
+    }
+    // The caller holds a reference to the code object, so this cannot
+    // deallocate anything.
+    Py_INCREF(code);
+    return cov;
+}
+
+// Return -1 if there is no memory left.  Called with the mutex held.
+static int
+add_line(code_coverage *cov, int line)
+{
+    if (line < cov->base || line - cov->base >= cov->nlines) {
+        // Grow the bitmap in steps of 64 lines
+        int base = Py_MIN(line, cov->base);
+        int end = Py_MAX(line + 1, cov->base + cov->nlines);
+        int nlines = (end - base + 63) & ~63;
+        uint8_t *lines = PyMem_RawCalloc(nlines / 8, 1);
+        if (lines == NULL) {
+            return -1;
+        }
+        for (int i = 0; i < cov->nlines; i++) {
+            if (cov->lines[i / 8] & (1 << (i % 8))) {
+                int j = i + cov->base - base;
+                lines[j / 8] |= (uint8_t)(1 << (j % 8));
+            }
+        }
+        PyMem_RawFree(cov->lines);
+        cov->lines = lines;
+        cov->base = base;
+        cov->nlines = nlines;
+    }
+    int i = line - cov->base;
+    cov->lines[i / 8] |= (uint8_t)(1 << (i % 8));
+    return 0;
+}
+
+// Record a branch.  Return 1 if both destinations were seen, 0 if not,
+// -1 if there is no memory left.  Called with the mutex held.
+static int
+add_branch(code_coverage *cov, PyCodeObject *code, Py_ssize_t src,
+           Py_ssize_t dest)
+{
+    if (cov->branches == NULL) {
+        Py_ssize_t n = Py_SIZE(code);
+        cov->branches = PyMem_RawMalloc(n * sizeof(cov->branches[0]));
+        if (cov->branches == NULL) {
+            return -1;
+        }
+        for (Py_ssize_t i = 0; i < n; i++) {
+            cov->branches[i][0] = cov->branches[i][1] = NO_DESTINATION;
+        }
+        cov->ncodeunits = n;
+    }
+    int32_t *dests = cov->branches[src];
+    if (dests[0] == NO_DESTINATION || dests[0] == dest) {
+        dests[0] = (int32_t)dest;
+        return 0;
+    }
+    dests[1] = (int32_t)dest;
+    return 1;
+}
+
+
+/* sys.monitoring callbacks */
+
+static PyObject *
+line_callback(PyObject *module, PyObject *const *args, Py_ssize_t nargs)
+{
+    coverage_state *state = get_coverage_state(module);
+    if (nargs != 2 || !PyCode_Check(args[0])) {
+        PyErr_SetString(PyExc_TypeError, "invalid LINE event arguments");
+        return NULL;
+    }
+    int line = PyLong_AsInt(args[1]);
+    if (line == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    int res = -1;
+    PyMutex_Lock(&state->mutex);
+    code_coverage *cov = get_code_coverage(state, (PyCodeObject *)args[0]);
+    if (cov != NULL) {
+        res = add_line(cov, line);
+    }
+    PyMutex_Unlock(&state->mutex);
+    if (res < 0) {
+        return PyErr_NoMemory();
+    }
+    return Py_NewRef(state->disable);
+}
+
+static PyObject *
+branch_callback(PyObject *module, PyObject *const *args, Py_ssize_t nargs)
+{
+    coverage_state *state = get_coverage_state(module);
+    if (nargs != 3 || !PyCode_Check(args[0])) {
+        PyErr_SetString(PyExc_TypeError, "invalid BRANCH event arguments");
+        return NULL;
+    }
+    // Offsets are in bytes
+    Py_ssize_t src = PyLong_AsSsize_t(args[1]);
+    if (src == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    Py_ssize_t dest = PyLong_AsSsize_t(args[2]);
+    if (dest == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    PyCodeObject *code = (PyCodeObject *)args[0];
+    src /= (Py_ssize_t)sizeof(_Py_CODEUNIT);
+    dest /= (Py_ssize_t)sizeof(_Py_CODEUNIT);
+    if (src < 0 || src >= Py_SIZE(code) || dest < 0 || dest > INT32_MAX) {
+        PyErr_SetString(PyExc_ValueError, "invalid BRANCH event offsets");
+        return NULL;
+    }
+
+    int res = -1;
+    PyMutex_Lock(&state->mutex);
+    code_coverage *cov = get_code_coverage(state, code);
+    if (cov != NULL) {
+        res = add_branch(cov, code, src, dest);
+    }
+    PyMutex_Unlock(&state->mutex);
+    if (res < 0) {
+        return PyErr_NoMemory();
+    }
+    if (res == 0) {
+        Py_RETURN_NONE;
+    }
+    return Py_NewRef(state->disable);
+}
+
+
+/* Module functions */
+
+static PyObject *
+call_monitoring(const char *method, const char *format, ...)
+{
+    PyObject *monitoring = _PyImport_GetModuleAttrString("sys", "monitoring");
+    if (monitoring == NULL) {
+        return NULL;
+    }
+    PyObject *func = PyObject_GetAttrString(monitoring, method);
+    Py_DECREF(monitoring);
+    if (func == NULL) {
+        return NULL;
+    }
+    va_list vargs;
+    va_start(vargs, format);
+    PyObject *args = Py_VaBuildValue(format, vargs);
+    va_end(vargs);
+    PyObject *res = NULL;
+    if (args != NULL) {
+        res = PyObject_CallObject(func, args);
+        Py_DECREF(args);
+    }
+    Py_DECREF(func);
+    return res;
+}
+
+static int
+register_callbacks(PyObject *module, int tool_id, int enable)
+{
+    static const struct {
+        int event;
+        const char *name;
+    } callbacks[] = {
+        {PY_MONITORING_EVENT_LINE, "_line_callback"},
+        {PY_MONITORING_EVENT_BRANCH, "_branch_callback"},
+    };
+    for (size_t i = 0; i < Py_ARRAY_LENGTH(callbacks); i++) {
+        PyObject *callback = Py_None;
+        if (enable) {
+            callback = PyObject_GetAttrString(module, callbacks[i].name);
+            if (callback == NULL) {
+                return -1;
+            }
+        }
+        PyObject *res = call_monitoring("register_callback", "(iiO)", tool_id,
+                                        1 << callbacks[i].event, callback);
+        if (enable) {
+            Py_DECREF(callback);
+        }
+        if (res == NULL) {
+            return -1;
+        }
+        Py_DECREF(res);
+    }
+    return 0;
+}
+
+/*[clinic input]
+_coverage.start
+
+    *
+    branches: bool = False
+        Also record which destinations of each branch were taken.
+    tool_id: int(c_default="PY_MONITORING_COVERAGE_ID") = sys.monitoring.COVERAGE_ID
+        sys.monitoring tool identifier to use.
+
+Start recording the lines executed by all threads.
+
+Data is accumulated with the one of previous runs until clear() is
+called.  Locations disabled by sys.monitoring tools are enabled again.
+[clinic start generated code]*/
+
+static PyObject *
+_coverage_start_impl(PyObject *module, int branches, int tool_id)
+/*[clinic end generated code: output=21eac4bc238ce9e2 input=8c642be87eeb5f1b]*/
+{
+    coverage_state *state = get_coverage_state(module);
+    if (state->tool_id >= 0) {
+        PyErr_SetString(PyExc_RuntimeError, "coverage is already running");
+        return NULL;
+    }
+    PyObject *res = call_monitoring("use_tool_id", "(is)", tool_id, "_coverage");
+    if (res == NULL) {
+        return NULL;
+    }
+    Py_DECREF(res);
+
+    int events = 1 << PY_MONITORING_EVENT_LINE;
+    if (branches) {
+        events |= 1 << PY_MONITORING_EVENT_BRANCH;
+    }
+    if (register_callbacks(module, tool_id, 1) < 0) {
+        goto error;
+    }
+    res = call_monitoring("set_events", "(ii)", tool_id, events);
+    if (res == NULL) {
+        goto error;
+    }
+    Py_DECREF(res);
+    // Locations disabled by a previous run (of this module or of another
+    // tool using the same identifier) must be reported again.
+    res = call_monitoring("restart_events", "()");
+    if (res == NULL) {
+        goto error;
+    }
+    Py_DECREF(res);
+    state->tool_id = tool_id;
+    Py_RETURN_NONE;
+
+error:
+    {
+        PyObject *exc = PyErr_GetRaisedException();
+        (void)register_callbacks(module, tool_id, 0);
+        Py_XDECREF(call_monitoring("free_tool_id", "(i)", tool_id));
+        PyErr_SetRaisedException(exc);
+    }
+    return NULL;
+}
+
+static int
+coverage_stop(PyObject *module)
+{
+    coverage_state *state = get_coverage_state(module);
+    int tool_id = state->tool_id;
+    if (tool_id < 0) {
+        return 0;
+    }
+    state->tool_id = -1;
+    PyObject *res = call_monitoring("set_events", "(ii)", tool_id, 0);
+    if (res == NULL) {
+        return -1;
+    }
+    Py_DECREF(res);
+    if (register_callbacks(module, tool_id, 0) < 0) {
+        return -1;
+    }
+    res = call_monitoring("free_tool_id", "(i)", tool_id);
+    if (res == NULL) {
+        return -1;
+    }
+    Py_DECREF(res);
+    return 0;
+}
+
+/*[clinic input]
+_coverage.stop
+
+Stop recording.  Recorded data is kept.
+[clinic start generated code]*/
+
+static PyObject *
+_coverage_stop_impl(PyObject *module)
+/*[clinic end generated code: output=08a7930aa97e8ff3 input=51ed143e560c73ed]*/
+{
+    if (coverage_stop(module) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_coverage.is_running
+
+Return True if coverage is being recorded.
+[clinic start generated code]*/
+
+static PyObject *
+_coverage_is_running_impl(PyObject *module)
+/*[clinic end generated code: output=9b1f024dd75c5de5 input=954662b46110cfa5]*/
+{
+    return PyBool_FromLong(get_coverage_state(module)->tool_id >= 0);
+}
+
+/*[clinic input]
+_coverage.clear
+
+Discard recorded data.
+
+If coverage is running, the lines and branches which were already
+reported are reported again the next time they are executed.
+[clinic start generated code]*/
+
+static PyObject *
+_coverage_clear_impl(PyObject *module)
+/*[clinic end generated code: output=2d469063c7c04e5f input=b6975f22ccc41d94]*/
+{
+    coverage_state *state = get_coverage_state(module);
+    _Py_hashtable_t *codes = codes_table_new();
+    if (codes == NULL) {
+        return PyErr_NoMemory();
+    }
+    PyMutex_Lock(&state->mutex);
+    _Py_hashtable_t *old = state->codes;
+    state->codes = codes;
+    PyMutex_Unlock(&state->mutex);
+    // Code objects may be freed here: destroy the old table without
+    // holding the mutex.
+    _Py_hashtable_destroy(old);
+
+    if (state->tool_id >= 0) {
+        PyObject *res = call_monitoring("restart_events", "()");
+        if (res == NULL) {
+            return NULL;
+        }
+        Py_DECREF(res);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+lines_to_set(const code_coverage *cov)
+{
+    PyObject *lines = PySet_New(NULL);
+    if (lines == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < cov->nlines; i++) {
+        if (!(cov->lines[i / 8] & (1 << (i % 8)))) {
+            continue;
+        }
+        PyObject *line = PyLong_FromLong(cov->base + i);
+        if (line == NULL || PySet_Add(lines, line) < 0) {
+            Py_XDECREF(line);
+            Py_DECREF(lines);
+            return NULL;
+        }
+        Py_DECREF(line);
+    }
+    return lines;
+}
+
+static PyObject *
+branches_to_set(const code_coverage *cov)
+{
+    PyObject *branches = PySet_New(NULL);
+    if (branches == NULL) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; cov->branches != NULL && i < cov->ncodeunits; i++) {
+        for (int j = 0; j < 2; j++) {
+            int32_t dest = cov->branches[i][j];
+            if (dest == NO_DESTINATION) {
+                continue;
+            }
+            PyObject *arc = Py_BuildValue(
+                "(nn)", i * (Py_ssize_t)sizeof(_Py_CODEUNIT),
+                (Py_ssize_t)dest * (Py_ssize_t)sizeof(_Py_CODEUNIT));
+            if (arc == NULL || PySet_Add(branches, arc) < 0) {
+                Py_XDECREF(arc);
+                Py_DECREF(branches);
+                return NULL;
+            }
+            Py_DECREF(arc);
+        }
+    }
+    return branches;
+}
+
+/* Copy of the data, taken with the mutex held and converted to Python
+   objects once it is released. */
+typedef struct {
+    Py_ssize_t size;
+    Py_ssize_t count;
+    PyCodeObject **codes;       // strong references
+    code_coverage *coverage;
+} snapshot;
+
+static void
+snapshot_clear(snapshot *snap)
+{
+    for (Py_ssize_t i = 0; i < snap->count; i++) {
+        Py_DECREF(snap->codes[i]);
+        PyMem_RawFree(snap->coverage[i].lines);
+        PyMem_RawFree(snap->coverage[i].branches);
+    }
+    PyMem_RawFree(snap->codes);
+    PyMem_RawFree(snap->coverage);
+}
+
+static int
+snapshot_code(_Py_hashtable_t *ht, const void *key, const void *value,
+              void *user_data)
+{
+    snapshot *snap = (snapshot *)user_data;
+    const code_coverage *cov = (const code_coverage *)value;
+    assert(snap->count < snap->size);
+    code_coverage copy = *cov;
+    copy.lines = NULL;
+    copy.branches = NULL;
+    if (cov->nlines) {
+        copy.lines = PyMem_RawMalloc(cov->nlines / 8);
+        if (copy.lines == NULL) {
+            return -1;
+        }
+        memcpy(copy.lines, cov->lines, cov->nlines / 8);
+    }
+    if (cov->branches != NULL) {
+        size_t size = cov->ncodeunits * sizeof(cov->branches[0]);
+        copy.branches = PyMem_RawMalloc(size);
+        if (copy.branches == NULL) {
+            PyMem_RawFree(copy.lines);
+            return -1;
+        }
+        memcpy(copy.branches, cov->branches, size);
+    }
+    snap->codes[snap->count] = (PyCodeObject *)Py_NewRef(key);
+    snap->coverage[snap->count] = copy;
+    snap->count++;
+    return 0;
+}
+
+// Return -1 if there is no memory left.  Called with the mutex held.
+static int
+take_snapshot(coverage_state *state, snapshot *snap)
+{
+    snap->size = _Py_hashtable_len(state->codes);
+    snap->count = 0;
+    snap->codes = PyMem_RawMalloc(Py_MAX(snap->size, 1) * sizeof(PyCodeObject *));
+    snap->coverage = PyMem_RawMalloc(Py_MAX(snap->size, 1) * sizeof(code_coverage));
+    if (snap->codes == NULL || snap->coverage == NULL) {
+        return -1;
+    }
+    return _Py_hashtable_foreach(state->codes, snapshot_code, snap);
+}
+
+/*[clinic input]
+_coverage.collect
+
+Return the recorded data.
+
+Return a dict mapping each code object which was executed to a
+(lines, branches) tuple.  lines is the set of executed line numbers.
+branches is the set of (offset, destination) pairs of the branches which
+were taken, as reported by the sys.monitoring BRANCH event; it is empty
+if branches were not recorded.
+[clinic start generated code]*/
+
+static PyObject *
+_coverage_collect_impl(PyObject *module)
+/*[clinic end generated code: output=cf00de2204e66947 input=158350a167fcc786]*/
+{
+    coverage_state *state = get_coverage_state(module);
+    snapshot snap;
+    PyMutex_Lock(&state->mutex);
+    int err = take_snapshot(state, &snap);
+    PyMutex_Unlock(&state->mutex);
+    if (err < 0) {
+        snapshot_clear(&snap);
+        return PyErr_NoMemory();
+    }
+
+    PyObject *result = PyDict_New();
+    if (result == NULL) {
+        goto error;
+    }
+    for (Py_ssize_t i = 0; i < snap.count; i++) {
+        PyObject *lines = lines_to_set(&snap.coverage[i]);
+        if (lines == NULL) {
+            goto error;
+        }
+        PyObject *branches = branches_to_set(&snap.coverage[i]);
+        if (branches == NULL) {
+            Py_DECREF(lines);
+            goto error;
+        }
+        PyObject *item = PyTuple_Pack(2, lines, branches);
+        Py_DECREF(lines);
+        Py_DECREF(branches);
+        if (item == NULL) {
+            goto error;
+        }
+        err = PyDict_SetItem(result, (PyObject *)snap.codes[i], item);
+        Py_DECREF(item);
+        if (err < 0) {
+            goto error;
+        }
+    }
+    snapshot_clear(&snap);
+    return result;
+
+error:
+    Py_XDECREF(result);
+    snapshot_clear(&snap);
+    return NULL;
+}
+
+static PyMethodDef coverage_methods[] = {
+    _COVERAGE_START_METHODDEF
+    _COVERAGE_STOP_METHODDEF
+    _COVERAGE_IS_RUNNING_METHODDEF
+    _COVERAGE_CLEAR_METHODDEF
+    _COVERAGE_COLLECT_METHODDEF
+    {"_line_callback", _PyCFunction_CAST(line_callback), METH_FASTCALL, NULL},
+    {"_branch_callback", _PyCFunction_CAST(branch_callback), METH_FASTCALL, NULL},
+    {NULL, NULL}
+};
+
+
+/* Module */
+
+static int
+coverage_exec(PyObject *module)
+{
+    coverage_state *state = get_coverage_state(module);
+    state->tool_id = -1;
+    state->codes = codes_table_new();
+    if (state->codes == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyObject *monitoring = _PyImport_GetModuleAttrString("sys", "monitoring");
+    if (monitoring == NULL) {
+        return -1;
+    }
+    state->disable = PyObject_GetAttrString(monitoring, "DISABLE");
+    Py_DECREF(monitoring);
+    if (state->disable == NULL) {
+        return -1;
+    }
+    return 0;
+}
+
+static int
+coverage_traverse(PyObject *module, visitproc visit, void *arg)
+{
+    coverage_state *state = get_coverage_state(module);
+    Py_VISIT(state->disable);
+    return 0;
+}
+
+static int
+coverage_clear(PyObject *module)
+{
+    coverage_state *state = get_coverage_state(module);
+    Py_CLEAR(state->disable);
+    return 0;
+}
+
+static void
+coverage_free(void *module)
+{
+    coverage_state *state = get_coverage_state((PyObject *)module);
+    if (state->tool_id >= 0) {
+        // The registered callbacks keep the module alive, so this only
+        // happens at interpreter shutdown.
+        if (coverage_stop((PyObject *)module) < 0) {
+            PyErr_WriteUnraisable((PyObject *)module);
+        }
+    }
+    if (state->codes != NULL) {
+        _Py_hashtable_destroy(state->codes);
+        state->codes = NULL;
+    }
+    (void)coverage_clear((PyObject *)module);
+}
+
+static PyModuleDef_Slot coverage_slots[] = {
+    {Py_mod_exec, coverage_exec},
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+    {0, NULL}
+};
+
+static struct PyModuleDef coveragemodule = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "_coverage",
+    .m_doc = "Line and branch coverage with sys.monitoring",
+    .m_size = sizeof(coverage_state),
+    .m_methods = coverage_methods,
+    .m_slots = coverage_slots,
+    .m_traverse = coverage_traverse,
+    .m_clear = coverage_clear,
+    .m_free = coverage_free,
+};
+
+PyMODINIT_FUNC
+PyInit__coverage(void)
+{
+    return PyModuleDef_Init(&coveragemodule);
+}
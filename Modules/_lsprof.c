@@ -5,19 +5,29 @@
 #include "Python.h"
 #include "pycore_call.h"          // _PyObject_CallNoArgs()
 #include "pycore_ceval.h"         // _PyEval_SetProfile()
+#include "pycore_frame.h"         // _PyThreadState_GetFrame()
+#include "pycore_hashtable.h"     // _Py_hashtable_t
 #include "pycore_pystate.h"       // _PyThreadState_GET()
 #include "pycore_time.h"          // _PyTime_FromLong()
 
-#include "rotatingtree.h"
-
 /************************************************************/
 /* Written by Brett Rosen and Ted Czotter */
 
 struct _ProfilerEntry;
 
+/* key of a ProfilerSubEntry: a call from 'caller' to 'callee',
+   made at line 'lineno' of the caller (-1 if call sites are not
+   tracked) */
+typedef struct {
+    struct _ProfilerEntry *caller;
+    struct _ProfilerEntry *callee;
+    int lineno;
+} ProfilerCallSite;
+
 /* represents a function called from another function */
 typedef struct _ProfilerSubEntry {
-    rotating_node_t header;
+    ProfilerCallSite key;
+    struct _ProfilerSubEntry *next; /* next call made by the same caller */
     PyTime_t tt;
     PyTime_t it;
     long callcount;
@@ -27,14 +37,15 @@ typedef struct _ProfilerSubEntry {
 
 /* represents a function or user defined block */
 typedef struct _ProfilerEntry {
-    rotating_node_t header;
+    void *key; /* PyCodeObject or PyMethodDef pointer */
+    struct _ProfilerEntry *next; /* next entry in creation order */
     PyObject *userObj; /* PyCodeObject, or a descriptive str for builtins */
     PyTime_t tt; /* total time in this entry */
     PyTime_t it; /* inline time in this entry (not in subcalls) */
     long callcount; /* how many times this was called */
     long recursivecallcount; /* how many times called recursively */
     long recursionLevel;
-    rotating_node_t *calls;
+    ProfilerSubEntry *calls;
 } ProfilerEntry;
 
 typedef struct _ProfilerContext {
@@ -42,11 +53,26 @@ typedef struct _ProfilerContext {
     PyTime_t subt;
     struct _ProfilerContext *previous;
     ProfilerEntry *ctxEntry;
+    ProfilerSubEntry *ctxSubEntry;
 } ProfilerContext;
 
+/* Entries and sub-entries are never freed individually: they are carved
+   out of arenas which are all released at once by clear(). */
+typedef struct _ProfilerArena {
+    struct _ProfilerArena *previous;
+    size_t used;
+    char data[];
+} ProfilerArena;
+
+#define PROFILER_ARENA_SIZE (16 * 1024)
+
 typedef struct {
     PyObject_HEAD
-    rotating_node_t *profilerEntries;
+    _Py_hashtable_t *entries;       /* key -> ProfilerEntry */
+    _Py_hashtable_t *subentries;    /* ProfilerCallSite -> ProfilerSubEntry */
+    ProfilerEntry *firstEntry;
+    ProfilerEntry **lastEntry;
+    ProfilerArena *arena;
     ProfilerContext *currentProfilerContext;
     ProfilerContext *freelistProfilerContext;
     int flags;
@@ -60,6 +86,7 @@ typedef struct {
 #define POF_SUBCALLS    0x002
 #define POF_BUILTINS    0x004
 #define POF_EXT_TIMER   0x008
+#define POF_CALLSITES   0x010
 #define POF_NOMEMORY    0x100
 
 /*[clinic input]
@@ -205,90 +232,170 @@ normalizeUserObj(PyObject *obj)
     }
 }
 
+static void *
+arenaAlloc(ProfilerObject *pObj, size_t size)
+{
+    ProfilerArena *arena = pObj->arena;
+    /* PyTime_t has the strictest alignment of the entry members */
+    size = _Py_SIZE_ROUND_UP(size, sizeof(PyTime_t));
+    assert(size <= PROFILER_ARENA_SIZE);
+    if (arena == NULL || PROFILER_ARENA_SIZE - arena->used < size) {
+        arena = PyMem_Malloc(sizeof(ProfilerArena) + PROFILER_ARENA_SIZE);
+        if (arena == NULL) {
+            pObj->flags |= POF_NOMEMORY;
+            return NULL;
+        }
+        arena->previous = pObj->arena;
+        arena->used = 0;
+        pObj->arena = arena;
+    }
+    void *ptr = arena->data + arena->used;
+    arena->used += size;
+    return ptr;
+}
+
+static Py_uhash_t
+hashCallSite(const void *key)
+{
+    const ProfilerCallSite *site = (const ProfilerCallSite *)key;
+    Py_uhash_t hash = _Py_hashtable_hash_ptr(site->caller);
+    hash = (hash * 1000003) ^ _Py_hashtable_hash_ptr(site->callee);
+    return (hash * 1000003) ^ (Py_uhash_t)site->lineno;
+}
+
+static int
+compareCallSite(const void *key1, const void *key2)
+{
+    const ProfilerCallSite *a = (const ProfilerCallSite *)key1;
+    const ProfilerCallSite *b = (const ProfilerCallSite *)key2;
+    return (a->caller == b->caller && a->callee == b->callee
+            && a->lineno == b->lineno);
+}
+
+static int
+ensureTables(ProfilerObject *pObj)
+{
+    if (pObj->entries == NULL) {
+        pObj->entries = _Py_hashtable_new(_Py_hashtable_hash_ptr,
+                                          _Py_hashtable_compare_direct);
+        if (pObj->entries == NULL) {
+            return -1;
+        }
+        pObj->firstEntry = NULL;
+        pObj->lastEntry = &pObj->firstEntry;
+    }
+    if (pObj->subentries == NULL) {
+        pObj->subentries = _Py_hashtable_new(hashCallSite, compareCallSite);
+        if (pObj->subentries == NULL) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
 static ProfilerEntry*
 newProfilerEntry(ProfilerObject *pObj, void *key, PyObject *userObj)
 {
     ProfilerEntry *self;
-    self = (ProfilerEntry*) PyMem_Malloc(sizeof(ProfilerEntry));
-    if (self == NULL) {
+    if (ensureTables(pObj) < 0) {
         pObj->flags |= POF_NOMEMORY;
         return NULL;
     }
+    self = (ProfilerEntry*) arenaAlloc(pObj, sizeof(ProfilerEntry));
+    if (self == NULL) {
+        return NULL;
+    }
     userObj = normalizeUserObj(userObj);
     if (userObj == NULL) {
         PyErr_Clear();
-        PyMem_Free(self);
         pObj->flags |= POF_NOMEMORY;
         return NULL;
     }
-    self->header.key = key;
+    if (_Py_hashtable_set(pObj->entries, key, self) < 0) {
+        Py_DECREF(userObj);
+        pObj->flags |= POF_NOMEMORY;
+        return NULL;
+    }
+    self->key = key;
+    self->next = NULL;
     self->userObj = userObj;
     self->tt = 0;
     self->it = 0;
     self->callcount = 0;
     self->recursivecallcount = 0;
     self->recursionLevel = 0;
-    self->calls = EMPTY_ROTATING_TREE;
-    RotatingTree_Add(&pObj->profilerEntries, &self->header);
+    self->calls = NULL;
+    *pObj->lastEntry = self;
+    pObj->lastEntry = &self->next;
     return self;
 }
 
-static ProfilerEntry*
+static inline ProfilerEntry*
 getEntry(ProfilerObject *pObj, void *key)
 {
-    return (ProfilerEntry*) RotatingTree_Get(&pObj->profilerEntries, key);
+    if (pObj->entries == NULL) {
+        return NULL;
+    }
+    return (ProfilerEntry*) _Py_hashtable_get(pObj->entries, key);
 }
 
 static ProfilerSubEntry *
-getSubEntry(ProfilerObject *pObj, ProfilerEntry *caller, ProfilerEntry* entry)
+getSubEntry(ProfilerObject *pObj, ProfilerEntry *caller, ProfilerEntry* entry,
+            int lineno)
 {
-    return (ProfilerSubEntry*) RotatingTree_Get(&caller->calls,
-                                                (void *)entry);
+    ProfilerCallSite site = {caller, entry, lineno};
+    return (ProfilerSubEntry*) _Py_hashtable_get(pObj->subentries, &site);
 }
 
 static ProfilerSubEntry *
-newSubEntry(ProfilerObject *pObj,  ProfilerEntry *caller, ProfilerEntry* entry)
+newSubEntry(ProfilerObject *pObj,  ProfilerEntry *caller, ProfilerEntry* entry,
+            int lineno)
 {
     ProfilerSubEntry *self;
-    self = (ProfilerSubEntry*) PyMem_Malloc(sizeof(ProfilerSubEntry));
+    self = (ProfilerSubEntry*) arenaAlloc(pObj, sizeof(ProfilerSubEntry));
     if (self == NULL) {
+        return NULL;
+    }
+    self->key.caller = caller;
+    self->key.callee = entry;
+    self->key.lineno = lineno;
+    if (_Py_hashtable_set(pObj->subentries, &self->key, self) < 0) {
         pObj->flags |= POF_NOMEMORY;
         return NULL;
     }
-    self->header.key = (void *)entry;
     self->tt = 0;
     self->it = 0;
     self->callcount = 0;
     self->recursivecallcount = 0;
     self->recursionLevel = 0;
-    RotatingTree_Add(&caller->calls, &self->header);
+    self->next = caller->calls;
+    caller->calls = self;
     return self;
 }
 
-static int freeSubEntry(rotating_node_t *header, void *arg)
-{
-    ProfilerSubEntry *subentry = (ProfilerSubEntry*) header;
-    PyMem_Free(subentry);
-    return 0;
-}
-
-static int freeEntry(rotating_node_t *header, void *arg)
-{
-    ProfilerEntry *entry = (ProfilerEntry*) header;
-    RotatingTree_Enum(entry->calls, freeSubEntry, NULL);
-    Py_DECREF(entry->userObj);
-    PyMem_Free(entry);
-    return 0;
-}
-
 static void clearEntries(ProfilerObject *pObj)
 {
-    RotatingTree_Enum(pObj->profilerEntries, freeEntry, NULL);
-    pObj->profilerEntries = EMPTY_ROTATING_TREE;
+    for (ProfilerEntry *entry = pObj->firstEntry; entry; entry = entry->next) {
+        Py_DECREF(entry->userObj);
+    }
+    pObj->firstEntry = NULL;
+    pObj->lastEntry = &pObj->firstEntry;
+    if (pObj->entries) {
+        _Py_hashtable_clear(pObj->entries);
+    }
+    if (pObj->subentries) {
+        _Py_hashtable_clear(pObj->subentries);
+    }
+    while (pObj->arena) {
+        ProfilerArena *arena = pObj->arena;
+        pObj->arena = arena->previous;
+        PyMem_Free(arena);
+    }
     /* release the memory hold by the ProfilerContexts */
-    if (pObj->currentProfilerContext) {
-        PyMem_Free(pObj->currentProfilerContext);
-        pObj->currentProfilerContext = NULL;
+    while (pObj->currentProfilerContext) {
+        ProfilerContext *c = pObj->currentProfilerContext;
+        pObj->currentProfilerContext = c->previous;
+        PyMem_Free(c);
     }
     while (pObj->freelistProfilerContext) {
         ProfilerContext *c = pObj->freelistProfilerContext;
@@ -299,9 +406,11 @@ static void clearEntries(ProfilerObject *pObj)
 }
 
 static void
-initContext(ProfilerObject *pObj, ProfilerContext *self, ProfilerEntry *entry)
+initContext(ProfilerObject *pObj, ProfilerContext *self, ProfilerEntry *entry,
+            int lineno)
 {
     self->ctxEntry = entry;
+    self->ctxSubEntry = NULL;
     self->subt = 0;
     self->previous = pObj->currentProfilerContext;
     pObj->currentProfilerContext = self;
@@ -309,11 +418,12 @@ initContext(ProfilerObject *pObj, ProfilerContext *self, ProfilerEntry *entry)
     if ((pObj->flags & POF_SUBCALLS) && self->previous) {
         /* find or create an entry for me in my caller's entry */
         ProfilerEntry *caller = self->previous->ctxEntry;
-        ProfilerSubEntry *subentry = getSubEntry(pObj, caller, entry);
+        ProfilerSubEntry *subentry = getSubEntry(pObj, caller, entry, lineno);
         if (subentry == NULL)
-            subentry = newSubEntry(pObj, caller, entry);
+            subentry = newSubEntry(pObj, caller, entry, lineno);
         if (subentry)
             ++subentry->recursionLevel;
+        self->ctxSubEntry = subentry;
     }
     self->t0 = call_timer(pObj);
 }
@@ -332,23 +442,20 @@ Stop(ProfilerObject *pObj, ProfilerContext *self, ProfilerEntry *entry)
         ++entry->recursivecallcount;
     entry->it += it;
     entry->callcount++;
-    if ((pObj->flags & POF_SUBCALLS) && self->previous) {
-        /* find or create an entry for me in my caller's entry */
-        ProfilerEntry *caller = self->previous->ctxEntry;
-        ProfilerSubEntry *subentry = getSubEntry(pObj, caller, entry);
-        if (subentry) {
-            if (--subentry->recursionLevel == 0)
-                subentry->tt += tt;
-            else
-                ++subentry->recursivecallcount;
-            subentry->it += it;
-            ++subentry->callcount;
-        }
+    /* the sub-entry was looked up (or created) when the call started */
+    ProfilerSubEntry *subentry = self->ctxSubEntry;
+    if (subentry && subentry->key.callee == entry) {
+        if (--subentry->recursionLevel == 0)
+            subentry->tt += tt;
+        else
+            ++subentry->recursivecallcount;
+        subentry->it += it;
+        ++subentry->callcount;
     }
 }
 
 static void
-ptrace_enter_call(PyObject *self, void *key, PyObject *userObj)
+ptrace_enter_call(PyObject *self, void *key, PyObject *userObj, int lineno)
 {
     /* entering a call to the function identified by 'key'
        (which can be a PyCodeObject or a PyMethodDef pointer) */
@@ -366,6 +473,10 @@ ptrace_enter_call(PyObject *self, void *key, PyObject *userObj)
 
     profEntry = getEntry(pObj, key);
     if (profEntry == NULL) {
+        if (userObj == NULL) {
+            /* the caller could not build the user object */
+            goto restorePyerr;
+        }
         profEntry = newProfilerEntry(pObj, key, userObj);
         if (profEntry == NULL)
             goto restorePyerr;
@@ -384,7 +495,7 @@ ptrace_enter_call(PyObject *self, void *key, PyObject *userObj)
             goto restorePyerr;
         }
     }
-    initContext(pObj, pContext, profEntry);
+    initContext(pObj, pContext, profEntry, lineno);
 
 restorePyerr:
     PyErr_SetRaisedException(exc);
@@ -443,6 +554,7 @@ static PyStructSequence_Field profiler_subentry_fields[] = {
     {"reccallcount", "how many times this is called recursively"},
     {"totaltime",    "total time spent in this call"},
     {"inlinetime",   "inline time (not in further subcalls)"},
+    {"lineno",       "line of the caller making the call, or None"},
     {0}
 };
 
@@ -467,20 +579,32 @@ typedef struct {
     _lsprof_state *state;
 } statscollector_t;
 
-static int statsForSubEntry(rotating_node_t *node, void *arg)
+static int statsForSubEntry(ProfilerSubEntry *sentry, statscollector_t *collect)
 {
-    ProfilerSubEntry *sentry = (ProfilerSubEntry*) node;
-    statscollector_t *collect = (statscollector_t*) arg;
-    ProfilerEntry *entry = (ProfilerEntry*) sentry->header.key;
+    ProfilerEntry *entry = sentry->key.callee;
     int err;
     PyObject *sinfo;
-    sinfo = PyObject_CallFunction((PyObject*) collect->state->stats_subentry_type,
-                                  "((Olldd))",
-                                  entry->userObj,
-                                  sentry->callcount,
-                                  sentry->recursivecallcount,
-                                  collect->factor * sentry->tt,
-                                  collect->factor * sentry->it);
+    if (sentry->key.lineno < 0) {
+        sinfo = PyObject_CallFunction(
+            (PyObject*) collect->state->stats_subentry_type,
+            "((Olldd))",
+            entry->userObj,
+            sentry->callcount,
+            sentry->recursivecallcount,
+            collect->factor * sentry->tt,
+            collect->factor * sentry->it);
+    }
+    else {
+        sinfo = PyObject_CallFunction(
+            (PyObject*) collect->state->stats_subentry_type,
+            "((Ollddi))",
+            entry->userObj,
+            sentry->callcount,
+            sentry->recursivecallcount,
+            collect->factor * sentry->tt,
+            collect->factor * sentry->it,
+            sentry->key.lineno);
+    }
     if (sinfo == NULL)
         return -1;
     err = PyList_Append(collect->sublist, sinfo);
@@ -488,23 +612,24 @@ static int statsForSubEntry(rotating_node_t *node, void *arg)
     return err;
 }
 
-static int statsForEntry(rotating_node_t *node, void *arg)
+static int statsForEntry(ProfilerEntry *entry, statscollector_t *collect)
 {
-    ProfilerEntry *entry = (ProfilerEntry*) node;
-    statscollector_t *collect = (statscollector_t*) arg;
     PyObject *info;
     int err;
     if (entry->callcount == 0)
         return 0;   /* skip */
 
-    if (entry->calls != EMPTY_ROTATING_TREE) {
+    if (entry->calls != NULL) {
         collect->sublist = PyList_New(0);
         if (collect->sublist == NULL)
             return -1;
-        if (RotatingTree_Enum(entry->calls,
-                              statsForSubEntry, collect) != 0) {
-            Py_DECREF(collect->sublist);
-            return -1;
+        for (ProfilerSubEntry *sentry = entry->calls; sentry;
+             sentry = sentry->next)
+        {
+            if (statsForSubEntry(sentry, collect) < 0) {
+                Py_DECREF(collect->sublist);
+                return -1;
+            }
         }
     }
     else {
@@ -555,11 +680,16 @@ profiler_subentry objects:
     reccallcount  how many times this is called recursively
     totaltime     total time spent in this call
     inlinetime    inline time (not in further subcalls)
+
+If the profiler was created with callsites=True, the
+calls made by a function are also separated according to
+the line of the caller, available (but not included in
+the tuple) as the lineno attribute of profiler_subentry.
 [clinic start generated code]*/
 
 static PyObject *
 _lsprof_Profiler_getstats_impl(ProfilerObject *self, PyTypeObject *cls)
-/*[clinic end generated code: output=1806ef720019ee03 input=445e193ef4522902]*/
+/*[clinic end generated code: output=1806ef720019ee03 input=799718c6d673cf3c]*/
 {
     statscollector_t collect;
     collect.state = _PyType_GetModuleState(cls);
@@ -577,10 +707,11 @@ _lsprof_Profiler_getstats_impl(ProfilerObject *self, PyTypeObject *cls)
     collect.list = PyList_New(0);
     if (collect.list == NULL)
         return NULL;
-    if (RotatingTree_Enum(self->profilerEntries, statsForEntry, &collect)
-        != 0) {
-        Py_DECREF(collect.list);
-        return NULL;
+    for (ProfilerEntry *entry = self->firstEntry; entry; entry = entry->next) {
+        if (statsForEntry(entry, &collect) < 0) {
+            Py_DECREF(collect.list);
+            return NULL;
+        }
     }
     return collect.list;
 }
@@ -606,10 +737,45 @@ setBuiltins(ProfilerObject *pObj, int nvalue)
     return 0;
 }
 
+static int
+setCallsites(ProfilerObject *pObj, int nvalue)
+{
+    if (nvalue == 0)
+        pObj->flags &= ~POF_CALLSITES;
+    else if (nvalue > 0)
+        pObj->flags |=  POF_CALLSITES;
+    return 0;
+}
+
+/* Return the line of the caller making the current call, or -1 if call
+   sites are not tracked.  For Python functions the current frame is the
+   callee's; for built-in functions it is the caller's. */
+static int
+callerLineno(ProfilerObject *pObj, int pycall)
+{
+    if (!(pObj->flags & POF_CALLSITES)) {
+        return -1;
+    }
+    PyThreadState *tstate = _PyThreadState_GET();
+    _PyInterpreterFrame *frame;
+    if (pycall) {
+        frame = tstate->current_frame;
+        frame = frame ? _PyFrame_GetFirstComplete(frame->previous) : NULL;
+    }
+    else {
+        frame = _PyThreadState_GetFrame(tstate);
+    }
+    if (frame == NULL) {
+        return -1;
+    }
+    return PyUnstable_InterpreterFrame_GetLine(frame);
+}
+
 PyObject* pystart_callback(ProfilerObject* self, PyObject *const *args, Py_ssize_t size)
 {
     PyObject* code = args[0];
-    ptrace_enter_call((PyObject*)self, (void *)code, (PyObject *)code);
+    ptrace_enter_call((PyObject*)self, (void *)code, (PyObject *)code,
+                      callerLineno(self, 1));
 
     Py_RETURN_NONE;
 }
@@ -622,6 +788,20 @@ PyObject* pyreturn_callback(ProfilerObject* self, PyObject *const *args, Py_ssiz
     Py_RETURN_NONE;
 }
 
+/* Return the PyMethodDef identifying a call to a built-in function or
+   method, without creating a bound method object. */
+static PyMethodDef *
+get_cfunc_def(PyObject* callable, PyObject* self_arg, PyObject* missing)
+{
+    if (PyCFunction_Check(callable)) {
+        return ((PyCFunctionObject *)callable)->m_ml;
+    }
+    if (Py_TYPE(callable) == &PyMethodDescr_Type && self_arg != missing) {
+        return ((PyMethodDescrObject *)callable)->d_method;
+    }
+    return NULL;
+}
+
 PyObject* get_cfunc_from_callable(PyObject* callable, PyObject* self_arg, PyObject* missing)
 {
     // return a new reference
@@ -640,11 +820,13 @@ PyObject* get_cfunc_from_callable(PyObject* callable, PyObject* self_arg, PyObje
         PyObject *meth = Py_TYPE(callable)->tp_descr_get(
             callable, self_arg, (PyObject*)Py_TYPE(self_arg));
         if (meth == NULL) {
+            PyErr_Clear();
             return NULL;
         }
         if (PyCFunction_Check(meth)) {
             return (PyObject*)((PyCFunctionObject *)meth);
         }
+        Py_DECREF(meth);
     }
     return NULL;
 }
@@ -655,12 +837,23 @@ PyObject* ccall_callback(ProfilerObject* self, PyObject *const *args, Py_ssize_t
         PyObject* callable = args[2];
         PyObject* self_arg = args[3];
 
+        PyMethodDef *ml = get_cfunc_def(callable, self_arg, self->missing);
+        if (ml == NULL) {
+            Py_RETURN_NONE;
+        }
+        if (getEntry(self, ml)) {
+            /* known function: no need to build its description */
+            ptrace_enter_call((PyObject*)self, ml, NULL,
+                              callerLineno(self, 0));
+            Py_RETURN_NONE;
+        }
+
         PyObject* cfunc = get_cfunc_from_callable(callable, self_arg, self->missing);
 
         if (cfunc) {
             ptrace_enter_call((PyObject*)self,
                               ((PyCFunctionObject *)cfunc)->m_ml,
-                              cfunc);
+                              cfunc, callerLineno(self, 0));
             Py_DECREF(cfunc);
         }
     }
@@ -673,12 +866,10 @@ PyObject* creturn_callback(ProfilerObject* self, PyObject *const *args, Py_ssize
         PyObject* callable = args[2];
         PyObject* self_arg = args[3];
 
-        PyObject* cfunc = get_cfunc_from_callable(callable, self_arg, self->missing);
+        PyMethodDef *ml = get_cfunc_def(callable, self_arg, self->missing);
 
-        if (cfunc) {
-            ptrace_leave_call((PyObject*)self,
-                              ((PyCFunctionObject *)cfunc)->m_ml);
-            Py_DECREF(cfunc);
+        if (ml) {
+            ptrace_leave_call((PyObject*)self, ml);
         }
     }
     Py_RETURN_NONE;
@@ -701,13 +892,16 @@ static const struct {
 };
 
 PyDoc_STRVAR(enable_doc, "\
-enable(subcalls=True, builtins=True)\n\
+enable(subcalls=True, builtins=True, callsites=False)\n\
 \n\
 Start collecting profiling information.\n\
 If 'subcalls' is True, also records for each function\n\
 statistics separated according to its current caller.\n\
 If 'builtins' is True, records the time spent in\n\
 built-in functions separately from their caller.\n\
+If 'callsites' is True, the statistics recorded for each\n\
+caller are further separated according to the line of the\n\
+caller making the call.\n\
 ");
 
 static PyObject*
@@ -715,13 +909,15 @@ profiler_enable(ProfilerObject *self, PyObject *args, PyObject *kwds)
 {
     int subcalls = -1;
     int builtins = -1;
-    static char *kwlist[] = {"subcalls", "builtins", 0};
+    int callsites = -1;
+    static char *kwlist[] = {"subcalls", "builtins", "callsites", 0};
     int all_events = 0;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|pp:enable",
-                                     kwlist, &subcalls, &builtins))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|ppp:enable",
+                                     kwlist, &subcalls, &builtins, &callsites))
         return NULL;
-    if (setSubcalls(self, subcalls) < 0 || setBuiltins(self, builtins) < 0) {
+    if (setSubcalls(self, subcalls) < 0 || setBuiltins(self, builtins) < 0
+        || setCallsites(self, callsites) < 0) {
         return NULL;
     }
 
@@ -873,6 +1069,12 @@ profiler_dealloc(ProfilerObject *op)
 
     flush_unmatched(op);
     clearEntries(op);
+    if (op->entries) {
+        _Py_hashtable_destroy(op->entries);
+    }
+    if (op->subentries) {
+        _Py_hashtable_destroy(op->subentries);
+    }
     Py_XDECREF(op->externalTimer);
     PyTypeObject *tp = Py_TYPE(op);
     tp->tp_free(op);
@@ -886,15 +1088,17 @@ profiler_init(ProfilerObject *pObj, PyObject *args, PyObject *kw)
     double timeunit = 0.0;
     int subcalls = 1;
     int builtins = 1;
+    int callsites = 0;
     static char *kwlist[] = {"timer", "timeunit",
-                                   "subcalls", "builtins", 0};
+                                   "subcalls", "builtins", "callsites", 0};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kw, "|Odpp:Profiler", kwlist,
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "|Odppp:Profiler", kwlist,
                                      &timer, &timeunit,
-                                     &subcalls, &builtins))
+                                     &subcalls, &builtins, &callsites))
         return -1;
 
-    if (setSubcalls(pObj, subcalls) < 0 || setBuiltins(pObj, builtins) < 0)
+    if (setSubcalls(pObj, subcalls) < 0 || setBuiltins(pObj, builtins) < 0
+        || setCallsites(pObj, callsites) < 0)
         return -1;
     pObj->externalTimerUnit = timeunit;
     Py_XSETREF(pObj->externalTimer, Py_XNewRef(timer));
@@ -933,13 +1137,16 @@ static PyMethodDef profiler_methods[] = {
 };
 
 PyDoc_STRVAR(profiler_doc, "\
-Profiler(timer=None, timeunit=None, subcalls=True, builtins=True)\n\
+Profiler(timer=None, timeunit=None, subcalls=True, builtins=True,\n\
+         callsites=False)\n\
 \n\
     Builds a profiler object using the specified timer function.\n\
     The default timer is a fast built-in one based on real time.\n\
     For custom timer functions returning integers, timeunit can\n\
     be a float specifying a scale (i.e. how long each integer unit\n\
     is, in seconds).\n\
+    If callsites is true, calls are also aggregated per line of\n\
+    the caller.\n\
 ");
 
 static PyType_Slot _lsprof_profiler_type_spec_slots[] = {
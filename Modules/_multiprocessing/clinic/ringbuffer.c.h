@@ -0,0 +1,288 @@
+/*[clinic input]
+preserve
+[clinic start generated code]*/
+
+#if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+#  include "pycore_gc.h"          // PyGC_Head
+#  include "pycore_runtime.h"     // _Py_ID()
+#endif
+#include "pycore_critical_section.h"// Py_BEGIN_CRITICAL_SECTION()
+#include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
+
+PyDoc_STRVAR(_multiprocessing_RingBuffer_send_bytes__doc__,
+"send_bytes($self, data, /, block=True, timeout=None)\n"
+"--\n"
+"\n"
+"Append a message to the ring buffer.\n"
+"\n"
+"Return False if there was not enough free space before the timeout.");
+
+#define _MULTIPROCESSING_RINGBUFFER_SEND_BYTES_METHODDEF    \
+    {"send_bytes", _PyCFunction_CAST(_multiprocessing_RingBuffer_send_bytes), METH_FASTCALL|METH_KEYWORDS, _multiprocessing_RingBuffer_send_bytes__doc__},
+
+static PyObject *
+_multiprocessing_RingBuffer_send_bytes_impl(RingBufferObject *self,
+                                            Py_buffer *data, int block,
+                                            PyObject *timeout_obj);
+
+static PyObject *
+_multiprocessing_RingBuffer_send_bytes(RingBufferObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 2
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(block), &_Py_ID(timeout), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"", "block", "timeout", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "send_bytes",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    Py_buffer data = {NULL, NULL};
+    int block = 1;
+    PyObject *timeout_obj = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 3, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (PyObject_GetBuffer(args[0], &data, PyBUF_SIMPLE) != 0) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[1]) {
+        block = PyObject_IsTrue(args[1]);
+        if (block < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    timeout_obj = args[2];
+skip_optional_pos:
+    return_value = _multiprocessing_RingBuffer_send_bytes_impl(self, &data, block, timeout_obj);
+
+exit:
+    /* Cleanup for data */
+    if (data.obj) {
+       PyBuffer_Release(&data);
+    }
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_multiprocessing_RingBuffer_recv_bytes__doc__,
+"recv_bytes($self, /, block=True, timeout=None)\n"
+"--\n"
+"\n"
+"Remove and return the oldest message of the ring buffer.\n"
+"\n"
+"Return None if no message arrived before the timeout.");
+
+#define _MULTIPROCESSING_RINGBUFFER_RECV_BYTES_METHODDEF    \
+    {"recv_bytes", _PyCFunction_CAST(_multiprocessing_RingBuffer_recv_bytes), METH_FASTCALL|METH_KEYWORDS, _multiprocessing_RingBuffer_recv_bytes__doc__},
+
+static PyObject *
+_multiprocessing_RingBuffer_recv_bytes_impl(RingBufferObject *self,
+                                            int block, PyObject *timeout_obj);
+
+static PyObject *
+_multiprocessing_RingBuffer_recv_bytes(RingBufferObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 2
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(block), &_Py_ID(timeout), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"block", "timeout", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "recv_bytes",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[2];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    int block = 1;
+    PyObject *timeout_obj = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 2, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[0]) {
+        block = PyObject_IsTrue(args[0]);
+        if (block < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    timeout_obj = args[1];
+skip_optional_pos:
+    return_value = _multiprocessing_RingBuffer_recv_bytes_impl(self, block, timeout_obj);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_multiprocessing_RingBuffer_empty__doc__,
+"empty($self, /)\n"
+"--\n"
+"\n"
+"Return True if the ring buffer holds no message.");
+
+#define _MULTIPROCESSING_RINGBUFFER_EMPTY_METHODDEF    \
+    {"empty", (PyCFunction)_multiprocessing_RingBuffer_empty, METH_NOARGS, _multiprocessing_RingBuffer_empty__doc__},
+
+static PyObject *
+_multiprocessing_RingBuffer_empty_impl(RingBufferObject *self);
+
+static PyObject *
+_multiprocessing_RingBuffer_empty(RingBufferObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _multiprocessing_RingBuffer_empty_impl(self);
+}
+
+PyDoc_STRVAR(_multiprocessing_RingBuffer_release__doc__,
+"release($self, /)\n"
+"--\n"
+"\n"
+"Release the underlying buffer.\n"
+"\n"
+"The ring buffer cannot be used anymore afterwards.");
+
+#define _MULTIPROCESSING_RINGBUFFER_RELEASE_METHODDEF    \
+    {"release", (PyCFunction)_multiprocessing_RingBuffer_release, METH_NOARGS, _multiprocessing_RingBuffer_release__doc__},
+
+static PyObject *
+_multiprocessing_RingBuffer_release_impl(RingBufferObject *self);
+
+static PyObject *
+_multiprocessing_RingBuffer_release(RingBufferObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _multiprocessing_RingBuffer_release_impl(self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_multiprocessing_RingBuffer__after_fork__doc__,
+"_after_fork($self, /)\n"
+"--\n"
+"\n"
+"Rezero the count of operations in progress after fork().");
+
+#define _MULTIPROCESSING_RINGBUFFER__AFTER_FORK_METHODDEF    \
+    {"_after_fork", (PyCFunction)_multiprocessing_RingBuffer__after_fork, METH_NOARGS, _multiprocessing_RingBuffer__after_fork__doc__},
+
+static PyObject *
+_multiprocessing_RingBuffer__after_fork_impl(RingBufferObject *self);
+
+static PyObject *
+_multiprocessing_RingBuffer__after_fork(RingBufferObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _multiprocessing_RingBuffer__after_fork_impl(self);
+}
+
+static PyObject *
+_multiprocessing_RingBuffer_impl(PyTypeObject *type, PyObject *buffer,
+                                 int create);
+
+static PyObject *
+_multiprocessing_RingBuffer(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 2
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(buffer), &_Py_ID(create), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"buffer", "create", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "RingBuffer",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[2];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 1;
+    PyObject *buffer;
+    int create = 0;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser, 1, 2, 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    buffer = fastargs[0];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    create = PyObject_IsTrue(fastargs[1]);
+    if (create < 0) {
+        goto exit;
+    }
+skip_optional_pos:
+    return_value = _multiprocessing_RingBuffer_impl(type, buffer, create);
+
+exit:
+    return return_value;
+}
+/*[clinic end generated code: output=427156326ebc021f input=a9049054013a1b77]*/
@@ -233,6 +233,29 @@ multiprocessing_exec(PyObject *module)
 
 #endif
 
+    PyTypeObject *ringbuffer_type = (PyTypeObject *)PyType_FromModuleAndSpec(
+                module, &_PyMp_RingBufferType_spec, NULL);
+    if (ringbuffer_type == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, ringbuffer_type) < 0) {
+        Py_DECREF(ringbuffer_type);
+        return -1;
+    }
+    PyObject *header_size = PyLong_FromSsize_t(_PyMp_RingBuffer_header_size);
+    if (header_size == NULL) {
+        Py_DECREF(ringbuffer_type);
+        return -1;
+    }
+    if (PyDict_SetItemString(ringbuffer_type->tp_dict, "HEADER_SIZE",
+                             header_size) < 0) {
+        Py_DECREF(header_size);
+        Py_DECREF(ringbuffer_type);
+        return -1;
+    }
+    Py_DECREF(header_size);
+    Py_DECREF(ringbuffer_type);
+
     /* Add configuration macros */
     PyObject *flags = PyDict_New();
     if (!flags) {
@@ -100,5 +100,7 @@ PyObject *_PyMp_SetError(PyObject *Type, int num);
 
 extern PyType_Spec _PyMp_SemLockType_spec;
 extern PyObject *_PyMp_sem_unlink(const char *name);
+extern PyType_Spec _PyMp_RingBufferType_spec;
+extern const Py_ssize_t _PyMp_RingBuffer_header_size;
 
 #endif /* MULTIPROCESSING_H */
@@ -0,0 +1,612 @@
+/*
+ * A ring buffer of messages in shared memory
+ *
+ * ringbuffer.c
+ *
+ * Licensed to PSF under a Contributor Agreement.
+ */
+
+#include "multiprocessing.h"
+#include "pycore_time.h"          // _PyDeadline_Init()
+
+#if defined(HAVE_LINUX_FUTEX_H) && defined(HAVE_SYS_SYSCALL_H)
+#  include <linux/futex.h>        // FUTEX_WAIT
+#  include <sys/syscall.h>        // SYS_futex
+#  ifdef SYS_futex
+#    define HAVE_RINGBUF_FUTEX
+#  endif
+#endif
+
+/*
+ * The buffer starts with a header shared by all the processes attached to
+ * it, followed by the data area.  Messages are stored in the data area as
+ * a 64-bit length followed by the payload, padded to a multiple of 8 bytes,
+ * so that a length never straddles the end of the data area.  'head' and
+ * 'tail' count the bytes ever written and read: they never wrap around.
+ *
+ * Producers are serialized by 'put_lock' and consumers by 'get_lock', so
+ * that the head is only written by the producer holding the lock and the
+ * tail by the consumer holding the lock.  Both locks are only held while
+ * copying a message.  A producer waiting for free space sleeps on
+ * 'space_seq', which consumers bump after each read, and a consumer waiting
+ * for a message sleeps on 'data_seq', which producers bump after each
+ * write.  The 'waiting' counters let the other side skip the wake-up
+ * system call when nobody sleeps, so that a busy queue makes no system
+ * calls at all.
+ *
+ * On Linux the waits use futexes, which work across processes on shared
+ * memory.  Elsewhere the waiting side polls with short sleeps.
+ */
+
+#define RINGBUF_MAGIC 0x676e6952704d7950ULL     /* "PyMpRing" */
+#define RINGBUF_ALIGN 8
+#define RINGBUF_SPIN 1000
+#define RINGBUF_POLL_DELAY 50000                /* nanoseconds */
+
+typedef struct {
+    uint64_t magic;
+    uint64_t capacity;              /* size of the data area */
+    char pad0[48];
+    /* Written by producers */
+    uint64_t head;
+    uint32_t put_lock;
+    uint32_t data_seq;
+    uint32_t writers_waiting;
+    char pad1[44];
+    /* Written by consumers */
+    uint64_t tail;
+    uint32_t get_lock;
+    uint32_t space_seq;
+    uint32_t readers_waiting;
+    char pad2[44];
+} ringbuf_header;
+
+static_assert(sizeof(ringbuf_header) == 192,
+              "the ring buffer header must keep its layout");
+
+typedef struct {
+    PyObject_HEAD
+    Py_buffer view;
+    ringbuf_header *header;
+    char *data;
+    uint64_t capacity;
+    Py_ssize_t active;              /* number of operations in progress */
+} RingBufferObject;
+
+/*[clinic input]
+module _multiprocessing
+class _multiprocessing.RingBuffer "RingBufferObject *" "&_PyMp_RingBufferType"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=fd7400a923d84a3a]*/
+
+#include "clinic/ringbuffer.c.h"
+
+/*
+ * Waiting and waking up, without the GIL
+ */
+
+/* Sleep while *addr == expected, at most 'timeout' nanoseconds if it is
+   not negative.  Return -1 if a signal interrupted the sleep, 0 otherwise:
+   the caller checks its condition again in any case. */
+static int
+ringbuf_futex_wait(uint32_t *addr, uint32_t expected, PyTime_t timeout)
+{
+#ifdef HAVE_RINGBUF_FUTEX
+    struct timespec ts, *pts = NULL;
+    if (timeout >= 0) {
+        _PyTime_AsTimespec_clamp(timeout, &ts);
+        pts = &ts;
+    }
+    if (syscall(SYS_futex, addr, FUTEX_WAIT, expected, pts, NULL, 0) < 0) {
+        return errno == EINTR ? -1 : 0;
+    }
+    return 0;
+#else
+    PyTime_t delay = RINGBUF_POLL_DELAY;
+    if (timeout >= 0 && timeout < delay) {
+        delay = timeout;
+    }
+#  ifdef MS_WINDOWS
+    Sleep(delay >= 1000000 ? 1 : 0);
+    return 0;
+#  else
+    struct timespec ts;
+    _PyTime_AsTimespec_clamp(delay, &ts);
+    return nanosleep(&ts, NULL) < 0 && errno == EINTR ? -1 : 0;
+#  endif
+#endif
+}
+
+static void
+ringbuf_futex_wake(uint32_t *addr, int count)
+{
+#ifdef HAVE_RINGBUF_FUTEX
+    syscall(SYS_futex, addr, FUTEX_WAKE, count, NULL, NULL, 0);
+#endif
+}
+
+/* Wait until *addr may differ from 'observed'.  Spin for a while first,
+   since the other side usually makes progress within microseconds.  If
+   'waiting' is not NULL, it counts the sleepers for the other side.
+   Return 0 when the caller should check its condition again, 1 when the
+   deadline has passed and -1 with an exception set if a signal handler
+   raised. */
+static int
+ringbuf_wait(uint32_t *addr, uint32_t *waiting, uint32_t observed,
+             PyTime_t endtime)
+{
+    PyTime_t timeout = -1;
+    if (endtime != 0) {
+        timeout = _PyDeadline_Get(endtime);
+        if (timeout <= 0) {
+            return 1;
+        }
+    }
+
+    int interrupted = 0;
+    Py_BEGIN_ALLOW_THREADS
+    int i = 0;
+    while (i < RINGBUF_SPIN
+           && _Py_atomic_load_uint32_relaxed(addr) == observed)
+    {
+        i++;
+    }
+    if (i == RINGBUF_SPIN) {
+        if (waiting != NULL) {
+            _Py_atomic_add_uint32(waiting, 1);
+        }
+        interrupted = ringbuf_futex_wait(addr, observed, timeout);
+        if (waiting != NULL) {
+            _Py_atomic_add_uint32(waiting, (uint32_t)-1);
+        }
+    }
+    Py_END_ALLOW_THREADS
+
+    if (interrupted && PyErr_CheckSignals() < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/* The locks have three states: 0 when unlocked, 1 when locked and 2 when
+   locked with possible sleepers.  They are only held while copying a
+   message, so non-blocking calls wait for them without a deadline. */
+static int
+ringbuf_lock(uint32_t *lock, PyTime_t endtime)
+{
+    uint32_t expected = 0;
+    if (_Py_atomic_compare_exchange_uint32(lock, &expected, 1)) {
+        return 0;
+    }
+    while (_Py_atomic_exchange_uint32(lock, 2) != 0) {
+        int res = ringbuf_wait(lock, NULL, 2, endtime);
+        if (res != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static void
+ringbuf_unlock(uint32_t *lock)
+{
+    if (_Py_atomic_exchange_uint32(lock, 0) == 2) {
+        ringbuf_futex_wake(lock, 1);
+    }
+}
+
+/*
+ * Access to the data area
+ */
+
+static inline uint64_t
+ringbuf_record_size(uint64_t len)
+{
+    return sizeof(uint64_t) + _Py_SIZE_ROUND_UP(len, RINGBUF_ALIGN);
+}
+
+static void
+ringbuf_copy_in(RingBufferObject *self, uint64_t pos, const char *src,
+                uint64_t len)
+{
+    uint64_t offset = pos % self->capacity;
+    uint64_t first = Py_MIN(len, self->capacity - offset);
+    memcpy(self->data + offset, src, first);
+    memcpy(self->data, src + first, len - first);
+}
+
+static void
+ringbuf_copy_out(RingBufferObject *self, uint64_t pos, char *dest,
+                 uint64_t len)
+{
+    uint64_t offset = pos % self->capacity;
+    uint64_t first = Py_MIN(len, self->capacity - offset);
+    memcpy(dest, self->data + offset, first);
+    memcpy(dest + first, self->data, len - first);
+}
+
+/* Operations run with the GIL released and must not see the buffer
+   released under their feet. */
+static int
+ringbuf_enter(RingBufferObject *self)
+{
+    int res = 0;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    if (self->header == NULL) {
+        PyErr_SetString(PyExc_ValueError,
+                        "operation on a released ring buffer");
+        res = -1;
+    }
+    else {
+        self->active++;
+    }
+    Py_END_CRITICAL_SECTION();
+    return res;
+}
+
+static void
+ringbuf_leave(RingBufferObject *self)
+{
+    Py_BEGIN_CRITICAL_SECTION(self);
+    self->active--;
+    Py_END_CRITICAL_SECTION();
+}
+
+static int
+parse_deadline(int block, PyObject *timeout_obj, PyTime_t *endtime)
+{
+    *endtime = 0;
+    if (!block) {
+        *endtime = _PyDeadline_Init(0);
+    }
+    else if (timeout_obj != Py_None) {
+        PyTime_t timeout;
+        if (_PyTime_FromSecondsObject(&timeout, timeout_obj,
+                                      _PyTime_ROUND_CEILING) < 0) {
+            return -1;
+        }
+        *endtime = _PyDeadline_Init(Py_MAX(timeout, 0));
+    }
+    return 0;
+}
+
+/*
+ * Ring buffer methods
+ */
+
+/*[clinic input]
+_multiprocessing.RingBuffer.send_bytes
+
+    data: Py_buffer
+    /
+    block: bool = True
+    timeout as timeout_obj: object = None
+
+Append a message to the ring buffer.
+
+Return False if there was not enough free space before the timeout.
+[clinic start generated code]*/
+
+static PyObject *
+_multiprocessing_RingBuffer_send_bytes_impl(RingBufferObject *self,
+                                            Py_buffer *data, int block,
+                                            PyObject *timeout_obj)
+/*[clinic end generated code: output=ec5b80382cf567ee input=8dbfb1efb368b471]*/
+{
+    PyTime_t endtime;
+    if (parse_deadline(block, timeout_obj, &endtime) < 0) {
+        return NULL;
+    }
+    if (ringbuf_enter(self) < 0) {
+        return NULL;
+    }
+
+    ringbuf_header *hdr = self->header;
+    uint64_t len = (uint64_t)data->len;
+    if (len > self->capacity - sizeof(uint64_t)) {
+        PyErr_Format(PyExc_ValueError,
+                     "message of %zd bytes does not fit in a ring buffer "
+                     "of %llu bytes", data->len,
+                     (unsigned long long)self->capacity);
+        ringbuf_leave(self);
+        return NULL;
+    }
+    uint64_t needed = ringbuf_record_size(len);
+
+    int res;
+    for (;;) {
+        res = ringbuf_lock(&hdr->put_lock, block ? endtime : 0);
+        if (res != 0) {
+            break;
+        }
+        /* Read the sequence before the tail, so that a consumer freeing
+           space in between makes the wait below return at once. */
+        uint32_t seq = _Py_atomic_load_uint32(&hdr->space_seq);
+        uint64_t head = _Py_atomic_load_uint64_relaxed(&hdr->head);
+        uint64_t tail = _Py_atomic_load_uint64_acquire(&hdr->tail);
+        if (self->capacity - (head - tail) >= needed) {
+            memcpy(self->data + head % self->capacity, &len, sizeof(len));
+            ringbuf_copy_in(self, head + sizeof(len), data->buf, len);
+            _Py_atomic_store_uint64_release(&hdr->head, head + needed);
+            ringbuf_unlock(&hdr->put_lock);
+            _Py_atomic_add_uint32(&hdr->data_seq, 1);
+            if (_Py_atomic_load_uint32(&hdr->readers_waiting)) {
+                ringbuf_futex_wake(&hdr->data_seq, INT_MAX);
+            }
+            break;
+        }
+        ringbuf_unlock(&hdr->put_lock);
+        res = ringbuf_wait(&hdr->space_seq, &hdr->writers_waiting, seq,
+                           endtime);
+        if (res != 0) {
+            break;
+        }
+    }
+
+    ringbuf_leave(self);
+    if (res < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(res == 0);
+}
+
+/*[clinic input]
+_multiprocessing.RingBuffer.recv_bytes
+
+    block: bool = True
+    timeout as timeout_obj: object = None
+
+Remove and return the oldest message of the ring buffer.
+
+Return None if no message arrived before the timeout.
+[clinic start generated code]*/
+
+static PyObject *
+_multiprocessing_RingBuffer_recv_bytes_impl(RingBufferObject *self,
+                                            int block, PyObject *timeout_obj)
+/*[clinic end generated code: output=a3c83d7c0a65cc0c input=ec713f5adbb6eef3]*/
+{
+    PyTime_t endtime;
+    if (parse_deadline(block, timeout_obj, &endtime) < 0) {
+        return NULL;
+    }
+    if (ringbuf_enter(self) < 0) {
+        return NULL;
+    }
+
+    ringbuf_header *hdr = self->header;
+    PyObject *result = NULL;
+    int res;
+    for (;;) {
+        res = ringbuf_lock(&hdr->get_lock, block ? endtime : 0);
+        if (res != 0) {
+            break;
+        }
+        uint32_t seq = _Py_atomic_load_uint32(&hdr->data_seq);
+        uint64_t tail = _Py_atomic_load_uint64_relaxed(&hdr->tail);
+        uint64_t head = _Py_atomic_load_uint64_acquire(&hdr->head);
+        if (head != tail) {
+            uint64_t len;
+            memcpy(&len, self->data + tail % self->capacity, sizeof(len));
+            if (len > self->capacity - sizeof(len)) {
+                ringbuf_unlock(&hdr->get_lock);
+                PyErr_SetString(PyExc_RuntimeError,
+                                "corrupted ring buffer");
+                res = -1;
+                break;
+            }
+            result = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)len);
+            if (result == NULL) {
+                ringbuf_unlock(&hdr->get_lock);
+                res = -1;
+                break;
+            }
+            ringbuf_copy_out(self, tail + sizeof(len),
+                             PyBytes_AS_STRING(result), len);
+            _Py_atomic_store_uint64_release(&hdr->tail,
+                                            tail + ringbuf_record_size(len));
+            ringbuf_unlock(&hdr->get_lock);
+            _Py_atomic_add_uint32(&hdr->space_seq, 1);
+            if (_Py_atomic_load_uint32(&hdr->writers_waiting)) {
+                ringbuf_futex_wake(&hdr->space_seq, INT_MAX);
+            }
+            break;
+        }
+        ringbuf_unlock(&hdr->get_lock);
+        res = ringbuf_wait(&hdr->data_seq, &hdr->readers_waiting, seq,
+                           endtime);
+        if (res != 0) {
+            break;
+        }
+    }
+
+    ringbuf_leave(self);
+    if (res > 0) {
+        Py_RETURN_NONE;
+    }
+    return result;
+}
+
+/*[clinic input]
+_multiprocessing.RingBuffer.empty
+
+Return True if the ring buffer holds no message.
+[clinic start generated code]*/
+
+static PyObject *
+_multiprocessing_RingBuffer_empty_impl(RingBufferObject *self)
+/*[clinic end generated code: output=3928df03fd0871db input=a84a2e95f8a10330]*/
+{
+    if (ringbuf_enter(self) < 0) {
+        return NULL;
+    }
+    ringbuf_header *hdr = self->header;
+    uint64_t tail = _Py_atomic_load_uint64_acquire(&hdr->tail);
+    uint64_t head = _Py_atomic_load_uint64_acquire(&hdr->head);
+    ringbuf_leave(self);
+    return PyBool_FromLong(head == tail);
+}
+
+/*[clinic input]
+@critical_section
+_multiprocessing.RingBuffer.release
+
+Release the underlying buffer.
+
+The ring buffer cannot be used anymore afterwards.
+[clinic start generated code]*/
+
+static PyObject *
+_multiprocessing_RingBuffer_release_impl(RingBufferObject *self)
+/*[clinic end generated code: output=9578b2bf0388f603 input=f6caa2a11b3e4a52]*/
+{
+    if (self->active > 0) {
+        PyErr_SetString(PyExc_BufferError,
+                        "ring buffer is in use by another thread");
+        return NULL;
+    }
+    if (self->header != NULL) {
+        PyBuffer_Release(&self->view);
+        self->header = NULL;
+        self->data = NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_multiprocessing.RingBuffer._after_fork
+
+Rezero the count of operations in progress after fork().
+[clinic start generated code]*/
+
+static PyObject *
+_multiprocessing_RingBuffer__after_fork_impl(RingBufferObject *self)
+/*[clinic end generated code: output=309db6d7fca01c45 input=3536ce9cd8648925]*/
+{
+    self->active = 0;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@classmethod
+_multiprocessing.RingBuffer.__new__
+
+    buffer: object
+    create: bool = False
+
+[clinic start generated code]*/
+
+static PyObject *
+_multiprocessing_RingBuffer_impl(PyTypeObject *type, PyObject *buffer,
+                                 int create)
+/*[clinic end generated code: output=6dd152759e781d9f input=d1d543bd07500b2f]*/
+{
+    RingBufferObject *self = (RingBufferObject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    if (PyObject_GetBuffer(buffer, &self->view, PyBUF_WRITABLE) < 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    if (!_Py_IS_ALIGNED(self->view.buf, RINGBUF_ALIGN)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "the ring buffer memory must be 8-byte aligned");
+        Py_DECREF(self);
+        return NULL;
+    }
+    if ((size_t)self->view.len < sizeof(ringbuf_header) + 2 * RINGBUF_ALIGN) {
+        PyErr_SetString(PyExc_ValueError, "buffer too small");
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    ringbuf_header *hdr = (ringbuf_header *)self->view.buf;
+    uint64_t available = (uint64_t)self->view.len - sizeof(ringbuf_header);
+    if (create) {
+        memset(hdr, 0, sizeof(*hdr));
+        hdr->capacity = available & ~(uint64_t)(RINGBUF_ALIGN - 1);
+        _Py_atomic_store_uint64_release(&hdr->magic, RINGBUF_MAGIC);
+    }
+    else if (_Py_atomic_load_uint64_acquire(&hdr->magic) != RINGBUF_MAGIC
+             || hdr->capacity > available
+             || hdr->capacity % RINGBUF_ALIGN != 0
+             || hdr->capacity < 2 * RINGBUF_ALIGN)
+    {
+        PyErr_SetString(PyExc_ValueError,
+                        "buffer does not hold a ring buffer");
+        Py_DECREF(self);
+        return NULL;
+    }
+    self->header = hdr;
+    self->data = (char *)self->view.buf + sizeof(ringbuf_header);
+    self->capacity = hdr->capacity;
+    return (PyObject *)self;
+}
+
+static PyObject *
+ringbuf_get_capacity(RingBufferObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromUnsignedLongLong(self->capacity);
+}
+
+static int
+ringbuf_traverse(RingBufferObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+static void
+ringbuf_dealloc(RingBufferObject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    PyBuffer_Release(&self->view);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyMethodDef ringbuf_methods[] = {
+    _MULTIPROCESSING_RINGBUFFER_SEND_BYTES_METHODDEF
+    _MULTIPROCESSING_RINGBUFFER_RECV_BYTES_METHODDEF
+    _MULTIPROCESSING_RINGBUFFER_EMPTY_METHODDEF
+    _MULTIPROCESSING_RINGBUFFER_RELEASE_METHODDEF
+    _MULTIPROCESSING_RINGBUFFER__AFTER_FORK_METHODDEF
+    {NULL}
+};
+
+static PyGetSetDef ringbuf_getsets[] = {
+    {"capacity", (getter)ringbuf_get_capacity, NULL,
+     "Size of the data area, in bytes.", NULL},
+    {NULL}
+};
+
+/*
+ * Ring buffer type
+ */
+
+static PyType_Slot _PyMp_RingBufferType_slots[] = {
+    {Py_tp_dealloc, ringbuf_dealloc},
+    {Py_tp_methods, ringbuf_methods},
+    {Py_tp_getset, ringbuf_getsets},
+    {Py_tp_new, _multiprocessing_RingBuffer},
+    {Py_tp_traverse, ringbuf_traverse},
+    {Py_tp_doc, (void *)PyDoc_STR(
+        "RingBuffer(buffer, create=False)\n"
+        "--\n\n"
+        "Ring buffer of messages in a writable buffer, usually shared memory.\n\n"
+        "If create is true, initialize the ring buffer, else attach to the\n"
+        "ring buffer initialized by another process.")},
+    {0, 0},
+};
+
+PyType_Spec _PyMp_RingBufferType_spec = {
+    .name = "_multiprocessing.RingBuffer",
+    .basicsize = sizeof(RingBufferObject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = _PyMp_RingBufferType_slots,
+};
+
+const Py_ssize_t _PyMp_RingBuffer_header_size = sizeof(ringbuf_header);
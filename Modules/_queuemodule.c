@@ -4,8 +4,10 @@
 
 #include "Python.h"
 #include "pycore_ceval.h"         // Py_MakePendingCalls()
+#include "pycore_lock.h"          // _Py_yield()
 #include "pycore_moduleobject.h"  // _PyModule_GetState()
 #include "pycore_parking_lot.h"
+#include "pycore_pymem.h"         // _PyMem_FreeDelayed()
 #include "pycore_time.h"          // _PyTime_FromSecondsObject()
 
 #include <stdbool.h>
@@ -13,7 +15,10 @@
 
 typedef struct {
     PyTypeObject *SimpleQueueType;
+    PyTypeObject *FastQueueType;
     PyObject *EmptyError;
+    PyObject *FullError;
+    PyObject *ShutDownError;
 } simplequeue_state;
 
 static simplequeue_state *
@@ -173,6 +178,26 @@ RingBuf_Put(RingBuf *buf, PyObject *item)
     return 0;
 }
 
+// Puts an item back at the head of the buffer.
+//
+// Returns 0 on success or -1 if the buffer failed to grow.
+//
+// Steals a reference to item.
+static int
+RingBuf_PutFront(RingBuf *buf, PyObject *item)
+{
+    if (buf->num_items == buf->items_cap) {
+        if (resize_ringbuf(buf, buf->items_cap * 2) < 0) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    buf->get_idx = (buf->get_idx - 1 + buf->items_cap) % buf->items_cap;
+    buf->items[buf->get_idx] = item;
+    buf->num_items++;
+    return 0;
+}
+
 static Py_ssize_t
 RingBuf_Len(RingBuf *buf)
 {
@@ -336,6 +361,77 @@ _queue_SimpleQueue_put_nowait_impl(simplequeueobject *self, PyObject *item)
     return _queue_SimpleQueue_put_impl(self, item, 0, Py_None);
 }
 
+static PyObject *
+simplequeue_put_many_lock_held(simplequeueobject *self, PyObject *seq)
+{
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    Py_ssize_t i = 0;
+
+    // Hand the first items off directly to the waiting threads
+    while (i < n && self->has_threads_waiting) {
+        HandoffData data = {
+            .handed_off = 0,
+            .item = Py_NewRef(items[i]),
+            .queue = self,
+        };
+        _PyParkingLot_Unpark(&self->has_threads_waiting,
+                             (_Py_unpark_fn_t *)maybe_handoff_item, &data);
+        if (!data.handed_off) {
+            Py_DECREF(items[i]);
+            break;
+        }
+        i++;
+    }
+
+    // Grow the buffer at most once for the other ones
+    RingBuf *buf = &self->buf;
+    Py_ssize_t needed = buf->num_items + (n - i);
+    if (needed > buf->items_cap) {
+        if (resize_ringbuf(buf, Py_MAX(needed, buf->items_cap * 2)) < 0) {
+            return PyErr_NoMemory();
+        }
+    }
+    for (; i < n; i++) {
+        if (RingBuf_Put(buf, Py_NewRef(items[i])) < 0) {
+            Py_DECREF(items[i]);
+            return NULL;
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_queue.SimpleQueue.put_many
+    items: object
+    /
+
+Put all the items of an iterable on the queue.
+
+This is equivalent to calling put() for each item, but the items
+are added at once, and handed off to the waiting threads in a row.
+
+[clinic start generated code]*/
+
+static PyObject *
+_queue_SimpleQueue_put_many(simplequeueobject *self, PyObject *items)
+/*[clinic end generated code: output=5f53df0b226d2025 input=ab26710527dbbd0c]*/
+{
+    // Consume the iterable before entering the critical section, as it may
+    // run arbitrary code.
+    PyObject *seq = PySequence_Fast(items,
+                                    "put_many() argument must be iterable");
+    if (seq == NULL) {
+        return NULL;
+    }
+    PyObject *res;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    res = simplequeue_put_many_lock_held(self, seq);
+    Py_END_CRITICAL_SECTION();
+    Py_DECREF(seq);
+    return res;
+}
+
 static PyObject *
 empty_error(PyTypeObject *cls)
 {
@@ -465,6 +561,55 @@ _queue_SimpleQueue_get_nowait_impl(simplequeueobject *self,
     return _queue_SimpleQueue_get_impl(self, cls, 0, Py_None);
 }
 
+/*[clinic input]
+@critical_section
+_queue.SimpleQueue.get_many
+
+    cls: defining_class
+    /
+    max_items: Py_ssize_t
+    block: bool = True
+    timeout as timeout_obj: object = None
+
+Remove and return a list of up to max_items items from the queue.
+
+Wait for the first item as get() does, with the same 'block' and
+'timeout' arguments, then also remove the items that are
+immediately available, up to max_items items in total.
+[clinic start generated code]*/
+
+static PyObject *
+_queue_SimpleQueue_get_many_impl(simplequeueobject *self, PyTypeObject *cls,
+                                 Py_ssize_t max_items, int block,
+                                 PyObject *timeout_obj)
+/*[clinic end generated code: output=5db4d0fe54081e21 input=5499d37412806715]*/
+{
+    if (max_items <= 0) {
+        PyErr_SetString(PyExc_ValueError, "'max_items' must be positive");
+        return NULL;
+    }
+    PyObject *item = _queue_SimpleQueue_get_impl(self, cls, block,
+                                                 timeout_obj);
+    if (item == NULL) {
+        return NULL;
+    }
+
+    RingBuf *buf = &self->buf;
+    Py_ssize_t n = 1 + Py_MIN(max_items - 1, RingBuf_Len(buf));
+    PyObject *list = PyList_New(n);
+    if (list == NULL) {
+        if (RingBuf_PutFront(buf, item) < 0) {
+            Py_DECREF(item);
+        }
+        return NULL;
+    }
+    PyList_SET_ITEM(list, 0, item);
+    for (Py_ssize_t i = 1; i < n; i++) {
+        PyList_SET_ITEM(list, i, RingBuf_Get(buf));
+    }
+    return list;
+}
+
 /*[clinic input]
 @critical_section
 _queue.SimpleQueue.empty -> bool
@@ -493,12 +638,778 @@ _queue_SimpleQueue_qsize_impl(simplequeueobject *self)
     return RingBuf_Len(&self->buf);
 }
 
+/* FastQueue is a FIFO queue with an optional maximum size, like queue.Queue,
+   built on an unbounded lock-free multi-producer multi-consumer list of
+   segments.
+
+   A segment is an array of item slots that is used only once.  A putter
+   claims a slot by incrementing put_idx and publishes its item with a
+   compare-and-swap from NULL.  A getter claims a slot by incrementing get_idx
+   and takes the item by swapping in SEGMENT_TAKEN; if it overtook the putter
+   of that slot, the compare-and-swap of the putter fails and the putter
+   retries with the next slot.  When a segment is exhausted, putters link a
+   new one and getters advance the head to it.  The old segment is released
+   with _PyMem_FreeDelayed(), so that it stays valid for the threads that may
+   still be reading it in the free-threaded build.
+
+   The number of items is tracked separately: putters increment `size` before
+   publishing an item, which enforces maxsize, and getters decrement it after
+   taking one.  Blocked threads park on the put_seq and get_seq counters,
+   which are incremented after every put and get; they are only unparked when
+   the counts of waiting threads show that someone may be parked. */
+
+#define SEGMENT_MIN_CAPACITY 16
+#define SEGMENT_MAX_CAPACITY 1024
+#define SEGMENT_TAKEN ((PyObject *)1)
+
+typedef struct Segment {
+    struct Segment *next;
+    Py_ssize_t capacity;
+
+    // The indices claimed by putters and by getters are kept on different
+    // cache lines.
+    char pad0[64];
+    Py_ssize_t put_idx;
+    char pad1[64 - sizeof(Py_ssize_t)];
+    Py_ssize_t get_idx;
+    char pad2[64 - sizeof(Py_ssize_t)];
+
+    PyObject *items[];
+} Segment;
+
+static Segment *
+Segment_New(Py_ssize_t capacity)
+{
+    Segment *seg = PyMem_Calloc(
+        1, sizeof(Segment) + capacity * sizeof(PyObject *));
+    if (seg == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    seg->capacity = capacity;
+    return seg;
+}
+
+typedef struct {
+    PyObject_HEAD
+
+    // Segment to get items from
+    Segment *head;
+
+    // Segment to put items to
+    Segment *tail;
+
+    Py_ssize_t maxsize;
+
+    // Number of items stored or being stored
+    Py_ssize_t size;
+
+    Py_ssize_t unfinished_tasks;
+
+    // Incremented after each put and get, for the blocked threads to park on
+    uint32_t put_seq;
+    uint32_t get_seq;
+
+    // Number of threads blocked in get(), put() and join()
+    Py_ssize_t getters;
+    Py_ssize_t putters;
+    Py_ssize_t joiners;
+
+    int is_shutdown;
+
+    PyObject *weakreflist;
+} fastqueueobject;
+
+/*[clinic input]
+class _queue.FastQueue "fastqueueobject *" "simplequeue_get_state_by_type(type)->FastQueueType"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=26e8f679fade2d91]*/
+
+// Appends an item, stealing a reference to it.
+//
+// Returns 0 on success or -1 if a new segment could not be allocated.
+static int
+fastqueue_push(fastqueueobject *self, PyObject *item)
+{
+    for (;;) {
+        Segment *tail = _Py_atomic_load_ptr(&self->tail);
+        Py_ssize_t idx = _Py_atomic_add_ssize(&tail->put_idx, 1);
+        if (idx < tail->capacity) {
+            PyObject *expected = NULL;
+            if (_Py_atomic_compare_exchange_ptr(&tail->items[idx],
+                                                &expected, item)) {
+                return 0;
+            }
+            // A getter gave up on this slot, try the next one.
+            continue;
+        }
+
+        // The segment is exhausted: link a new one, or help the thread
+        // that linked it to advance the tail.
+        Segment *next = _Py_atomic_load_ptr(&tail->next);
+        if (next == NULL) {
+            Segment *seg = Segment_New(
+                Py_MIN(tail->capacity * 2, SEGMENT_MAX_CAPACITY));
+            if (seg == NULL) {
+                return -1;
+            }
+            seg->items[0] = item;
+            seg->put_idx = 1;
+            if (_Py_atomic_compare_exchange_ptr(&tail->next, &next, seg)) {
+                _Py_atomic_compare_exchange_ptr(&self->tail, &tail, seg);
+                return 0;
+            }
+            // Another thread linked its segment first (now in next).
+            PyMem_Free(seg);
+        }
+        _Py_atomic_compare_exchange_ptr(&self->tail, &tail, next);
+    }
+}
+
+// Removes the first item and returns a strong reference to it, or NULL if
+// the queue is empty.  Does not set an exception.
+static PyObject *
+fastqueue_pop(fastqueueobject *self)
+{
+    for (;;) {
+        Segment *head = _Py_atomic_load_ptr(&self->head);
+        if (_Py_atomic_load_ssize(&head->get_idx) >=
+                _Py_atomic_load_ssize(&head->put_idx) &&
+            _Py_atomic_load_ptr(&head->next) == NULL)
+        {
+            return NULL;
+        }
+
+        Py_ssize_t idx = _Py_atomic_add_ssize(&head->get_idx, 1);
+        if (idx < head->capacity) {
+            PyObject *item = _Py_atomic_exchange_ptr(&head->items[idx],
+                                                     SEGMENT_TAKEN);
+            if (item != NULL) {
+                return item;
+            }
+            // The putter that claimed this slot has not published its item
+            // yet; it will retry with another slot.
+            continue;
+        }
+
+        Segment *next = _Py_atomic_load_ptr(&head->next);
+        if (next == NULL) {
+            return NULL;
+        }
+        if (_Py_atomic_compare_exchange_ptr(&self->head, &head, next)) {
+            _PyMem_FreeDelayed(head);
+        }
+    }
+}
+
+// Accounts for a new item.  Returns 0 if the queue is full, 1 otherwise.
+static int
+fastqueue_reserve(fastqueueobject *self)
+{
+    Py_ssize_t maxsize = _Py_atomic_load_ssize_relaxed(&self->maxsize);
+    if (maxsize <= 0) {
+        _Py_atomic_add_ssize(&self->size, 1);
+        return 1;
+    }
+    Py_ssize_t size = _Py_atomic_load_ssize(&self->size);
+    do {
+        if (size >= maxsize) {
+            return 0;
+        }
+    } while (!_Py_atomic_compare_exchange_ssize(&self->size, &size,
+                                                size + 1));
+    return 1;
+}
+
+static void
+unpark_one(void *arg, void *park_arg, int has_more_waiters)
+{
+}
+
+// Bumps *seq and unparks one of the threads parked on it, if any.
+static void
+fastqueue_notify(uint32_t *seq, Py_ssize_t *waiters)
+{
+    _Py_atomic_add_uint32(seq, 1);
+    if (_Py_atomic_load_ssize(waiters) > 0) {
+        _PyParkingLot_Unpark(seq, unpark_one, NULL);
+    }
+}
+
+// Bumps *seq and unparks all the threads parked on it.
+static void
+fastqueue_notify_all(uint32_t *seq)
+{
+    _Py_atomic_add_uint32(seq, 1);
+    _PyParkingLot_UnparkAll(seq);
+}
+
+static int
+fastqueue_can_get(fastqueueobject *self)
+{
+    return (_Py_atomic_load_ssize(&self->size) > 0 ||
+            _Py_atomic_load_int(&self->is_shutdown));
+}
+
+static int
+fastqueue_can_put(fastqueueobject *self)
+{
+    Py_ssize_t maxsize = _Py_atomic_load_ssize_relaxed(&self->maxsize);
+    return (maxsize <= 0 ||
+            _Py_atomic_load_ssize(&self->size) < maxsize ||
+            _Py_atomic_load_int(&self->is_shutdown));
+}
+
+// Parks the thread until *seq is bumped, unless can_proceed() already
+// returns true once the thread is counted in *waiters.
+//
+// Returns Py_PARK_TIMEOUT if endtime has already passed, or else the result
+// of _PyParkingLot_Park() with its timeouts reported as Py_PARK_OK: the
+// caller checks its condition once more before giving up.
+static int
+fastqueue_park(fastqueueobject *self, uint32_t *seq, Py_ssize_t *waiters,
+               int (*can_proceed)(fastqueueobject *), PyTime_t endtime)
+{
+    PyTime_t timeout_ns = -1;
+    if (endtime != 0) {
+        timeout_ns = _PyDeadline_Get(endtime);
+        if (timeout_ns < 0) {
+            return Py_PARK_TIMEOUT;
+        }
+    }
+
+    int st = Py_PARK_AGAIN;
+    _Py_atomic_add_ssize(waiters, 1);
+    uint32_t expected = _Py_atomic_load_uint32(seq);
+    if (!can_proceed(self)) {
+        st = _PyParkingLot_Park(seq, &expected, sizeof(expected),
+                                timeout_ns, NULL, /* detach */ 1);
+    }
+    _Py_atomic_add_ssize(waiters, -1);
+    return st == Py_PARK_TIMEOUT ? Py_PARK_OK : st;
+}
+
+// Marks n tasks as done, unblocking join() when none is left.
+static void
+fastqueue_finish_tasks(fastqueueobject *self, Py_ssize_t n)
+{
+    if (_Py_atomic_add_ssize(&self->unfinished_tasks, -n) == n &&
+        _Py_atomic_load_ssize(&self->joiners) > 0)
+    {
+        _PyParkingLot_UnparkAll(&self->unfinished_tasks);
+    }
+}
+
+static int
+parse_deadline(PyObject *timeout_obj, PyTime_t *endtime)
+{
+    *endtime = 0;
+    if (!Py_IsNone(timeout_obj)) {
+        PyTime_t timeout;
+        if (_PyTime_FromSecondsObject(&timeout,
+                                      timeout_obj, _PyTime_ROUND_CEILING) < 0) {
+            return -1;
+        }
+        if (timeout < 0) {
+            PyErr_SetString(PyExc_ValueError,
+                            "'timeout' must be a non-negative number");
+            return -1;
+        }
+        *endtime = _PyDeadline_Init(timeout);
+    }
+    return 0;
+}
+
+static PyObject *
+full_error(PyTypeObject *cls)
+{
+    PyObject *module = PyType_GetModule(cls);
+    assert(module != NULL);
+    simplequeue_state *state = simplequeue_get_state(module);
+    PyErr_SetNone(state->FullError);
+    return NULL;
+}
+
+static PyObject *
+shutdown_error(PyTypeObject *cls)
+{
+    PyObject *module = PyType_GetModule(cls);
+    assert(module != NULL);
+    simplequeue_state *state = simplequeue_get_state(module);
+    PyErr_SetNone(state->ShutDownError);
+    return NULL;
+}
+
+static int
+fastqueue_clear(fastqueueobject *self)
+{
+    PyObject *item;
+    while ((item = fastqueue_pop(self)) != NULL) {
+        _Py_atomic_add_ssize(&self->size, -1);
+        Py_DECREF(item);
+    }
+    return 0;
+}
+
+static void
+fastqueue_dealloc(fastqueueobject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+
+    PyObject_GC_UnTrack(self);
+    (void)fastqueue_clear(self);
+    if (self->weakreflist != NULL) {
+        PyObject_ClearWeakRefs((PyObject *) self);
+    }
+    Segment *seg = self->head;
+    while (seg != NULL) {
+        Segment *next = seg->next;
+        PyMem_Free(seg);
+        seg = next;
+    }
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static int
+fastqueue_traverse(fastqueueobject *self, visitproc visit, void *arg)
+{
+    for (Segment *seg = self->head; seg != NULL; seg = seg->next) {
+        Py_ssize_t end = Py_MIN(seg->put_idx, seg->capacity);
+        for (Py_ssize_t i = Py_MIN(seg->get_idx, end); i < end; i++) {
+            PyObject *item = seg->items[i];
+            if (item != NULL && item != SEGMENT_TAKEN) {
+                Py_VISIT(item);
+            }
+        }
+    }
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+/*[clinic input]
+@classmethod
+_queue.FastQueue.__new__ as fastqueue_new
+
+    maxsize: Py_ssize_t = 0
+
+Create a lock-free FIFO queue object with a given maximum size.
+
+If maxsize is <= 0, the queue size is infinite.
+[clinic start generated code]*/
+
+static PyObject *
+fastqueue_new_impl(PyTypeObject *type, Py_ssize_t maxsize)
+/*[clinic end generated code: output=783f3b23e0eca408 input=fc271244765870b9]*/
+{
+    fastqueueobject *self;
+
+    self = (fastqueueobject *) type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->weakreflist = NULL;
+    self->maxsize = maxsize;
+    self->head = self->tail = Segment_New(SEGMENT_MIN_CAPACITY);
+    if (self->head == NULL) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *) self;
+}
+
+/*[clinic input]
+_queue.FastQueue.put
+
+    cls: defining_class
+    /
+    item: object
+    block: bool = True
+    timeout as timeout_obj: object = None
+
+Put an item into the queue.
+
+If optional args 'block' is true and 'timeout' is None (the default),
+block if necessary until a free slot is available. If 'timeout' is
+a non-negative number, it blocks at most 'timeout' seconds and raises
+the Full exception if no free slot was available within that time.
+Otherwise ('block' is false), put an item on the queue if a free slot
+is immediately available, else raise the Full exception ('timeout'
+is ignored in that case).
+
+Raises ShutDown if the queue has been shut down.
+[clinic start generated code]*/
+
+static PyObject *
+_queue_FastQueue_put_impl(fastqueueobject *self, PyTypeObject *cls,
+                          PyObject *item, int block, PyObject *timeout_obj)
+/*[clinic end generated code: output=e8b8453507420fbe input=348df76c75e07ced]*/
+{
+    PyTime_t endtime = 0;
+    if (block && _Py_atomic_load_ssize_relaxed(&self->maxsize) > 0 &&
+        parse_deadline(timeout_obj, &endtime) < 0)
+    {
+        return NULL;
+    }
+
+    for (;;) {
+        if (_Py_atomic_load_int(&self->is_shutdown)) {
+            return shutdown_error(cls);
+        }
+        if (fastqueue_reserve(self)) {
+            break;
+        }
+        if (!block) {
+            return full_error(cls);
+        }
+
+        int st = fastqueue_park(self, &self->get_seq, &self->putters,
+                                fastqueue_can_put, endtime);
+        if (st == Py_PARK_TIMEOUT) {
+            return full_error(cls);
+        }
+        if (st == Py_PARK_INTR && Py_MakePendingCalls() < 0) {
+            // Let another putter take the free slot we were woken up for.
+            if (fastqueue_can_put(self)) {
+                fastqueue_notify(&self->get_seq, &self->putters);
+            }
+            return NULL;
+        }
+    }
+
+    // The queue may have been shut down while the slot was reserved: back
+    // out, so that shutdown(immediate=True) does not wait for this item.
+    if (_Py_atomic_load_int(&self->is_shutdown)) {
+        _Py_atomic_add_ssize(&self->size, -1);
+        return shutdown_error(cls);
+    }
+    _Py_atomic_add_ssize(&self->unfinished_tasks, 1);
+    if (fastqueue_push(self, Py_NewRef(item)) < 0) {
+        Py_DECREF(item);
+        _Py_atomic_add_ssize(&self->size, -1);
+        fastqueue_finish_tasks(self, 1);
+        return NULL;
+    }
+    fastqueue_notify(&self->put_seq, &self->getters);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_queue.FastQueue.put_nowait
+
+    cls: defining_class
+    /
+    item: object
+
+Put an item into the queue without blocking.
+
+Only enqueue the item if a free slot is immediately available.
+Otherwise raise the Full exception.
+[clinic start generated code]*/
+
+static PyObject *
+_queue_FastQueue_put_nowait_impl(fastqueueobject *self, PyTypeObject *cls,
+                                 PyObject *item)
+/*[clinic end generated code: output=73709ffb811a5172 input=2259c23fb7f3b902]*/
+{
+    return _queue_FastQueue_put_impl(self, cls, item, 0, Py_None);
+}
+
+/*[clinic input]
+_queue.FastQueue.get
+
+    cls: defining_class
+    /
+    block: bool = True
+    timeout as timeout_obj: object = None
+
+Remove and return an item from the queue.
+
+If optional args 'block' is true and 'timeout' is None (the default),
+block if necessary until an item is available. If 'timeout' is
+a non-negative number, it blocks at most 'timeout' seconds and raises
+the Empty exception if no item was available within that time.
+Otherwise ('block' is false), return an item if one is immediately
+available, else raise the Empty exception ('timeout' is ignored
+in that case).
+
+Raises ShutDown if the queue has been shut down and is empty,
+or if the queue has been shut down immediately.
+[clinic start generated code]*/
+
+static PyObject *
+_queue_FastQueue_get_impl(fastqueueobject *self, PyTypeObject *cls,
+                          int block, PyObject *timeout_obj)
+/*[clinic end generated code: output=52580abdda689899 input=fe650cc8279d0b91]*/
+{
+    PyTime_t endtime = 0;
+    if (block && parse_deadline(timeout_obj, &endtime) < 0) {
+        return NULL;
+    }
+
+    for (;;) {
+        PyObject *item = fastqueue_pop(self);
+        if (item != NULL) {
+            _Py_atomic_add_ssize(&self->size, -1);
+            fastqueue_notify(&self->get_seq, &self->putters);
+            return item;
+        }
+        if (_Py_atomic_load_int(&self->is_shutdown)) {
+            if (_Py_atomic_load_ssize(&self->size) > 0) {
+                // A put that started before the shutdown is publishing
+                // its item.
+                _Py_yield();
+                continue;
+            }
+            return shutdown_error(cls);
+        }
+        if (!block) {
+            return empty_error(cls);
+        }
+
+        int st = fastqueue_park(self, &self->put_seq, &self->getters,
+                                fastqueue_can_get, endtime);
+        if (st == Py_PARK_TIMEOUT) {
+            return empty_error(cls);
+        }
+        if (st == Py_PARK_INTR && Py_MakePendingCalls() < 0) {
+            // Let another getter take the item we were woken up for.
+            if (_Py_atomic_load_ssize(&self->size) > 0) {
+                fastqueue_notify(&self->put_seq, &self->getters);
+            }
+            return NULL;
+        }
+    }
+}
+
+/*[clinic input]
+_queue.FastQueue.get_nowait
+
+    cls: defining_class
+    /
+
+Remove and return an item from the queue without blocking.
+
+Only get an item if one is immediately available. Otherwise
+raise the Empty exception.
+[clinic start generated code]*/
+
+static PyObject *
+_queue_FastQueue_get_nowait_impl(fastqueueobject *self, PyTypeObject *cls)
+/*[clinic end generated code: output=4f77d23a9e3234af input=47d474dff089d50e]*/
+{
+    return _queue_FastQueue_get_impl(self, cls, 0, Py_None);
+}
+
+/*[clinic input]
+_queue.FastQueue.task_done
+
+Indicate that a formerly enqueued task is complete.
+
+Used by Queue consumer threads.  For each get() used to fetch a task,
+a subsequent call to task_done() tells the queue that the processing
+on the task is complete.
+
+If a join() is currently blocking, it will resume when all items
+have been processed (meaning that a task_done() call was received
+for every item that had been put() into the queue).
+
+shutdown(immediate=True) calls task_done() for each remaining item in
+the queue.
+
+Raises a ValueError if called more times than there were items
+placed in the queue.
+[clinic start generated code]*/
+
+static PyObject *
+_queue_FastQueue_task_done_impl(fastqueueobject *self)
+/*[clinic end generated code: output=a4d35100e2c694db input=628d532d8527aaf3]*/
+{
+    Py_ssize_t unfinished = _Py_atomic_load_ssize(&self->unfinished_tasks);
+    do {
+        if (unfinished <= 0) {
+            PyErr_SetString(PyExc_ValueError,
+                            "task_done() called too many times");
+            return NULL;
+        }
+    } while (!_Py_atomic_compare_exchange_ssize(&self->unfinished_tasks,
+                                                &unfinished, unfinished - 1));
+    if (unfinished == 1 && _Py_atomic_load_ssize(&self->joiners) > 0) {
+        _PyParkingLot_UnparkAll(&self->unfinished_tasks);
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_queue.FastQueue.join
+
+Blocks until all items in the Queue have been gotten and processed.
+
+The count of unfinished tasks goes up whenever an item is added to the
+queue. The count goes down whenever a consumer thread calls task_done()
+to indicate the item was retrieved and all work on it is complete.
+
+When the count of unfinished tasks drops to zero, join() unblocks.
+[clinic start generated code]*/
+
+static PyObject *
+_queue_FastQueue_join_impl(fastqueueobject *self)
+/*[clinic end generated code: output=93bb9a8216423f24 input=c7526551e1d13b8f]*/
+{
+    for (;;) {
+        int st = Py_PARK_AGAIN;
+        _Py_atomic_add_ssize(&self->joiners, 1);
+        Py_ssize_t unfinished = _Py_atomic_load_ssize(&self->unfinished_tasks);
+        if (unfinished > 0) {
+            st = _PyParkingLot_Park(&self->unfinished_tasks, &unfinished,
+                                    sizeof(unfinished), -1, NULL,
+                                    /* detach */ 1);
+        }
+        _Py_atomic_add_ssize(&self->joiners, -1);
+        if (unfinished <= 0) {
+            Py_RETURN_NONE;
+        }
+        if (st == Py_PARK_INTR && Py_MakePendingCalls() < 0) {
+            return NULL;
+        }
+    }
+}
+
+/*[clinic input]
+_queue.FastQueue.shutdown
+
+    immediate: bool = False
+
+Shut-down the queue, making queue gets and puts raise ShutDown.
+
+By default, gets will only raise once the queue is empty. Set
+'immediate' to True to make gets raise immediately instead.
+
+All blocked callers of put() and get() will be unblocked. If
+'immediate', a task is marked as done for each item remaining in
+the queue, which may unblock callers of join().
+[clinic start generated code]*/
+
+static PyObject *
+_queue_FastQueue_shutdown_impl(fastqueueobject *self, int immediate)
+/*[clinic end generated code: output=f943f315cd181acd input=9add3f1075aaa509]*/
+{
+    _Py_atomic_store_int(&self->is_shutdown, 1);
+    if (immediate) {
+        // The puts that reserved a slot before the shutdown publish their
+        // item shortly, the others back out.
+        while (_Py_atomic_load_ssize(&self->size) > 0) {
+            PyObject *item = fastqueue_pop(self);
+            if (item == NULL) {
+                _Py_yield();
+                continue;
+            }
+            _Py_atomic_add_ssize(&self->size, -1);
+            Py_DECREF(item);
+            Py_ssize_t unfinished =
+                _Py_atomic_load_ssize(&self->unfinished_tasks);
+            while (unfinished > 0 &&
+                   !_Py_atomic_compare_exchange_ssize(&self->unfinished_tasks,
+                                                      &unfinished,
+                                                      unfinished - 1))
+            {
+            }
+        }
+        // Release all blocked threads in join()
+        _PyParkingLot_UnparkAll(&self->unfinished_tasks);
+    }
+    // All getters need to re-check queue-empty to raise ShutDown
+    fastqueue_notify_all(&self->put_seq);
+    fastqueue_notify_all(&self->get_seq);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_queue.FastQueue.empty -> bool
+
+Return True if the queue is empty, False otherwise (not reliable!).
+[clinic start generated code]*/
+
+static int
+_queue_FastQueue_empty_impl(fastqueueobject *self)
+/*[clinic end generated code: output=f9996493aa1238ff input=f40a703dbca2bfb3]*/
+{
+    return _Py_atomic_load_ssize(&self->size) <= 0;
+}
+
+/*[clinic input]
+_queue.FastQueue.full -> bool
+
+Return True if the queue is full, False otherwise (not reliable!).
+[clinic start generated code]*/
+
+static int
+_queue_FastQueue_full_impl(fastqueueobject *self)
+/*[clinic end generated code: output=7677be5d09e28430 input=56a68da49859fbc1]*/
+{
+    Py_ssize_t maxsize = _Py_atomic_load_ssize_relaxed(&self->maxsize);
+    return 0 < maxsize && maxsize <= _Py_atomic_load_ssize(&self->size);
+}
+
+/*[clinic input]
+_queue.FastQueue.qsize -> Py_ssize_t
+
+Return the approximate size of the queue (not reliable!).
+[clinic start generated code]*/
+
+static Py_ssize_t
+_queue_FastQueue_qsize_impl(fastqueueobject *self)
+/*[clinic end generated code: output=10a3e44d45d1a363 input=72ac68be7dfbb026]*/
+{
+    return Py_MAX(_Py_atomic_load_ssize(&self->size), 0);
+}
+
+static PyObject *
+fastqueue_get_maxsize(fastqueueobject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSsize_t(_Py_atomic_load_ssize_relaxed(&self->maxsize));
+}
+
+static int
+fastqueue_set_maxsize(fastqueueobject *self, PyObject *value,
+                      void *Py_UNUSED(closure))
+{
+    if (value == NULL) {
+        PyErr_SetString(PyExc_AttributeError, "cannot delete attribute");
+        return -1;
+    }
+    Py_ssize_t maxsize = PyLong_AsSsize_t(value);
+    if (maxsize == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    _Py_atomic_store_ssize_relaxed(&self->maxsize, maxsize);
+    // Blocked putters need to re-check queue-full
+    fastqueue_notify_all(&self->get_seq);
+    return 0;
+}
+
+static PyObject *
+fastqueue_get_unfinished_tasks(fastqueueobject *self,
+                               void *Py_UNUSED(closure))
+{
+    return PyLong_FromSsize_t(_Py_atomic_load_ssize(&self->unfinished_tasks));
+}
+
+static PyObject *
+fastqueue_get_is_shutdown(fastqueueobject *self, void *Py_UNUSED(closure))
+{
+    return PyBool_FromLong(_Py_atomic_load_int(&self->is_shutdown));
+}
+
 static int
 queue_traverse(PyObject *m, visitproc visit, void *arg)
 {
     simplequeue_state *state = simplequeue_get_state(m);
     Py_VISIT(state->SimpleQueueType);
+    Py_VISIT(state->FastQueueType);
     Py_VISIT(state->EmptyError);
+    Py_VISIT(state->FullError);
+    Py_VISIT(state->ShutDownError);
     return 0;
 }
 
@@ -507,7 +1418,10 @@ queue_clear(PyObject *m)
 {
     simplequeue_state *state = simplequeue_get_state(m);
     Py_CLEAR(state->SimpleQueueType);
+    Py_CLEAR(state->FastQueueType);
     Py_CLEAR(state->EmptyError);
+    Py_CLEAR(state->FullError);
+    Py_CLEAR(state->ShutDownError);
     return 0;
 }
 
@@ -523,8 +1437,10 @@ queue_free(void *m)
 static PyMethodDef simplequeue_methods[] = {
     _QUEUE_SIMPLEQUEUE_EMPTY_METHODDEF
     _QUEUE_SIMPLEQUEUE_GET_METHODDEF
+    _QUEUE_SIMPLEQUEUE_GET_MANY_METHODDEF
     _QUEUE_SIMPLEQUEUE_GET_NOWAIT_METHODDEF
     _QUEUE_SIMPLEQUEUE_PUT_METHODDEF
+    _QUEUE_SIMPLEQUEUE_PUT_MANY_METHODDEF
     _QUEUE_SIMPLEQUEUE_PUT_NOWAIT_METHODDEF
     _QUEUE_SIMPLEQUEUE_QSIZE_METHODDEF
     {"__class_getitem__",    Py_GenericAlias,
@@ -556,6 +1472,55 @@ static PyType_Spec simplequeue_spec = {
     .slots = simplequeue_slots,
 };
 
+static PyMethodDef fastqueue_methods[] = {
+    _QUEUE_FASTQUEUE_EMPTY_METHODDEF
+    _QUEUE_FASTQUEUE_FULL_METHODDEF
+    _QUEUE_FASTQUEUE_GET_METHODDEF
+    _QUEUE_FASTQUEUE_GET_NOWAIT_METHODDEF
+    _QUEUE_FASTQUEUE_JOIN_METHODDEF
+    _QUEUE_FASTQUEUE_PUT_METHODDEF
+    _QUEUE_FASTQUEUE_PUT_NOWAIT_METHODDEF
+    _QUEUE_FASTQUEUE_QSIZE_METHODDEF
+    _QUEUE_FASTQUEUE_SHUTDOWN_METHODDEF
+    _QUEUE_FASTQUEUE_TASK_DONE_METHODDEF
+    {"__class_getitem__",    Py_GenericAlias,
+    METH_O|METH_CLASS,       PyDoc_STR("See PEP 585")},
+    {NULL,           NULL}              /* sentinel */
+};
+
+static PyGetSetDef fastqueue_getsets[] = {
+    {"maxsize", (getter)fastqueue_get_maxsize,
+     (setter)fastqueue_set_maxsize, NULL},
+    {"unfinished_tasks", (getter)fastqueue_get_unfinished_tasks, NULL, NULL},
+    {"is_shutdown", (getter)fastqueue_get_is_shutdown, NULL, NULL},
+    {NULL},
+};
+
+static struct PyMemberDef fastqueue_members[] = {
+    {"__weaklistoffset__", Py_T_PYSSIZET, offsetof(fastqueueobject, weakreflist), Py_READONLY},
+    {NULL},
+};
+
+static PyType_Slot fastqueue_slots[] = {
+    {Py_tp_dealloc, fastqueue_dealloc},
+    {Py_tp_doc, (void *)fastqueue_new__doc__},
+    {Py_tp_traverse, fastqueue_traverse},
+    {Py_tp_clear, fastqueue_clear},
+    {Py_tp_members, fastqueue_members},
+    {Py_tp_getset, fastqueue_getsets},
+    {Py_tp_methods, fastqueue_methods},
+    {Py_tp_new, fastqueue_new},
+    {0, NULL},
+};
+
+static PyType_Spec fastqueue_spec = {
+    .name = "_queue.FastQueue",
+    .basicsize = sizeof(fastqueueobject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = fastqueue_slots,
+};
+
 
 /* Initialization function */
 
@@ -579,6 +1544,28 @@ queuemodule_exec(PyObject *module)
         return -1;
     }
 
+    state->FullError = PyErr_NewExceptionWithDoc(
+        "_queue.Full",
+        "Exception raised by Queue.put(block=0)/put_nowait().",
+        NULL, NULL);
+    if (state->FullError == NULL) {
+        return -1;
+    }
+    if (PyModule_AddObjectRef(module, "Full", state->FullError) < 0) {
+        return -1;
+    }
+
+    state->ShutDownError = PyErr_NewExceptionWithDoc(
+        "_queue.ShutDown",
+        "Raised when put/get with shut-down queue.",
+        NULL, NULL);
+    if (state->ShutDownError == NULL) {
+        return -1;
+    }
+    if (PyModule_AddObjectRef(module, "ShutDown", state->ShutDownError) < 0) {
+        return -1;
+    }
+
     state->SimpleQueueType = (PyTypeObject *)PyType_FromModuleAndSpec(
         module, &simplequeue_spec, NULL);
     if (state->SimpleQueueType == NULL) {
@@ -588,6 +1575,15 @@ queuemodule_exec(PyObject *module)
         return -1;
     }
 
+    state->FastQueueType = (PyTypeObject *)PyType_FromModuleAndSpec(
+        module, &fastqueue_spec, NULL);
+    if (state->FastQueueType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->FastQueueType) < 0) {
+        return -1;
+    }
+
     return 0;
 }
 
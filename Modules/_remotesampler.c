@@ -0,0 +1,1093 @@
+/* Out of process sampling profiler.
+ *
+ * A Sampler attaches to another process running the same version of Python
+ * and reads the stacks of its threads through the offsets published in
+ * _PyRuntime.debug_offsets (see _Py_DebugOffsets).  The target is never
+ * stopped: a sample is a best effort snapshot, and samples which cannot be
+ * decoded because the target was changing its state are counted as lost.
+ *
+ * To keep the number of system calls per sample low:
+ *
+ * - the used part of the data stack chunks of each thread is copied with
+ *   one read, so that the frames owned by the thread are decoded locally;
+ * - the headers of the code objects of a stack are read with one batched
+ *   read;
+ * - names and line tables of code objects are cached across samples, and
+ *   only reloaded when another code object is found at the same address.
+ *
+ * If the _asyncio module of the target publishes its "AsyncioDebug"
+ * section, the name of the task run by each thread is reported as well.
+ */
+
+#ifndef Py_BUILD_CORE_BUILTIN
+#  define Py_BUILD_CORE_MODULE 1
+#endif
+
+#include "Python.h"
+#include "pycore_code.h"          // _PyLineTable_InitAddressRange()
+#include "pycore_frame.h"         // _PyInterpreterFrame
+#include "pycore_hashtable.h"     // _Py_hashtable_t
+#include "pycore_runtime.h"       // _Py_DebugOffsets
+#include "pycore_stackref.h"      // Py_TAG_BITS
+#include "pycore_tstate.h"        // _PyThreadStateImpl
+
+#include "remote_debug.h"
+
+#include <math.h>                 // ceil()
+#include <stddef.h>               // offsetof()
+#include <time.h>                 // nanosleep()
+
+/*[clinic input]
+module _remotesampler
+class _remotesampler.Sampler "SamplerObject *" "clinic_state()->sampler_type"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=dd32198018cf1e27]*/
+
+// Upper bounds protecting against inconsistent reads.
+#define MAX_THREADS 4096
+#define MAX_FRAMES 1024
+#define MAX_CHUNKS 8
+#define MAX_CHUNK_SIZE (64 * 1024 * 1024)
+#define MAX_STRING_LENGTH 1024
+#define MAX_LINETABLE_SIZE (1024 * 1024)
+
+// The code cache is emptied before a sample when it grew beyond this
+// number of entries.
+#define MAX_CACHED_CODE 65536
+
+// Look for the _asyncio module of the target at most once per second.
+#define ASYNCIO_LOOKUP_INTERVAL (1000 * 1000 * 1000)
+
+typedef struct {
+    PyTypeObject *sampler_type;
+} remotesampler_state;
+
+static inline remotesampler_state *
+get_remotesampler_state(PyObject *module)
+{
+    void *state = PyModule_GetState(module);
+    assert(state != NULL);
+    return (remotesampler_state *)state;
+}
+
+/* Metadata of a remote code object.  The addresses of its name, file name
+   and line table identify it: when they change, the code object was freed
+   and another one was allocated at the same address. */
+typedef struct {
+    uintptr_t qualname_addr;
+    uintptr_t filename_addr;
+    uintptr_t linetable_addr;
+    int firstlineno;
+    PyObject *qualname;
+    PyObject *filename;
+    char *linetable;
+    Py_ssize_t linetable_len;
+} code_info;
+
+// Local copy of the used part of a remote data stack chunk.
+typedef struct {
+    uintptr_t start;
+    uintptr_t end;
+    char *data;
+    size_t capacity;
+} stack_chunk;
+
+typedef struct {
+    uintptr_t code_addr;
+    uintptr_t instr_ptr;
+    char owner;
+    code_info *info;            // borrowed from the code cache
+    int lineno;
+} sampled_frame;
+
+typedef struct {
+    PyObject_HEAD
+    pid_t pid;
+    uintptr_t runtime_address;
+    _Py_DebugOffsets offsets;
+    int has_asyncio;
+    _Py_AsyncioModuleDebugOffsets asyncio_offsets;
+    PyTime_t asyncio_lookup_time;
+    uintptr_t code_type;            // remote address of PyCode_Type
+    _Py_hashtable_t *code_cache;    // remote address => code_info*
+
+    // Buffers reused across samples
+    char *tstate;
+    stack_chunk chunks[MAX_CHUNKS];
+    sampled_frame *frames;
+    char *code_headers;
+    _Py_RemoteDebug_ReadRequest *requests;
+
+    Py_ssize_t nsamples;
+    Py_ssize_t nlost;
+} SamplerObject;
+
+#define SamplerObject_CAST(op) ((SamplerObject *)(op))
+
+static struct PyModuleDef remotesamplermodule;
+
+#define clinic_state() (get_remotesampler_state(PyType_GetModuleByDef(type, &remotesamplermodule)))
+#include "clinic/_remotesampler.c.h"
+#undef clinic_state
+
+
+/* Remote memory access */
+
+static inline int
+read_memory(SamplerObject *self, uintptr_t address, size_t len, void *dst)
+{
+    if (_Py_RemoteDebug_ReadMemory(self->pid, (void *)address, len, dst) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static inline int
+read_ptr(SamplerObject *self, uintptr_t address, uintptr_t *dst)
+{
+    return read_memory(self, address, sizeof(uintptr_t), dst);
+}
+
+static inline uintptr_t
+get_ptr(const char *buf, uint64_t offset)
+{
+    uintptr_t value;
+    memcpy(&value, buf + offset, sizeof(value));
+    return value;
+}
+
+static inline int
+get_int(const char *buf, uint64_t offset)
+{
+    int value;
+    memcpy(&value, buf + offset, sizeof(value));
+    return value;
+}
+
+// Read a compact str object.
+static PyObject *
+read_unicode(SamplerObject *self, uintptr_t address)
+{
+    PyCompactUnicodeObject header;
+    if (read_memory(self, address, sizeof(header), &header) < 0) {
+        return NULL;
+    }
+    PyASCIIObject *ascii = (PyASCIIObject *)&header;
+    Py_ssize_t length = ascii->length;
+    int kind = ascii->state.kind;
+    if (!ascii->state.compact || length < 0 || length > MAX_STRING_LENGTH
+        || (kind != PyUnicode_1BYTE_KIND && kind != PyUnicode_2BYTE_KIND
+            && kind != PyUnicode_4BYTE_KIND))
+    {
+        PyErr_SetString(PyExc_RuntimeError, "unsupported remote string");
+        return NULL;
+    }
+    uintptr_t data = address + (ascii->state.ascii
+                                ? sizeof(PyASCIIObject)
+                                : sizeof(PyCompactUnicodeObject));
+    Py_UCS4 buffer[MAX_STRING_LENGTH];
+    if (length && read_memory(self, data, (size_t)length * kind, buffer) < 0) {
+        return NULL;
+    }
+    return PyUnicode_FromKindAndData(kind, buffer, length);
+}
+
+// Return 1 if the remote type is the code type, 0 if not, -1 on error.
+static int
+is_code_type(SamplerObject *self, uintptr_t type)
+{
+    if (self->code_type != 0) {
+        return type == self->code_type;
+    }
+    uintptr_t tp_name;
+    char name[sizeof("code")];
+    if (read_ptr(self, type + self->offsets.type_object.tp_name, &tp_name) < 0
+        || read_memory(self, tp_name, sizeof(name), name) < 0)
+    {
+        return -1;
+    }
+    if (memcmp(name, "code", sizeof(name)) != 0) {
+        return 0;
+    }
+    self->code_type = type;
+    return 1;
+}
+
+
+/* Code object cache */
+
+static void
+code_info_free(void *ptr)
+{
+    code_info *info = (code_info *)ptr;
+    Py_XDECREF(info->qualname);
+    Py_XDECREF(info->filename);
+    PyMem_RawFree(info->linetable);
+    PyMem_RawFree(info);
+}
+
+static code_info *
+code_info_load(SamplerObject *self, const char *header)
+{
+    const _Py_DebugOffsets *offsets = &self->offsets;
+    code_info *info = PyMem_RawCalloc(1, sizeof(code_info));
+    if (info == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    info->qualname_addr = get_ptr(header, offsets->code_object.qualname);
+    info->filename_addr = get_ptr(header, offsets->code_object.filename);
+    info->linetable_addr = get_ptr(header, offsets->code_object.linetable);
+    info->firstlineno = get_int(header, offsets->code_object.firstlineno);
+
+    info->qualname = read_unicode(self, info->qualname_addr);
+    if (info->qualname == NULL) {
+        goto error;
+    }
+    info->filename = read_unicode(self, info->filename_addr);
+    if (info->filename == NULL) {
+        goto error;
+    }
+
+    Py_ssize_t size;
+    if (read_memory(self, info->linetable_addr + offsets->bytes_object.ob_size,
+                    sizeof(size), &size) < 0) {
+        goto error;
+    }
+    if (size < 0 || size > MAX_LINETABLE_SIZE) {
+        PyErr_SetString(PyExc_RuntimeError, "invalid remote line table");
+        goto error;
+    }
+    info->linetable = PyMem_RawMalloc(size + 1);
+    if (info->linetable == NULL) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    if (size && read_memory(self, info->linetable_addr + offsets->bytes_object.ob_sval,
+                            size, info->linetable) < 0) {
+        goto error;
+    }
+    info->linetable_len = size;
+    return info;
+
+error:
+    code_info_free(info);
+    return NULL;
+}
+
+static int
+code_info_matches(SamplerObject *self, const code_info *info, const char *header)
+{
+    const _Py_DebugOffsets *offsets = &self->offsets;
+    return (info->qualname_addr == get_ptr(header, offsets->code_object.qualname)
+            && info->filename_addr == get_ptr(header, offsets->code_object.filename)
+            && info->linetable_addr == get_ptr(header, offsets->code_object.linetable)
+            && info->firstlineno == get_int(header, offsets->code_object.firstlineno));
+}
+
+// Return a borrowed pointer to the metadata of the code object at
+// `code_addr`, whose header was just read.
+static code_info *
+get_code_info(SamplerObject *self, uintptr_t code_addr, const char *header)
+{
+    code_info *info = _Py_hashtable_get(self->code_cache, (void *)code_addr);
+    if (info != NULL) {
+        if (code_info_matches(self, info, header)) {
+            return info;
+        }
+        _Py_hashtable_steal(self->code_cache, (void *)code_addr);
+        code_info_free(info);
+    }
+    info = code_info_load(self, header);
+    if (info == NULL) {
+        return NULL;
+    }
+    if (_Py_hashtable_set(self->code_cache, (void *)code_addr, info) < 0) {
+        code_info_free(info);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    return info;
+}
+
+static int
+get_lineno(SamplerObject *self, const code_info *info, uintptr_t code_addr,
+           uintptr_t instr_ptr)
+{
+    uintptr_t code_start = code_addr + self->offsets.code_object.co_code_adaptive;
+    if (instr_ptr < code_start) {
+        return info->firstlineno;
+    }
+    PyCodeAddressRange bounds;
+    _PyLineTable_InitAddressRange(info->linetable, info->linetable_len,
+                                  info->firstlineno, &bounds);
+    return _PyCode_CheckLineNumber((int)(instr_ptr - code_start), &bounds);
+}
+
+
+/* asyncio support */
+
+static void
+find_asyncio_offsets(SamplerObject *self)
+{
+    if (self->has_asyncio) {
+        return;
+    }
+    PyTime_t now;
+    (void)PyTime_MonotonicRaw(&now);
+    if (self->asyncio_lookup_time != 0
+        && now - self->asyncio_lookup_time < ASYNCIO_LOOKUP_INTERVAL)
+    {
+        return;
+    }
+    self->asyncio_lookup_time = now;
+
+    // _asyncio is usually a shared extension, but it can be built in.
+    static const char *const maps[] = {"_asyncio.", "libpython", "python"};
+    void *address = NULL;
+    for (size_t i = 0; i < Py_ARRAY_LENGTH(maps) && address == NULL; i++) {
+        address = _Py_RemoteDebug_GetSectionAddress(self->pid, "AsyncioDebug",
+                                                    maps[i]);
+        if (address == NULL) {
+            PyErr_Clear();
+        }
+    }
+    if (address == NULL) {
+        return;
+    }
+    _Py_AsyncioModuleDebugOffsets *aoffsets = &self->asyncio_offsets;
+    if (read_memory(self, (uintptr_t)address, sizeof(*aoffsets), aoffsets) < 0) {
+        PyErr_Clear();
+        return;
+    }
+    if (aoffsets->asyncio_thread_state.size != sizeof(_PyThreadStateImpl)) {
+        return;
+    }
+    self->has_asyncio = 1;
+}
+
+// Return the name of the task run by the thread whose state was copied
+// to self->tstate, or None.
+static PyObject *
+read_task_name(SamplerObject *self)
+{
+    if (!self->has_asyncio) {
+        Py_RETURN_NONE;
+    }
+    const _Py_DebugOffsets *offsets = &self->offsets;
+    const _Py_AsyncioModuleDebugOffsets *aoffsets = &self->asyncio_offsets;
+    uintptr_t task = get_ptr(self->tstate,
+                             aoffsets->asyncio_thread_state.asyncio_running_task);
+    if (task == 0) {
+        Py_RETURN_NONE;
+    }
+
+    uintptr_t name, type;
+    unsigned long flags;
+    if (read_ptr(self, task + aoffsets->asyncio_task_object.task_name, &name) < 0
+        || read_ptr(self, name + offsets->pyobject.ob_type, &type) < 0
+        || read_memory(self, type + offsets->type_object.tp_flags,
+                       sizeof(flags), &flags) < 0)
+    {
+        return NULL;
+    }
+    if (flags & Py_TPFLAGS_UNICODE_SUBCLASS) {
+        return read_unicode(self, name);
+    }
+    if (flags & Py_TPFLAGS_LONG_SUBCLASS) {
+        // Tasks created without a name only store their number: the name
+        // is formatted on first use.
+        uintptr_t tag;
+        digit digits[2] = {0, 0};
+        if (read_memory(self, name + offsets->long_object.lv_tag,
+                        sizeof(tag), &tag) < 0) {
+            return NULL;
+        }
+        size_t ndigits = Py_MIN(tag >> 3, Py_ARRAY_LENGTH(digits));
+        if (ndigits && read_memory(self, name + offsets->long_object.ob_digit,
+                                   ndigits * sizeof(digit), digits) < 0) {
+            return NULL;
+        }
+        unsigned long long number = digits[0]
+            | ((unsigned long long)digits[1] << PyLong_SHIFT);
+        return PyUnicode_FromFormat("Task-%llu", number);
+    }
+    Py_RETURN_NONE;
+}
+
+
+/* Stack walking */
+
+// Copy the used part of the data stack chunks of the thread whose state
+// was copied to self->tstate.  The frames owned by the thread live there.
+static int
+copy_stack_chunks(SamplerObject *self)
+{
+    const _Py_DebugOffsets *offsets = &self->offsets;
+    uintptr_t chunk = get_ptr(self->tstate, offsets->thread_state.datastack_chunk);
+    uintptr_t top = get_ptr(self->tstate, offsets->thread_state.datastack_top);
+    const size_t header_size = offsetof(_PyStackChunk, data);
+
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        self->chunks[i].start = self->chunks[i].end = 0;
+    }
+    for (int i = 0; i < MAX_CHUNKS && chunk != 0; i++) {
+        _PyStackChunk header;
+        size_t used;
+        if (i == 0) {
+            used = top > chunk ? top - chunk : header_size;
+        }
+        else {
+            if (read_memory(self, chunk, header_size, &header) < 0) {
+                return -1;
+            }
+            used = header_size + header.top * sizeof(PyObject *);
+        }
+        if (used < header_size || used > MAX_CHUNK_SIZE) {
+            PyErr_SetString(PyExc_RuntimeError, "invalid remote stack chunk");
+            return -1;
+        }
+        stack_chunk *local = &self->chunks[i];
+        if (local->capacity < used) {
+            char *data = PyMem_RawRealloc(local->data, used);
+            if (data == NULL) {
+                PyErr_NoMemory();
+                return -1;
+            }
+            local->data = data;
+            local->capacity = used;
+        }
+        if (read_memory(self, chunk, used, local->data) < 0) {
+            return -1;
+        }
+        local->start = chunk;
+        local->end = chunk + used;
+        memcpy(&header, local->data, header_size);
+        chunk = (uintptr_t)header.previous;
+    }
+    return 0;
+}
+
+static int
+read_frame(SamplerObject *self, uintptr_t address, _PyInterpreterFrame *frame)
+{
+    const size_t size = sizeof(_PyInterpreterFrame);
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        stack_chunk *chunk = &self->chunks[i];
+        if (chunk->start <= address && address + size <= chunk->end) {
+            memcpy(frame, chunk->data + (address - chunk->start), size);
+            return 0;
+        }
+    }
+    // Frames of generators and coroutines are embedded in their object.
+    return read_memory(self, address, size, frame);
+}
+
+// Decode the stack of the thread whose state was copied to self->tstate
+// into self->frames, innermost frame first.  Return the number of frames,
+// or -1 on error.
+static int
+read_thread_stack(SamplerObject *self)
+{
+    const _Py_DebugOffsets *offsets = &self->offsets;
+    if (copy_stack_chunks(self) < 0) {
+        return -1;
+    }
+
+    _PyInterpreterFrame frame;
+    const char *buf = (const char *)&frame;
+    uintptr_t address = get_ptr(self->tstate, offsets->thread_state.current_frame);
+    int nframes = 0;
+    while (address != 0) {
+        if (nframes == MAX_FRAMES) {
+            PyErr_SetString(PyExc_RuntimeError, "too many remote frames");
+            return -1;
+        }
+        if (read_frame(self, address, &frame) < 0) {
+            return -1;
+        }
+        char owner = buf[offsets->interpreter_frame.owner];
+        uintptr_t code = get_ptr(buf, offsets->interpreter_frame.executable);
+        code &= ~Py_TAG_BITS;
+        if (owner != FRAME_OWNED_BY_CSTACK && code != 0) {
+            sampled_frame *f = &self->frames[nframes++];
+            f->code_addr = code;
+            f->instr_ptr = get_ptr(buf, offsets->interpreter_frame.instr_ptr);
+            f->owner = owner;
+        }
+        address = get_ptr(buf, offsets->interpreter_frame.previous);
+    }
+
+    // Read the headers of all code objects at once
+    const size_t header_size = offsets->code_object.co_code_adaptive;
+    for (int i = 0; i < nframes; i++) {
+        self->requests[i].remote_address = (void *)self->frames[i].code_addr;
+        self->requests[i].len = header_size;
+        self->requests[i].dst = self->code_headers + i * header_size;
+    }
+    if (_Py_RemoteDebug_ReadMemoryBatch(self->pid, self->requests, nframes) < 0) {
+        return -1;
+    }
+
+    int n = 0;
+    for (int i = 0; i < nframes; i++) {
+        sampled_frame f = self->frames[i];
+        const char *header = self->code_headers + i * header_size;
+        int res = is_code_type(self, get_ptr(header, offsets->pyobject.ob_type));
+        if (res < 0) {
+            return -1;
+        }
+        if (res == 0) {
+            // The executable of the shim frames is not a code object.
+            continue;
+        }
+        f.info = get_code_info(self, f.code_addr, header);
+        if (f.info == NULL) {
+            return -1;
+        }
+        f.lineno = get_lineno(self, f.info, f.code_addr, f.instr_ptr);
+        self->frames[n++] = f;
+    }
+    return n;
+}
+
+static PyObject *
+build_frame_list(SamplerObject *self, int nframes)
+{
+    PyObject *list = PyList_New(nframes);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < nframes; i++) {
+        sampled_frame *f = &self->frames[i];
+        PyObject *item = Py_BuildValue("(OOi)", f->info->qualname,
+                                       f->info->filename, f->lineno);
+        if (item == NULL) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
+
+/* Format a stack the same way as _sampleprof: outermost frame first,
+   frames separated by semicolons.  The name of the task is inserted
+   before the outermost coroutine frame. */
+static PyObject *
+build_collapsed_stack(SamplerObject *self, int nframes, PyObject *task_name,
+                      PyObject *thread_name)
+{
+    int task_index = -1;
+    if (task_name != Py_None) {
+        for (int i = nframes - 1; i >= 0; i--) {
+            if (self->frames[i].owner == FRAME_OWNED_BY_GENERATOR) {
+                task_index = i;
+                break;
+            }
+        }
+    }
+
+    PyUnicodeWriter *writer = PyUnicodeWriter_Create(0);
+    if (writer == NULL) {
+        return NULL;
+    }
+    if (thread_name != NULL) {
+        if (PyUnicodeWriter_WriteStr(writer, thread_name) < 0
+            || PyUnicodeWriter_WriteChar(writer, ';') < 0)
+        {
+            goto error;
+        }
+    }
+    for (int i = nframes - 1; i >= 0; i--) {
+        sampled_frame *f = &self->frames[i];
+        if (i == task_index
+            && PyUnicodeWriter_Format(writer, "<Task %U>;", task_name) < 0) {
+            goto error;
+        }
+        if (PyUnicodeWriter_Format(writer, "%U (%U:%d)", f->info->qualname,
+                                   f->info->filename, f->lineno) < 0) {
+            goto error;
+        }
+        if (i > 0 && PyUnicodeWriter_WriteChar(writer, ';') < 0) {
+            goto error;
+        }
+    }
+    return PyUnicodeWriter_Finish(writer);
+
+error:
+    PyUnicodeWriter_Discard(writer);
+    return NULL;
+}
+
+typedef int (*thread_callback)(SamplerObject *self, unsigned long thread_id,
+                               PyObject *task_name, int nframes, void *arg);
+
+// Walk the threads of the main interpreter of the target, and call
+// `callback` with the decoded stack of each thread.
+static int
+take_sample(SamplerObject *self, thread_callback callback, void *arg)
+{
+    const _Py_DebugOffsets *offsets = &self->offsets;
+    find_asyncio_offsets(self);
+
+    // Frames borrow their metadata from the cache until the next sample.
+    if (_Py_hashtable_len(self->code_cache) >= MAX_CACHED_CODE) {
+        _Py_hashtable_clear(self->code_cache);
+    }
+
+    uintptr_t interp, tstate;
+    if (read_ptr(self, self->runtime_address + offsets->runtime_state.interpreters_head,
+                 &interp) < 0) {
+        return -1;
+    }
+    if (interp == 0) {
+        // The runtime is finalized
+        return 0;
+    }
+    if (read_ptr(self, interp + offsets->interpreter_state.threads_head,
+                 &tstate) < 0) {
+        return -1;
+    }
+    for (int i = 0; tstate != 0; i++) {
+        if (i == MAX_THREADS) {
+            PyErr_SetString(PyExc_RuntimeError, "too many remote threads");
+            return -1;
+        }
+        if (read_memory(self, tstate, sizeof(_PyThreadStateImpl), self->tstate) < 0) {
+            return -1;
+        }
+        unsigned long thread_id;
+        memcpy(&thread_id, self->tstate + offsets->thread_state.native_thread_id,
+               sizeof(thread_id));
+
+        PyObject *task_name = read_task_name(self);
+        if (task_name == NULL) {
+            return -1;
+        }
+        int nframes = read_thread_stack(self);
+        if (nframes < 0
+            || callback(self, thread_id, task_name, nframes, arg) < 0)
+        {
+            Py_DECREF(task_name);
+            return -1;
+        }
+        Py_DECREF(task_name);
+        tstate = get_ptr(self->tstate, offsets->thread_state.next);
+    }
+    return 0;
+}
+
+
+/* Sampler type */
+
+// Check that the target runs the same version of Python, built with the
+// same layout.
+static int
+check_offsets(const _Py_DebugOffsets *offsets)
+{
+    if (memcmp(offsets->cookie, _Py_Debug_Cookie, sizeof(offsets->cookie)) != 0) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "the process does not expose debug offsets");
+        return -1;
+    }
+    if (offsets->version != PY_VERSION_HEX
+        || offsets->free_threaded != _Py_Debug_Free_Threaded
+        || offsets->interpreter_frame.size != sizeof(_PyInterpreterFrame)
+        || offsets->thread_state.size != sizeof(PyThreadState)
+        || offsets->unicode_object.asciiobject_size != sizeof(PyASCIIObject)
+        || offsets->code_object.co_code_adaptive > offsets->code_object.size)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "the process runs an incompatible version of Python");
+        return -1;
+    }
+    return 0;
+}
+
+/*[clinic input]
+@classmethod
+_remotesampler.Sampler.__new__ as sampler_new
+
+    pid: int
+        Identifier of the process to sample.  It must run the same
+        version of Python as the current process.
+
+Sample the Python stacks of another process.
+[clinic start generated code]*/
+
+static PyObject *
+sampler_new_impl(PyTypeObject *type, int pid)
+/*[clinic end generated code: output=0efb996dc23f1304 input=d2cd7a2756247923]*/
+{
+#if !Py_REMOTE_DEBUG_SUPPORTED
+    PyErr_SetString(PyExc_RuntimeError,
+                    "remote sampling is not supported on this platform");
+    return NULL;
+#else
+    SamplerObject *self = (SamplerObject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->pid = (pid_t)pid;
+
+    self->runtime_address = (uintptr_t)_Py_RemoteDebug_GetPyRuntimeAddress(self->pid);
+    if (self->runtime_address == 0) {
+        goto error;
+    }
+    if (read_memory(self, self->runtime_address, sizeof(self->offsets),
+                    &self->offsets) < 0) {
+        goto error;
+    }
+    if (check_offsets(&self->offsets) < 0) {
+        goto error;
+    }
+
+    self->code_cache = _Py_hashtable_new_full(_Py_hashtable_hash_ptr,
+                                              _Py_hashtable_compare_direct,
+                                              NULL, code_info_free, NULL);
+    size_t header_size = self->offsets.code_object.co_code_adaptive;
+    self->tstate = PyMem_RawMalloc(sizeof(_PyThreadStateImpl));
+    self->frames = PyMem_RawMalloc(MAX_FRAMES * sizeof(sampled_frame));
+    self->code_headers = PyMem_RawMalloc(MAX_FRAMES * header_size);
+    self->requests = PyMem_RawMalloc(MAX_FRAMES * sizeof(_Py_RemoteDebug_ReadRequest));
+    if (self->code_cache == NULL || self->tstate == NULL
+        || self->frames == NULL || self->code_headers == NULL
+        || self->requests == NULL)
+    {
+        PyErr_NoMemory();
+        goto error;
+    }
+    return (PyObject *)self;
+
+error:
+    Py_DECREF(self);
+    return NULL;
+#endif
+}
+
+static void
+sampler_dealloc(PyObject *op)
+{
+    SamplerObject *self = SamplerObject_CAST(op);
+    PyTypeObject *tp = Py_TYPE(self);
+    if (self->code_cache != NULL) {
+        _Py_hashtable_destroy(self->code_cache);
+    }
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        PyMem_RawFree(self->chunks[i].data);
+    }
+    PyMem_RawFree(self->tstate);
+    PyMem_RawFree(self->frames);
+    PyMem_RawFree(self->code_headers);
+    PyMem_RawFree(self->requests);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static int
+append_thread_sample(SamplerObject *self, unsigned long thread_id,
+                     PyObject *task_name, int nframes, void *arg)
+{
+    PyObject *result = (PyObject *)arg;
+    PyObject *frames = build_frame_list(self, nframes);
+    if (frames == NULL) {
+        return -1;
+    }
+    PyObject *item = Py_BuildValue("(kON)", thread_id, task_name, frames);
+    if (item == NULL) {
+        return -1;
+    }
+    int err = PyList_Append(result, item);
+    Py_DECREF(item);
+    return err;
+}
+
+/*[clinic input]
+_remotesampler.Sampler.sample
+
+Take one sample of the stacks of all threads.
+
+Return a list of (thread_id, task_name, frames) tuples, one per thread.
+thread_id is the native identifier of the thread, task_name is the name
+of the asyncio task run by the thread or None, and frames is a list of
+(qualname, filename, lineno) tuples, innermost frame first.
+[clinic start generated code]*/
+
+static PyObject *
+_remotesampler_Sampler_sample_impl(SamplerObject *self)
+/*[clinic end generated code: output=b5a117e897de9503 input=558ca519a2a28add]*/
+{
+    PyObject *result = PyList_New(0);
+    if (result == NULL) {
+        return NULL;
+    }
+    if (take_sample(self, append_thread_sample, result) < 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    self->nsamples++;
+    return result;
+}
+
+typedef struct {
+    PyObject *stacks;
+    int per_thread;
+} collapse_state;
+
+static int
+count_thread_sample(SamplerObject *self, unsigned long thread_id,
+                    PyObject *task_name, int nframes, void *arg)
+{
+    collapse_state *state = (collapse_state *)arg;
+    if (nframes == 0) {
+        // The thread is not running Python code
+        return 0;
+    }
+    PyObject *thread_name = NULL;
+    if (state->per_thread) {
+        thread_name = PyUnicode_FromFormat("Thread %lu", thread_id);
+        if (thread_name == NULL) {
+            return -1;
+        }
+    }
+    PyObject *key = build_collapsed_stack(self, nframes, task_name, thread_name);
+    Py_XDECREF(thread_name);
+    if (key == NULL) {
+        return -1;
+    }
+    PyObject *count;
+    if (PyDict_GetItemRef(state->stacks, key, &count) < 0) {
+        Py_DECREF(key);
+        return -1;
+    }
+    Py_ssize_t n = count == NULL ? 0 : PyLong_AsSsize_t(count);
+    Py_XDECREF(count);
+    if (n < 0) {
+        Py_DECREF(key);
+        return -1;
+    }
+    count = PyLong_FromSsize_t(n + 1);
+    if (count == NULL) {
+        Py_DECREF(key);
+        return -1;
+    }
+    int err = PyDict_SetItem(state->stacks, key, count);
+    Py_DECREF(key);
+    Py_DECREF(count);
+    return err;
+}
+
+static int
+seconds_to_ns(double seconds, const char *name, PyTime_t *ns)
+{
+    double value = ceil(seconds * 1e9);
+    if (!(value < (double)PyTime_MAX)) {
+        PyErr_Format(PyExc_OverflowError, "%s is too large", name);
+        return -1;
+    }
+    *ns = (PyTime_t)value;
+    return 0;
+}
+
+static void
+sleep_ns(PyTime_t ns)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / (1000 * 1000 * 1000));
+    ts.tv_nsec = (long)(ns % (1000 * 1000 * 1000));
+    Py_BEGIN_ALLOW_THREADS
+    // An interrupted sleep is fine: the caller checks for signals.
+    (void)nanosleep(&ts, NULL);
+    Py_END_ALLOW_THREADS
+}
+
+/*[clinic input]
+_remotesampler.Sampler.run
+
+    duration: double
+        Duration of the profiling, in seconds.
+    interval: double = 0.01
+        Time between two samples, in seconds.
+    *
+    per_thread: bool = False
+        Prefix each stack with the identifier of its thread.
+
+Sample the process at regular intervals.
+
+Return a dict mapping collapsed stacks to the number of times they
+were sampled.  A collapsed stack lists the frames of a thread, outermost
+first, as "qualname (filename:lineno)" strings separated by semicolons.
+The name of the asyncio task run by the thread is inserted as a
+"<Task name>" frame.  Written as "stack count" lines, the result can be
+rendered as a flame graph by flamegraph.pl.
+
+Sampling stops early if the process exits.  Samples which cannot be
+decoded, for example because a thread changed its stack while it was
+read, are counted as lost.
+[clinic start generated code]*/
+
+static PyObject *
+_remotesampler_Sampler_run_impl(SamplerObject *self, double duration,
+                                double interval, int per_thread)
+/*[clinic end generated code: output=392484304accfa96 input=6017049ce04d89e3]*/
+{
+    if (!(duration >= 0.0)) {
+        PyErr_SetString(PyExc_ValueError, "duration must be non-negative");
+        return NULL;
+    }
+    if (!(interval > 0.0)) {
+        PyErr_SetString(PyExc_ValueError, "interval must be positive");
+        return NULL;
+    }
+    PyTime_t duration_ns, interval_ns;
+    if (seconds_to_ns(duration, "duration", &duration_ns) < 0
+        || seconds_to_ns(interval, "interval", &interval_ns) < 0)
+    {
+        return NULL;
+    }
+
+    collapse_state state = {.stacks = PyDict_New(), .per_thread = per_thread};
+    if (state.stacks == NULL) {
+        return NULL;
+    }
+    PyTime_t now;
+    (void)PyTime_MonotonicRaw(&now);
+    PyTime_t end = now + duration_ns;
+    PyTime_t next = now;
+    while (1) {
+        if (take_sample(self, count_thread_sample, &state) == 0) {
+            self->nsamples++;
+        }
+        else if (PyErr_ExceptionMatches(PyExc_ProcessLookupError)) {
+            // The process exited
+            PyErr_Clear();
+            break;
+        }
+        else if (PyErr_ExceptionMatches(PyExc_OSError)
+                 || PyErr_ExceptionMatches(PyExc_RuntimeError))
+        {
+            // The process changed its state while it was read
+            PyErr_Clear();
+            self->nlost++;
+        }
+        else {
+            goto error;
+        }
+
+        next += interval_ns;
+        (void)PyTime_MonotonicRaw(&now);
+        if (now >= end) {
+            break;
+        }
+        if (next < now) {
+            // Sampling is slower than requested: skip the missed samples.
+            next = now;
+        }
+        sleep_ns(Py_MIN(next, end) - now);
+        if (PyErr_CheckSignals() < 0) {
+            goto error;
+        }
+    }
+    return state.stacks;
+
+error:
+    Py_DECREF(state.stacks);
+    return NULL;
+}
+
+static PyMethodDef sampler_methods[] = {
+    _REMOTESAMPLER_SAMPLER_SAMPLE_METHODDEF
+    _REMOTESAMPLER_SAMPLER_RUN_METHODDEF
+    {NULL, NULL}
+};
+
+static PyMemberDef sampler_members[] = {
+    {"pid", Py_T_INT, offsetof(SamplerObject, pid), Py_READONLY,
+     "Identifier of the sampled process."},
+    {"samples", Py_T_PYSSIZET, offsetof(SamplerObject, nsamples), Py_READONLY,
+     "Number of samples taken."},
+    {"lost", Py_T_PYSSIZET, offsetof(SamplerObject, nlost), Py_READONLY,
+     "Number of samples which could not be decoded."},
+    {NULL}
+};
+
+static PyType_Slot sampler_slots[] = {
+    {Py_tp_new, sampler_new},
+    {Py_tp_dealloc, sampler_dealloc},
+    {Py_tp_methods, sampler_methods},
+    {Py_tp_members, sampler_members},
+    {Py_tp_doc, (void *)sampler_new__doc__},
+    {0, NULL}
+};
+
+static PyType_Spec sampler_spec = {
+    .name = "_remotesampler.Sampler",
+    .basicsize = sizeof(SamplerObject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = sampler_slots,
+};
+
+
+/* Module */
+
+static int
+remotesampler_exec(PyObject *module)
+{
+    remotesampler_state *state = get_remotesampler_state(module);
+    state->sampler_type = (PyTypeObject *)PyType_FromModuleAndSpec(
+        module, &sampler_spec, NULL);
+    if (state->sampler_type == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->sampler_type) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static int
+remotesampler_traverse(PyObject *module, visitproc visit, void *arg)
+{
+    remotesampler_state *state = get_remotesampler_state(module);
+    Py_VISIT(state->sampler_type);
+    return 0;
+}
+
+static int
+remotesampler_clear(PyObject *module)
+{
+    remotesampler_state *state = get_remotesampler_state(module);
+    Py_CLEAR(state->sampler_type);
+    return 0;
+}
+
+static void
+remotesampler_free(void *module)
+{
+    (void)remotesampler_clear((PyObject *)module);
+}
+
+static PyModuleDef_Slot remotesampler_slots[] = {
+    {Py_mod_exec, remotesampler_exec},
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+    {0, NULL}
+};
+
+static struct PyModuleDef remotesamplermodule = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "_remotesampler",
+    .m_doc = "Out of process sampling profiler",
+    .m_size = sizeof(remotesampler_state),
+    .m_slots = remotesampler_slots,
+    .m_traverse = remotesampler_traverse,
+    .m_clear = remotesampler_clear,
+    .m_free = remotesampler_free,
+};
+
+PyMODINIT_FUNC
+PyInit__remotesampler(void)
+{
+    return PyModuleDef_Init(&remotesamplermodule);
+}
@@ -0,0 +1,660 @@
+/* Statistical (sampling) profiler.
+ *
+ * A helper thread wakes up every `interval` seconds and schedules a pending
+ * call on the profiled interpreter.  The pending call runs at the next
+ * eval breaker check on a thread that is executing Python code, and records
+ * the frame chain of that thread (or of every thread of the interpreter)
+ * into a table of unique stacks.  Nothing is done on the call and return
+ * paths, so the cost depends on the sampling rate, not on the amount of
+ * Python code executed.
+ *
+ * Samples are only taken while some thread runs Python code: time spent
+ * blocked with the GIL released is not accounted for.
+ */
+
+#ifndef Py_BUILD_CORE_BUILTIN
+#  define Py_BUILD_CORE_MODULE 1
+#endif
+
+#include "Python.h"
+#include "pycore_ceval.h"         // _PyEval_AddPendingCall()
+#include "pycore_frame.h"         // _PyFrame_GetFirstComplete()
+#include "pycore_hashtable.h"     // _Py_hashtable_t
+#include "pycore_lock.h"          // PyEvent
+#include "pycore_pyhash.h"        // _Py_HashPointerRaw()
+#include "pycore_pystate.h"       // _PyThreadState_GET()
+#include "pycore_pythread.h"      // PyThread_start_joinable_thread()
+
+/*[clinic input]
+module _sampleprof
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=e73f6cf49b76d7fd]*/
+
+#define DEFAULT_MAX_DEPTH 256
+
+typedef struct {
+    PyCodeObject *code;
+    int lineno;
+} sample_frame;
+
+/* A unique stack, innermost frame first.  Keys owned by the table hold a
+   strong reference to each code object. */
+typedef struct {
+    Py_uhash_t hash;
+    Py_ssize_t depth;
+    sample_frame frames[1];
+} stack_key;
+
+#define STACK_KEY_SIZE(depth) \
+    (offsetof(stack_key, frames) + (size_t)(depth) * sizeof(sample_frame))
+
+/* State shared between the module, the helper thread and the queued
+   pending call.  It is freed by whichever of them drops the last
+   reference, so it never requires the GIL. */
+typedef struct {
+    Py_ssize_t refcnt;
+    PyInterpreterState *interp;
+    PyTime_t interval;
+    int all_threads;
+    PyEvent stop;
+    PyThread_handle_t handle;
+    PyThread_ident_t ident;
+    // Set while a sample request is queued, so that an idle interpreter
+    // does not accumulate requests.
+    int sample_pending;
+
+    PyMutex mutex;
+    // The fields below are protected by the mutex.  `stacks` is borrowed
+    // from the module state and is NULL once the sampler is stopped.
+    _Py_hashtable_t *stacks;
+    Py_ssize_t nsamples;
+    Py_ssize_t nlost;
+    stack_key *scratch;
+    Py_ssize_t max_depth;
+} sampler_t;
+
+typedef struct {
+    sampler_t *sampler;         // NULL unless the profiler is running
+    _Py_hashtable_t *stacks;    // stack_key* -> number of samples
+    Py_ssize_t nsamples;
+    Py_ssize_t nlost;
+} sampleprof_state;
+
+static inline sampleprof_state *
+get_sampleprof_state(PyObject *module)
+{
+    void *state = PyModule_GetState(module);
+    assert(state != NULL);
+    return (sampleprof_state *)state;
+}
+
+#include "clinic/_sampleprof.c.h"
+
+
+/* Stack table */
+
+static Py_uhash_t
+stack_key_hash(const void *key)
+{
+    return ((const stack_key *)key)->hash;
+}
+
+static int
+stack_key_compare(const void *key1, const void *key2)
+{
+    const stack_key *a = (const stack_key *)key1;
+    const stack_key *b = (const stack_key *)key2;
+    if (a->hash != b->hash || a->depth != b->depth) {
+        return 0;
+    }
+    for (Py_ssize_t i = 0; i < a->depth; i++) {
+        if (a->frames[i].code != b->frames[i].code ||
+            a->frames[i].lineno != b->frames[i].lineno)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void
+stack_key_destroy(void *key)
+{
+    stack_key *stack = (stack_key *)key;
+    for (Py_ssize_t i = 0; i < stack->depth; i++) {
+        Py_DECREF(stack->frames[i].code);
+    }
+    PyMem_RawFree(stack);
+}
+
+static _Py_hashtable_t *
+stacks_new(void)
+{
+    return _Py_hashtable_new_full(stack_key_hash, stack_key_compare,
+                                  stack_key_destroy, NULL, NULL);
+}
+
+
+/* Sampling */
+
+static void
+sampler_incref(sampler_t *sampler)
+{
+    _Py_atomic_add_ssize(&sampler->refcnt, 1);
+}
+
+static void
+sampler_decref(sampler_t *sampler)
+{
+    if (_Py_atomic_add_ssize(&sampler->refcnt, -1) == 1) {
+        PyMem_RawFree(sampler->scratch);
+        PyMem_RawFree(sampler);
+    }
+}
+
+// Called with the sampler mutex held.
+static void
+record_stack(sampler_t *sampler, PyThreadState *tstate)
+{
+    stack_key *key = sampler->scratch;
+    Py_uhash_t hash = 0;
+    Py_ssize_t depth = 0;
+
+    _PyInterpreterFrame *frame = _PyFrame_GetFirstComplete(tstate->current_frame);
+    while (frame != NULL && depth < sampler->max_depth) {
+        PyCodeObject *code = _PyFrame_GetCode(frame);
+        int lineno = PyUnstable_InterpreterFrame_GetLine(frame);
+        key->frames[depth].code = code;
+        key->frames[depth].lineno = lineno;
+        hash = (hash * 1000003U) ^ (Py_uhash_t)_Py_HashPointerRaw(code);
+        hash = (hash * 1000003U) ^ (Py_uhash_t)lineno;
+        depth++;
+        frame = _PyFrame_GetFirstComplete(frame->previous);
+    }
+    if (depth == 0) {
+        // The thread is not running Python code
+        return;
+    }
+    key->hash = hash;
+    key->depth = depth;
+
+    _Py_hashtable_entry_t *entry = _Py_hashtable_get_entry(sampler->stacks, key);
+    if (entry != NULL) {
+        entry->value = (void *)((uintptr_t)entry->value + 1);
+        sampler->nsamples++;
+        return;
+    }
+
+    stack_key *copy = PyMem_RawMalloc(STACK_KEY_SIZE(depth));
+    if (copy == NULL) {
+        sampler->nlost++;
+        return;
+    }
+    memcpy(copy, key, STACK_KEY_SIZE(depth));
+    for (Py_ssize_t i = 0; i < depth; i++) {
+        Py_INCREF(copy->frames[i].code);
+    }
+    if (_Py_hashtable_set(sampler->stacks, copy, (void *)(uintptr_t)1) < 0) {
+        stack_key_destroy(copy);
+        sampler->nlost++;
+        return;
+    }
+    sampler->nsamples++;
+}
+
+// Pending call scheduled by the helper thread.  It never fails: errors
+// would otherwise be raised in whatever code happens to be running.
+static int
+take_sample(void *arg)
+{
+    sampler_t *sampler = (sampler_t *)arg;
+    _Py_atomic_store_int(&sampler->sample_pending, 0);
+
+    PyMutex_Lock(&sampler->mutex);
+    if (sampler->stacks != NULL) {
+        PyInterpreterState *interp = sampler->interp;
+        if (sampler->all_threads) {
+            _PyRuntimeState *runtime = &_PyRuntime;
+            _PyEval_StopTheWorld(interp);
+            HEAD_LOCK(runtime);
+            for (PyThreadState *t = interp->threads.head; t != NULL; t = t->next) {
+                record_stack(sampler, t);
+            }
+            HEAD_UNLOCK(runtime);
+            _PyEval_StartTheWorld(interp);
+        }
+        else {
+            record_stack(sampler, _PyThreadState_GET());
+        }
+    }
+    PyMutex_Unlock(&sampler->mutex);
+
+    sampler_decref(sampler);
+    return 0;
+}
+
+static void
+sampler_thread(void *arg)
+{
+    sampler_t *sampler = (sampler_t *)arg;
+    while (!PyEvent_WaitTimed(&sampler->stop, sampler->interval, 0)) {
+        if (_Py_atomic_load_int_relaxed(&sampler->sample_pending)) {
+            // The previous request has not been handled yet: no thread
+            // executed Python code since then.
+            continue;
+        }
+        _Py_atomic_store_int(&sampler->sample_pending, 1);
+        sampler_incref(sampler);
+        if (_PyEval_AddPendingCall(sampler->interp, take_sample, sampler, 0)
+            != _Py_ADD_PENDING_SUCCESS)
+        {
+            _Py_atomic_store_int(&sampler->sample_pending, 0);
+            sampler_decref(sampler);
+        }
+    }
+    sampler_decref(sampler);
+}
+
+static void
+sampler_stop(sampleprof_state *state)
+{
+    sampler_t *sampler = state->sampler;
+    if (sampler == NULL) {
+        return;
+    }
+    state->sampler = NULL;
+
+    PyMutex_Lock(&sampler->mutex);
+    sampler->stacks = NULL;
+    state->nsamples += sampler->nsamples;
+    state->nlost += sampler->nlost;
+    PyMutex_Unlock(&sampler->mutex);
+
+    // The helper thread never takes the GIL, so it is safe to join it
+    // without releasing the GIL.
+    _PyEvent_Notify(&sampler->stop);
+    PyThread_join_thread(sampler->handle);
+    sampler_decref(sampler);
+}
+
+
+/* Module functions */
+
+/*[clinic input]
+_sampleprof.start
+
+    interval: double = 0.01
+        Time between two samples, in seconds.
+    *
+    all_threads: bool = False
+        Sample every thread of the interpreter instead of only the
+        thread which is running Python code.
+    max_depth: Py_ssize_t(c_default="DEFAULT_MAX_DEPTH") = 256
+        Maximum number of frames recorded per stack.  The outermost
+        frames of deeper stacks are dropped.
+
+Start sampling the Python stacks of the current interpreter.
+
+Samples are accumulated with the ones of previous runs until clear()
+is called.
+[clinic start generated code]*/
+
+static PyObject *
+_sampleprof_start_impl(PyObject *module, double interval, int all_threads,
+                       Py_ssize_t max_depth)
+/*[clinic end generated code: output=2e2833e358e47c52 input=c841d3a41e1e0a29]*/
+{
+    sampleprof_state *state = get_sampleprof_state(module);
+    if (state->sampler != NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "the profiler is already running");
+        return NULL;
+    }
+    if (!(interval > 0.0)) {
+        PyErr_SetString(PyExc_ValueError, "interval must be positive");
+        return NULL;
+    }
+    if (max_depth < 1) {
+        PyErr_SetString(PyExc_ValueError, "max_depth must be at least 1");
+        return NULL;
+    }
+    double ns = ceil(interval * 1e9);
+    if (!(ns < (double)PyTime_MAX)) {
+        PyErr_SetString(PyExc_OverflowError, "interval is too large");
+        return NULL;
+    }
+    PyTime_t interval_ns = (PyTime_t)ns;
+
+    sampler_t *sampler = PyMem_RawCalloc(1, sizeof(sampler_t));
+    if (sampler == NULL) {
+        return PyErr_NoMemory();
+    }
+    sampler->scratch = PyMem_RawMalloc(STACK_KEY_SIZE(max_depth));
+    if (sampler->scratch == NULL) {
+        PyMem_RawFree(sampler);
+        return PyErr_NoMemory();
+    }
+    sampler->refcnt = 1;
+    sampler->interp = _PyInterpreterState_GET();
+    sampler->interval = interval_ns;
+    sampler->all_threads = all_threads;
+    sampler->max_depth = max_depth;
+    sampler->stacks = state->stacks;
+
+    // The reference is owned by the helper thread.
+    sampler_incref(sampler);
+    if (PyThread_start_joinable_thread(sampler_thread, sampler,
+                                       &sampler->ident,
+                                       &sampler->handle) < 0) {
+        sampler_decref(sampler);
+        sampler_decref(sampler);
+        PyErr_SetString(PyExc_RuntimeError, "can't start the sampling thread");
+        return NULL;
+    }
+    state->sampler = sampler;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_sampleprof.stop
+
+Stop sampling.
+
+The samples collected so far are kept.
+[clinic start generated code]*/
+
+static PyObject *
+_sampleprof_stop_impl(PyObject *module)
+/*[clinic end generated code: output=9db7d4760741412e input=d1d92d29e5911e93]*/
+{
+    sampler_stop(get_sampleprof_state(module));
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_sampleprof.is_running
+
+Return True if the profiler is running.
+[clinic start generated code]*/
+
+static PyObject *
+_sampleprof_is_running_impl(PyObject *module)
+/*[clinic end generated code: output=cadf14ff20444f6a input=d3ac75b9c62ecfe0]*/
+{
+    return PyBool_FromLong(get_sampleprof_state(module)->sampler != NULL);
+}
+
+/*[clinic input]
+_sampleprof.clear
+
+Discard the samples collected so far.
+[clinic start generated code]*/
+
+static PyObject *
+_sampleprof_clear_impl(PyObject *module)
+/*[clinic end generated code: output=e1edcb39422ad160 input=1fcd11dc6595c2e7]*/
+{
+    sampleprof_state *state = get_sampleprof_state(module);
+    sampler_t *sampler = state->sampler;
+    if (sampler != NULL) {
+        PyMutex_Lock(&sampler->mutex);
+        sampler->nsamples = 0;
+        sampler->nlost = 0;
+    }
+    _Py_hashtable_clear(state->stacks);
+    state->nsamples = 0;
+    state->nlost = 0;
+    if (sampler != NULL) {
+        PyMutex_Unlock(&sampler->mutex);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+format_stack(const stack_key *stack)
+{
+    PyObject *parts = PyList_New(stack->depth);
+    if (parts == NULL) {
+        return NULL;
+    }
+    // Collapsed stacks list the outermost frame first.
+    for (Py_ssize_t i = 0; i < stack->depth; i++) {
+        const sample_frame *frame = &stack->frames[stack->depth - 1 - i];
+        PyObject *item = PyUnicode_FromFormat("%U (%U:%d)",
+                                              frame->code->co_qualname,
+                                              frame->code->co_filename,
+                                              frame->lineno);
+        if (item == NULL) {
+            Py_DECREF(parts);
+            return NULL;
+        }
+        PyList_SET_ITEM(parts, i, item);
+    }
+    PyObject *sep = PyUnicode_FromOrdinal(';');
+    if (sep == NULL) {
+        Py_DECREF(parts);
+        return NULL;
+    }
+    PyObject *res = PyUnicode_Join(sep, parts);
+    Py_DECREF(sep);
+    Py_DECREF(parts);
+    return res;
+}
+
+static int
+collect_stack(_Py_hashtable_t *ht, const void *key, const void *value,
+              void *user_data)
+{
+    PyObject *result = (PyObject *)user_data;
+    PyObject *name = format_stack((const stack_key *)key);
+    if (name == NULL) {
+        return -1;
+    }
+    // Distinct code objects may have the same name: add their counts.
+    Py_ssize_t count = (Py_ssize_t)(uintptr_t)value;
+    PyObject *old = PyDict_GetItemWithError(result, name);
+    if (old != NULL) {
+        Py_ssize_t prev = PyLong_AsSsize_t(old);
+        if (prev == -1 && PyErr_Occurred()) {
+            Py_DECREF(name);
+            return -1;
+        }
+        count += prev;
+    }
+    else if (PyErr_Occurred()) {
+        Py_DECREF(name);
+        return -1;
+    }
+    PyObject *obj = PyLong_FromSsize_t(count);
+    if (obj == NULL) {
+        Py_DECREF(name);
+        return -1;
+    }
+    int res = PyDict_SetItem(result, name, obj);
+    Py_DECREF(obj);
+    Py_DECREF(name);
+    return res;
+}
+
+static PyObject *
+collect_stacks(sampleprof_state *state)
+{
+    PyObject *result = PyDict_New();
+    if (result == NULL) {
+        return NULL;
+    }
+    sampler_t *sampler = state->sampler;
+    if (sampler != NULL) {
+        PyMutex_Lock(&sampler->mutex);
+    }
+    int res = _Py_hashtable_foreach(state->stacks, collect_stack, result);
+    if (sampler != NULL) {
+        PyMutex_Unlock(&sampler->mutex);
+    }
+    if (res < 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
+/*[clinic input]
+_sampleprof.collect
+
+Return the samples collected so far.
+
+The result is a dict mapping collapsed stacks to the number of samples.
+A collapsed stack is a string of "qualname (filename:lineno)" frames
+separated by semicolons, outermost frame first.
+[clinic start generated code]*/
+
+static PyObject *
+_sampleprof_collect_impl(PyObject *module)
+/*[clinic end generated code: output=8db0b47d3a56ee71 input=78c9ea29393e834d]*/
+{
+    return collect_stacks(get_sampleprof_state(module));
+}
+
+/*[clinic input]
+_sampleprof.dump
+
+    filename: object
+
+Write the samples collected so far to a file in collapsed stack format.
+
+Each line holds a collapsed stack, a space and the number of samples.
+The file can be fed to flame graph tools.
+[clinic start generated code]*/
+
+static PyObject *
+_sampleprof_dump_impl(PyObject *module, PyObject *filename)
+/*[clinic end generated code: output=4378db9bb9787d5b input=9996c1d1bc17b39d]*/
+{
+    PyObject *stacks = collect_stacks(get_sampleprof_state(module));
+    if (stacks == NULL) {
+        return NULL;
+    }
+    FILE *fp = _Py_fopen_obj(filename, "w");
+    if (fp == NULL) {
+        Py_DECREF(stacks);
+        return NULL;
+    }
+
+    Py_ssize_t pos = 0;
+    PyObject *name, *count;
+    while (PyDict_Next(stacks, &pos, &name, &count)) {
+        Py_ssize_t size;
+        const char *utf8 = PyUnicode_AsUTF8AndSize(name, &size);
+        if (utf8 == NULL) {
+            goto error;
+        }
+        Py_ssize_t n = PyLong_AsSsize_t(count);
+        if (n == -1 && PyErr_Occurred()) {
+            goto error;
+        }
+        if (fwrite(utf8, 1, (size_t)size, fp) != (size_t)size
+            || fprintf(fp, " %zd\n", n) < 0)
+        {
+            PyErr_SetFromErrno(PyExc_OSError);
+            goto error;
+        }
+    }
+    Py_DECREF(stacks);
+    if (fclose(fp) != 0) {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+    Py_RETURN_NONE;
+
+error:
+    Py_DECREF(stacks);
+    fclose(fp);
+    return NULL;
+}
+
+/*[clinic input]
+_sampleprof.get_stats
+
+Return a dict with the number of samples taken and lost.
+
+Samples are lost when memory cannot be allocated to record them.
+[clinic start generated code]*/
+
+static PyObject *
+_sampleprof_get_stats_impl(PyObject *module)
+/*[clinic end generated code: output=377dca3f56f072be input=6bb49e0ba21d5228]*/
+{
+    sampleprof_state *state = get_sampleprof_state(module);
+    Py_ssize_t nsamples = state->nsamples;
+    Py_ssize_t nlost = state->nlost;
+    size_t nstacks;
+    sampler_t *sampler = state->sampler;
+    if (sampler != NULL) {
+        PyMutex_Lock(&sampler->mutex);
+        nsamples += sampler->nsamples;
+        nlost += sampler->nlost;
+    }
+    nstacks = _Py_hashtable_len(state->stacks);
+    if (sampler != NULL) {
+        PyMutex_Unlock(&sampler->mutex);
+    }
+    return Py_BuildValue("{snsnsn}",
+                         "samples", nsamples,
+                         "lost", nlost,
+                         "stacks", (Py_ssize_t)nstacks);
+}
+
+static PyMethodDef sampleprof_methods[] = {
+    _SAMPLEPROF_START_METHODDEF
+    _SAMPLEPROF_STOP_METHODDEF
+    _SAMPLEPROF_IS_RUNNING_METHODDEF
+    _SAMPLEPROF_CLEAR_METHODDEF
+    _SAMPLEPROF_COLLECT_METHODDEF
+    _SAMPLEPROF_DUMP_METHODDEF
+    _SAMPLEPROF_GET_STATS_METHODDEF
+    {NULL, NULL}
+};
+
+static int
+sampleprof_exec(PyObject *module)
+{
+    sampleprof_state *state = get_sampleprof_state(module);
+    state->stacks = stacks_new();
+    if (state->stacks == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+static void
+sampleprof_free(void *module)
+{
+    sampleprof_state *state = get_sampleprof_state((PyObject *)module);
+    sampler_stop(state);
+    if (state->stacks != NULL) {
+        _Py_hashtable_destroy(state->stacks);
+        state->stacks = NULL;
+    }
+}
+
+static PyModuleDef_Slot sampleprof_slots[] = {
+    {Py_mod_exec, sampleprof_exec},
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+    {0, NULL}
+};
+
+static struct PyModuleDef sampleprofmodule = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "_sampleprof",
+    .m_doc = "Low overhead statistical profiler",
+    .m_size = sizeof(sampleprof_state),
+    .m_methods = sampleprof_methods,
+    .m_slots = sampleprof_slots,
+    .m_free = sampleprof_free,
+};
+
+PyMODINIT_FUNC
+PyInit__sampleprof(void)
+{
+    return PyModuleDef_Init(&sampleprofmodule);
+}
@@ -72,4 +72,66 @@ skip_optional:
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=105105d759c0c271 input=a9049054013a1b77]*/
+
+PyDoc_STRVAR(_testinternalcapi_benchmark_rwlocks__doc__,
+"benchmark_rwlocks($module, num_threads, use_brlock=True, time_ms=1000,\n"
+"                  /)\n"
+"--\n"
+"\n"
+"Benchmark the read side of _PyRWMutex or _PyBRLock.\n"
+"\n"
+"The first thread also takes the lock for writing 10 times per million reads.\n"
+"Return the number of reads per second and a list of the reads of each thread.");
+
+#define _TESTINTERNALCAPI_BENCHMARK_RWLOCKS_METHODDEF    \
+    {"benchmark_rwlocks", _PyCFunction_CAST(_testinternalcapi_benchmark_rwlocks), METH_FASTCALL, _testinternalcapi_benchmark_rwlocks__doc__},
+
+static PyObject *
+_testinternalcapi_benchmark_rwlocks_impl(PyObject *module,
+                                         Py_ssize_t num_threads,
+                                         int use_brlock, int time_ms);
+
+static PyObject *
+_testinternalcapi_benchmark_rwlocks(PyObject *module, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t num_threads;
+    int use_brlock = 1;
+    int time_ms = 1000;
+
+    if (!_PyArg_CheckPositional("benchmark_rwlocks", nargs, 1, 3)) {
+        goto exit;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[0]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        num_threads = ival;
+    }
+    if (nargs < 2) {
+        goto skip_optional;
+    }
+    use_brlock = PyObject_IsTrue(args[1]);
+    if (use_brlock < 0) {
+        goto exit;
+    }
+    if (nargs < 3) {
+        goto skip_optional;
+    }
+    time_ms = PyLong_AsInt(args[2]);
+    if (time_ms == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    return_value = _testinternalcapi_benchmark_rwlocks_impl(module, num_threads, use_brlock, time_ms);
+
+exit:
+    return return_value;
+}
+/*[clinic end generated code: output=8498f5d4cdbb5dc4 input=a9049054013a1b77]*/
@@ -2,7 +2,9 @@
 
 #include "parts.h"
 #include "pycore_lock.h"
+#include "pycore_parking_lot.h"   // Py_PARK_OK
 #include "pycore_pythread.h"      // PyThread_get_thread_ident_ex()
+#include "pycore_semaphore.h"     // _PySemaphore
 
 #include "clinic/test_lock.c.h"
 
@@ -43,6 +45,33 @@ test_lock_basic(PyObject *self, PyObject *obj)
     Py_RETURN_NONE;
 }
 
+static PyObject *
+test_lock_timeout(PyObject *self, PyObject *obj)
+{
+    PyMutex m = (PyMutex){0};
+    PyMutex_Lock(&m);
+
+    // a timed lock of a locked mutex parks, then fails
+    PyLockStatus st = _PyMutex_LockTimed(&m, 10*1000*1000, 0);
+    assert(st == PY_LOCK_FAILURE);
+    PyMutex_Unlock(&m);
+    assert(m._bits == 0);
+
+    // a wakeup before the wait is not lost
+    _PySemaphore sema;
+    _PySemaphore_Init(&sema);
+    _PySemaphore_Wakeup(&sema);
+    int res = _PySemaphore_Wait(&sema, 1000*1000*1000, /*detach=*/0);
+    assert(res == Py_PARK_OK);
+    res = _PySemaphore_Wait(&sema, 10*1000*1000, /*detach=*/0);
+    assert(res == Py_PARK_TIMEOUT);
+    _PySemaphore_Destroy(&sema);
+    (void)st;
+    (void)res;
+
+    Py_RETURN_NONE;
+}
+
 struct test_lock2_data {
     PyMutex m;
     PyEvent done;
@@ -477,6 +506,237 @@ test_lock_rwlock(PyObject *self, PyObject *obj)
     Py_RETURN_NONE;
 }
 
+struct test_brlock_data {
+    _PyBRLock lock;
+    int writer_done;
+    PyEvent reader_started;
+    PyEvent step1;
+    PyEvent step2;
+    PyEvent reader_done;
+    PyEvent done;
+};
+
+static void
+brlock_reader_thread(void *arg)
+{
+    struct test_brlock_data *test_data = arg;
+
+    _PyBRLock_RLock(&test_data->lock);
+    _PyEvent_Notify(&test_data->reader_started);
+    PyEvent_Wait(&test_data->step1);
+    _PyBRLock_RUnlock(&test_data->lock);
+    _PyEvent_Notify(&test_data->reader_done);
+}
+
+static void
+brlock_writer_thread(void *arg)
+{
+    struct test_brlock_data *test_data = arg;
+
+    // Waits for the reader to release the lock
+    _PyBRLock_Lock(&test_data->lock);
+    _Py_atomic_store_int(&test_data->writer_done, 1);
+    PyEvent_Wait(&test_data->step2);
+    _PyBRLock_Unlock(&test_data->lock);
+    _PyEvent_Notify(&test_data->done);
+}
+
+static PyObject *
+test_lock_brlock(PyObject *self, PyObject *obj)
+{
+    struct test_brlock_data test_data;
+    memset(&test_data, 0, sizeof(test_data));
+    _PyBRLock *lock = &test_data.lock;
+
+    _PyBRLock_RLock(lock);
+    assert(_PyBRLock_TryRLock(lock));
+    _PyBRLock_RUnlock(lock);
+    _PyBRLock_RUnlock(lock);
+
+    _PyBRLock_Lock(lock);
+    assert(!_PyBRLock_TryRLock(lock));
+    _PyBRLock_Unlock(lock);
+    assert(_PyBRLock_TryRLock(lock));
+    _PyBRLock_RUnlock(lock);
+
+    // The writer waits for the reader of another thread
+    PyThread_start_new_thread(brlock_reader_thread, &test_data);
+    PyEvent_Wait(&test_data.reader_started);
+    PyThread_start_new_thread(brlock_writer_thread, &test_data);
+    pysleep(100);
+    assert(!_Py_atomic_load_int(&test_data.writer_done));
+
+    // New readers don't overtake a waiting writer
+    assert(!_PyBRLock_TryRLock(lock));
+
+    _PyEvent_Notify(&test_data.step1);
+    PyEvent_Wait(&test_data.reader_done);
+    while (!_Py_atomic_load_int(&test_data.writer_done)) {
+        pysleep(10);
+    }
+    assert(!_PyBRLock_TryRLock(lock));
+
+    _PyEvent_Notify(&test_data.step2);
+    PyEvent_Wait(&test_data.done);
+    assert(_PyBRLock_TryRLock(lock));
+    _PyBRLock_RUnlock(lock);
+    Py_RETURN_NONE;
+}
+
+// Writes done by the first thread of benchmark_rwlocks(), per million reads
+#define BENCH_RWLOCK_WRITES 10
+
+struct bench_data_rwlocks {
+    int stop;
+    int use_brlock;
+    _PyRWMutex rw;
+    _PyBRLock br;
+    Py_ssize_t value;
+    Py_ssize_t total_iters;
+};
+
+struct bench_rwlock_thread_data {
+    struct bench_data_rwlocks *bench_data;
+    int writer;
+    Py_ssize_t iters;
+    PyEvent done;
+};
+
+static void
+thread_benchmark_rwlocks(void *arg)
+{
+    struct bench_rwlock_thread_data *thread_data = arg;
+    struct bench_data_rwlocks *bench_data = thread_data->bench_data;
+    int use_brlock = bench_data->use_brlock;
+
+    Py_ssize_t iters = 0;
+    Py_ssize_t sum = 0;
+    while (!_Py_atomic_load_int_relaxed(&bench_data->stop)) {
+        int write = (thread_data->writer &&
+                     iters % (1000000 / BENCH_RWLOCK_WRITES) == 0);
+        if (use_brlock) {
+            if (write) {
+                _PyBRLock_Lock(&bench_data->br);
+                bench_data->value++;
+                _PyBRLock_Unlock(&bench_data->br);
+            }
+            _PyBRLock_RLock(&bench_data->br);
+            sum += bench_data->value;
+            _PyBRLock_RUnlock(&bench_data->br);
+        }
+        else {
+            if (write) {
+                _PyRWMutex_Lock(&bench_data->rw);
+                bench_data->value++;
+                _PyRWMutex_Unlock(&bench_data->rw);
+            }
+            _PyRWMutex_RLock(&bench_data->rw);
+            sum += bench_data->value;
+            _PyRWMutex_RUnlock(&bench_data->rw);
+        }
+        iters++;
+    }
+
+    assert(sum >= 0);
+    thread_data->iters = iters;
+    _Py_atomic_add_ssize(&bench_data->total_iters, iters);
+    _PyEvent_Notify(&thread_data->done);
+}
+
+/*[clinic input]
+_testinternalcapi.benchmark_rwlocks
+
+    num_threads: Py_ssize_t
+    use_brlock: bool = True
+    time_ms: int = 1000
+    /
+
+Benchmark the read side of _PyRWMutex or _PyBRLock.
+
+The first thread also takes the lock for writing 10 times per million reads.
+Return the number of reads per second and a list of the reads of each thread.
+[clinic start generated code]*/
+
+static PyObject *
+_testinternalcapi_benchmark_rwlocks_impl(PyObject *module,
+                                         Py_ssize_t num_threads,
+                                         int use_brlock, int time_ms)
+/*[clinic end generated code: output=95d45fd5dd1aad74 input=fa9ed7d6238dcf0b]*/
+{
+    // Run from Tools/lockbench/lockbench.py --rwlock
+    PyObject *thread_iters = NULL;
+    PyObject *res = NULL;
+
+    struct bench_data_rwlocks bench_data;
+    memset(&bench_data, 0, sizeof(bench_data));
+    bench_data.use_brlock = use_brlock;
+
+    struct bench_rwlock_thread_data *thread_data = NULL;
+    thread_data = PyMem_Calloc(num_threads, sizeof(*thread_data));
+    if (thread_data == NULL) {
+        PyErr_NoMemory();
+        goto exit;
+    }
+
+    thread_iters = PyList_New(num_threads);
+    if (thread_iters == NULL) {
+        goto exit;
+    }
+
+    PyTime_t start, end;
+    if (PyTime_PerfCounter(&start) < 0) {
+        goto exit;
+    }
+
+    for (Py_ssize_t i = 0; i < num_threads; i++) {
+        thread_data[i].bench_data = &bench_data;
+        thread_data[i].writer = (i == 0);
+        PyThread_start_new_thread(thread_benchmark_rwlocks, &thread_data[i]);
+    }
+
+    pysleep(time_ms);
+    _Py_atomic_store_int(&bench_data.stop, 1);
+
+    for (Py_ssize_t i = 0; i < num_threads; i++) {
+        PyEvent_Wait(&thread_data[i].done);
+    }
+
+    Py_ssize_t total_iters = bench_data.total_iters;
+    if (PyTime_PerfCounter(&end) < 0) {
+        goto exit;
+    }
+
+    for (Py_ssize_t i = 0; i < num_threads; i++) {
+        PyObject *iter = PyLong_FromSsize_t(thread_data[i].iters);
+        if (iter == NULL) {
+            goto exit;
+        }
+        PyList_SET_ITEM(thread_iters, i, iter);
+    }
+
+    assert(end != start);
+    double rate = total_iters * 1e9 / (end - start);
+    res = Py_BuildValue("(dO)", rate, thread_iters);
+
+exit:
+    PyMem_Free(thread_data);
+    Py_XDECREF(thread_iters);
+    return res;
+}
+
+static PyObject *
+test_lock_benchmark_rwlocks(PyObject *module, PyObject *obj)
+{
+    // Just make sure the benchmark runs without crashing
+    PyObject *res = _testinternalcapi_benchmark_rwlocks_impl(
+        module, 2, 1, 100);
+    if (res == NULL) {
+        return NULL;
+    }
+    Py_DECREF(res);
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 test_lock_recursive(PyObject *self, PyObject *obj)
 {
@@ -502,6 +762,7 @@ test_lock_recursive(PyObject *self, PyObject *obj)
 
 static PyMethodDef test_methods[] = {
     {"test_lock_basic", test_lock_basic, METH_NOARGS},
+    {"test_lock_timeout", test_lock_timeout, METH_NOARGS},
     {"test_lock_two_threads", test_lock_two_threads, METH_NOARGS},
     {"test_lock_counter", test_lock_counter, METH_NOARGS},
     {"test_lock_counter_slow", test_lock_counter_slow, METH_NOARGS},
@@ -509,6 +770,9 @@ static PyMethodDef test_methods[] = {
     {"test_lock_benchmark", test_lock_benchmark, METH_NOARGS},
     {"test_lock_once", test_lock_once, METH_NOARGS},
     {"test_lock_rwlock", test_lock_rwlock, METH_NOARGS},
+    {"test_lock_brlock", test_lock_brlock, METH_NOARGS},
+    _TESTINTERNALCAPI_BENCHMARK_RWLOCKS_METHODDEF
+    {"test_lock_benchmark_rwlocks", test_lock_benchmark_rwlocks, METH_NOARGS},
     {"test_lock_recursive", test_lock_recursive, METH_NOARGS},
     {NULL, NULL} /* sentinel */
 };
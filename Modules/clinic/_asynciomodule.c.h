@@ -6,6 +6,7 @@ preserve
 #  include "pycore_gc.h"          // PyGC_Head
 #  include "pycore_runtime.h"     // _Py_ID()
 #endif
+#include "pycore_critical_section.h"// Py_BEGIN_CRITICAL_SECTION()
 #include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
 
 PyDoc_STRVAR(_asyncio_Future___init____doc__,
@@ -1488,6 +1489,235 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(_asyncio__LoopCore___init____doc__,
+"_LoopCore(loop, epoll_fd=-1, fd_to_key=<unrepresentable>)\n"
+"--\n"
+"\n"
+"The ready queue, timers and I/O dispatch of an event loop.\n"
+"\n"
+"If epoll_fd is given, it must be the file descriptor of the\n"
+"selectors.EpollSelector of the loop, and fd_to_key its dictionary of keys.");
+
+static int
+_asyncio__LoopCore___init___impl(LoopCoreObj *self, PyObject *loop,
+                                 int epoll_fd, PyObject *fd_to_key);
+
+static int
+_asyncio__LoopCore___init__(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int return_value = -1;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(loop), &_Py_ID(epoll_fd), &_Py_ID(fd_to_key), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"loop", "epoll_fd", "fd_to_key", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "_LoopCore",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 1;
+    PyObject *loop;
+    int epoll_fd = -1;
+    PyObject *fd_to_key = NULL;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser, 1, 3, 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    loop = fastargs[0];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (fastargs[1]) {
+        epoll_fd = PyLong_AsInt(fastargs[1]);
+        if (epoll_fd == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    if (!PyDict_Check(fastargs[2])) {
+        _PyArg_BadArgument("_LoopCore", "argument 'fd_to_key'", "dict", fastargs[2]);
+        goto exit;
+    }
+    fd_to_key = fastargs[2];
+skip_optional_pos:
+    return_value = _asyncio__LoopCore___init___impl((LoopCoreObj *)self, loop, epoll_fd, fd_to_key);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__LoopCore_append__doc__,
+"append($self, handle, /)\n"
+"--\n"
+"\n"
+"Add a handle to the ready queue.");
+
+#define _ASYNCIO__LOOPCORE_APPEND_METHODDEF    \
+    {"append", (PyCFunction)_asyncio__LoopCore_append, METH_O, _asyncio__LoopCore_append__doc__},
+
+static PyObject *
+_asyncio__LoopCore_append_impl(LoopCoreObj *self, PyObject *handle);
+
+static PyObject *
+_asyncio__LoopCore_append(LoopCoreObj *self, PyObject *handle)
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio__LoopCore_append_impl(self, handle);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__LoopCore_popleft__doc__,
+"popleft($self, /)\n"
+"--\n"
+"\n"
+"Remove and return the first handle of the ready queue.");
+
+#define _ASYNCIO__LOOPCORE_POPLEFT_METHODDEF    \
+    {"popleft", _PyCFunction_CAST(_asyncio__LoopCore_popleft), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio__LoopCore_popleft__doc__},
+
+static PyObject *
+_asyncio__LoopCore_popleft_impl(LoopCoreObj *self, PyTypeObject *cls);
+
+static PyObject *
+_asyncio__LoopCore_popleft(LoopCoreObj *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+
+    if (nargs || (kwnames && PyTuple_GET_SIZE(kwnames))) {
+        PyErr_SetString(PyExc_TypeError, "popleft() takes no arguments");
+        goto exit;
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio__LoopCore_popleft_impl(self, cls);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__LoopCore_clear__doc__,
+"clear($self, /)\n"
+"--\n"
+"\n"
+"Remove all the handles of the ready queue.");
+
+#define _ASYNCIO__LOOPCORE_CLEAR_METHODDEF    \
+    {"clear", (PyCFunction)_asyncio__LoopCore_clear, METH_NOARGS, _asyncio__LoopCore_clear__doc__},
+
+static PyObject *
+_asyncio__LoopCore_clear_impl(LoopCoreObj *self);
+
+static PyObject *
+_asyncio__LoopCore_clear(LoopCoreObj *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio__LoopCore_clear_impl(self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__LoopCore_push_timer__doc__,
+"push_timer($self, handle, /)\n"
+"--\n"
+"\n"
+"Schedule a TimerHandle at its \'when\' time.");
+
+#define _ASYNCIO__LOOPCORE_PUSH_TIMER_METHODDEF    \
+    {"push_timer", (PyCFunction)_asyncio__LoopCore_push_timer, METH_O, _asyncio__LoopCore_push_timer__doc__},
+
+static PyObject *
+_asyncio__LoopCore_push_timer_impl(LoopCoreObj *self, PyObject *handle);
+
+static PyObject *
+_asyncio__LoopCore_push_timer(LoopCoreObj *self, PyObject *handle)
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio__LoopCore_push_timer_impl(self, handle);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__LoopCore_clear_timers__doc__,
+"clear_timers($self, /)\n"
+"--\n"
+"\n"
+"Remove all the scheduled timers.");
+
+#define _ASYNCIO__LOOPCORE_CLEAR_TIMERS_METHODDEF    \
+    {"clear_timers", (PyCFunction)_asyncio__LoopCore_clear_timers, METH_NOARGS, _asyncio__LoopCore_clear_timers__doc__},
+
+static PyObject *
+_asyncio__LoopCore_clear_timers_impl(LoopCoreObj *self);
+
+static PyObject *
+_asyncio__LoopCore_clear_timers(LoopCoreObj *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio__LoopCore_clear_timers_impl(self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__LoopCore_run_once__doc__,
+"run_once($self, /)\n"
+"--\n"
+"\n"
+"Run one full iteration of the event loop.\n"
+"\n"
+"Like BaseEventLoop._run_once(): call all the ready callbacks, poll for\n"
+"I/O, schedule the resulting callbacks and the expired timers.");
+
+#define _ASYNCIO__LOOPCORE_RUN_ONCE_METHODDEF    \
+    {"run_once", _PyCFunction_CAST(_asyncio__LoopCore_run_once), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio__LoopCore_run_once__doc__},
+
+static PyObject *
+_asyncio__LoopCore_run_once_impl(LoopCoreObj *self, PyTypeObject *cls);
+
+static PyObject *
+_asyncio__LoopCore_run_once(LoopCoreObj *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    if (nargs || (kwnames && PyTuple_GET_SIZE(kwnames))) {
+        PyErr_SetString(PyExc_TypeError, "run_once() takes no arguments");
+        return NULL;
+    }
+    return _asyncio__LoopCore_run_once_impl(self, cls);
+}
+
 PyDoc_STRVAR(_asyncio_all_tasks__doc__,
 "all_tasks($module, /, loop=None)\n"
 "--\n"
@@ -1547,4 +1777,4 @@ skip_optional_pos:
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=ffe9b71bc65888b3 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=c84c9b58893d512c input=a9049054013a1b77]*/
@@ -0,0 +1,172 @@
+/*[clinic input]
+preserve
+[clinic start generated code]*/
+
+#if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+#  include "pycore_gc.h"          // PyGC_Head
+#  include "pycore_runtime.h"     // _Py_ID()
+#endif
+#include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
+
+PyDoc_STRVAR(_coverage_start__doc__,
+"start($module, /, *, branches=False, tool_id=sys.monitoring.COVERAGE_ID)\n"
+"--\n"
+"\n"
+"Start recording the lines executed by all threads.\n"
+"\n"
+"  branches\n"
+"    Also record which destinations of each branch were taken.\n"
+"  tool_id\n"
+"    sys.monitoring tool identifier to use.\n"
+"\n"
+"Data is accumulated with the one of previous runs until clear() is\n"
+"called.  Locations disabled by sys.monitoring tools are enabled again.");
+
+#define _COVERAGE_START_METHODDEF    \
+    {"start", _PyCFunction_CAST(_coverage_start), METH_FASTCALL|METH_KEYWORDS, _coverage_start__doc__},
+
+static PyObject *
+_coverage_start_impl(PyObject *module, int branches, int tool_id);
+
+static PyObject *
+_coverage_start(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 2
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(branches), &_Py_ID(tool_id), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"branches", "tool_id", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "start",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[2];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    int branches = 0;
+    int tool_id = PY_MONITORING_COVERAGE_ID;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 0, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    if (args[0]) {
+        branches = PyObject_IsTrue(args[0]);
+        if (branches < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_kwonly;
+        }
+    }
+    tool_id = PyLong_AsInt(args[1]);
+    if (tool_id == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional_kwonly:
+    return_value = _coverage_start_impl(module, branches, tool_id);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_coverage_stop__doc__,
+"stop($module, /)\n"
+"--\n"
+"\n"
+"Stop recording.  Recorded data is kept.");
+
+#define _COVERAGE_STOP_METHODDEF    \
+    {"stop", (PyCFunction)_coverage_stop, METH_NOARGS, _coverage_stop__doc__},
+
+static PyObject *
+_coverage_stop_impl(PyObject *module);
+
+static PyObject *
+_coverage_stop(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _coverage_stop_impl(module);
+}
+
+PyDoc_STRVAR(_coverage_is_running__doc__,
+"is_running($module, /)\n"
+"--\n"
+"\n"
+"Return True if coverage is being recorded.");
+
+#define _COVERAGE_IS_RUNNING_METHODDEF    \
+    {"is_running", (PyCFunction)_coverage_is_running, METH_NOARGS, _coverage_is_running__doc__},
+
+static PyObject *
+_coverage_is_running_impl(PyObject *module);
+
+static PyObject *
+_coverage_is_running(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _coverage_is_running_impl(module);
+}
+
+PyDoc_STRVAR(_coverage_clear__doc__,
+"clear($module, /)\n"
+"--\n"
+"\n"
+"Discard recorded data.\n"
+"\n"
+"If coverage is running, the lines and branches which were already\n"
+"reported are reported again the next time they are executed.");
+
+#define _COVERAGE_CLEAR_METHODDEF    \
+    {"clear", (PyCFunction)_coverage_clear, METH_NOARGS, _coverage_clear__doc__},
+
+static PyObject *
+_coverage_clear_impl(PyObject *module);
+
+static PyObject *
+_coverage_clear(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _coverage_clear_impl(module);
+}
+
+PyDoc_STRVAR(_coverage_collect__doc__,
+"collect($module, /)\n"
+"--\n"
+"\n"
+"Return the recorded data.\n"
+"\n"
+"Return a dict mapping each code object which was executed to a\n"
+"(lines, branches) tuple.  lines is the set of executed line numbers.\n"
+"branches is the set of (offset, destination) pairs of the branches which\n"
+"were taken, as reported by the sys.monitoring BRANCH event; it is empty\n"
+"if branches were not recorded.");
+
+#define _COVERAGE_COLLECT_METHODDEF    \
+    {"collect", (PyCFunction)_coverage_collect, METH_NOARGS, _coverage_collect__doc__},
+
+static PyObject *
+_coverage_collect_impl(PyObject *module);
+
+static PyObject *
+_coverage_collect(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _coverage_collect_impl(module);
+}
+/*[clinic end generated code: output=822660bd4f890bc3 input=a9049054013a1b77]*/
@@ -28,7 +28,12 @@ PyDoc_STRVAR(_lsprof_Profiler_getstats__doc__,
 "    callcount     how many times this is called\n"
 "    reccallcount  how many times this is called recursively\n"
 "    totaltime     total time spent in this call\n"
-"    inlinetime    inline time (not in further subcalls)");
+"    inlinetime    inline time (not in further subcalls)\n"
+"\n"
+"If the profiler was created with callsites=True, the\n"
+"calls made by a function are also separated according to\n"
+"the line of the caller, available (but not included in\n"
+"the tuple) as the lineno attribute of profiler_subentry.");
 
 #define _LSPROF_PROFILER_GETSTATS_METHODDEF    \
     {"getstats", _PyCFunction_CAST(_lsprof_Profiler_getstats), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _lsprof_Profiler_getstats__doc__},
@@ -45,4 +50,4 @@ _lsprof_Profiler_getstats(ProfilerObject *self, PyTypeObject *cls, PyObject *con
     }
     return _lsprof_Profiler_getstats_impl(self, cls);
 }
-/*[clinic end generated code: output=5c9d87d89863dc83 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=19fd1a510e6480fa input=a9049054013a1b77]*/
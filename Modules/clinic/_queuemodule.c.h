@@ -6,6 +6,7 @@ preserve
 #  include "pycore_gc.h"          // PyGC_Head
 #  include "pycore_runtime.h"     // _Py_ID()
 #endif
+#include "pycore_abstract.h"      // _PyNumber_Index()
 #include "pycore_critical_section.h"// Py_BEGIN_CRITICAL_SECTION()
 #include "pycore_modsupport.h"    // _PyArg_NoKeywords()
 
@@ -176,6 +177,18 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(_queue_SimpleQueue_put_many__doc__,
+"put_many($self, items, /)\n"
+"--\n"
+"\n"
+"Put all the items of an iterable on the queue.\n"
+"\n"
+"This is equivalent to calling put() for each item, but the items\n"
+"are added at once, and handed off to the waiting threads in a row.");
+
+#define _QUEUE_SIMPLEQUEUE_PUT_MANY_METHODDEF    \
+    {"put_many", (PyCFunction)_queue_SimpleQueue_put_many, METH_O, _queue_SimpleQueue_put_many__doc__},
+
 PyDoc_STRVAR(_queue_SimpleQueue_get__doc__,
 "get($self, /, block=True, timeout=None)\n"
 "--\n"
@@ -290,6 +303,97 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(_queue_SimpleQueue_get_many__doc__,
+"get_many($self, /, max_items, block=True, timeout=None)\n"
+"--\n"
+"\n"
+"Remove and return a list of up to max_items items from the queue.\n"
+"\n"
+"Wait for the first item as get() does, with the same \'block\' and\n"
+"\'timeout\' arguments, then also remove the items that are\n"
+"immediately available, up to max_items items in total.");
+
+#define _QUEUE_SIMPLEQUEUE_GET_MANY_METHODDEF    \
+    {"get_many", _PyCFunction_CAST(_queue_SimpleQueue_get_many), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _queue_SimpleQueue_get_many__doc__},
+
+static PyObject *
+_queue_SimpleQueue_get_many_impl(simplequeueobject *self, PyTypeObject *cls,
+                                 Py_ssize_t max_items, int block,
+                                 PyObject *timeout_obj);
+
+static PyObject *
+_queue_SimpleQueue_get_many(simplequeueobject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(max_items), &_Py_ID(block), &_Py_ID(timeout), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"max_items", "block", "timeout", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "get_many",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    Py_ssize_t max_items;
+    int block = 1;
+    PyObject *timeout_obj = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 3, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[0]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        max_items = ival;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[1]) {
+        block = PyObject_IsTrue(args[1]);
+        if (block < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    timeout_obj = args[2];
+skip_optional_pos:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _queue_SimpleQueue_get_many_impl(self, cls, max_items, block, timeout_obj);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(_queue_SimpleQueue_empty__doc__,
 "empty($self, /)\n"
 "--\n"
@@ -349,4 +453,535 @@ _queue_SimpleQueue_qsize(simplequeueobject *self, PyObject *Py_UNUSED(ignored))
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=44a718f40072018a input=a9049054013a1b77]*/
+
+PyDoc_STRVAR(fastqueue_new__doc__,
+"FastQueue(maxsize=0)\n"
+"--\n"
+"\n"
+"Create a lock-free FIFO queue object with a given maximum size.\n"
+"\n"
+"If maxsize is <= 0, the queue size is infinite.");
+
+static PyObject *
+fastqueue_new_impl(PyTypeObject *type, Py_ssize_t maxsize);
+
+static PyObject *
+fastqueue_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 1
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(maxsize), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"maxsize", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "FastQueue",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 0;
+    Py_ssize_t maxsize = 0;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser, 0, 1, 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(fastargs[0]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        maxsize = ival;
+    }
+skip_optional_pos:
+    return_value = fastqueue_new_impl(type, maxsize);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_queue_FastQueue_put__doc__,
+"put($self, /, item, block=True, timeout=None)\n"
+"--\n"
+"\n"
+"Put an item into the queue.\n"
+"\n"
+"If optional args \'block\' is true and \'timeout\' is None (the default),\n"
+"block if necessary until a free slot is available. If \'timeout\' is\n"
+"a non-negative number, it blocks at most \'timeout\' seconds and raises\n"
+"the Full exception if no free slot was available within that time.\n"
+"Otherwise (\'block\' is false), put an item on the queue if a free slot\n"
+"is immediately available, else raise the Full exception (\'timeout\'\n"
+"is ignored in that case).\n"
+"\n"
+"Raises ShutDown if the queue has been shut down.");
+
+#define _QUEUE_FASTQUEUE_PUT_METHODDEF    \
+    {"put", _PyCFunction_CAST(_queue_FastQueue_put), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _queue_FastQueue_put__doc__},
+
+static PyObject *
+_queue_FastQueue_put_impl(fastqueueobject *self, PyTypeObject *cls,
+                          PyObject *item, int block, PyObject *timeout_obj);
+
+static PyObject *
+_queue_FastQueue_put(fastqueueobject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(item), &_Py_ID(block), &_Py_ID(timeout), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"item", "block", "timeout", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "put",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    PyObject *item;
+    int block = 1;
+    PyObject *timeout_obj = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 3, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    item = args[0];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[1]) {
+        block = PyObject_IsTrue(args[1]);
+        if (block < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    timeout_obj = args[2];
+skip_optional_pos:
+    return_value = _queue_FastQueue_put_impl(self, cls, item, block, timeout_obj);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_queue_FastQueue_put_nowait__doc__,
+"put_nowait($self, /, item)\n"
+"--\n"
+"\n"
+"Put an item into the queue without blocking.\n"
+"\n"
+"Only enqueue the item if a free slot is immediately available.\n"
+"Otherwise raise the Full exception.");
+
+#define _QUEUE_FASTQUEUE_PUT_NOWAIT_METHODDEF    \
+    {"put_nowait", _PyCFunction_CAST(_queue_FastQueue_put_nowait), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _queue_FastQueue_put_nowait__doc__},
+
+static PyObject *
+_queue_FastQueue_put_nowait_impl(fastqueueobject *self, PyTypeObject *cls,
+                                 PyObject *item);
+
+static PyObject *
+_queue_FastQueue_put_nowait(fastqueueobject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 1
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(item), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"item", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "put_nowait",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    PyObject *item;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    item = args[0];
+    return_value = _queue_FastQueue_put_nowait_impl(self, cls, item);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_queue_FastQueue_get__doc__,
+"get($self, /, block=True, timeout=None)\n"
+"--\n"
+"\n"
+"Remove and return an item from the queue.\n"
+"\n"
+"If optional args \'block\' is true and \'timeout\' is None (the default),\n"
+"block if necessary until an item is available. If \'timeout\' is\n"
+"a non-negative number, it blocks at most \'timeout\' seconds and raises\n"
+"the Empty exception if no item was available within that time.\n"
+"Otherwise (\'block\' is false), return an item if one is immediately\n"
+"available, else raise the Empty exception (\'timeout\' is ignored\n"
+"in that case).\n"
+"\n"
+"Raises ShutDown if the queue has been shut down and is empty,\n"
+"or if the queue has been shut down immediately.");
+
+#define _QUEUE_FASTQUEUE_GET_METHODDEF    \
+    {"get", _PyCFunction_CAST(_queue_FastQueue_get), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _queue_FastQueue_get__doc__},
+
+static PyObject *
+_queue_FastQueue_get_impl(fastqueueobject *self, PyTypeObject *cls,
+                          int block, PyObject *timeout_obj);
+
+static PyObject *
+_queue_FastQueue_get(fastqueueobject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 2
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(block), &_Py_ID(timeout), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"block", "timeout", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "get",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[2];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    int block = 1;
+    PyObject *timeout_obj = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 2, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[0]) {
+        block = PyObject_IsTrue(args[0]);
+        if (block < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    timeout_obj = args[1];
+skip_optional_pos:
+    return_value = _queue_FastQueue_get_impl(self, cls, block, timeout_obj);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_queue_FastQueue_get_nowait__doc__,
+"get_nowait($self, /)\n"
+"--\n"
+"\n"
+"Remove and return an item from the queue without blocking.\n"
+"\n"
+"Only get an item if one is immediately available. Otherwise\n"
+"raise the Empty exception.");
+
+#define _QUEUE_FASTQUEUE_GET_NOWAIT_METHODDEF    \
+    {"get_nowait", _PyCFunction_CAST(_queue_FastQueue_get_nowait), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _queue_FastQueue_get_nowait__doc__},
+
+static PyObject *
+_queue_FastQueue_get_nowait_impl(fastqueueobject *self, PyTypeObject *cls);
+
+static PyObject *
+_queue_FastQueue_get_nowait(fastqueueobject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    if (nargs || (kwnames && PyTuple_GET_SIZE(kwnames))) {
+        PyErr_SetString(PyExc_TypeError, "get_nowait() takes no arguments");
+        return NULL;
+    }
+    return _queue_FastQueue_get_nowait_impl(self, cls);
+}
+
+PyDoc_STRVAR(_queue_FastQueue_task_done__doc__,
+"task_done($self, /)\n"
+"--\n"
+"\n"
+"Indicate that a formerly enqueued task is complete.\n"
+"\n"
+"Used by Queue consumer threads.  For each get() used to fetch a task,\n"
+"a subsequent call to task_done() tells the queue that the processing\n"
+"on the task is complete.\n"
+"\n"
+"If a join() is currently blocking, it will resume when all items\n"
+"have been processed (meaning that a task_done() call was received\n"
+"for every item that had been put() into the queue).\n"
+"\n"
+"shutdown(immediate=True) calls task_done() for each remaining item in\n"
+"the queue.\n"
+"\n"
+"Raises a ValueError if called more times than there were items\n"
+"placed in the queue.");
+
+#define _QUEUE_FASTQUEUE_TASK_DONE_METHODDEF    \
+    {"task_done", (PyCFunction)_queue_FastQueue_task_done, METH_NOARGS, _queue_FastQueue_task_done__doc__},
+
+static PyObject *
+_queue_FastQueue_task_done_impl(fastqueueobject *self);
+
+static PyObject *
+_queue_FastQueue_task_done(fastqueueobject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _queue_FastQueue_task_done_impl(self);
+}
+
+PyDoc_STRVAR(_queue_FastQueue_join__doc__,
+"join($self, /)\n"
+"--\n"
+"\n"
+"Blocks until all items in the Queue have been gotten and processed.\n"
+"\n"
+"The count of unfinished tasks goes up whenever an item is added to the\n"
+"queue. The count goes down whenever a consumer thread calls task_done()\n"
+"to indicate the item was retrieved and all work on it is complete.\n"
+"\n"
+"When the count of unfinished tasks drops to zero, join() unblocks.");
+
+#define _QUEUE_FASTQUEUE_JOIN_METHODDEF    \
+    {"join", (PyCFunction)_queue_FastQueue_join, METH_NOARGS, _queue_FastQueue_join__doc__},
+
+static PyObject *
+_queue_FastQueue_join_impl(fastqueueobject *self);
+
+static PyObject *
+_queue_FastQueue_join(fastqueueobject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _queue_FastQueue_join_impl(self);
+}
+
+PyDoc_STRVAR(_queue_FastQueue_shutdown__doc__,
+"shutdown($self, /, immediate=False)\n"
+"--\n"
+"\n"
+"Shut-down the queue, making queue gets and puts raise ShutDown.\n"
+"\n"
+"By default, gets will only raise once the queue is empty. Set\n"
+"\'immediate\' to True to make gets raise immediately instead.\n"
+"\n"
+"All blocked callers of put() and get() will be unblocked. If\n"
+"\'immediate\', a task is marked as done for each item remaining in\n"
+"the queue, which may unblock callers of join().");
+
+#define _QUEUE_FASTQUEUE_SHUTDOWN_METHODDEF    \
+    {"shutdown", _PyCFunction_CAST(_queue_FastQueue_shutdown), METH_FASTCALL|METH_KEYWORDS, _queue_FastQueue_shutdown__doc__},
+
+static PyObject *
+_queue_FastQueue_shutdown_impl(fastqueueobject *self, int immediate);
+
+static PyObject *
+_queue_FastQueue_shutdown(fastqueueobject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 1
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(immediate), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"immediate", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "shutdown",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    int immediate = 0;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    immediate = PyObject_IsTrue(args[0]);
+    if (immediate < 0) {
+        goto exit;
+    }
+skip_optional_pos:
+    return_value = _queue_FastQueue_shutdown_impl(self, immediate);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_queue_FastQueue_empty__doc__,
+"empty($self, /)\n"
+"--\n"
+"\n"
+"Return True if the queue is empty, False otherwise (not reliable!).");
+
+#define _QUEUE_FASTQUEUE_EMPTY_METHODDEF    \
+    {"empty", (PyCFunction)_queue_FastQueue_empty, METH_NOARGS, _queue_FastQueue_empty__doc__},
+
+static int
+_queue_FastQueue_empty_impl(fastqueueobject *self);
+
+static PyObject *
+_queue_FastQueue_empty(fastqueueobject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    int _return_value;
+
+    _return_value = _queue_FastQueue_empty_impl(self);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyBool_FromLong((long)_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_queue_FastQueue_full__doc__,
+"full($self, /)\n"
+"--\n"
+"\n"
+"Return True if the queue is full, False otherwise (not reliable!).");
+
+#define _QUEUE_FASTQUEUE_FULL_METHODDEF    \
+    {"full", (PyCFunction)_queue_FastQueue_full, METH_NOARGS, _queue_FastQueue_full__doc__},
+
+static int
+_queue_FastQueue_full_impl(fastqueueobject *self);
+
+static PyObject *
+_queue_FastQueue_full(fastqueueobject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    int _return_value;
+
+    _return_value = _queue_FastQueue_full_impl(self);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyBool_FromLong((long)_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_queue_FastQueue_qsize__doc__,
+"qsize($self, /)\n"
+"--\n"
+"\n"
+"Return the approximate size of the queue (not reliable!).");
+
+#define _QUEUE_FASTQUEUE_QSIZE_METHODDEF    \
+    {"qsize", (PyCFunction)_queue_FastQueue_qsize, METH_NOARGS, _queue_FastQueue_qsize__doc__},
+
+static Py_ssize_t
+_queue_FastQueue_qsize_impl(fastqueueobject *self);
+
+static PyObject *
+_queue_FastQueue_qsize(fastqueueobject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t _return_value;
+
+    _return_value = _queue_FastQueue_qsize_impl(self);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromSsize_t(_return_value);
+
+exit:
+    return return_value;
+}
+/*[clinic end generated code: output=619d0cf1180cd3dc input=a9049054013a1b77]*/
@@ -0,0 +1,207 @@
+/*[clinic input]
+preserve
+[clinic start generated code]*/
+
+#if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+#  include "pycore_gc.h"          // PyGC_Head
+#  include "pycore_runtime.h"     // _Py_ID()
+#endif
+#include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
+
+PyDoc_STRVAR(sampler_new__doc__,
+"Sampler(pid)\n"
+"--\n"
+"\n"
+"Sample the Python stacks of another process.\n"
+"\n"
+"  pid\n"
+"    Identifier of the process to sample.  It must run the same\n"
+"    version of Python as the current process.");
+
+static PyObject *
+sampler_new_impl(PyTypeObject *type, int pid);
+
+static PyObject *
+sampler_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 1
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(pid), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"pid", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "Sampler",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    int pid;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser, 1, 1, 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    pid = PyLong_AsInt(fastargs[0]);
+    if (pid == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = sampler_new_impl(type, pid);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_remotesampler_Sampler_sample__doc__,
+"sample($self, /)\n"
+"--\n"
+"\n"
+"Take one sample of the stacks of all threads.\n"
+"\n"
+"Return a list of (thread_id, task_name, frames) tuples, one per thread.\n"
+"thread_id is the native identifier of the thread, task_name is the name\n"
+"of the asyncio task run by the thread or None, and frames is a list of\n"
+"(qualname, filename, lineno) tuples, innermost frame first.");
+
+#define _REMOTESAMPLER_SAMPLER_SAMPLE_METHODDEF    \
+    {"sample", (PyCFunction)_remotesampler_Sampler_sample, METH_NOARGS, _remotesampler_Sampler_sample__doc__},
+
+static PyObject *
+_remotesampler_Sampler_sample_impl(SamplerObject *self);
+
+static PyObject *
+_remotesampler_Sampler_sample(SamplerObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _remotesampler_Sampler_sample_impl(self);
+}
+
+PyDoc_STRVAR(_remotesampler_Sampler_run__doc__,
+"run($self, /, duration, interval=0.01, *, per_thread=False)\n"
+"--\n"
+"\n"
+"Sample the process at regular intervals.\n"
+"\n"
+"  duration\n"
+"    Duration of the profiling, in seconds.\n"
+"  interval\n"
+"    Time between two samples, in seconds.\n"
+"  per_thread\n"
+"    Prefix each stack with the identifier of its thread.\n"
+"\n"
+"Return a dict mapping collapsed stacks to the number of times they\n"
+"were sampled.  A collapsed stack lists the frames of a thread, outermost\n"
+"first, as \"qualname (filename:lineno)\" strings separated by semicolons.\n"
+"The name of the asyncio task run by the thread is inserted as a\n"
+"\"<Task name>\" frame.  Written as \"stack count\" lines, the result can be\n"
+"rendered as a flame graph by flamegraph.pl.\n"
+"\n"
+"Sampling stops early if the process exits.  Samples which cannot be\n"
+"decoded, for example because a thread changed its stack while it was\n"
+"read, are counted as lost.");
+
+#define _REMOTESAMPLER_SAMPLER_RUN_METHODDEF    \
+    {"run", _PyCFunction_CAST(_remotesampler_Sampler_run), METH_FASTCALL|METH_KEYWORDS, _remotesampler_Sampler_run__doc__},
+
+static PyObject *
+_remotesampler_Sampler_run_impl(SamplerObject *self, double duration,
+                                double interval, int per_thread);
+
+static PyObject *
+_remotesampler_Sampler_run(SamplerObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(duration), &_Py_ID(interval), &_Py_ID(per_thread), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"duration", "interval", "per_thread", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "run",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    double duration;
+    double interval = 0.01;
+    int per_thread = 0;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 2, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (PyFloat_CheckExact(args[0])) {
+        duration = PyFloat_AS_DOUBLE(args[0]);
+    }
+    else
+    {
+        duration = PyFloat_AsDouble(args[0]);
+        if (duration == -1.0 && PyErr_Occurred()) {
+            goto exit;
+        }
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[1]) {
+        if (PyFloat_CheckExact(args[1])) {
+            interval = PyFloat_AS_DOUBLE(args[1]);
+        }
+        else
+        {
+            interval = PyFloat_AsDouble(args[1]);
+            if (interval == -1.0 && PyErr_Occurred()) {
+                goto exit;
+            }
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+skip_optional_pos:
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    per_thread = PyObject_IsTrue(args[2]);
+    if (per_thread < 0) {
+        goto exit;
+    }
+skip_optional_kwonly:
+    return_value = _remotesampler_Sampler_run_impl(self, duration, interval, per_thread);
+
+exit:
+    return return_value;
+}
+/*[clinic end generated code: output=9f84387b3772412e input=a9049054013a1b77]*/
@@ -0,0 +1,281 @@
+/*[clinic input]
+preserve
+[clinic start generated code]*/
+
+#if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+#  include "pycore_gc.h"          // PyGC_Head
+#  include "pycore_runtime.h"     // _Py_ID()
+#endif
+#include "pycore_abstract.h"      // _PyNumber_Index()
+#include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
+
+PyDoc_STRVAR(_sampleprof_start__doc__,
+"start($module, /, interval=0.01, *, all_threads=False, max_depth=256)\n"
+"--\n"
+"\n"
+"Start sampling the Python stacks of the current interpreter.\n"
+"\n"
+"  interval\n"
+"    Time between two samples, in seconds.\n"
+"  all_threads\n"
+"    Sample every thread of the interpreter instead of only the\n"
+"    thread which is running Python code.\n"
+"  max_depth\n"
+"    Maximum number of frames recorded per stack.  The outermost\n"
+"    frames of deeper stacks are dropped.\n"
+"\n"
+"Samples are accumulated with the ones of previous runs until clear()\n"
+"is called.");
+
+#define _SAMPLEPROF_START_METHODDEF    \
+    {"start", _PyCFunction_CAST(_sampleprof_start), METH_FASTCALL|METH_KEYWORDS, _sampleprof_start__doc__},
+
+static PyObject *
+_sampleprof_start_impl(PyObject *module, double interval, int all_threads,
+                       Py_ssize_t max_depth);
+
+static PyObject *
+_sampleprof_start(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(interval), &_Py_ID(all_threads), &_Py_ID(max_depth), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"interval", "all_threads", "max_depth", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "start",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    double interval = 0.01;
+    int all_threads = 0;
+    Py_ssize_t max_depth = DEFAULT_MAX_DEPTH;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[0]) {
+        if (PyFloat_CheckExact(args[0])) {
+            interval = PyFloat_AS_DOUBLE(args[0]);
+        }
+        else
+        {
+            interval = PyFloat_AsDouble(args[0]);
+            if (interval == -1.0 && PyErr_Occurred()) {
+                goto exit;
+            }
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+skip_optional_pos:
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    if (args[1]) {
+        all_threads = PyObject_IsTrue(args[1]);
+        if (all_threads < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_kwonly;
+        }
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[2]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        max_depth = ival;
+    }
+skip_optional_kwonly:
+    return_value = _sampleprof_start_impl(module, interval, all_threads, max_depth);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_sampleprof_stop__doc__,
+"stop($module, /)\n"
+"--\n"
+"\n"
+"Stop sampling.\n"
+"\n"
+"The samples collected so far are kept.");
+
+#define _SAMPLEPROF_STOP_METHODDEF    \
+    {"stop", (PyCFunction)_sampleprof_stop, METH_NOARGS, _sampleprof_stop__doc__},
+
+static PyObject *
+_sampleprof_stop_impl(PyObject *module);
+
+static PyObject *
+_sampleprof_stop(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _sampleprof_stop_impl(module);
+}
+
+PyDoc_STRVAR(_sampleprof_is_running__doc__,
+"is_running($module, /)\n"
+"--\n"
+"\n"
+"Return True if the profiler is running.");
+
+#define _SAMPLEPROF_IS_RUNNING_METHODDEF    \
+    {"is_running", (PyCFunction)_sampleprof_is_running, METH_NOARGS, _sampleprof_is_running__doc__},
+
+static PyObject *
+_sampleprof_is_running_impl(PyObject *module);
+
+static PyObject *
+_sampleprof_is_running(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _sampleprof_is_running_impl(module);
+}
+
+PyDoc_STRVAR(_sampleprof_clear__doc__,
+"clear($module, /)\n"
+"--\n"
+"\n"
+"Discard the samples collected so far.");
+
+#define _SAMPLEPROF_CLEAR_METHODDEF    \
+    {"clear", (PyCFunction)_sampleprof_clear, METH_NOARGS, _sampleprof_clear__doc__},
+
+static PyObject *
+_sampleprof_clear_impl(PyObject *module);
+
+static PyObject *
+_sampleprof_clear(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _sampleprof_clear_impl(module);
+}
+
+PyDoc_STRVAR(_sampleprof_collect__doc__,
+"collect($module, /)\n"
+"--\n"
+"\n"
+"Return the samples collected so far.\n"
+"\n"
+"The result is a dict mapping collapsed stacks to the number of samples.\n"
+"A collapsed stack is a string of \"qualname (filename:lineno)\" frames\n"
+"separated by semicolons, outermost frame first.");
+
+#define _SAMPLEPROF_COLLECT_METHODDEF    \
+    {"collect", (PyCFunction)_sampleprof_collect, METH_NOARGS, _sampleprof_collect__doc__},
+
+static PyObject *
+_sampleprof_collect_impl(PyObject *module);
+
+static PyObject *
+_sampleprof_collect(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _sampleprof_collect_impl(module);
+}
+
+PyDoc_STRVAR(_sampleprof_dump__doc__,
+"dump($module, /, filename)\n"
+"--\n"
+"\n"
+"Write the samples collected so far to a file in collapsed stack format.\n"
+"\n"
+"Each line holds a collapsed stack, a space and the number of samples.\n"
+"The file can be fed to flame graph tools.");
+
+#define _SAMPLEPROF_DUMP_METHODDEF    \
+    {"dump", _PyCFunction_CAST(_sampleprof_dump), METH_FASTCALL|METH_KEYWORDS, _sampleprof_dump__doc__},
+
+static PyObject *
+_sampleprof_dump_impl(PyObject *module, PyObject *filename);
+
+static PyObject *
+_sampleprof_dump(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 1
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(filename), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"filename", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "dump",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    PyObject *filename;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    filename = args[0];
+    return_value = _sampleprof_dump_impl(module, filename);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_sampleprof_get_stats__doc__,
+"get_stats($module, /)\n"
+"--\n"
+"\n"
+"Return a dict with the number of samples taken and lost.\n"
+"\n"
+"Samples are lost when memory cannot be allocated to record them.");
+
+#define _SAMPLEPROF_GET_STATS_METHODDEF    \
+    {"get_stats", (PyCFunction)_sampleprof_get_stats, METH_NOARGS, _sampleprof_get_stats__doc__},
+
+static PyObject *
+_sampleprof_get_stats_impl(PyObject *module);
+
+static PyObject *
+_sampleprof_get_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return _sampleprof_get_stats_impl(module);
+}
+/*[clinic end generated code: output=d4f45117b980b076 input=a9049054013a1b77]*/
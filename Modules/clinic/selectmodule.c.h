@@ -1014,6 +1014,189 @@ exit:
 
 #if defined(HAVE_EPOLL)
 
+PyDoc_STRVAR(select_epoll_poll_into__doc__,
+"poll_into($self, /, buffer, timeout=None)\n"
+"--\n"
+"\n"
+"Wait for events on the epoll file descriptor, without creating objects.\n"
+"\n"
+"  buffer\n"
+"    a writable buffer of C ints, such as array.array(\'i\')\n"
+"  timeout\n"
+"    the maximum time to wait in seconds (as float);\n"
+"    a timeout of None or -1 makes poll wait indefinitely\n"
+"\n"
+"The descriptors that have events to report and their events are written\n"
+"to the buffer as pairs of C ints: fd, events, fd, events, ...  At most\n"
+"len(buffer) // 2 events are reported.\n"
+"\n"
+"Returns the number of events.");
+
+#define SELECT_EPOLL_POLL_INTO_METHODDEF    \
+    {"poll_into", _PyCFunction_CAST(select_epoll_poll_into), METH_FASTCALL|METH_KEYWORDS, select_epoll_poll_into__doc__},
+
+static PyObject *
+select_epoll_poll_into_impl(pyEpoll_Object *self, Py_buffer *buffer,
+                            PyObject *timeout_obj);
+
+static PyObject *
+select_epoll_poll_into(pyEpoll_Object *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 2
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(buffer), &_Py_ID(timeout), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"buffer", "timeout", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "poll_into",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[2];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    Py_buffer buffer = {NULL, NULL};
+    PyObject *timeout_obj = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 2, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (PyObject_GetBuffer(args[0], &buffer, PyBUF_WRITABLE) < 0) {
+        _PyArg_BadArgument("poll_into", "argument 'buffer'", "read-write bytes-like object", args[0]);
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    timeout_obj = args[1];
+skip_optional_pos:
+    return_value = select_epoll_poll_into_impl(self, &buffer, timeout_obj);
+
+exit:
+    /* Cleanup for buffer */
+    if (buffer.obj) {
+       PyBuffer_Release(&buffer);
+    }
+
+    return return_value;
+}
+
+#endif /* defined(HAVE_EPOLL) */
+
+#if defined(HAVE_EPOLL)
+
+PyDoc_STRVAR(select_epoll_dispatch__doc__,
+"dispatch($self, /, handlers, timeout=None, maxevents=-1)\n"
+"--\n"
+"\n"
+"Wait for events on the epoll file descriptor and call their handlers.\n"
+"\n"
+"  handlers\n"
+"    a dictionary mapping file descriptors to callables\n"
+"  timeout\n"
+"    the maximum time to wait in seconds (as float);\n"
+"    a timeout of None or -1 makes poll wait indefinitely\n"
+"  maxevents\n"
+"    the maximum number of events handled; -1 means no limit\n"
+"\n"
+"For every descriptor which has events to report, handlers[fd](events) is\n"
+"called.  Descriptors missing from handlers are ignored.  If a handler\n"
+"raises an exception, the remaining events are discarded and the exception\n"
+"is propagated.\n"
+"\n"
+"Returns the number of events.");
+
+#define SELECT_EPOLL_DISPATCH_METHODDEF    \
+    {"dispatch", _PyCFunction_CAST(select_epoll_dispatch), METH_FASTCALL|METH_KEYWORDS, select_epoll_dispatch__doc__},
+
+static PyObject *
+select_epoll_dispatch_impl(pyEpoll_Object *self, PyObject *handlers,
+                           PyObject *timeout_obj, int maxevents);
+
+static PyObject *
+select_epoll_dispatch(pyEpoll_Object *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(handlers), &_Py_ID(timeout), &_Py_ID(maxevents), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"handlers", "timeout", "maxevents", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "dispatch",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    PyObject *handlers;
+    PyObject *timeout_obj = Py_None;
+    int maxevents = -1;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 3, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!PyDict_Check(args[0])) {
+        _PyArg_BadArgument("dispatch", "argument 'handlers'", "dict", args[0]);
+        goto exit;
+    }
+    handlers = args[0];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[1]) {
+        timeout_obj = args[1];
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    maxevents = PyLong_AsInt(args[2]);
+    if (maxevents == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional_pos:
+    return_value = select_epoll_dispatch_impl(self, handlers, timeout_obj, maxevents);
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_EPOLL) */
+
+#if defined(HAVE_EPOLL)
+
 PyDoc_STRVAR(select_epoll___enter____doc__,
 "__enter__($self, /)\n"
 "--\n"
@@ -1337,6 +1520,14 @@ exit:
     #define SELECT_EPOLL_POLL_METHODDEF
 #endif /* !defined(SELECT_EPOLL_POLL_METHODDEF) */
 
+#ifndef SELECT_EPOLL_POLL_INTO_METHODDEF
+    #define SELECT_EPOLL_POLL_INTO_METHODDEF
+#endif /* !defined(SELECT_EPOLL_POLL_INTO_METHODDEF) */
+
+#ifndef SELECT_EPOLL_DISPATCH_METHODDEF
+    #define SELECT_EPOLL_DISPATCH_METHODDEF
+#endif /* !defined(SELECT_EPOLL_DISPATCH_METHODDEF) */
+
 #ifndef SELECT_EPOLL___ENTER___METHODDEF
     #define SELECT_EPOLL___ENTER___METHODDEF
 #endif /* !defined(SELECT_EPOLL___ENTER___METHODDEF) */
@@ -1360,4 +1551,4 @@ exit:
 #ifndef SELECT_KQUEUE_CONTROL_METHODDEF
     #define SELECT_KQUEUE_CONTROL_METHODDEF
 #endif /* !defined(SELECT_KQUEUE_CONTROL_METHODDEF) */
-/*[clinic end generated code: output=f99427b75cbe6d44 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=78b17b4556bfc1c5 input=a9049054013a1b77]*/
@@ -0,0 +1,524 @@
+/* Helpers to read the memory of another Python process.
+
+   Shared by the _remotesampler and _testexternalinspection modules.  This
+   header must be included after Python.h and pycore_runtime.h. */
+
+#ifndef Py_REMOTE_DEBUG_H
+#define Py_REMOTE_DEBUG_H
+
+#ifdef __linux__
+#    include <elf.h>
+#    include <sys/uio.h>
+#    if INTPTR_MAX == INT64_MAX
+#        define Elf_Ehdr Elf64_Ehdr
+#        define Elf_Shdr Elf64_Shdr
+#        define Elf_Phdr Elf64_Phdr
+#    else
+#        define Elf_Ehdr Elf32_Ehdr
+#        define Elf_Shdr Elf32_Shdr
+#        define Elf_Phdr Elf32_Phdr
+#    endif
+#    include <sys/mman.h>
+#endif
+
+#if defined(__APPLE__)
+#  include <TargetConditionals.h>
+// Older macOS SDKs do not define TARGET_OS_OSX
+#  if !defined(TARGET_OS_OSX)
+#     define TARGET_OS_OSX 1
+#  endif
+#  if TARGET_OS_OSX
+#    include <libproc.h>
+#    include <mach-o/fat.h>
+#    include <mach-o/loader.h>
+#    include <mach-o/nlist.h>
+#    include <mach/mach.h>
+#    include <mach/mach_vm.h>
+#    include <mach/machine.h>
+#    include <sys/mman.h>
+#    include <sys/proc.h>
+#    include <sys/sysctl.h>
+#  endif
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#ifndef HAVE_PROCESS_VM_READV
+#    define HAVE_PROCESS_VM_READV 0
+#endif
+
+#if (defined(__linux__) && HAVE_PROCESS_VM_READV) || \
+    (defined(__APPLE__) && TARGET_OS_OSX)
+#    define Py_REMOTE_DEBUG_SUPPORTED 1
+#else
+#    define Py_REMOTE_DEBUG_SUPPORTED 0
+#endif
+
+#if defined(__APPLE__) && TARGET_OS_OSX
+static void*
+analyze_macho64(mach_port_t proc_ref, void* base, void* map, const char* secname)
+{
+    struct mach_header_64* hdr = (struct mach_header_64*)map;
+    int ncmds = hdr->ncmds;
+
+    int cmd_cnt = 0;
+    struct segment_command_64* cmd = map + sizeof(struct mach_header_64);
+
+    mach_vm_size_t size = 0;
+    mach_msg_type_number_t count = sizeof(vm_region_basic_info_data_64_t);
+    mach_vm_address_t address = (mach_vm_address_t)base;
+    vm_region_basic_info_data_64_t region_info;
+    mach_port_t object_name;
+
+    for (int i = 0; cmd_cnt < 2 && i < ncmds; i++) {
+        if (cmd->cmd == LC_SEGMENT_64 && strcmp(cmd->segname, "__DATA") == 0) {
+            while (cmd->filesize != size) {
+                address += size;
+                if (mach_vm_region(
+                            proc_ref,
+                            &address,
+                            &size,
+                            VM_REGION_BASIC_INFO_64,
+                            (vm_region_info_t)&region_info,  // cppcheck-suppress [uninitvar]
+                            &count,
+                            &object_name)
+                    != KERN_SUCCESS)
+                {
+                    PyErr_SetString(PyExc_RuntimeError, "Cannot get any more VM maps.\n");
+                    return NULL;
+                }
+            }
+            base = (void*)address - cmd->vmaddr;
+
+            int nsects = cmd->nsects;
+            struct section_64* sec =
+                    (struct section_64*)((void*)cmd + sizeof(struct segment_command_64));
+            for (int j = 0; j < nsects; j++) {
+                if (strcmp(sec[j].sectname, secname) == 0) {
+                    return base + sec[j].addr;
+                }
+            }
+            cmd_cnt++;
+        }
+
+        cmd = (struct segment_command_64*)((void*)cmd + cmd->cmdsize);
+    }
+    return NULL;
+}
+
+static void*
+analyze_macho(char* path, void* base, mach_vm_size_t size, mach_port_t proc_ref,
+              const char* secname)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        PyErr_Format(PyExc_RuntimeError, "Cannot open binary %s\n", path);
+        return NULL;
+    }
+
+    struct stat fs;
+    if (fstat(fd, &fs) == -1) {
+        PyErr_Format(PyExc_RuntimeError, "Cannot get size of binary %s\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    void* map = mmap(0, fs.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        PyErr_Format(PyExc_RuntimeError, "Cannot map binary %s\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    void* result = NULL;
+
+    struct mach_header_64* hdr = (struct mach_header_64*)map;
+    switch (hdr->magic) {
+        case MH_MAGIC:
+        case MH_CIGAM:
+        case FAT_MAGIC:
+        case FAT_CIGAM:
+            PyErr_SetString(PyExc_RuntimeError, "32-bit Mach-O binaries are not supported");
+            break;
+        case MH_MAGIC_64:
+        case MH_CIGAM_64:
+            result = analyze_macho64(proc_ref, base, map, secname);
+            break;
+        default:
+            PyErr_SetString(PyExc_RuntimeError, "Unknown Mach-O magic");
+            break;
+    }
+
+    munmap(map, fs.st_size);
+    if (close(fd) != 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+    }
+    return result;
+}
+
+static mach_port_t
+pid_to_task(pid_t pid)
+{
+    mach_port_t task;
+    kern_return_t result;
+
+    result = task_for_pid(mach_task_self(), pid, &task);
+    if (result != KERN_SUCCESS) {
+        PyErr_Format(PyExc_PermissionError, "Cannot get task for PID %d", pid);
+        return 0;
+    }
+    return task;
+}
+
+static void*
+search_map_for_section_macos(pid_t pid, const char* secname, const char* map)
+{
+    mach_vm_address_t address = 0;
+    mach_vm_size_t size = 0;
+    mach_msg_type_number_t count = sizeof(vm_region_basic_info_data_64_t);
+    vm_region_basic_info_data_64_t region_info;
+    mach_port_t object_name;
+
+    mach_port_t proc_ref = pid_to_task(pid);
+    if (proc_ref == 0) {
+        PyErr_SetString(PyExc_PermissionError, "Cannot get task for PID");
+        return NULL;
+    }
+
+    char map_filename[MAXPATHLEN + 1];
+    while (mach_vm_region(
+                   proc_ref,
+                   &address,
+                   &size,
+                   VM_REGION_BASIC_INFO_64,
+                   (vm_region_info_t)&region_info,
+                   &count,
+                   &object_name)
+           == KERN_SUCCESS)
+    {
+        int path_len = proc_regionfilename(pid, address, map_filename, MAXPATHLEN);
+        if (path_len == 0) {
+            address += size;
+            continue;
+        }
+
+        char* filename = strrchr(map_filename, '/');
+        if (filename != NULL) {
+            filename++;  // Move past the '/'
+        } else {
+            filename = map_filename;  // No path, use the whole string
+        }
+
+        if (strncmp(filename, map, strlen(map)) == 0) {
+            return analyze_macho(map_filename, (void*)address, size, proc_ref, secname);
+        }
+
+        address += size;
+    }
+    return NULL;
+}
+#endif
+
+#ifdef __linux__
+static void*
+find_map_start_address(pid_t pid, char* result_filename, const char* map)
+{
+    char maps_file_path[64];
+    sprintf(maps_file_path, "/proc/%d/maps", pid);
+
+    FILE* maps_file = fopen(maps_file_path, "r");
+    if (maps_file == NULL) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return NULL;
+    }
+
+    size_t map_len = strlen(map);
+    char line[256];
+    char map_filename[PATH_MAX];
+    void* result_address = 0;
+    while (fgets(line, sizeof(line), maps_file) != NULL) {
+        unsigned long start_address = 0;
+        map_filename[0] = '\0';
+        sscanf(line, "%lx-%*x %*s %*s %*s %*s %s", &start_address, map_filename);
+        char* filename = strrchr(map_filename, '/');
+        if (filename != NULL) {
+            filename++;  // Move past the '/'
+        } else {
+            filename = map_filename;  // No path, use the whole string
+        }
+
+        if (strncmp(filename, map, map_len) == 0) {
+            result_address = (void*)start_address;
+            strcpy(result_filename, map_filename);
+            break;
+        }
+    }
+
+    fclose(maps_file);
+    return result_address;
+}
+
+static void*
+search_map_for_section_linux(pid_t pid, const char* secname, const char* map)
+{
+    char elf_file[PATH_MAX];
+    void* start_address = find_map_start_address(pid, elf_file, map);
+
+    if (start_address == 0) {
+        return NULL;
+    }
+
+    void* result = NULL;
+    void* file_memory = NULL;
+    struct stat file_stats;
+
+    int fd = open(elf_file, O_RDONLY);
+    if (fd < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return NULL;
+    }
+
+    if (fstat(fd, &file_stats) != 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        goto exit;
+    }
+
+    file_memory = mmap(NULL, file_stats.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (file_memory == MAP_FAILED) {
+        file_memory = NULL;
+        PyErr_SetFromErrno(PyExc_OSError);
+        goto exit;
+    }
+
+    Elf_Ehdr* elf_header = (Elf_Ehdr*)file_memory;
+
+    Elf_Shdr* section_header_table = (Elf_Shdr*)(file_memory + elf_header->e_shoff);
+
+    Elf_Shdr* shstrtab_section = &section_header_table[elf_header->e_shstrndx];
+    char* shstrtab = (char*)(file_memory + shstrtab_section->sh_offset);
+
+    Elf_Shdr* section = NULL;
+    for (int i = 0; i < elf_header->e_shnum; i++) {
+        const char* name = shstrtab + section_header_table[i].sh_name;
+        if (name[0] == '.' && strcmp(secname, name + 1) == 0) {
+            section = &section_header_table[i];
+            break;
+        }
+    }
+
+    Elf_Phdr* program_header_table = (Elf_Phdr*)(file_memory + elf_header->e_phoff);
+    // Find the first PT_LOAD segment
+    Elf_Phdr* first_load_segment = NULL;
+    for (int i = 0; i < elf_header->e_phnum; i++) {
+        if (program_header_table[i].p_type == PT_LOAD) {
+            first_load_segment = &program_header_table[i];
+            break;
+        }
+    }
+
+    if (section != NULL && first_load_segment != NULL) {
+        uintptr_t elf_load_addr = first_load_segment->p_vaddr
+                                  - (first_load_segment->p_vaddr % first_load_segment->p_align);
+        result = start_address + section->sh_addr - elf_load_addr;
+    }
+
+exit:
+    if (close(fd) != 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+    }
+    if (file_memory != NULL) {
+        munmap(file_memory, file_stats.st_size);
+    }
+    return result;
+}
+#endif
+
+/* Return the address of the named data section (for example "PyRuntime")
+   of the first binary mapped in process `pid` whose file name starts with
+   `map`.  Return NULL if it is not found; an exception is set only if an
+   error occurred. */
+static inline void*
+_Py_RemoteDebug_GetSectionAddress(pid_t pid, const char* secname, const char* map)
+{
+#if defined(__linux__)
+    return search_map_for_section_linux(pid, secname, map);
+#elif defined(__APPLE__) && TARGET_OS_OSX
+    return search_map_for_section_macos(pid, secname, map);
+#else
+    return NULL;
+#endif
+}
+
+/* Return the address of the _PyRuntime structure of process `pid`.  Return
+   NULL with an exception set on failure. */
+static inline void*
+_Py_RemoteDebug_GetPyRuntimeAddress(pid_t pid)
+{
+    // The runtime lives in libpython if Python was built with
+    // --enable-shared, and in the python executable otherwise.
+    void* address = _Py_RemoteDebug_GetSectionAddress(pid, "PyRuntime", "libpython");
+    if (address == NULL && !PyErr_Occurred()) {
+        address = _Py_RemoteDebug_GetSectionAddress(pid, "PyRuntime", "python");
+    }
+    if (address == NULL && !PyErr_Occurred()) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "Failed to get .PyRuntime address");
+    }
+    return address;
+}
+
+/* Read `len` bytes at `remote_address` in process `pid` into `dst`.
+   Return the number of bytes read, or -1 with an exception set. */
+static inline ssize_t
+_Py_RemoteDebug_ReadMemory(pid_t pid, void* remote_address, size_t len, void* dst)
+{
+    ssize_t total_bytes_read = 0;
+#if defined(__linux__) && HAVE_PROCESS_VM_READV
+    struct iovec local[1];
+    struct iovec remote[1];
+    ssize_t result = 0;
+    ssize_t read = 0;
+
+    do {
+        local[0].iov_base = dst + result;
+        local[0].iov_len = len - result;
+        remote[0].iov_base = (void*)(remote_address + result);
+        remote[0].iov_len = len - result;
+
+        read = process_vm_readv(pid, local, 1, remote, 1, 0);
+        if (read < 0) {
+            PyErr_SetFromErrno(PyExc_OSError);
+            return -1;
+        }
+        if (read == 0) {
+            PyErr_SetString(PyExc_OSError, "Unexpected end of remote memory");
+            return -1;
+        }
+
+        result += read;
+    } while ((size_t)read != local[0].iov_len);
+    total_bytes_read = result;
+#elif defined(__APPLE__) && TARGET_OS_OSX
+    ssize_t result = -1;
+    kern_return_t kr = mach_vm_read_overwrite(
+            pid_to_task(pid),
+            (mach_vm_address_t)remote_address,
+            len,
+            (mach_vm_address_t)dst,
+            (mach_vm_size_t*)&result);
+
+    if (kr != KERN_SUCCESS) {
+        switch (kr) {
+            case KERN_PROTECTION_FAILURE:
+                PyErr_SetString(PyExc_PermissionError, "Not enough permissions to read memory");
+                break;
+            case KERN_INVALID_ARGUMENT:
+                PyErr_SetString(PyExc_PermissionError, "Invalid argument to mach_vm_read_overwrite");
+                break;
+            default:
+                PyErr_SetString(PyExc_RuntimeError, "Unknown error reading memory");
+        }
+        return -1;
+    }
+    total_bytes_read = len;
+#else
+    PyErr_SetString(PyExc_RuntimeError,
+                    "Reading remote memory is not supported on this platform");
+    return -1;
+#endif
+    return total_bytes_read;
+}
+
+typedef struct {
+    void* remote_address;
+    size_t len;
+    void* dst;
+} _Py_RemoteDebug_ReadRequest;
+
+/* Perform `n` reads with as few system calls as possible.  Return 0 on
+   success, or -1 with an exception set if any of the reads failed. */
+static inline int
+_Py_RemoteDebug_ReadMemoryBatch(pid_t pid, _Py_RemoteDebug_ReadRequest* requests,
+                                size_t n)
+{
+#if defined(__linux__) && HAVE_PROCESS_VM_READV
+    // Read up to BATCH_SIZE regions per system call.  process_vm_readv()
+    // stops at the first region which cannot be read entirely; the
+    // remaining requests are retried one by one to report the error.
+#   define BATCH_SIZE 64
+    struct iovec local[BATCH_SIZE];
+    struct iovec remote[BATCH_SIZE];
+    size_t done = 0;
+    while (done < n) {
+        size_t count = Py_MIN(n - done, (size_t)BATCH_SIZE);
+        size_t expected = 0;
+        for (size_t i = 0; i < count; i++) {
+            _Py_RemoteDebug_ReadRequest* req = &requests[done + i];
+            local[i].iov_base = req->dst;
+            local[i].iov_len = req->len;
+            remote[i].iov_base = req->remote_address;
+            remote[i].iov_len = req->len;
+            expected += req->len;
+        }
+        ssize_t read = process_vm_readv(pid, local, count, remote, count, 0);
+        if (read < 0 || (size_t)read != expected) {
+            for (size_t i = 0; i < count; i++) {
+                _Py_RemoteDebug_ReadRequest* req = &requests[done + i];
+                if (_Py_RemoteDebug_ReadMemory(pid, req->remote_address,
+                                               req->len, req->dst) < 0) {
+                    return -1;
+                }
+            }
+        }
+        done += count;
+    }
+    return 0;
+#   undef BATCH_SIZE
+#else
+    for (size_t i = 0; i < n; i++) {
+        _Py_RemoteDebug_ReadRequest* req = &requests[i];
+        if (_Py_RemoteDebug_ReadMemory(pid, req->remote_address,
+                                       req->len, req->dst) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+#endif
+}
+
+/* Read the ASCII string object at `address` into `buffer`.  Return 0 on
+   success, or -1 with an exception set. */
+static inline int
+_Py_RemoteDebug_ReadString(pid_t pid, _Py_DebugOffsets* debug_offsets,
+                           void* address, char* buffer, Py_ssize_t size)
+{
+    Py_ssize_t len;
+    ssize_t bytes_read = _Py_RemoteDebug_ReadMemory(
+            pid, address + debug_offsets->unicode_object.length, sizeof(Py_ssize_t), &len);
+    if (bytes_read == -1) {
+        return -1;
+    }
+    if (len >= size) {
+        PyErr_SetString(PyExc_RuntimeError, "Buffer too small");
+        return -1;
+    }
+    size_t offset = debug_offsets->unicode_object.asciiobject_size;
+    bytes_read = _Py_RemoteDebug_ReadMemory(pid, address + offset, len, buffer);
+    if (bytes_read == -1) {
+        return -1;
+    }
+    buffer[len] = '\0';
+    return 0;
+}
+
+#endif  // !Py_REMOTE_DEBUG_H
@@ -1271,9 +1271,17 @@ static int select_have_broken_poll(void)
 #include <sys/epoll.h>
 #endif
 
+/* Array of events filled by epoll_wait() */
+typedef struct {
+    int size;
+    struct epoll_event events[];
+} pyEpoll_Buffer;
+
 typedef struct {
     PyObject_HEAD
     SOCKET epfd;                        /* epoll control file descriptor */
+    pyEpoll_Buffer *buffer;             /* reused by poll() and friends, NULL
+                                           while a thread is polling */
 } pyEpoll_Object;
 
 static PyObject *
@@ -1308,6 +1316,7 @@ newPyEpoll_Object(PyTypeObject *type, int sizehint, SOCKET fd)
     self = (pyEpoll_Object *) epoll_alloc(type, 0);
     if (self == NULL)
         return NULL;
+    self->buffer = NULL;
 
     if (fd == -1) {
         Py_BEGIN_ALLOW_THREADS
@@ -1382,6 +1391,7 @@ pyepoll_dealloc(pyEpoll_Object *self)
 {
     PyTypeObject* type = Py_TYPE(self);
     (void)pyepoll_internal_close(self);
+    PyMem_Free(self->buffer);
     freefunc epoll_free = PyType_GetSlot(type, Py_tp_free);
     epoll_free((PyObject *)self);
     Py_DECREF((PyObject *)type);
@@ -1547,33 +1557,48 @@ select_epoll_unregister_impl(pyEpoll_Object *self, int fd)
     return pyepoll_internal_ctl(self->epfd, EPOLL_CTL_DEL, fd, 0);
 }
 
-/*[clinic input]
-select.epoll.poll
-
-    timeout as timeout_obj: object = None
-      the maximum time to wait in seconds (as float);
-      a timeout of None or -1 makes poll wait indefinitely
-    maxevents: int = -1
-      the maximum number of events returned; -1 means no limit
-
-Wait for events on the epoll file descriptor.
+/* Take the event buffer of the epoll object, or allocate a new one if
+   another thread is using it or if it is too small. */
+static pyEpoll_Buffer *
+pyepoll_get_buffer(pyEpoll_Object *self, int maxevents)
+{
+    pyEpoll_Buffer *buffer = _Py_atomic_exchange_ptr(&self->buffer, NULL);
+    if (buffer != NULL && buffer->size >= maxevents) {
+        return buffer;
+    }
+    PyMem_Free(buffer);
+    buffer = PyMem_Malloc(sizeof(pyEpoll_Buffer) +
+                          (size_t)maxevents * sizeof(struct epoll_event));
+    if (buffer == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    buffer->size = maxevents;
+    return buffer;
+}
 
-Returns a list containing any descriptors that have events to report,
-as a list of (fd, events) 2-tuples.
-[clinic start generated code]*/
+static void
+pyepoll_release_buffer(pyEpoll_Object *self, pyEpoll_Buffer *buffer)
+{
+    buffer = _Py_atomic_exchange_ptr(&self->buffer, buffer);
+    PyMem_Free(buffer);
+}
 
-static PyObject *
-select_epoll_poll_impl(pyEpoll_Object *self, PyObject *timeout_obj,
-                       int maxevents)
-/*[clinic end generated code: output=e02d121a20246c6c input=33d34a5ea430fd5b]*/
+/* Wait for at most maxevents events, into a buffer which must be released
+   with pyepoll_release_buffer().  Return the number of events, or -1 with
+   an exception set. */
+static int
+pyepoll_wait(pyEpoll_Object *self, PyObject *timeout_obj, int maxevents,
+             pyEpoll_Buffer **pbuffer)
 {
-    int nfds, i;
-    PyObject *elist = NULL, *etuple = NULL;
-    struct epoll_event *evs = NULL;
+    int nfds;
+    pyEpoll_Buffer *buffer;
     PyTime_t timeout = -1, ms = -1, deadline = 0;
 
-    if (self->epfd < 0)
-        return pyepoll_err_closed();
+    if (self->epfd < 0) {
+        pyepoll_err_closed();
+        return -1;
+    }
 
     if (timeout_obj != Py_None) {
         /* epoll_wait() has a resolution of 1 millisecond, round towards
@@ -1584,13 +1609,13 @@ select_epoll_poll_impl(pyEpoll_Object *self, PyObject *timeout_obj,
                 PyErr_SetString(PyExc_TypeError,
                                 "timeout must be an integer or None");
             }
-            return NULL;
+            return -1;
         }
 
         ms = _PyTime_AsMilliseconds(timeout, _PyTime_ROUND_CEILING);
         if (ms < INT_MIN || ms > INT_MAX) {
             PyErr_SetString(PyExc_OverflowError, "timeout is too large");
-            return NULL;
+            return -1;
         }
         /* epoll_wait(2) treats all arbitrary negative numbers the same
            for the timeout argument, but -1 is the documented way to block
@@ -1615,19 +1640,18 @@ select_epoll_poll_impl(pyEpoll_Object *self, PyObject *timeout_obj,
         PyErr_Format(PyExc_ValueError,
                      "maxevents must be greater than 0, got %d",
                      maxevents);
-        return NULL;
+        return -1;
     }
 
-    evs = PyMem_New(struct epoll_event, maxevents);
-    if (evs == NULL) {
-        PyErr_NoMemory();
-        return NULL;
+    buffer = pyepoll_get_buffer(self, maxevents);
+    if (buffer == NULL) {
+        return -1;
     }
 
     do {
         Py_BEGIN_ALLOW_THREADS
         errno = 0;
-        nfds = epoll_wait(self->epfd, evs, maxevents, (int)ms);
+        nfds = epoll_wait(self->epfd, buffer->events, maxevents, (int)ms);
         Py_END_ALLOW_THREADS
 
         if (errno != EINTR)
@@ -1652,6 +1676,42 @@ select_epoll_poll_impl(pyEpoll_Object *self, PyObject *timeout_obj,
         PyErr_SetFromErrno(PyExc_OSError);
         goto error;
     }
+    *pbuffer = buffer;
+    return nfds;
+
+error:
+    pyepoll_release_buffer(self, buffer);
+    return -1;
+}
+
+/*[clinic input]
+select.epoll.poll
+
+    timeout as timeout_obj: object = None
+      the maximum time to wait in seconds (as float);
+      a timeout of None or -1 makes poll wait indefinitely
+    maxevents: int = -1
+      the maximum number of events returned; -1 means no limit
+
+Wait for events on the epoll file descriptor.
+
+Returns a list containing any descriptors that have events to report,
+as a list of (fd, events) 2-tuples.
+[clinic start generated code]*/
+
+static PyObject *
+select_epoll_poll_impl(pyEpoll_Object *self, PyObject *timeout_obj,
+                       int maxevents)
+/*[clinic end generated code: output=e02d121a20246c6c input=33d34a5ea430fd5b]*/
+{
+    int nfds, i;
+    PyObject *elist = NULL, *etuple = NULL;
+    pyEpoll_Buffer *buffer;
+
+    nfds = pyepoll_wait(self, timeout_obj, maxevents, &buffer);
+    if (nfds < 0) {
+        return NULL;
+    }
 
     elist = PyList_New(nfds);
     if (elist == NULL) {
@@ -1659,7 +1719,8 @@ select_epoll_poll_impl(pyEpoll_Object *self, PyObject *timeout_obj,
     }
 
     for (i = 0; i < nfds; i++) {
-        etuple = Py_BuildValue("iI", evs[i].data.fd, evs[i].events);
+        etuple = Py_BuildValue("iI", buffer->events[i].data.fd,
+                               buffer->events[i].events);
         if (etuple == NULL) {
             Py_CLEAR(elist);
             goto error;
@@ -1668,10 +1729,140 @@ select_epoll_poll_impl(pyEpoll_Object *self, PyObject *timeout_obj,
     }
 
     error:
-    PyMem_Free(evs);
+    pyepoll_release_buffer(self, buffer);
     return elist;
 }
 
+/*[clinic input]
+select.epoll.poll_into
+
+    buffer: Py_buffer(accept={rwbuffer})
+      a writable buffer of C ints, such as array.array('i')
+    timeout as timeout_obj: object = None
+      the maximum time to wait in seconds (as float);
+      a timeout of None or -1 makes poll wait indefinitely
+
+Wait for events on the epoll file descriptor, without creating objects.
+
+The descriptors that have events to report and their events are written
+to the buffer as pairs of C ints: fd, events, fd, events, ...  At most
+len(buffer) // 2 events are reported.
+
+Returns the number of events.
+[clinic start generated code]*/
+
+static PyObject *
+select_epoll_poll_into_impl(pyEpoll_Object *self, Py_buffer *buffer,
+                            PyObject *timeout_obj)
+/*[clinic end generated code: output=7c6be9e9d75f39d0 input=e40a4d4b5189e81d]*/
+{
+    pyEpoll_Buffer *events;
+    Py_ssize_t maxevents = buffer->len / (2 * (Py_ssize_t)sizeof(int));
+    if (maxevents == 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "buffer is too small for a single event");
+        return NULL;
+    }
+    if (maxevents > INT_MAX) {
+        maxevents = INT_MAX;
+    }
+
+    int nfds = pyepoll_wait(self, timeout_obj, (int)maxevents, &events);
+    if (nfds < 0) {
+        return NULL;
+    }
+    char *out = buffer->buf;
+    for (int i = 0; i < nfds; i++) {
+        /* The buffer is not necessarily aligned */
+        int pair[2] = {events->events[i].data.fd,
+                       (int)events->events[i].events};
+        memcpy(out + i * sizeof(pair), pair, sizeof(pair));
+    }
+    pyepoll_release_buffer(self, events);
+    return PyLong_FromLong(nfds);
+}
+
+/*[clinic input]
+select.epoll.dispatch
+
+    handlers: object(subclass_of='&PyDict_Type')
+      a dictionary mapping file descriptors to callables
+    timeout as timeout_obj: object = None
+      the maximum time to wait in seconds (as float);
+      a timeout of None or -1 makes poll wait indefinitely
+    maxevents: int = -1
+      the maximum number of events handled; -1 means no limit
+
+Wait for events on the epoll file descriptor and call their handlers.
+
+For every descriptor which has events to report, handlers[fd](events) is
+called.  Descriptors missing from handlers are ignored.  If a handler
+raises an exception, the remaining events are discarded and the exception
+is propagated.
+
+Returns the number of events.
+[clinic start generated code]*/
+
+static PyObject *
+select_epoll_dispatch_impl(pyEpoll_Object *self, PyObject *handlers,
+                           PyObject *timeout_obj, int maxevents)
+/*[clinic end generated code: output=7325a8840f4a5f71 input=45e8183b0c3bad8f]*/
+{
+    pyEpoll_Buffer *buffer;
+    int nfds = pyepoll_wait(self, timeout_obj, maxevents, &buffer);
+    if (nfds < 0) {
+        return NULL;
+    }
+    /* Copy the events: a handler can poll the same epoll object. */
+    struct epoll_event small[16], *evs = small;
+    if (nfds > (int)Py_ARRAY_LENGTH(small)) {
+        evs = PyMem_New(struct epoll_event, nfds);
+        if (evs == NULL) {
+            pyepoll_release_buffer(self, buffer);
+            return PyErr_NoMemory();
+        }
+    }
+    memcpy(evs, buffer->events, nfds * sizeof(struct epoll_event));
+    pyepoll_release_buffer(self, buffer);
+
+    int err = 0;
+    for (int i = 0; i < nfds && !err; i++) {
+        PyObject *fd = PyLong_FromLong(evs[i].data.fd);
+        if (fd == NULL) {
+            err = 1;
+            break;
+        }
+        PyObject *handler;
+        int found = PyDict_GetItemRef(handlers, fd, &handler);
+        Py_DECREF(fd);
+        if (found <= 0) {
+            err = found < 0;
+            continue;
+        }
+        PyObject *mask = PyLong_FromUnsignedLong(evs[i].events);
+        if (mask == NULL) {
+            Py_DECREF(handler);
+            err = 1;
+            break;
+        }
+        PyObject *res = PyObject_CallOneArg(handler, mask);
+        Py_DECREF(mask);
+        Py_DECREF(handler);
+        if (res == NULL) {
+            err = 1;
+            break;
+        }
+        Py_DECREF(res);
+    }
+    if (evs != small) {
+        PyMem_Free(evs);
+    }
+    if (err) {
+        return NULL;
+    }
+    return PyLong_FromLong(nfds);
+}
+
 
 /*[clinic input]
 select.epoll.__enter__
@@ -2477,6 +2668,8 @@ static PyMethodDef pyepoll_methods[] = {
     SELECT_EPOLL_REGISTER_METHODDEF
     SELECT_EPOLL_UNREGISTER_METHODDEF
     SELECT_EPOLL_POLL_METHODDEF
+    SELECT_EPOLL_POLL_INTO_METHODDEF
+    SELECT_EPOLL_DISPATCH_METHODDEF
     SELECT_EPOLL___ENTER___METHODDEF
     SELECT_EPOLL___EXIT___METHODDEF
     {NULL,      NULL},
@@ -4866,6 +4866,294 @@ the message.  The return value is the number of bytes of non-ancillary\n\
 data sent.");
 #endif    /* CMSG_LEN */
 
+#if defined(HAVE_RECVMMSG) || defined(HAVE_SENDMMSG)
+/* Maximum number of datagrams per recvmmsg() or sendmmsg() call, the
+   limit of the Linux kernel (UIO_MAXIOV). */
+#define SOCK_MMSG_MAX 1024
+
+/* Buffers and message headers of a recvmmsg() or sendmmsg() call */
+struct sock_mmsg {
+    Py_ssize_t n;
+    Py_ssize_t nbufs;           /* number of buffers to release */
+    Py_buffer *bufs;
+    struct iovec *iovs;
+    struct mmsghdr *msgs;
+    sock_addr_t *addrs;         /* NULL if there is no address */
+    int flags;
+    int result;
+};
+
+static int
+sock_mmsg_alloc(struct sock_mmsg *ctx, Py_ssize_t n, int with_addresses)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    if (n > SOCK_MMSG_MAX) {
+        PyErr_Format(PyExc_ValueError,
+                     "at most %d datagrams can be transferred at once",
+                     SOCK_MMSG_MAX);
+        return -1;
+    }
+    ctx->n = n;
+    ctx->bufs = PyMem_New(Py_buffer, n);
+    ctx->iovs = PyMem_New(struct iovec, n);
+    ctx->msgs = PyMem_New(struct mmsghdr, n);
+    if (with_addresses) {
+        ctx->addrs = PyMem_New(sock_addr_t, n);
+    }
+    if (ctx->bufs == NULL || ctx->iovs == NULL || ctx->msgs == NULL ||
+        (with_addresses && ctx->addrs == NULL))
+    {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(ctx->msgs, 0, n * sizeof(struct mmsghdr));
+    for (Py_ssize_t i = 0; i < n; i++) {
+        ctx->msgs[i].msg_hdr.msg_iov = &ctx->iovs[i];
+        ctx->msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    return 0;
+}
+
+static void
+sock_mmsg_free(struct sock_mmsg *ctx)
+{
+    for (Py_ssize_t i = 0; i < ctx->nbufs; i++) {
+        PyBuffer_Release(&ctx->bufs[i]);
+    }
+    PyMem_Free(ctx->bufs);
+    PyMem_Free(ctx->iovs);
+    PyMem_Free(ctx->msgs);
+    PyMem_Free(ctx->addrs);
+}
+#endif
+
+#ifdef HAVE_RECVMMSG
+static int
+sock_recvmmsg_impl(PySocketSockObject *s, void *data)
+{
+    struct sock_mmsg *ctx = data;
+
+    ctx->result = recvmmsg(s->sock_fd, ctx->msgs, (unsigned int)ctx->n,
+                           ctx->flags, NULL);
+    return (ctx->result >= 0);
+}
+
+/* s.recvmmsg_into(buffers, sizes[, flags[, addresses]]) method */
+
+static PyObject *
+sock_recvmmsg_into(PySocketSockObject *s, PyObject *args)
+{
+    PyObject *buffers_arg, *addresses = NULL, *fast = NULL, *retval = NULL;
+    Py_buffer sizes;
+    int flags = 0;
+    socklen_t addrlen = 0;
+    struct sock_mmsg ctx;
+
+    if (!PyArg_ParseTuple(args, "Ow*|iO!:recvmmsg_into", &buffers_arg,
+                          &sizes, &flags, &PyList_Type, &addresses)) {
+        return NULL;
+    }
+    memset(&ctx, 0, sizeof(ctx));
+
+    if (!IS_SELECTABLE(s)) {
+        select_error();
+        goto finally;
+    }
+    if (addresses != NULL && !getsockaddrlen(s, &addrlen)) {
+        goto finally;
+    }
+    fast = PySequence_Fast(buffers_arg, "recvmmsg_into() argument 1 must "
+                                        "be an iterable");
+    if (fast == NULL) {
+        goto finally;
+    }
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(fast);
+    if (n == 0) {
+        retval = PyLong_FromLong(0);
+        goto finally;
+    }
+    if (sizes.len / (Py_ssize_t)sizeof(int) < n) {
+        PyErr_SetString(PyExc_ValueError,
+                        "recvmmsg_into() sizes has less items than buffers");
+        goto finally;
+    }
+    if (sock_mmsg_alloc(&ctx, n, addresses != NULL) < 0) {
+        goto finally;
+    }
+    for (; ctx.nbufs < n; ctx.nbufs++) {
+        Py_ssize_t i = ctx.nbufs;
+        if (!PyArg_Parse(PySequence_Fast_GET_ITEM(fast, i),
+                         "w*;recvmmsg_into() argument 1 must be an iterable "
+                         "of single-segment read-write buffers",
+                         &ctx.bufs[i])) {
+            goto finally;
+        }
+        ctx.iovs[i].iov_base = ctx.bufs[i].buf;
+        ctx.iovs[i].iov_len = ctx.bufs[i].len;
+        if (addresses != NULL) {
+            memset(&ctx.addrs[i], 0, addrlen);
+            ctx.msgs[i].msg_hdr.msg_name = SAS2SA(&ctx.addrs[i]);
+            ctx.msgs[i].msg_hdr.msg_namelen = addrlen;
+        }
+    }
+
+    /* Like recv(), only wait for the first datagram. */
+    ctx.flags = flags;
+#ifdef MSG_WAITFORONE
+    ctx.flags |= MSG_WAITFORONE;
+#endif
+    if (sock_call(s, 0, sock_recvmmsg_impl, &ctx) < 0) {
+        goto finally;
+    }
+
+    for (int i = 0; i < ctx.result; i++) {
+        int len = (int)ctx.msgs[i].msg_len;
+        memcpy((char *)sizes.buf + i * sizeof(int), &len, sizeof(int));
+        if (addresses != NULL) {
+            PyObject *addr = makesockaddr(s->sock_fd,
+                                          SAS2SA(&ctx.addrs[i]),
+                                          ctx.msgs[i].msg_hdr.msg_namelen,
+                                          s->sock_proto);
+            if (addr == NULL) {
+                goto finally;
+            }
+            int res = PyList_Append(addresses, addr);
+            Py_DECREF(addr);
+            if (res < 0) {
+                goto finally;
+            }
+        }
+    }
+    retval = PyLong_FromLong(ctx.result);
+
+finally:
+    sock_mmsg_free(&ctx);
+    Py_XDECREF(fast);
+    PyBuffer_Release(&sizes);
+    return retval;
+}
+
+PyDoc_STRVAR(recvmmsg_into_doc,
+"recvmmsg_into(buffers, sizes[, flags[, addresses]]) -> count\n\
+\n\
+Receive up to len(buffers) datagrams with a single system call, one\n\
+datagram into each buffer of the buffers iterable.  The length of each\n\
+datagram is stored into sizes, a writable buffer of C ints such as an\n\
+array.array('i').  If addresses is a list, the address of the sender of\n\
+each datagram is appended to it.  Only wait for the first datagram,\n\
+like recv().  Return the number of datagrams received.");
+#endif    /* HAVE_RECVMMSG */
+
+#ifdef HAVE_SENDMMSG
+static int
+sock_sendmmsg_impl(PySocketSockObject *s, void *data)
+{
+    struct sock_mmsg *ctx = data;
+
+    ctx->result = sendmmsg(s->sock_fd, ctx->msgs, (unsigned int)ctx->n,
+                           ctx->flags);
+    return (ctx->result >= 0);
+}
+
+/* s.sendmmsg(buffers[, flags[, addresses]]) method */
+
+static PyObject *
+sock_sendmmsg(PySocketSockObject *s, PyObject *args)
+{
+    PyObject *buffers_arg, *addresses_arg = NULL, *retval = NULL;
+    PyObject *fast = NULL, *addresses = NULL;
+    int flags = 0;
+    struct sock_mmsg ctx;
+
+    if (!PyArg_ParseTuple(args, "O|iO:sendmmsg", &buffers_arg, &flags,
+                          &addresses_arg)) {
+        return NULL;
+    }
+    memset(&ctx, 0, sizeof(ctx));
+    if (addresses_arg == Py_None) {
+        addresses_arg = NULL;
+    }
+
+    if (!IS_SELECTABLE(s)) {
+        select_error();
+        goto finally;
+    }
+    fast = PySequence_Fast(buffers_arg, "sendmmsg() argument 1 must be an "
+                                        "iterable");
+    if (fast == NULL) {
+        goto finally;
+    }
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(fast);
+    if (addresses_arg != NULL) {
+        addresses = PySequence_Fast(addresses_arg, "sendmmsg() argument 3 "
+                                                   "must be an iterable");
+        if (addresses == NULL) {
+            goto finally;
+        }
+        if (PySequence_Fast_GET_SIZE(addresses) != n) {
+            PyErr_SetString(PyExc_ValueError,
+                            "sendmmsg() needs one address per buffer");
+            goto finally;
+        }
+    }
+    if (n == 0) {
+        retval = PyLong_FromLong(0);
+        goto finally;
+    }
+    if (sock_mmsg_alloc(&ctx, n, addresses != NULL) < 0) {
+        goto finally;
+    }
+    for (; ctx.nbufs < n; ctx.nbufs++) {
+        Py_ssize_t i = ctx.nbufs;
+        if (!PyArg_Parse(PySequence_Fast_GET_ITEM(fast, i),
+                         "y*;sendmmsg() argument 1 must be an iterable of "
+                         "bytes-like objects",
+                         &ctx.bufs[i])) {
+            goto finally;
+        }
+        ctx.iovs[i].iov_base = ctx.bufs[i].buf;
+        ctx.iovs[i].iov_len = ctx.bufs[i].len;
+        if (addresses != NULL) {
+            PyObject *addr = PySequence_Fast_GET_ITEM(addresses, i);
+            int addrlen;
+            if (!getsockaddrarg(s, addr, &ctx.addrs[i], &addrlen,
+                                "sendmmsg")) {
+                goto finally;
+            }
+            if (PySys_Audit("socket.sendmsg", "OO", s, addr) < 0) {
+                goto finally;
+            }
+            ctx.msgs[i].msg_hdr.msg_name = SAS2SA(&ctx.addrs[i]);
+            ctx.msgs[i].msg_hdr.msg_namelen = addrlen;
+        }
+    }
+    if (addresses == NULL &&
+        PySys_Audit("socket.sendmsg", "OO", s, Py_None) < 0) {
+        goto finally;
+    }
+
+    ctx.flags = flags;
+    if (sock_call(s, 1, sock_sendmmsg_impl, &ctx) < 0) {
+        goto finally;
+    }
+    retval = PyLong_FromLong(ctx.result);
+
+finally:
+    sock_mmsg_free(&ctx);
+    Py_XDECREF(fast);
+    Py_XDECREF(addresses);
+    return retval;
+}
+
+PyDoc_STRVAR(sendmmsg_doc,
+"sendmmsg(buffers[, flags[, addresses]]) -> count\n\
+\n\
+Send each buffer of the buffers iterable as a separate datagram, with a\n\
+single system call.  If addresses is supplied and not None, it must be an\n\
+iterable with the destination address of each datagram.  Return the\n\
+number of datagrams sent, which can be less than len(buffers).");
+#endif    /* HAVE_SENDMMSG */
+
 #ifdef HAVE_SOCKADDR_ALG
 static PyObject*
 sock_sendmsg_afalg(PySocketSockObject *self, PyObject *args, PyObject *kwds)
@@ -5230,6 +5518,14 @@ static PyMethodDef sock_methods[] = {
     {"sendmsg",           (PyCFunction)sock_sendmsg, METH_VARARGS,
                       sendmsg_doc},
 #endif
+#ifdef HAVE_RECVMMSG
+    {"recvmmsg_into",     (PyCFunction)sock_recvmmsg_into, METH_VARARGS,
+                      recvmmsg_into_doc},
+#endif
+#ifdef HAVE_SENDMMSG
+    {"sendmmsg",          (PyCFunction)sock_sendmmsg, METH_VARARGS,
+                      sendmmsg_doc},
+#endif
 #ifdef HAVE_SOCKADDR_ALG
     {"sendmsg_afalg",     _PyCFunction_CAST(sock_sendmsg_afalg), METH_VARARGS | METH_KEYWORDS,
                       sendmsg_afalg_doc},
@@ -7974,6 +8270,9 @@ socket_exec(PyObject *m)
 #ifdef  SO_BINDTOIFINDEX
     ADD_INT_MACRO(m, SO_BINDTOIFINDEX);
 #endif
+#ifdef  SO_ZEROCOPY
+    ADD_INT_MACRO(m, SO_ZEROCOPY);
+#endif
 #ifdef  SO_PRIORITY
     ADD_INT_MACRO(m, SO_PRIORITY);
 #endif
@@ -8067,6 +8366,15 @@ socket_exec(PyObject *m)
 #ifdef  MSG_ERRQUEUE
     ADD_INT_MACRO(m, MSG_ERRQUEUE);
 #endif
+#ifdef  MSG_ZEROCOPY
+    ADD_INT_MACRO(m, MSG_ZEROCOPY);
+#endif
+#ifdef  SO_EE_ORIGIN_ZEROCOPY
+    ADD_INT_MACRO(m, SO_EE_ORIGIN_ZEROCOPY);
+#endif
+#ifdef  SO_EE_CODE_ZEROCOPY_COPIED
+    ADD_INT_MACRO(m, SO_EE_CODE_ZEROCOPY_COPIED);
+#endif
 #ifdef  MSG_CONFIRM
     ADD_INT_MACRO(m, MSG_CONFIRM);
 #endif
@@ -8085,6 +8393,9 @@ socket_exec(PyObject *m)
 #ifdef MSG_FASTOPEN
     ADD_INT_MACRO(m, MSG_FASTOPEN);
 #endif
+#ifdef MSG_WAITFORONE
+    ADD_INT_MACRO(m, MSG_WAITFORONE);
+#endif
 
     /* Protocol level and numbers, usable for [gs]etsockopt */
 #ifdef  SOL_SOCKET
@@ -8575,6 +8886,9 @@ socket_exec(PyObject *m)
 #ifdef IPV6_RECVDSTOPTS
     ADD_INT_MACRO(m, IPV6_RECVDSTOPTS);
 #endif
+#ifdef IPV6_RECVERR
+    ADD_INT_MACRO(m, IPV6_RECVERR);
+#endif
 #ifdef IPV6_RECVHOPLIMIT
     ADD_INT_MACRO(m, IPV6_RECVHOPLIMIT);
 #endif
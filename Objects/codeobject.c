@@ -508,6 +508,7 @@ init_code(PyCodeObject *co, struct _PyCodeConstructor *con)
     co->co_weakreflist = NULL;
     co->co_extra = NULL;
     co->_co_cached = NULL;
+    co->_co_exctable = NULL;
     co->co_executors = NULL;
 
     memcpy(_PyCode_CODE(co), PyBytes_AS_STRING(con->code),
@@ -1866,6 +1867,7 @@ code_dealloc(PyCodeObject *co)
         Py_XDECREF(co->_co_cached->_co_varnames);
         PyMem_Free(co->_co_cached);
     }
+    PyMem_RawFree(co->_co_exctable);
     if (co->co_weakreflist != NULL) {
         PyObject_ClearWeakRefs((PyObject*)co);
     }
@@ -2115,6 +2117,11 @@ code_sizeof(PyCodeObject *co, PyObject *Py_UNUSED(args))
         res += sizeof(_PyCodeObjectExtra);
         res += ((size_t)co_extra->ce_size - 1) * sizeof(co_extra->ce_extras[0]);
     }
+    _PyCoExceptionTable *exctable = FT_ATOMIC_LOAD_PTR_ACQUIRE(co->_co_exctable);
+    if (exctable != NULL) {
+        res += sizeof(_PyCoExceptionTable);
+        res += ((size_t)exctable->size - 1) * sizeof(exctable->entries[0]);
+    }
     return PyLong_FromSize_t(res);
 }
 
@@ -13,6 +13,7 @@
 #include "pycore_modsupport.h"    // _PyArg_NoKeywords()
 #include "pycore_object.h"
 #include "pycore_pyerrors.h"      // struct _PyErr_SetRaisedException
+#include "pycore_traceback.h"     // _PyTraceBack_Materialize()
 
 #include "osdefs.h"               // SEP
 
@@ -307,9 +308,33 @@ BaseException_set_args(PyBaseExceptionObject *self, PyObject *val, void *Py_UNUS
     return 0;
 }
 
+/* Replace a lazily captured traceback with traceback objects */
+static int
+materialize_traceback(PyBaseExceptionObject *self)
+{
+    PyObject *tb = self->traceback;
+    if (tb == NULL || !_PyLazyTraceBack_Check(tb)) {
+        return 0;
+    }
+    tb = _PyTraceBack_Materialize(tb);
+    if (tb == NULL) {
+        return -1;
+    }
+    if (Py_IsNone(tb)) {
+        Py_CLEAR(self->traceback);
+    }
+    else {
+        Py_SETREF(self->traceback, tb);
+    }
+    return 0;
+}
+
 static PyObject *
 BaseException_get_tb(PyBaseExceptionObject *self, void *Py_UNUSED(ignored))
 {
+    if (materialize_traceback(self) < 0) {
+        return NULL;
+    }
     if (self->traceback == NULL) {
         Py_RETURN_NONE;
     }
@@ -412,6 +437,17 @@ PyObject *
 PyException_GetTraceback(PyObject *self)
 {
     PyBaseExceptionObject *base_self = _PyBaseExceptionObject_cast(self);
+    PyObject *tb = base_self->traceback;
+    if (tb != NULL && _PyLazyTraceBack_Check(tb)) {
+        /* This function cannot fail: on memory error, the traceback
+           is lost but the current exception is preserved. */
+        PyObject *exc = PyErr_GetRaisedException();
+        if (materialize_traceback(base_self) < 0) {
+            PyErr_Clear();
+            Py_CLEAR(base_self->traceback);
+        }
+        PyErr_SetRaisedException(exc);
+    }
     return Py_XNewRef(base_self->traceback);
 }
 
@@ -122,6 +122,40 @@ _PyGen_Finalize(PyObject *self)
     PyErr_SetRaisedException(exc);
 }
 
+/* Generators, coroutines and asynchronous generators have the same layout,
+   so they share free lists, one for each size class of the embedded frame.
+   The frame of a generator which fits in a size class is allocated with
+   the number of slots of the size class, so that the memory of a finished
+   coroutine is reused by the next call of any function with a frame of
+   similar size.  Generators have no ob_size: the size class is computed
+   from the code object. */
+
+static inline Py_ssize_t
+gen_size_class(Py_ssize_t slots)
+{
+    if (slots == 0) {
+        return 0;
+    }
+    return (slots - 1) / PyGen_SAVECLASS_SLOTS;
+}
+
+static PyGenObject *
+gen_alloc(PyTypeObject *type, Py_ssize_t slots)
+{
+    Py_ssize_t index = gen_size_class(slots);
+    if (index < PyGen_MAXSAVECLASS) {
+        PyGenObject *gen = _Py_FREELIST_POP(PyGenObject, gens[index]);
+        if (gen != NULL) {
+            Py_SET_TYPE(gen, type);
+            // The previous generator may have been finalized
+            _PyGC_CLEAR_FINALIZED((PyObject *)gen);
+            return gen;
+        }
+        slots = (index + 1) * PyGen_SAVECLASS_SLOTS;
+    }
+    return PyObject_GC_NewVar(PyGenObject, type, slots);
+}
+
 static void
 gen_dealloc(PyGenObject *gen)
 {
@@ -155,10 +189,18 @@ gen_dealloc(PyGenObject *gen)
         _PyErr_ClearExcState(&gen->gi_exc_state);
     }
     assert(gen->gi_exc_state.exc_value == NULL);
+    // The size of the frame is only known from the code object
+    Py_ssize_t index = gen_size_class(
+        _PyFrame_NumSlotsForCodeObject(_PyGen_GetCode(gen)));
     PyStackRef_CLEAR(gen->gi_iframe.f_executable);
     Py_CLEAR(gen->gi_name);
     Py_CLEAR(gen->gi_qualname);
 
+    if (index < PyGen_MAXSAVECLASS &&
+        _Py_FREELIST_PUSH(gens[index], gen, Py_gens_MAXFREELIST))
+    {
+        return;
+    }
     PyObject_GC_Del(gen);
 }
 
@@ -874,7 +916,7 @@ make_gen(PyTypeObject *type, PyFunctionObject *func)
 {
     PyCodeObject *code = (PyCodeObject *)func->func_code;
     int slots = _PyFrame_NumSlotsForCodeObject(code);
-    PyGenObject *gen = PyObject_GC_NewVar(PyGenObject, type, slots);
+    PyGenObject *gen = gen_alloc(type, slots);
     if (gen == NULL) {
         return NULL;
     }
@@ -945,7 +987,7 @@ gen_new_with_qualname(PyTypeObject *type, PyFrameObject *f,
 {
     PyCodeObject *code = _PyFrame_GetCode(f->f_frame);
     int size = code->co_nlocalsplus + code->co_stacksize;
-    PyGenObject *gen = PyObject_GC_NewVar(PyGenObject, type, size);
+    PyGenObject *gen = gen_alloc(type, size);
     if (gen == NULL) {
         Py_DECREF(f);
         return NULL;
@@ -23,6 +23,7 @@
 #include "pycore_pymem.h"         // _PyMem_IsPtrFreed()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
 #include "pycore_symtable.h"      // PySTEntry_Type
+#include "pycore_traceback.h"     // _PyLazyTraceBack_Type
 #include "pycore_typeobject.h"    // _PyBufferWrapper_Type
 #include "pycore_typevarobject.h" // _PyTypeAlias_Type, _Py_initialize_generic
 #include "pycore_unionobject.h"   // _PyUnion_Type
@@ -857,6 +858,10 @@ _PyObject_ClearFreeLists(struct _Py_freelists *freelists, int is_finalization)
     clear_freelist(&freelists->async_gens, is_finalization, free_object);
     clear_freelist(&freelists->async_gen_asends, is_finalization, free_object);
     clear_freelist(&freelists->futureiters, is_finalization, free_object);
+    clear_freelist(&freelists->lazy_tracebacks, is_finalization, free_object);
+    for (Py_ssize_t i = 0; i < PyGen_MAXSAVECLASS; i++) {
+        clear_freelist(&freelists->gens[i], is_finalization, free_object);
+    }
     if (is_finalization) {
         // Only clear object stack chunks during finalization. We use object
         // stacks during GC, so emptying the free-list is counterproductive.
@@ -2323,6 +2328,7 @@ static PyTypeObject* static_types[] = {
     &_PyHamt_CollisionNode_Type,
     &_PyHamt_Type,
     &_PyInstructionSequence_Type,
+    &_PyLazyTraceBack_Type,
     &_PyLegacyEventHandler_Type,
     &_PyLineIterator,
     &_PyManagedBuffer_Type,
@@ -61,18 +61,82 @@ class object "PyObject *" "&PyBaseObject_Type"
 // in odd behaviors w.r.t. running with the GIL as the outer type lock could
 // be released and reacquired during a subclass update if there's contention
 // on the subclass lock.
+//
+// The type cache lookups which miss read the MRO under the lookup lock, a
+// big reader lock which the holders of the type lock take for writing:
+// lookups on different threads don't serialize on the type lock.  Since
+// writers don't wait for each other, a writer whose critical section is
+// suspended does not block the other writers.
 #define TYPE_LOCK &PyInterpreterState_Get()->types.mutex
-#define BEGIN_TYPE_LOCK() Py_BEGIN_CRITICAL_SECTION_MUT(TYPE_LOCK)
-#define END_TYPE_LOCK() Py_END_CRITICAL_SECTION()
+#define TYPE_LOOKUP_LOCK &PyInterpreterState_Get()->types.lookup_lock
+#define BEGIN_TYPE_LOCK() \
+    Py_BEGIN_CRITICAL_SECTION_MUT(TYPE_LOCK); \
+    _PyBRLock_Lock(TYPE_LOOKUP_LOCK)
+#define END_TYPE_LOCK() \
+    _PyBRLock_Unlock(TYPE_LOOKUP_LOCK); \
+    Py_END_CRITICAL_SECTION()
 
 #define BEGIN_TYPE_DICT_LOCK(d) \
-    Py_BEGIN_CRITICAL_SECTION2_MUT(TYPE_LOCK, &_PyObject_CAST(d)->ob_mutex)
+    Py_BEGIN_CRITICAL_SECTION2_MUT(TYPE_LOCK, &_PyObject_CAST(d)->ob_mutex); \
+    _PyBRLock_Lock(TYPE_LOOKUP_LOCK)
 
-#define END_TYPE_DICT_LOCK() Py_END_CRITICAL_SECTION2()
+#define END_TYPE_DICT_LOCK() \
+    _PyBRLock_Unlock(TYPE_LOOKUP_LOCK); \
+    Py_END_CRITICAL_SECTION2()
 
 #define ASSERT_TYPE_LOCK_HELD() \
     _Py_CRITICAL_SECTION_ASSERT_MUTEX_LOCKED(TYPE_LOCK)
 
+// Read-only accesses which don't call arbitrary code hold the lookup lock
+// for reading instead of the type lock, unless a thread holds the type lock.
+#define BEGIN_TYPE_READ_LOCK() \
+    { \
+        PyCriticalSection _type_read_cs; \
+        int _type_read_shared = type_read_lock_begin(&_type_read_cs)
+#define END_TYPE_READ_LOCK() \
+        type_read_lock_end(&_type_read_cs, _type_read_shared); \
+    }
+
+#ifdef Py_DEBUG
+// Number of read locks held by the current thread on the lookup lock
+static _Py_thread_local int type_read_lock_depth;
+
+#define ASSERT_TYPE_READ_LOCK_HELD() \
+    if (type_read_lock_depth == 0) { \
+        ASSERT_TYPE_LOCK_HELD(); \
+    }
+#else
+#define ASSERT_TYPE_READ_LOCK_HELD() ASSERT_TYPE_LOCK_HELD()
+#endif
+
+static inline int
+type_read_lock_begin(PyCriticalSection *cs)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (_PyBRLock_TryRLock(&interp->types.lookup_lock)) {
+#ifdef Py_DEBUG
+        type_read_lock_depth++;
+#endif
+        return 1;
+    }
+    _PyCriticalSection_BeginMutex(cs, &interp->types.mutex);
+    return 0;
+}
+
+static inline void
+type_read_lock_end(PyCriticalSection *cs, int shared)
+{
+    if (shared) {
+#ifdef Py_DEBUG
+        type_read_lock_depth--;
+#endif
+        _PyBRLock_RUnlock(TYPE_LOOKUP_LOCK);
+    }
+    else {
+        _PyCriticalSection_End(cs);
+    }
+}
+
 #else
 
 #define BEGIN_TYPE_LOCK()
@@ -80,6 +144,9 @@ class object "PyObject *" "&PyBaseObject_Type"
 #define BEGIN_TYPE_DICT_LOCK(d)
 #define END_TYPE_DICT_LOCK()
 #define ASSERT_TYPE_LOCK_HELD()
+#define BEGIN_TYPE_READ_LOCK()
+#define END_TYPE_READ_LOCK()
+#define ASSERT_TYPE_READ_LOCK_HELD()
 
 #endif
 
@@ -452,10 +519,10 @@ _PyType_GetBases(PyTypeObject *self)
 {
     PyObject *res;
 
-    BEGIN_TYPE_LOCK();
+    BEGIN_TYPE_READ_LOCK();
     res = lookup_tp_bases(self);
     Py_INCREF(res);
-    END_TYPE_LOCK();
+    END_TYPE_READ_LOCK();
 
     return res;
 }
@@ -507,7 +574,7 @@ clear_tp_bases(PyTypeObject *self, int final)
 static inline PyObject *
 lookup_tp_mro(PyTypeObject *self)
 {
-    ASSERT_TYPE_LOCK_HELD();
+    ASSERT_TYPE_READ_LOCK_HELD();
     return self->tp_mro;
 }
 
@@ -523,10 +590,10 @@ _PyType_GetMRO(PyTypeObject *self)
         return mro;
     }
 
-    BEGIN_TYPE_LOCK();
+    BEGIN_TYPE_READ_LOCK();
     mro = lookup_tp_mro(self);
     Py_XINCREF(mro);
-    END_TYPE_LOCK();
+    END_TYPE_READ_LOCK();
     return mro;
 #else
     return Py_XNewRef(lookup_tp_mro(self));
@@ -1550,7 +1617,7 @@ type_get_mro(PyTypeObject *type, void *context)
 {
     PyObject *mro;
 
-    BEGIN_TYPE_LOCK();
+    BEGIN_TYPE_READ_LOCK();
     mro = lookup_tp_mro(type);
     if (mro == NULL) {
         mro = Py_None;
@@ -1558,7 +1625,7 @@ type_get_mro(PyTypeObject *type, void *context)
         Py_INCREF(mro);
     }
 
-    END_TYPE_LOCK();
+    END_TYPE_READ_LOCK();
     return mro;
 }
 
@@ -5229,7 +5296,7 @@ PyType_GetModuleByDef(PyTypeObject *type, PyModuleDef *def)
     }
 
     PyObject *res = NULL;
-    BEGIN_TYPE_LOCK();
+    BEGIN_TYPE_READ_LOCK();
 
     PyObject *mro = lookup_tp_mro(type);
     // The type must be ready
@@ -5256,7 +5323,7 @@ PyType_GetModuleByDef(PyTypeObject *type, PyModuleDef *def)
             break;
         }
     }
-    END_TYPE_LOCK();
+    END_TYPE_READ_LOCK();
 
     if (res == NULL) {
         PyErr_Format(
@@ -5472,6 +5539,69 @@ find_name_in_mro(PyTypeObject *type, PyObject *name, int *error)
     return res;
 }
 
+#ifdef Py_GIL_DISABLED
+/* Look for a name through the MRO holding the lookup lock for reading, so
+   that lookups on different threads don't serialize on the type lock.  Only
+   done when the lookup cannot call arbitrary code, or would need to set the
+   version tag: exact str name, ready type, and dicts with only str keys.
+   Return 1 and set '*res' (a new reference or NULL) if the lookup was done,
+   0 if it must be done under the type lock. */
+static int
+find_name_in_mro_shared(PyTypeObject *type, PyObject *name, PyObject **res,
+                        int *has_version, unsigned int *version)
+{
+    if (!PyUnicode_CheckExact(name)) {
+        return 0;
+    }
+    Py_hash_t hash = _PyObject_HashFast(name);
+    if (hash == -1) {
+        PyErr_Clear();
+        return 0;
+    }
+    if (!_PyBRLock_TryRLock(TYPE_LOOKUP_LOCK)) {
+        return 0;
+    }
+
+    int done = 0;
+    *res = NULL;
+    *has_version = 0;
+    if (MCACHE_CACHEABLE_NAME(name)) {
+        *version = _Py_atomic_load_uint32_relaxed(&type->tp_version_tag);
+        if (*version == 0) {
+            goto exit;
+        }
+        *has_version = 1;
+    }
+    PyObject *mro = _Py_atomic_load_ptr_relaxed(&type->tp_mro);
+    if (mro == NULL) {
+        goto exit;
+    }
+    Py_ssize_t n = PyTuple_GET_SIZE(mro);
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *dict = lookup_tp_dict(_PyType_CAST(PyTuple_GET_ITEM(mro, i)));
+        PyDictKeysObject *keys = _Py_atomic_load_ptr(&((PyDictObject *)dict)->ma_keys);
+        if (!DK_IS_UNICODE(keys)) {
+            goto exit;
+        }
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *dict = lookup_tp_dict(_PyType_CAST(PyTuple_GET_ITEM(mro, i)));
+        if (_PyDict_GetItemRef_KnownHash((PyDictObject *)dict, name, hash, res) < 0) {
+            PyErr_Clear();
+            goto exit;
+        }
+        if (*res != NULL) {
+            break;
+        }
+    }
+    done = 1;
+
+exit:
+    _PyBRLock_RUnlock(TYPE_LOOKUP_LOCK);
+    return done;
+}
+#endif
+
 /* Check if the "readied" PyUnicode name
    is a double-underscore special name. */
 static int
@@ -5545,6 +5675,7 @@ _PyTypes_AfterFork(void)
             entry->version = 0;
         }
     }
+    _PyBRLock_AfterFork(TYPE_LOOKUP_LOCK);
 #endif
 }
 
@@ -5609,6 +5740,16 @@ _PyType_LookupRef(PyTypeObject *type, PyObject *name)
 
     int has_version = 0;
     int version = 0;
+#ifdef Py_GIL_DISABLED
+    unsigned int shared_version;
+    if (find_name_in_mro_shared(type, name, &res, &has_version,
+                                &shared_version)) {
+        if (has_version) {
+            update_cache_gil_disabled(entry, name, shared_version, res);
+        }
+        return res;
+    }
+#endif
     BEGIN_TYPE_LOCK();
     res = find_name_in_mro(type, name, &error);
     if (MCACHE_CACHEABLE_NAME(name)) {
@@ -9107,7 +9248,7 @@ hackcheck_unlocked(PyObject *self, setattrofunc func, const char *what)
 {
     PyTypeObject *type = Py_TYPE(self);
 
-    ASSERT_TYPE_LOCK_HELD();
+    ASSERT_TYPE_READ_LOCK_HELD();
 
     PyObject *mro = lookup_tp_mro(type);
     if (!mro) {
@@ -9158,9 +9299,9 @@ hackcheck(PyObject *self, setattrofunc func, const char *what)
     }
 
     int res;
-    BEGIN_TYPE_LOCK();
+    BEGIN_TYPE_READ_LOCK();
     res = hackcheck_unlocked(self, func, what);
-    END_TYPE_LOCK();
+    END_TYPE_READ_LOCK();
     return res;
 }
 
@@ -10377,9 +10518,9 @@ releasebuffer_maybe_call_super(PyObject *self, Py_buffer *buffer)
 {
     releasebufferproc base_releasebuffer;
 
-    BEGIN_TYPE_LOCK();
+    BEGIN_TYPE_READ_LOCK();
     base_releasebuffer = releasebuffer_maybe_call_super_unlocked(self, buffer);
-    END_TYPE_LOCK();
+    END_TYPE_READ_LOCK();
 
     if (base_releasebuffer != NULL) {
         base_releasebuffer(self, buffer);
@@ -11423,14 +11564,14 @@ _super_lookup_descr(PyTypeObject *su_type, PyTypeObject *su_obj_type, PyObject *
     PyObject *mro, *res;
     Py_ssize_t i, n;
 
-    BEGIN_TYPE_LOCK();
+    BEGIN_TYPE_READ_LOCK();
     mro = lookup_tp_mro(su_obj_type);
     /* keep a strong reference to mro because su_obj_type->tp_mro can be
        replaced during PyDict_GetItemRef(dict, name, &res) and because
        another thread can modify it after we end the critical section
        below  */
     Py_XINCREF(mro);
-    END_TYPE_LOCK();
+    END_TYPE_READ_LOCK();
 
     if (mro == NULL)
         return NULL;
@@ -68,6 +68,8 @@ extern PyObject* PyInit__codecs_kr(void);
 extern PyObject* PyInit__codecs_tw(void);
 extern PyObject* PyInit__winapi(void);
 extern PyObject* PyInit__lsprof(void);
+extern PyObject* PyInit__sampleprof(void);
+extern PyObject* PyInit__coverage(void);
 extern PyObject* PyInit__ast(void);
 extern PyObject* PyInit__io(void);
 extern PyObject* PyInit__pickle(void);
@@ -124,6 +126,8 @@ struct _inittab _PyImport_Inittab[] = {
     {"_bisect", PyInit__bisect},
     {"_heapq", PyInit__heapq},
     {"_lsprof", PyInit__lsprof},
+    {"_sampleprof", PyInit__sampleprof},
+    {"_coverage", PyInit__coverage},
     {"itertools", PyInit_itertools},
     {"_collections", PyInit__collections},
     {"_symtable", PyInit__symtable},
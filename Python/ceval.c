@@ -27,6 +27,7 @@
 #include "pycore_setobject.h"     // _PySet_Update()
 #include "pycore_sliceobject.h"   // _PyBuildSlice_ConsumeRefs
 #include "pycore_sysmodule.h"     // _PySys_Audit()
+#include "pycore_traceback.h"     // _PyTraceBack_AddFrame()
 #include "pycore_tuple.h"         // _PyTuple_ITEMS()
 #include "pycore_typeobject.h"    // _PySuper_Lookup()
 #include "pycore_uop_ids.h"       // Uops
@@ -907,10 +908,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
         /* Log traceback info. */
         assert(frame != &entry_frame);
         if (!_PyFrame_IsIncomplete(frame)) {
-            PyFrameObject *f = _PyFrame_GetFrameObject(frame);
-            if (f != NULL) {
-                PyTraceBack_Here(f);
-            }
+            _PyTraceBack_AddFrame(tstate, frame);
         }
         _PyEval_MonitorRaise(tstate, frame, next_instr-1);
 exception_unwind:
@@ -1005,13 +1003,11 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
 #undef GOTO_ERROR
 #define GOTO_ERROR(LABEL) goto LABEL ## _tier_two
 
-#ifdef Py_STATS
 // Disable these macros that apply to Tier 1 stats when we are in Tier 2
 #undef STAT_INC
 #define STAT_INC(opname, name) ((void)0)
 #undef STAT_DEC
 #define STAT_DEC(opname, name) ((void)0)
-#endif
 
 #undef ENABLE_SPECIALIZATION
 #define ENABLE_SPECIALIZATION 0
@@ -1091,6 +1087,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
 
 error_tier_two:
     OPT_HIST(trace_uop_execution_counter, trace_run_length_hist);
+    _Py_EXEC_OPT_STAT_INC(tstate, executor_exits);
     assert(next_uop[-1].format == UOP_FORMAT_TARGET);
     frame->return_offset = 0;  // Don't leave this random
     _PyFrame_SetStackPointer(frame, stack_pointer);
@@ -1111,6 +1108,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
     assert(next_uop[-1].format == UOP_FORMAT_TARGET);
     next_instr = next_uop[-1].target + _PyCode_CODE(_PyFrame_GetCode(frame));
 goto_to_tier1:
+    _Py_EXEC_OPT_STAT_INC(tstate, executor_exits);
 #ifdef Py_DEBUG
     if (lltrace >= 2) {
         printf("DEOPT: [UOp ");
@@ -1379,7 +1377,7 @@ skip_to_next_entry(unsigned char *p, unsigned char *end) {
 #define MAX_LINEAR_SEARCH 40
 
 static int
-get_exception_handler(PyCodeObject *code, int index, int *level, int *handler, int *lasti)
+scan_exception_table(PyCodeObject *code, int index, int *level, int *handler, int *lasti)
 {
     unsigned char *start = (unsigned char *)PyBytes_AS_STRING(code->co_exceptiontable);
     unsigned char *end = start + PyBytes_GET_SIZE(code->co_exceptiontable);
@@ -1428,6 +1426,91 @@ get_exception_handler(PyCodeObject *code, int index, int *level, int *handler, i
     return 0;
 }
 
+#ifdef PY_EXCEPTION_TABLE_CACHE
+/* Decode the exception table of the code object and store it in
+   code->_co_exctable.  Return NULL on memory error, without setting
+   an exception: the caller falls back to scanning the encoded table. */
+static _PyCoExceptionTable *
+cache_exception_table(PyCodeObject *code)
+{
+    unsigned char *start = (unsigned char *)PyBytes_AS_STRING(code->co_exceptiontable);
+    unsigned char *end = start + PyBytes_GET_SIZE(code->co_exceptiontable);
+    Py_ssize_t size = 0;
+    for (unsigned char *p = start; p < end; p++) {
+        /* The first byte of each entry has the high bit set */
+        size += (p[0] & 128) != 0;
+    }
+    assert(size > 0);
+    _PyCoExceptionTable *table = PyMem_RawMalloc(
+        sizeof(_PyCoExceptionTable) +
+        (size - 1) * sizeof(_PyExceptionTableEntry));
+    if (table == NULL) {
+        return NULL;
+    }
+    table->size = size;
+    unsigned char *scan = start;
+    for (Py_ssize_t i = 0; i < size; i++) {
+        _PyExceptionTableEntry *entry = &table->entries[i];
+        int length;
+        scan = parse_varint(scan, &entry->start);
+        scan = parse_varint(scan, &length);
+        scan = parse_varint(scan, &entry->handler);
+        scan = parse_varint(scan, &entry->depth_and_lasti);
+        entry->end = entry->start + length;
+        assert(i == 0 || entry->start >= table->entries[i-1].end);
+    }
+    assert(scan == end);
+#ifdef Py_GIL_DISABLED
+    _PyCoExceptionTable *expected = NULL;
+    if (!_Py_atomic_compare_exchange_ptr(&code->_co_exctable, &expected, table)) {
+        PyMem_RawFree(table);
+        table = expected;
+    }
+#else
+    code->_co_exctable = table;
+#endif
+    return table;
+}
+#endif
+
+static int
+get_exception_handler(PyCodeObject *code, int index, int *level, int *handler, int *lasti)
+{
+#ifdef PY_EXCEPTION_TABLE_CACHE
+    _PyCoExceptionTable *table = FT_ATOMIC_LOAD_PTR_ACQUIRE(code->_co_exctable);
+    if (table == NULL) {
+        if (PyBytes_GET_SIZE(code->co_exceptiontable) == 0) {
+            return 0;
+        }
+        table = cache_exception_table(code);
+        if (table == NULL) {
+            return scan_exception_table(code, index, level, handler, lasti);
+        }
+    }
+    /* Find the last entry starting at or before index */
+    Py_ssize_t lo = 0, hi = table->size;
+    while (lo < hi) {
+        Py_ssize_t mid = (lo + hi) / 2;
+        if (table->entries[mid].start <= index) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    if (lo == 0 || index >= table->entries[lo - 1].end) {
+        return 0;
+    }
+    _PyExceptionTableEntry *entry = &table->entries[lo - 1];
+    *handler = entry->handler;
+    *level = entry->depth_and_lasti >> 1;
+    *lasti = entry->depth_and_lasti & 1;
+    return 1;
+#else
+    return scan_exception_table(code, index, level, handler, lasti);
+#endif
+}
+
 static int
 initialize_locals(PyThreadState *tstate, PyFunctionObject *func,
     _PyStackRef *localsplus, _PyStackRef const *args,
@@ -322,9 +322,17 @@ take_gil(PyThreadState *tstate)
     MUTEX_LOCK(gil->mutex);
 
     int drop_requested = 0;
+    PyTime_t wait_start = 0;
     while (_Py_atomic_load_int_relaxed(&gil->locked)) {
         unsigned long saved_switchnum = gil->switch_number;
 
+        if (wait_start == 0 &&
+            _Py_atomic_load_int_relaxed(&interp->lock_contention.enabled))
+        {
+            // silently ignore error: cannot report error to the caller
+            (void)PyTime_MonotonicRaw(&wait_start);
+        }
+
         unsigned long interval = (gil->interval >= 1 ? gil->interval : 1);
         int timed_out = 0;
         COND_TIMED_WAIT(gil->cond, gil->mutex, interval, timed_out);
@@ -406,6 +414,9 @@ take_gil(PyThreadState *tstate)
     assert(_PyThreadState_CheckConsistency(tstate));
 
     tstate->_status.holds_gil = 1;
+    // The wait is recorded by _PyThreadState_Attach(): the thread state is
+    // not attached yet, so it cannot call the memory allocator.
+    ((_PyThreadStateImpl *)tstate)->gil_wait_start = wait_start;
     _Py_unset_eval_breaker_bit(tstate, _PY_GIL_DROP_REQUEST_BIT);
     update_eval_breaker_for_thread(interp, tstate);
 
@@ -1305,6 +1316,11 @@ _Py_HandlePending(PyThreadState *tstate)
 
     /* GIL drop request */
     if ((breaker & _PY_GIL_DROP_REQUEST_BIT) != 0) {
+        if (_PyLockContention_GET(tstate) != NULL) {
+            _PyLockContention_RecordHolder(tstate, _Py_LOCK_CONTENTION_GIL,
+                                           tstate->interp->ceval.gil);
+        }
+
         /* Give another thread a chance */
         _PyThreadState_Detach(tstate);
 
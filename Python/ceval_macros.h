@@ -260,7 +260,9 @@ GETITEM(PyObject *v, Py_ssize_t i) {
 
 #define GO_TO_INSTRUCTION(op) goto PREDICT_ID(op)
 
-#ifdef Py_STATS
+#undef _Py_EXEC_STATS_TSTATE
+#define _Py_EXEC_STATS_TSTATE tstate
+
 #define UPDATE_MISS_STATS(INSTNAME)                              \
     do {                                                         \
         STAT_INC(opcode, miss);                                  \
@@ -270,9 +272,6 @@ GETITEM(PyObject *v, Py_ssize_t i) {
             STAT_INC((INSTNAME), deopt);                         \
         }                                                        \
     } while (0)
-#else
-#define UPDATE_MISS_STATS(INSTNAME) ((void)0)
-#endif
 
 #define DEOPT_IF(COND, INSTNAME)                            \
     if ((COND)) {                                           \
@@ -397,8 +396,10 @@ _PyFrame_SetStackPointer(frame, stack_pointer)
 #define GOTO_TIER_TWO(EXECUTOR)                        \
 do {                                                   \
     OPT_STAT_INC(traces_executed);                     \
+    _Py_EXEC_OPT_STAT_INC(tstate, executor_entries);   \
     jit_func jitted = (EXECUTOR)->jit_code;            \
     next_instr = jitted(frame, stack_pointer, tstate); \
+    _Py_EXEC_OPT_STAT_INC(tstate, executor_exits);     \
     Py_DECREF(tstate->previous_executor);              \
     tstate->previous_executor = NULL;                  \
     frame = tstate->current_frame;                     \
@@ -412,6 +413,7 @@ do {                                                   \
 #define GOTO_TIER_TWO(EXECUTOR) \
 do { \
     OPT_STAT_INC(traces_executed); \
+    _Py_EXEC_OPT_STAT_INC(tstate, executor_entries); \
     next_uop = (EXECUTOR)->trace; \
     assert(next_uop->opcode == _START_EXECUTOR); \
     goto enter_tier_two; \
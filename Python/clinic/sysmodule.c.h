@@ -1331,6 +1331,236 @@ exit:
 
 #endif /* defined(Py_STATS) */
 
+PyDoc_STRVAR(sys__exec_stats_on__doc__,
+"_exec_stats_on($module, /)\n"
+"--\n"
+"\n"
+"Turns on gathering of the execution stats (off by default).\n"
+"\n"
+"The execution stats count specialization attempts, hits, misses and\n"
+"deoptimizations per instruction, and the tier 2 executors which are created,\n"
+"entered and exited.  They are available in all builds.");
+
+#define SYS__EXEC_STATS_ON_METHODDEF    \
+    {"_exec_stats_on", (PyCFunction)sys__exec_stats_on, METH_NOARGS, sys__exec_stats_on__doc__},
+
+static PyObject *
+sys__exec_stats_on_impl(PyObject *module);
+
+static PyObject *
+sys__exec_stats_on(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__exec_stats_on_impl(module);
+}
+
+PyDoc_STRVAR(sys__exec_stats_off__doc__,
+"_exec_stats_off($module, /)\n"
+"--\n"
+"\n"
+"Turns off gathering of the execution stats.\n"
+"\n"
+"The counts gathered so far are kept.");
+
+#define SYS__EXEC_STATS_OFF_METHODDEF    \
+    {"_exec_stats_off", (PyCFunction)sys__exec_stats_off, METH_NOARGS, sys__exec_stats_off__doc__},
+
+static PyObject *
+sys__exec_stats_off_impl(PyObject *module);
+
+static PyObject *
+sys__exec_stats_off(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__exec_stats_off_impl(module);
+}
+
+PyDoc_STRVAR(sys__exec_stats_clear__doc__,
+"_exec_stats_clear($module, /)\n"
+"--\n"
+"\n"
+"Clears the execution stats.");
+
+#define SYS__EXEC_STATS_CLEAR_METHODDEF    \
+    {"_exec_stats_clear", (PyCFunction)sys__exec_stats_clear, METH_NOARGS, sys__exec_stats_clear__doc__},
+
+static PyObject *
+sys__exec_stats_clear_impl(PyObject *module);
+
+static PyObject *
+sys__exec_stats_clear(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__exec_stats_clear_impl(module);
+}
+
+PyDoc_STRVAR(sys__get_exec_stats__doc__,
+"_get_exec_stats($module, /)\n"
+"--\n"
+"\n"
+"Return the execution stats as a dict.\n"
+"\n"
+"The keys are the same as in the files written by sys._exec_stats_dump().");
+
+#define SYS__GET_EXEC_STATS_METHODDEF    \
+    {"_get_exec_stats", (PyCFunction)sys__get_exec_stats, METH_NOARGS, sys__get_exec_stats__doc__},
+
+static PyObject *
+sys__get_exec_stats_impl(PyObject *module);
+
+static PyObject *
+sys__get_exec_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__get_exec_stats_impl(module);
+}
+
+PyDoc_STRVAR(sys__exec_stats_dump__doc__,
+"_exec_stats_dump($module, /)\n"
+"--\n"
+"\n"
+"Dump the execution stats to file, and clear them.\n"
+"\n"
+"The file is written in the pystats directory, in the format read by\n"
+"Tools/scripts/summarize_stats.py.  Return False if the file could not be\n"
+"created.");
+
+#define SYS__EXEC_STATS_DUMP_METHODDEF    \
+    {"_exec_stats_dump", (PyCFunction)sys__exec_stats_dump, METH_NOARGS, sys__exec_stats_dump__doc__},
+
+static int
+sys__exec_stats_dump_impl(PyObject *module);
+
+static PyObject *
+sys__exec_stats_dump(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    int _return_value;
+
+    _return_value = sys__exec_stats_dump_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyBool_FromLong((long)_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__lock_contention_on__doc__,
+"_lock_contention_on($module, /)\n"
+"--\n"
+"\n"
+"Turns on the lock contention profile (off by default).\n"
+"\n"
+"The profile records how long threads wait for the locks of the runtime,\n"
+"the locks of the critical sections of the free-threaded build and the GIL,\n"
+"and where.  Only contended acquisitions are recorded.");
+
+#define SYS__LOCK_CONTENTION_ON_METHODDEF    \
+    {"_lock_contention_on", (PyCFunction)sys__lock_contention_on, METH_NOARGS, sys__lock_contention_on__doc__},
+
+static PyObject *
+sys__lock_contention_on_impl(PyObject *module);
+
+static PyObject *
+sys__lock_contention_on(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__lock_contention_on_impl(module);
+}
+
+PyDoc_STRVAR(sys__lock_contention_off__doc__,
+"_lock_contention_off($module, /)\n"
+"--\n"
+"\n"
+"Turns off the lock contention profile.\n"
+"\n"
+"The waits recorded so far are kept.");
+
+#define SYS__LOCK_CONTENTION_OFF_METHODDEF    \
+    {"_lock_contention_off", (PyCFunction)sys__lock_contention_off, METH_NOARGS, sys__lock_contention_off__doc__},
+
+static PyObject *
+sys__lock_contention_off_impl(PyObject *module);
+
+static PyObject *
+sys__lock_contention_off(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__lock_contention_off_impl(module);
+}
+
+PyDoc_STRVAR(sys__lock_contention_clear__doc__,
+"_lock_contention_clear($module, /)\n"
+"--\n"
+"\n"
+"Clears the lock contention profile.");
+
+#define SYS__LOCK_CONTENTION_CLEAR_METHODDEF    \
+    {"_lock_contention_clear", (PyCFunction)sys__lock_contention_clear, METH_NOARGS, sys__lock_contention_clear__doc__},
+
+static PyObject *
+sys__lock_contention_clear_impl(PyObject *module);
+
+static PyObject *
+sys__lock_contention_clear(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__lock_contention_clear_impl(module);
+}
+
+PyDoc_STRVAR(sys__get_lock_contention__doc__,
+"_get_lock_contention($module, /)\n"
+"--\n"
+"\n"
+"Return the lock contention profile as a dict.\n"
+"\n"
+"\'sites\' is a list of dicts, one per contended lock, sorted by decreasing\n"
+"total wait time, and \'dropped\' counts the waits which could not be\n"
+"recorded.  Each site has the keys:\n"
+"\n"
+"* \'kind\': \'mutex\', \'critical_section\' or \'gil\';\n"
+"* \'lock\': the address of the lock;\n"
+"* \'type\': the type of the object of a critical section, or None;\n"
+"* \'count\', \'total_ns\' and \'max_ns\': the number of contended acquisitions,\n"
+"  and the total and longest wait times in nanoseconds;\n"
+"* \'histogram\': a tuple of counts of waits shorter than 1 us, then in\n"
+"  [2**(i-1), 2**i) us for the i-th item; the last item also counts longer\n"
+"  waits;\n"
+"* \'waiter\' and \'holder\': the innermost frames of the first thread which\n"
+"  waited for the lock, and of the first one which released it while threads\n"
+"  were waiting, as (filename, lineno, qualname) tuples.");
+
+#define SYS__GET_LOCK_CONTENTION_METHODDEF    \
+    {"_get_lock_contention", (PyCFunction)sys__get_lock_contention, METH_NOARGS, sys__get_lock_contention__doc__},
+
+static PyObject *
+sys__get_lock_contention_impl(PyObject *module);
+
+static PyObject *
+sys__get_lock_contention(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__get_lock_contention_impl(module);
+}
+
+PyDoc_STRVAR(sys__get_datastack_stats__doc__,
+"_get_datastack_stats($module, /)\n"
+"--\n"
+"\n"
+"Return a dict of counters about the data stack of the current thread.\n"
+"\n"
+"The data stack holds the frames of the Python functions which are executing.\n"
+"It grows by chunks: \'allocated\' and \'freed\' count the chunks which were\n"
+"allocated and freed, \'reused\' the chunks taken from the \'spare\' chunks which\n"
+"are kept after being popped, and \'chunk_size\' is the size in bytes of the\n"
+"largest chunk.");
+
+#define SYS__GET_DATASTACK_STATS_METHODDEF    \
+    {"_get_datastack_stats", (PyCFunction)sys__get_datastack_stats, METH_NOARGS, sys__get_datastack_stats__doc__},
+
+static PyObject *
+sys__get_datastack_stats_impl(PyObject *module);
+
+static PyObject *
+sys__get_datastack_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__get_datastack_stats_impl(module);
+}
+
 #if defined(ANDROID_API_LEVEL)
 
 PyDoc_STRVAR(sys_getandroidapilevel__doc__,
@@ -1614,4 +1844,4 @@ exit:
 #ifndef SYS_GETANDROIDAPILEVEL_METHODDEF
     #define SYS_GETANDROIDAPILEVEL_METHODDEF
 #endif /* !defined(SYS_GETANDROIDAPILEVEL_METHODDEF) */
-/*[clinic end generated code: output=9cc9069aef1482bc input=a9049054013a1b77]*/
+/*[clinic end generated code: output=1b8a5b7544363307 input=a9049054013a1b77]*/
@@ -8,17 +8,33 @@ static_assert(_Alignof(PyCriticalSection) >= 4,
               "critical section must be aligned to at least 4 bytes");
 #endif
 
-void
-_PyCriticalSection_BeginSlow(PyCriticalSection *c, PyMutex *m)
-{
 #ifdef Py_GIL_DISABLED
+static void
+critical_section_begin_slow(PyCriticalSection *c, PyMutex *m, PyObject *op)
+{
     PyThreadState *tstate = _PyThreadState_GET();
     c->_cs_mutex = NULL;
     c->_cs_prev = (uintptr_t)tstate->critical_section;
     tstate->critical_section = (uintptr_t)c;
 
-    PyMutex_Lock(m);
+    _PyMutex_LockCriticalSection(m, op);
     c->_cs_mutex = m;
+}
+#endif
+
+void
+_PyCriticalSection_BeginSlow(PyCriticalSection *c, PyMutex *m)
+{
+#ifdef Py_GIL_DISABLED
+    critical_section_begin_slow(c, m, NULL);
+#endif
+}
+
+void
+_PyCriticalSection_BeginObjectSlow(PyCriticalSection *c, PyObject *op)
+{
+#ifdef Py_GIL_DISABLED
+    critical_section_begin_slow(c, &op->ob_mutex, op);
 #endif
 }
 
@@ -34,9 +50,9 @@ _PyCriticalSection2_BeginSlow(PyCriticalSection2 *c, PyMutex *m1, PyMutex *m2,
     tstate->critical_section = (uintptr_t)c | _Py_CRITICAL_SECTION_TWO_MUTEXES;
 
     if (!is_m1_locked) {
-        PyMutex_Lock(m1);
+        _PyMutex_LockCriticalSection(m1, NULL);
     }
-    PyMutex_Lock(m2);
+    _PyMutex_LockCriticalSection(m2, NULL);
     c->_cs_base._cs_mutex = m1;
     c->_cs_mutex2 = m2;
 #endif
@@ -96,10 +112,10 @@ _PyCriticalSection_Resume(PyThreadState *tstate)
     }
 
     if (m1) {
-        PyMutex_Lock(m1);
+        _PyMutex_LockCriticalSection(m1, NULL);
     }
     if (m2) {
-        PyMutex_Lock(m2);
+        _PyMutex_LockCriticalSection(m2, NULL);
     }
 
     c->_cs_mutex = m1;
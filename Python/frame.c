@@ -6,6 +6,7 @@
 #include "pycore_code.h"          // stats
 #include "pycore_frame.h"
 #include "pycore_object.h"        // _PyObject_GC_UNTRACK()
+#include "pycore_traceback.h"     // _PyTraceBack_ReleaseFrame()
 #include "opcode.h"
 
 int
@@ -112,6 +113,9 @@ _PyFrame_ClearExceptCode(_PyInterpreterFrame *frame)
     // GH-99729: Clearing this frame can expose the stack (via finalizers). It's
     // crucial that this frame has been unlinked, and is no longer visible:
     assert(_PyThreadState_GET()->current_frame != frame);
+    if (frame->lazy_tb) {
+        _PyTraceBack_ReleaseFrame(frame);
+    }
     if (frame->frame_obj) {
         PyFrameObject *f = frame->frame_obj;
         frame->frame_obj = NULL;
@@ -540,6 +540,89 @@ _PyJIT_Compile(_PyExecutorObject *executor, const _PyUOpInstruction trace[], siz
     return 0;
 }
 
+// Code object of the function or code object in the operand of _PUSH_FRAME
+// and the return uops (see translate_bytecode_to_trace), or NULL:
+static PyCodeObject *
+operand_code(uint64_t operand)
+{
+    if (operand & 1) {
+        return (PyCodeObject *)(uintptr_t)(operand & ~(uint64_t)1);
+    }
+    if (operand) {
+        return (PyCodeObject *)((PyFunctionObject *)(uintptr_t)operand)->func_code;
+    }
+    return NULL;
+}
+
+// Register the machine code of the executor with the perf trampoline, along
+// with a line table mapping each uop to the line of the instruction it was
+// translated from. The trace starts in code, and may continue in the frames
+// of the functions it inlined:
+void
+_PyJIT_RegisterWithPerf(_PyExecutorObject *executor, PyCodeObject *code)
+{
+    if (executor->jit_code == NULL || !_PyPerfTrampoline_IsTrackingJitCode()) {
+        return;
+    }
+    size_t length = executor->code_size;
+    _PyPerf_JitLineEntry *lines = PyMem_RawMalloc(
+        length * sizeof(_PyPerf_JitLineEntry));
+    if (lines == NULL) {
+        return;
+    }
+    PyCodeObject *start_code = code;
+    PyCodeObject *callers[TRACE_STACK_SIZE];
+    int depth = 0;
+    Py_ssize_t nlines = 0;
+    size_t code_size = trampoline.code_size;
+    for (size_t i = 0; i < length; i++) {
+        const _PyUOpInstruction *instruction = &executor->trace[i];
+        if (code != NULL && instruction->format == UOP_FORMAT_TARGET) {
+            int lineno = PyCode_Addr2Line(
+                code, instruction->target * (int)sizeof(_Py_CODEUNIT));
+            if (nlines == 0 || lines[nlines - 1].code != code ||
+                lines[nlines - 1].lineno != lineno)
+            {
+                lines[nlines].code_addr = (unsigned char *)executor->jit_code + code_size;
+                lines[nlines].code = code;
+                lines[nlines].lineno = lineno;
+                nlines++;
+            }
+        }
+        switch (instruction->opcode) {
+            case _PUSH_FRAME:
+                if (depth < TRACE_STACK_SIZE) {
+                    callers[depth] = code;
+                }
+                depth++;
+                code = operand_code(instruction->operand);
+                break;
+            case _RETURN_VALUE:
+            case _RETURN_GENERATOR:
+            case _YIELD_VALUE:
+                if (depth > 0) {
+                    depth--;
+                    code = depth < TRACE_STACK_SIZE ? callers[depth] : NULL;
+                }
+                else {
+                    code = operand_code(instruction->operand);
+                }
+                break;
+        }
+        if (is_terminator(instruction)) {
+            // The exit stubs which follow are shared by the whole trace, the
+            // line of their target is not known here:
+            code = NULL;
+        }
+        code_size += stencil_groups[instruction->opcode].code_size;
+    }
+    code_size += stencil_groups[_FATAL_ERROR].code_size;
+    assert(code_size <= executor->jit_size);
+    _PyPerfTrampoline_WriteJitCode(executor->jit_code, (unsigned int)code_size,
+                                   start_code, lines, nlines);
+    PyMem_RawFree(lines);
+}
+
 void
 _PyJIT_Free(_PyExecutorObject *executor)
 {
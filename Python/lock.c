@@ -3,7 +3,9 @@
 #include "Python.h"
 
 #include "pycore_lock.h"
+#include "pycore_lock_contention.h" // _PyLockContention_RecordWait()
 #include "pycore_parking_lot.h"
+#include "pycore_pystate.h"       // _PyThreadState_GET()
 #include "pycore_semaphore.h"
 #include "pycore_time.h"          // _PyTime_Add()
 
@@ -28,6 +30,23 @@ static const int MAX_SPIN_COUNT = 40;
 static const int MAX_SPIN_COUNT = 0;
 #endif
 
+// How long to spin is adapted to each mutex. A PyMutex is a single byte, so
+// the estimates are kept in a side table hashed by the mutex address:
+// mutexes which collide share their estimate. The estimate of a mutex is the
+// moving average of how long its contended acquisitions waited, which
+// follows how long it is held and, when its holder is preempted or blocked,
+// how long the holder does not run. Waiters spin for up to twice the
+// estimate, and not at all if it exceeds SPIN_LIMIT_NS: parking is then
+// cheaper than spinning. The first MIN_SPIN_COUNT spins are always done, so
+// that a mutex which is held for shorter times again is noticed.
+#define SPIN_TABLE_SIZE 256
+static const int MIN_SPIN_COUNT = 2;
+static const PyTime_t SPIN_LIMIT_NS = 50*1000;
+static uint32_t spin_estimates[SPIN_TABLE_SIZE];
+
+// Number of CPUs this process can run on, or 0 if not known yet
+static int spin_ncpus;
+
 struct mutex_entry {
     // The time after which the unlocking thread should hand off lock ownership
     // directly to the waiting thread. Written by the waiting thread.
@@ -37,7 +56,7 @@ struct mutex_entry {
     int handed_off;
 };
 
-static void
+void
 _Py_yield(void)
 {
 #ifdef MS_WINDOWS
@@ -47,8 +66,96 @@ _Py_yield(void)
 #endif
 }
 
-PyLockStatus
-_PyMutex_LockTimed(PyMutex *m, PyTime_t timeout, _PyLockFlags flags)
+static int
+get_cpu_count(void)
+{
+    int ncpus = _Py_atomic_load_int_relaxed(&spin_ncpus);
+    if (ncpus != 0) {
+        return ncpus;
+    }
+#ifdef MS_WINDOWS
+    ncpus = (int)GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#else
+#  if defined(HAVE_SCHED_SETAFFINITY) && defined(CPU_COUNT)
+    // Containers usually restrict the CPUs with an affinity mask
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        ncpus = CPU_COUNT(&set);
+    }
+#  endif
+#  if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+    if (ncpus <= 0) {
+        ncpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+#  endif
+#endif
+    if (ncpus <= 0) {
+        ncpus = 2;  // unknown: assume that spinning may help
+    }
+    _Py_atomic_store_int_relaxed(&spin_ncpus, ncpus);
+    return ncpus;
+}
+
+static inline uint32_t *
+spin_estimate(PyMutex *m)
+{
+    // Mutexes are often embedded in objects: mix the high bits in.
+    uintptr_t h = (uintptr_t)m;
+    h ^= h >> 8;
+    h ^= h >> 16;
+    return &spin_estimates[h % SPIN_TABLE_SIZE];
+}
+
+// Return how long a waiter on 'm' may spin, or -1 if it should not spin.
+static PyTime_t
+spin_duration(PyMutex *m)
+{
+    if (MAX_SPIN_COUNT == 0) {
+        return -1;
+    }
+    if (get_cpu_count() == 1) {
+        // The thread holding the mutex cannot run while we spin.
+        return -1;
+    }
+    PyTime_t estimate = _Py_atomic_load_uint32_relaxed(spin_estimate(m));
+    if (estimate > SPIN_LIMIT_NS) {
+        return -1;
+    }
+    return 2 * estimate;
+}
+
+// Update the estimate of 'm' after a contended acquisition which waited
+// for 'wait' nanoseconds.
+static void
+update_spin_estimate(PyMutex *m, PyTime_t wait)
+{
+    uint32_t *p = spin_estimate(m);
+    PyTime_t estimate = _Py_atomic_load_uint32_relaxed(p);
+    wait = Py_MIN(Py_MAX(wait, 0), 8 * SPIN_LIMIT_NS);
+    PyTime_t updated = estimate + (wait - estimate) / 8;
+    if (updated != estimate) {
+        // Racy update: losing a sample now and then does not matter.
+        _Py_atomic_store_uint32_relaxed(p, (uint32_t)updated);
+    }
+}
+
+// Return the current thread state if it records lock contention.
+static inline PyThreadState *
+lock_contention_tstate(void)
+{
+    PyThreadState *tstate = _PyThreadState_GET();
+    if (tstate != NULL &&
+        _Py_atomic_load_int_relaxed(&tstate->state) == _Py_THREAD_ATTACHED &&
+        _PyLockContention_GET(tstate) != NULL)
+    {
+        return tstate;
+    }
+    return NULL;
+}
+
+static PyLockStatus
+mutex_lock_timed(PyMutex *m, PyTime_t timeout, _PyLockFlags flags,
+                 _PyLockContentionKind kind, PyObject *obj)
 {
     uint8_t v = _Py_atomic_load_uint8_relaxed(&m->_bits);
     if ((v & _Py_LOCKED) == 0) {
@@ -73,21 +180,29 @@ _PyMutex_LockTimed(PyMutex *m, PyTime_t timeout, _PyLockFlags flags)
         .handed_off = 0,
     };
 
-    Py_ssize_t spin_count = 0;
+    PyTime_t max_spin = spin_duration(m);
+    int spin_count = 0;
     for (;;) {
         if ((v & _Py_LOCKED) == 0) {
             // The lock is unlocked. Try to grab it.
             if (_Py_atomic_compare_exchange_uint8(&m->_bits, &v, v|_Py_LOCKED)) {
-                return PY_LOCK_ACQUIRED;
+                break;
             }
             continue;
         }
 
-        if (!(v & _Py_HAS_PARKED) && spin_count < MAX_SPIN_COUNT) {
-            // Spin for a bit.
-            _Py_yield();
-            spin_count++;
-            continue;
+        if (!(v & _Py_HAS_PARKED) && max_spin >= 0 &&
+            spin_count < MAX_SPIN_COUNT)
+        {
+            PyTime_t spin_now;
+            (void)PyTime_MonotonicRaw(&spin_now);
+            if (spin_count < MIN_SPIN_COUNT || spin_now - now < max_spin) {
+                // Spin for a bit.
+                _Py_yield();
+                spin_count++;
+                v = _Py_atomic_load_uint8_relaxed(&m->_bits);
+                continue;
+            }
         }
 
         if (timeout == 0) {
@@ -109,7 +224,7 @@ _PyMutex_LockTimed(PyMutex *m, PyTime_t timeout, _PyLockFlags flags)
             if (entry.handed_off) {
                 // We own the lock now.
                 assert(_Py_atomic_load_uint8_relaxed(&m->_bits) & _Py_LOCKED);
-                return PY_LOCK_ACQUIRED;
+                break;
             }
         }
         else if (ret == Py_PARK_INTR && (flags & _PY_LOCK_HANDLE_SIGNALS)) {
@@ -132,6 +247,33 @@ _PyMutex_LockTimed(PyMutex *m, PyTime_t timeout, _PyLockFlags flags)
 
         v = _Py_atomic_load_uint8_relaxed(&m->_bits);
     }
+
+    if (MAX_SPIN_COUNT > 0) {
+        PyTime_t acquired;
+        (void)PyTime_MonotonicRaw(&acquired);
+        update_spin_estimate(m, acquired - now);
+    }
+
+    PyThreadState *tstate = lock_contention_tstate();
+    if (tstate != NULL) {
+        _PyLockContention_RecordWait(tstate, kind, m, obj, now);
+    }
+    return PY_LOCK_ACQUIRED;
+}
+
+PyLockStatus
+_PyMutex_LockTimed(PyMutex *m, PyTime_t timeout, _PyLockFlags flags)
+{
+    return mutex_lock_timed(m, timeout, flags, _Py_LOCK_CONTENTION_MUTEX, NULL);
+}
+
+void
+_PyMutex_LockCriticalSection(PyMutex *m, PyObject *obj)
+{
+    if (!PyMutex_LockFast(&m->_bits)) {
+        mutex_lock_timed(m, -1, _PY_LOCK_DETACH,
+                         _Py_LOCK_CONTENTION_CRITICAL_SECTION, obj);
+    }
 }
 
 static void
@@ -165,6 +307,11 @@ _PyMutex_TryUnlock(PyMutex *m)
             return -1;
         }
         else if ((v & _Py_HAS_PARKED)) {
+            PyThreadState *tstate = lock_contention_tstate();
+            if (tstate != NULL) {
+                _PyLockContention_RecordHolder(
+                    tstate, _Py_LOCK_CONTENTION_MUTEX, m);
+            }
             // wake up a single thread
             _PyParkingLot_Unpark(&m->_bits, (_Py_unpark_fn_t *)mutex_unpark, m);
             return 0;
@@ -500,6 +647,106 @@ _PyRWMutex_Unlock(_PyRWMutex *rwmutex)
     }
 }
 
+static inline _PyBRLockSlot *
+brlock_slot(_PyBRLock *lock)
+{
+#ifdef Py_GIL_DISABLED
+    uint64_t id = _Py_ThreadId();
+#else
+    uint64_t id = PyThread_get_thread_ident_ex();
+#endif
+    // Thread ids are often aligned addresses: spread them over the slots.
+    uint32_t h = (uint32_t)((id * 0x9E3779B97F4A7C15ULL) >> 32);
+    return &lock->slots[h % _Py_BRLOCK_SLOTS];
+}
+
+static void
+brlock_reader_leave(_PyBRLock *lock, _PyBRLockSlot *slot)
+{
+    Py_ssize_t readers = _Py_atomic_add_ssize(&slot->readers, -1);
+    assert(readers > 0 && "lock was not read-locked");
+    (void)readers;
+    if (_Py_atomic_load_ssize(&lock->writers) != 0) {
+        // A writer may be waiting for the readers to leave.
+        _Py_atomic_add_uint32(&lock->drain_seq, 1);
+        _PyParkingLot_UnparkAll(&lock->drain_seq);
+    }
+}
+
+int
+_PyBRLock_TryRLock(_PyBRLock *lock)
+{
+    _PyBRLockSlot *slot = brlock_slot(lock);
+    _Py_atomic_add_ssize(&slot->readers, 1);
+    // The increment above and this load are sequentially consistent, and so
+    // are the writer's update of `writers` and its loads of the slots: either
+    // the writer sees our count or we see the writer.
+    if (_Py_atomic_load_ssize(&lock->writers) == 0) {
+        return 1;
+    }
+    brlock_reader_leave(lock, slot);
+    return 0;
+}
+
+void
+_PyBRLock_RLock(_PyBRLock *lock)
+{
+    while (!_PyBRLock_TryRLock(lock)) {
+        // Wait until there are no writers.
+        Py_ssize_t writers = _Py_atomic_load_ssize(&lock->writers);
+        if (writers != 0) {
+            _PyParkingLot_Park(&lock->writers, &writers, sizeof(writers), -1,
+                               NULL, 1);
+        }
+    }
+}
+
+void
+_PyBRLock_RUnlock(_PyBRLock *lock)
+{
+    brlock_reader_leave(lock, brlock_slot(lock));
+}
+
+void
+_PyBRLock_Lock(_PyBRLock *lock)
+{
+    _Py_atomic_add_ssize(&lock->writers, 1);
+    for (;;) {
+        uint32_t seq = _Py_atomic_load_uint32(&lock->drain_seq);
+        Py_ssize_t readers = 0;
+        for (int i = 0; i < _Py_BRLOCK_SLOTS; i++) {
+            readers += _Py_atomic_load_ssize(&lock->slots[i].readers);
+        }
+        if (readers == 0) {
+            return;
+        }
+        // Wait for a reader to leave.
+        _PyParkingLot_Park(&lock->drain_seq, &seq, sizeof(seq), -1, NULL, 1);
+    }
+}
+
+void
+_PyBRLock_Unlock(_PyBRLock *lock)
+{
+    Py_ssize_t writers = _Py_atomic_add_ssize(&lock->writers, -1);
+    assert(writers > 0 && "lock was not write-locked");
+    if (writers == 1) {
+        // Wake up the readers waiting in _PyBRLock_RLock().
+        _PyParkingLot_UnparkAll(&lock->writers);
+    }
+}
+
+void
+_PyBRLock_AfterFork(_PyBRLock *lock)
+{
+    // The other threads do not exist in the child process. The writers are
+    // kept, since the thread which forked may hold the write lock.
+    for (int i = 0; i < _Py_BRLOCK_SLOTS; i++) {
+        lock->slots[i].readers = 0;
+    }
+    lock->drain_seq = 0;
+}
+
 #define SEQLOCK_IS_UPDATING(sequence) (sequence & 0x01)
 
 void _PySeqLock_LockWrite(_PySeqLock *seqlock)
@@ -0,0 +1,611 @@
+// Lock contention profile, see pycore_lock_contention.h
+
+#include "Python.h"
+
+#include "pycore_frame.h"         // _PyThreadState_GetFrame()
+#include "pycore_lock_contention.h"
+#include "pycore_pystate.h"       // _PyThreadState_GET()
+#include "pycore_time.h"          // PyTime_MonotonicRaw()
+
+// Number of slots of a new table
+#define INITIAL_SLOTS 16
+// Maximum number of slots of the table of a thread, and of the table of the
+// threads which exited.  Tables are at most 3/4 full.
+#define THREAD_MAX_SLOTS 4096
+#define RETIRED_MAX_SLOTS (4 * THREAD_MAX_SLOTS)
+
+static const char * const kind_names[] = {
+    [_Py_LOCK_CONTENTION_MUTEX] = "mutex",
+    [_Py_LOCK_CONTENTION_CRITICAL_SECTION] = "critical_section",
+    [_Py_LOCK_CONTENTION_GIL] = "gil",
+};
+
+static Py_ssize_t
+slot_index(const void *lock, Py_ssize_t mask)
+{
+    // Locks are at least 1 byte apart, but most are in objects or structures
+    // which are 8 or 16 bytes aligned: mix the high bits into the index.
+    uintptr_t h = (uintptr_t)lock;
+    h ^= h >> 17;
+    h *= (uintptr_t)0x9E3779B97F4A7C15ULL;
+    return (Py_ssize_t)((h >> 7) & (uintptr_t)mask);
+}
+
+static int
+table_resize(_PyLockContentionTable *table, Py_ssize_t nslots)
+{
+    _PyLockContentionSite *sites = PyMem_RawCalloc(nslots, sizeof(*sites));
+    if (sites == NULL) {
+        return -1;
+    }
+    Py_ssize_t mask = nslots - 1;
+    if (table->sites != NULL) {
+        for (Py_ssize_t i = 0; i <= table->mask; i++) {
+            _PyLockContentionSite *site = &table->sites[i];
+            if (site->lock == NULL) {
+                continue;
+            }
+            Py_ssize_t j = slot_index(site->lock, mask);
+            while (sites[j].lock != NULL) {
+                j = (j + 1) & mask;
+            }
+            sites[j] = *site;
+        }
+        PyMem_RawFree(table->sites);
+    }
+    table->sites = sites;
+    table->mask = mask;
+    return 0;
+}
+
+/* Make room for 'n' sites in an empty table. */
+static int
+table_reserve(_PyLockContentionTable *table, Py_ssize_t n)
+{
+    assert(table->size == 0);
+    Py_ssize_t nslots = INITIAL_SLOTS;
+    while (nslots / 4 * 3 < n) {
+        nslots *= 2;
+    }
+    return table_resize(table, nslots);
+}
+
+/* Return the site of 'lock', adding it if needed.  Return NULL if the table
+   cannot grow beyond 'max_slots' slots or on memory error. */
+static _PyLockContentionSite *
+table_get(_PyLockContentionTable *table, const void *lock,
+          Py_ssize_t max_slots)
+{
+    if (table->sites != NULL) {
+        Py_ssize_t i = slot_index(lock, table->mask);
+        for (;;) {
+            _PyLockContentionSite *site = &table->sites[i];
+            if (site->lock == lock) {
+                return site;
+            }
+            if (site->lock == NULL) {
+                break;
+            }
+            i = (i + 1) & table->mask;
+        }
+    }
+
+    Py_ssize_t nslots = table->sites == NULL ? 0 : table->mask + 1;
+    if ((table->size + 1) > nslots / 4 * 3) {
+        Py_ssize_t new_nslots = nslots == 0 ? INITIAL_SLOTS : nslots * 2;
+        if (new_nslots > max_slots || table_resize(table, new_nslots) < 0) {
+            return NULL;
+        }
+    }
+    Py_ssize_t i = slot_index(lock, table->mask);
+    while (table->sites[i].lock != NULL) {
+        i = (i + 1) & table->mask;
+    }
+    _PyLockContentionSite *site = &table->sites[i];
+    site->lock = lock;
+    table->size++;
+    return site;
+}
+
+static void
+frames_clear(_PyLockContentionFrame *frames)
+{
+    for (int i = 0; i < _Py_LOCK_CONTENTION_DEPTH; i++) {
+        Py_CLEAR(frames[i].code);
+    }
+}
+
+/* Release the references held by the table and free its sites. */
+static void
+table_clear(_PyLockContentionTable *table)
+{
+    if (table->sites != NULL) {
+        for (Py_ssize_t i = 0; i <= table->mask; i++) {
+            _PyLockContentionSite *site = &table->sites[i];
+            if (site->lock != NULL) {
+                Py_CLEAR(site->type);
+                frames_clear(site->waiter);
+                frames_clear(site->holder);
+            }
+        }
+        PyMem_RawFree(table->sites);
+    }
+    table->sites = NULL;
+    table->size = 0;
+    table->mask = 0;
+    table->dropped = 0;
+}
+
+static void
+table_free_list(_PyLockContentionTable *table)
+{
+    while (table != NULL) {
+        _PyLockContentionTable *next = table->next;
+        table_clear(table);
+        PyMem_RawFree(table);
+        table = next;
+    }
+}
+
+static void
+frames_merge(_PyLockContentionFrame *dst, _PyLockContentionFrame *src,
+             int steal)
+{
+    if (dst[0].code != NULL || src[0].code == NULL) {
+        return;
+    }
+    for (int i = 0; i < _Py_LOCK_CONTENTION_DEPTH; i++) {
+        dst[i] = src[i];
+        if (steal) {
+            src[i].code = NULL;
+        }
+        else {
+            Py_XINCREF(dst[i].code);
+        }
+    }
+}
+
+/* Add the sites of 'src' to 'dst'.  If 'steal' is true, the references
+   are moved from 'src' to 'dst' when 'dst' does not have them already,
+   otherwise they are copied.  This never releases references, so it can be
+   called while the world is stopped. */
+static void
+table_merge(_PyLockContentionTable *dst, _PyLockContentionTable *src,
+            int steal, Py_ssize_t max_slots)
+{
+    dst->dropped += src->dropped;
+    if (src->sites == NULL) {
+        return;
+    }
+    for (Py_ssize_t i = 0; i <= src->mask; i++) {
+        _PyLockContentionSite *s = &src->sites[i];
+        if (s->lock == NULL) {
+            continue;
+        }
+        _PyLockContentionSite *d = table_get(dst, s->lock, max_slots);
+        if (d == NULL) {
+            dst->dropped += s->count;
+            continue;
+        }
+        if (s->kind > d->kind) {
+            d->kind = s->kind;
+        }
+        if (d->type == NULL && s->type != NULL) {
+            d->type = s->type;
+            if (steal) {
+                s->type = NULL;
+            }
+            else {
+                Py_INCREF(d->type);
+            }
+        }
+        d->count += s->count;
+        d->total_ns += s->total_ns;
+        if (s->max_ns > d->max_ns) {
+            d->max_ns = s->max_ns;
+        }
+        for (int j = 0; j < _Py_LOCK_CONTENTION_BUCKETS; j++) {
+            d->histogram[j] += s->histogram[j];
+        }
+        frames_merge(d->waiter, s->waiter, steal);
+        frames_merge(d->holder, s->holder, steal);
+    }
+}
+
+
+/* Recording */
+
+static void
+capture_stack(PyThreadState *tstate, _PyLockContentionFrame *frames)
+{
+    _PyInterpreterFrame *frame = _PyThreadState_GetFrame(tstate);
+    for (int i = 0; i < _Py_LOCK_CONTENTION_DEPTH && frame != NULL; i++) {
+        frames[i].code = (PyCodeObject *)Py_NewRef(_PyFrame_GetCode(frame));
+        frames[i].lineno = PyUnstable_InterpreterFrame_GetLine(frame);
+        frame = _PyFrame_GetFirstComplete(frame->previous);
+    }
+}
+
+static int
+histogram_bucket(uint64_t ns)
+{
+    uint64_t us = ns / 1000;
+    int bucket = 0;
+    while (us != 0 && bucket < _Py_LOCK_CONTENTION_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void
+_PyLockContention_RecordWait(PyThreadState *tstate,
+                             _PyLockContentionKind kind,
+                             const void *lock, PyObject *obj,
+                             PyTime_t start)
+{
+    _PyLockContentionTable *table = _PyLockContention_GET(tstate);
+    if (table == NULL || table->busy) {
+        return;
+    }
+    PyTime_t now;
+    // silently ignore error: cannot report error to the caller
+    (void)PyTime_MonotonicRaw(&now);
+    uint64_t ns = now > start ? (uint64_t)(now - start) : 0;
+
+    table->busy = 1;
+    _PyLockContentionSite *site = table_get(table, lock, THREAD_MAX_SLOTS);
+    if (site == NULL) {
+        table->dropped++;
+        table->busy = 0;
+        return;
+    }
+    if (kind > site->kind) {
+        site->kind = kind;
+    }
+    if (obj != NULL && site->type == NULL) {
+        site->type = (PyTypeObject *)Py_NewRef(Py_TYPE(obj));
+    }
+    site->count++;
+    site->total_ns += ns;
+    if (ns > site->max_ns) {
+        site->max_ns = ns;
+    }
+    site->histogram[histogram_bucket(ns)]++;
+    if (site->waiter[0].code == NULL) {
+        capture_stack(tstate, site->waiter);
+    }
+    table->busy = 0;
+}
+
+void
+_PyLockContention_RecordHolder(PyThreadState *tstate,
+                               _PyLockContentionKind kind, const void *lock)
+{
+    _PyLockContentionTable *table = _PyLockContention_GET(tstate);
+    if (table == NULL || table->busy) {
+        return;
+    }
+    table->busy = 1;
+    _PyLockContentionSite *site = table_get(table, lock, THREAD_MAX_SLOTS);
+    if (site != NULL) {
+        if (kind > site->kind) {
+            site->kind = kind;
+        }
+        if (site->holder[0].code == NULL) {
+            capture_stack(tstate, site->holder);
+        }
+    }
+    table->busy = 0;
+}
+
+
+/* Thread and interpreter life cycle */
+
+static void
+merge_retired(PyInterpreterState *interp, _PyLockContentionTable *table)
+{
+    struct _lock_contention_state *state = &interp->lock_contention;
+    // Don't detach: the world cannot be stopped while the mutex is held.
+    PyMutex_LockFlags(&state->mutex, _Py_LOCK_DONT_DETACH);
+    table_merge(&state->retired, table, 1, RETIRED_MAX_SLOTS);
+    PyMutex_Unlock(&state->mutex);
+}
+
+void
+_PyLockContention_ClearThread(PyThreadState *tstate)
+{
+    _PyThreadStateImpl *impl = (_PyThreadStateImpl *)tstate;
+    _PyLockContentionTable *table = impl->lock_contention;
+    if (table == NULL) {
+        return;
+    }
+    impl->lock_contention = NULL;
+    merge_retired(tstate->interp, table);
+    // Release the references which were not moved
+    table->next = NULL;
+    table_free_list(table);
+}
+
+void
+_PyLockContention_Fini(PyInterpreterState *interp)
+{
+    interp->lock_contention.enabled = 0;
+    table_clear(&interp->lock_contention.retired);
+}
+
+
+/* Control */
+
+int
+_PyLockContention_Enable(PyInterpreterState *interp)
+{
+    _PyRuntimeState *runtime = interp->runtime;
+
+    // Allocate the tables before stopping the world: the memory allocator
+    // must not be called with HEAD_LOCK held.
+    Py_ssize_t nthreads = 0;
+    HEAD_LOCK(runtime);
+    if (interp->lock_contention.enabled) {
+        HEAD_UNLOCK(runtime);
+        return 0;
+    }
+    for (PyThreadState *t = interp->threads.head; t != NULL; t = t->next) {
+        nthreads++;
+    }
+    HEAD_UNLOCK(runtime);
+
+    _PyLockContentionTable *pool = NULL;
+    for (Py_ssize_t i = 0; i < nthreads; i++) {
+        _PyLockContentionTable *table = PyMem_RawCalloc(1, sizeof(*table));
+        if (table == NULL) {
+            table_free_list(pool);
+            PyErr_NoMemory();
+            return -1;
+        }
+        table->next = pool;
+        pool = table;
+    }
+
+    _PyEval_StopTheWorld(interp);
+    HEAD_LOCK(runtime);
+    if (!interp->lock_contention.enabled) {
+        // Threads started in the meantime already have their table if
+        // profiling got enabled, otherwise they are left out.  Threads which
+        // are being deleted are left out too.
+        for (PyThreadState *t = interp->threads.head;
+             t != NULL && pool != NULL; t = t->next)
+        {
+            _PyThreadStateImpl *impl = (_PyThreadStateImpl *)t;
+            if (impl->lock_contention == NULL && !t->_status.finalizing) {
+                impl->lock_contention = pool;
+                pool = pool->next;
+                impl->lock_contention->next = NULL;
+            }
+        }
+        _Py_atomic_store_int_relaxed(&interp->lock_contention.enabled, 1);
+    }
+    HEAD_UNLOCK(runtime);
+    _PyEval_StartTheWorld(interp);
+
+    table_free_list(pool);
+    return 0;
+}
+
+/* Take the tables of all threads, and turn profiling off. */
+static _PyLockContentionTable *
+detach_tables(PyInterpreterState *interp)
+{
+    _PyRuntimeState *runtime = interp->runtime;
+    _PyLockContentionTable *detached = NULL;
+
+    _PyEval_StopTheWorld(interp);
+    HEAD_LOCK(runtime);
+    for (PyThreadState *t = interp->threads.head; t != NULL; t = t->next) {
+        _PyThreadStateImpl *impl = (_PyThreadStateImpl *)t;
+        _PyLockContentionTable *table = impl->lock_contention;
+        if (table != NULL) {
+            impl->lock_contention = NULL;
+            table->next = detached;
+            detached = table;
+        }
+    }
+    _Py_atomic_store_int_relaxed(&interp->lock_contention.enabled, 0);
+    HEAD_UNLOCK(runtime);
+    _PyEval_StartTheWorld(interp);
+    return detached;
+}
+
+void
+_PyLockContention_Disable(PyInterpreterState *interp)
+{
+    _PyLockContentionTable *detached = detach_tables(interp);
+    for (_PyLockContentionTable *t = detached; t != NULL; t = t->next) {
+        merge_retired(interp, t);
+    }
+    table_free_list(detached);
+}
+
+int
+_PyLockContention_Clear(PyInterpreterState *interp)
+{
+    struct _lock_contention_state *state = &interp->lock_contention;
+    int enabled = _Py_atomic_load_int_relaxed(&state->enabled);
+    table_free_list(detach_tables(interp));
+
+    _PyLockContentionTable retired = {0};
+    PyMutex_LockFlags(&state->mutex, _Py_LOCK_DONT_DETACH);
+    retired = state->retired;
+    memset(&state->retired, 0, sizeof(state->retired));
+    PyMutex_Unlock(&state->mutex);
+    table_clear(&retired);
+
+    if (enabled) {
+        return _PyLockContention_Enable(interp);
+    }
+    return 0;
+}
+
+
+/* Reading */
+
+/* Sum the sites of all threads into 'total', which must be empty. */
+static int
+collect_sites(PyInterpreterState *interp, _PyLockContentionTable *total)
+{
+    _PyRuntimeState *runtime = interp->runtime;
+    struct _lock_contention_state *state = &interp->lock_contention;
+
+    _PyEval_StopTheWorld(interp);
+    Py_ssize_t n = 0;
+    HEAD_LOCK(runtime);
+    for (PyThreadState *t = interp->threads.head; t != NULL; t = t->next) {
+        _PyLockContentionTable *table = _PyLockContention_GET(t);
+        if (table != NULL) {
+            n += table->size;
+        }
+    }
+    HEAD_UNLOCK(runtime);
+    PyMutex_LockFlags(&state->mutex, _Py_LOCK_DONT_DETACH);
+    n += state->retired.size;
+
+    // The tables don't change while the world is stopped, so 'total'
+    // doesn't need to grow below.
+    int res = table_reserve(total, n);
+    if (res == 0) {
+        Py_ssize_t max_slots = total->mask + 1;
+        table_merge(total, &state->retired, 0, max_slots);
+        HEAD_LOCK(runtime);
+        for (PyThreadState *t = interp->threads.head; t != NULL; t = t->next) {
+            _PyLockContentionTable *table = _PyLockContention_GET(t);
+            if (table != NULL) {
+                table_merge(total, table, 0, max_slots);
+            }
+        }
+        HEAD_UNLOCK(runtime);
+    }
+    PyMutex_Unlock(&state->mutex);
+    _PyEval_StartTheWorld(interp);
+
+    if (res < 0) {
+        PyErr_NoMemory();
+    }
+    return res;
+}
+
+static PyObject *
+frames_as_list(const _PyLockContentionFrame *frames)
+{
+    PyObject *list = PyList_New(0);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < _Py_LOCK_CONTENTION_DEPTH; i++) {
+        PyCodeObject *code = frames[i].code;
+        if (code == NULL) {
+            break;
+        }
+        PyObject *frame = Py_BuildValue("(OiO)", code->co_filename,
+                                        frames[i].lineno, code->co_qualname);
+        if (frame == NULL || PyList_Append(list, frame) < 0) {
+            Py_XDECREF(frame);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(frame);
+    }
+    return list;
+}
+
+static PyObject *
+site_as_dict(const _PyLockContentionSite *site)
+{
+    PyObject *histogram = PyTuple_New(_Py_LOCK_CONTENTION_BUCKETS);
+    if (histogram == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < _Py_LOCK_CONTENTION_BUCKETS; i++) {
+        PyObject *count = PyLong_FromUnsignedLongLong(site->histogram[i]);
+        if (count == NULL) {
+            Py_DECREF(histogram);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(histogram, i, count);
+    }
+    PyObject *waiter = frames_as_list(site->waiter);
+    PyObject *holder = frames_as_list(site->holder);
+    PyObject *dict = NULL;
+    if (waiter != NULL && holder != NULL) {
+        dict = Py_BuildValue(
+            "{sssNsOsKsKsKsOsOsO}",
+            "kind", kind_names[site->kind],
+            "lock", PyLong_FromVoidPtr((void *)site->lock),
+            "type", site->type != NULL ? (PyObject *)site->type : Py_None,
+            "count", (unsigned long long)site->count,
+            "total_ns", (unsigned long long)site->total_ns,
+            "max_ns", (unsigned long long)site->max_ns,
+            "histogram", histogram,
+            "waiter", waiter,
+            "holder", holder);
+    }
+    Py_DECREF(histogram);
+    Py_XDECREF(waiter);
+    Py_XDECREF(holder);
+    return dict;
+}
+
+static int
+compare_sites(const void *a, const void *b)
+{
+    const _PyLockContentionSite *x = *(const _PyLockContentionSite **)a;
+    const _PyLockContentionSite *y = *(const _PyLockContentionSite **)b;
+    if (x->total_ns != y->total_ns) {
+        return x->total_ns < y->total_ns ? 1 : -1;
+    }
+    return (x->count < y->count) - (x->count > y->count);
+}
+
+PyObject *
+_PyLockContention_AsDict(PyInterpreterState *interp)
+{
+    _PyLockContentionTable total = {0};
+    if (collect_sites(interp, &total) < 0) {
+        return NULL;
+    }
+
+    PyObject *result = NULL;
+    PyObject *sites = NULL;
+    _PyLockContentionSite **sorted = PyMem_Malloc(
+        (total.size ? total.size : 1) * sizeof(*sorted));
+    if (sorted == NULL) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    Py_ssize_t n = 0;
+    for (Py_ssize_t i = 0; i <= total.mask; i++) {
+        if (total.sites[i].lock != NULL) {
+            sorted[n++] = &total.sites[i];
+        }
+    }
+    qsort(sorted, n, sizeof(*sorted), compare_sites);
+
+    sites = PyList_New(n);
+    if (sites == NULL) {
+        goto done;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *site = site_as_dict(sorted[i]);
+        if (site == NULL) {
+            goto done;
+        }
+        PyList_SET_ITEM(sites, i, site);
+    }
+    result = Py_BuildValue("{sOsK}", "sites", sites,
+                           "dropped", (unsigned long long)total.dropped);
+
+done:
+    PyMem_Free(sorted);
+    Py_XDECREF(sites);
+    table_clear(&total);
+    return result;
+}
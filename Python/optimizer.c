@@ -202,6 +202,9 @@ _PyOptimizer_Optimize(
     }
     (*executor_ptr)->vm_data.chain_depth = chain_depth;
     assert((*executor_ptr)->vm_data.valid);
+#ifdef _Py_JIT
+    _PyJIT_RegisterWithPerf(*executor_ptr, code);
+#endif
     return 1;
 }
 
@@ -1238,6 +1241,7 @@ uop_optimize(
     _Py_BloomFilter_Init(&dependencies);
     _PyUOpInstruction buffer[UOP_MAX_TRACE_LENGTH];
     OPT_STAT_INC(attempts);
+    _Py_EXEC_OPT_STAT_INC(_PyThreadState_GET(), optimization_attempts);
     int length = translate_bytecode_to_trace(frame, instr, buffer, UOP_MAX_TRACE_LENGTH, &dependencies, progress_needed);
     if (length <= 0) {
         // Error or nothing translated
@@ -1245,6 +1249,7 @@ uop_optimize(
     }
     assert(length < UOP_MAX_TRACE_LENGTH);
     OPT_STAT_INC(traces_created);
+    _Py_EXEC_OPT_STAT_INC(_PyThreadState_GET(), executors_created);
     char *env_var = Py_GETENV("PYTHON_UOPS_OPTIMIZE");
     if (env_var == NULL || *env_var == '\0' || *env_var > '0') {
         length = _Py_uop_analyze_and_optimize(frame, buffer,
@@ -1630,6 +1635,7 @@ _Py_Executors_InvalidateDependency(PyInterpreterState *interp, void *obj, int is
         executor_clear(exec);
         if (is_invalidation) {
             OPT_STAT_INC(executors_invalidated);
+            _Py_EXEC_OPT_STAT_INC(_PyThreadState_GET(), executors_invalidated);
         }
     }
     Py_DECREF(invalidate);
@@ -1657,6 +1663,7 @@ _Py_Executors_InvalidateAll(PyInterpreterState *interp, int is_invalidation)
         }
         if (is_invalidation) {
             OPT_STAT_INC(executors_invalidated);
+            _Py_EXEC_OPT_STAT_INC(_PyThreadState_GET(), executors_invalidated);
         }
     }
 }
@@ -9,6 +9,9 @@
 #include "pycore_time.h"          // _PyTime_Add()
 
 #include <stdbool.h>
+#ifdef _Py_USE_FUTEX
+#  include <linux/futex.h>        // FUTEX_WAIT_PRIVATE
+#endif
 
 
 typedef struct {
@@ -63,6 +66,8 @@ _PySemaphore_Init(_PySemaphore *sema)
     if (!sema->platform_sem) {
         Py_FatalError("parking_lot: CreateSemaphore failed");
     }
+#elif defined(_Py_USE_FUTEX)
+    sema->counter = 0;
 #elif defined(_Py_USE_SEMAPHORES)
     if (sem_init(&sema->platform_sem, /*pshared=*/0, /*value=*/0) < 0) {
         Py_FatalError("parking_lot: sem_init failed");
@@ -83,6 +88,8 @@ _PySemaphore_Destroy(_PySemaphore *sema)
 {
 #if defined(MS_WINDOWS)
     CloseHandle(sema->platform_sem);
+#elif defined(_Py_USE_FUTEX)
+    // nothing to release
 #elif defined(_Py_USE_SEMAPHORES)
     sem_destroy(&sema->platform_sem);
 #else
@@ -114,6 +121,55 @@ _PySemaphore_PlatformWait(_PySemaphore *sema, PyTime_t timeout)
     else {
         res = Py_PARK_INTR;
     }
+#elif defined(_Py_USE_FUTEX)
+    PyTime_t deadline = 0;
+    if (timeout > 0) {
+        PyTime_t now;
+        // silently ignore error: cannot report error to the caller
+        (void)PyTime_MonotonicRaw(&now);
+        deadline = _PyTime_Add(now, timeout);
+    }
+    for (;;) {
+        uint32_t counter = _Py_atomic_load_uint32(&sema->counter);
+        if (counter > 0) {
+            if (_Py_atomic_compare_exchange_uint32(&sema->counter, &counter,
+                                                   counter - 1)) {
+                res = Py_PARK_OK;
+                break;
+            }
+            continue;
+        }
+        if (timeout == 0) {
+            res = Py_PARK_TIMEOUT;
+            break;
+        }
+        // The timeout of FUTEX_WAIT is relative and uses CLOCK_MONOTONIC.
+        struct timespec ts, *pts = NULL;
+        if (timeout > 0) {
+            _PyTime_AsTimespec_clamp(timeout, &ts);
+            pts = &ts;
+        }
+        if (syscall(SYS_futex, &sema->counter, FUTEX_WAIT_PRIVATE, 0,
+                    pts, NULL, 0) < 0) {
+            int err = errno;
+            if (err == EINTR) {
+                res = Py_PARK_INTR;
+                break;
+            }
+            else if (err != EAGAIN && err != ETIMEDOUT) {
+                _Py_FatalErrorFormat(__func__,
+                    "unexpected error from futex: %d",
+                    err);
+            }
+        }
+        if (timeout > 0) {
+            // Woken up spuriously or timed out: check the counter again.
+            timeout = _PyDeadline_Get(deadline);
+            if (timeout < 0) {
+                timeout = 0;
+            }
+        }
+    }
 #elif defined(_Py_USE_SEMAPHORES)
     int err;
     if (timeout >= 0) {
@@ -224,6 +280,9 @@ _PySemaphore_Wakeup(_PySemaphore *sema)
     if (!ReleaseSemaphore(sema->platform_sem, 1, NULL)) {
         Py_FatalError("parking_lot: ReleaseSemaphore failed");
     }
+#elif defined(_Py_USE_FUTEX)
+    _Py_atomic_add_uint32(&sema->counter, 1);
+    syscall(SYS_futex, &sema->counter, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
 #elif defined(_Py_USE_SEMAPHORES)
     int err = sem_post(&sema->platform_sem);
     if (err != 0) {
@@ -162,6 +162,19 @@ typedef struct {
     uint64_t mapped_size;
 } CodeUnwindingInfoEvent;
 
+typedef struct {
+    struct BaseEvent base;
+    uint64_t code_address;
+    uint64_t nr_entry;
+} DebugInfoEvent;
+
+// Followed by the null-terminated source file name
+typedef struct {
+    uint64_t code_address;
+    int32_t line;
+    int32_t discriminator;
+} DebugEntry;
+
 static const intptr_t nanoseconds_per_second = 1000000000;
 
 // Dwarf encoding constants
@@ -303,6 +316,7 @@ static void* perf_map_jit_init(void) {
 enum {
     DWRF_CFA_nop = 0x0,
     DWRF_CFA_offset_extended = 0x5,
+    DWRF_CFA_same_value = 0x8,
     DWRF_CFA_def_cfa = 0xc,
     DWRF_CFA_def_cfa_offset = 0xe,
     DWRF_CFA_offset_extended_sf = 0x11,
@@ -382,6 +396,7 @@ typedef struct ELFObjectContext
     uint8_t* startp; /* Pointer to start address in obj.space. */
     uint8_t* eh_frame_p; /* Pointer to start address in obj.space. */
     uint32_t code_size; /* Size of machine code. */
+    int frameless; /* Machine code keeps the CFA of its entry point. */
 } ELFObjectContext;
 
 /* Append a null-terminated string. */
@@ -465,6 +480,26 @@ elf_init_ehframe(ELFObjectContext* ctx)
 
     ctx->eh_frame_p = p;
 
+    if (ctx->frameless) {
+        /* Emit DWARF EH FDE for JIT executors. Their code is made of stencils
+           which tail-call each other, and is compiled without unwind tables:
+           describe the state at the stencil boundaries, where the return
+           address into the interpreter is the same as at the entry point. */
+        DWRF_SECTION(FDE, DWRF_U32((uint32_t)(p - framep)); /* Offset to CIE. */
+                     /* Machine code offset relative to .text. */
+                     DWRF_U32(-(int32_t)(round_up(ctx->code_size, 8) + (p - framep)));
+                     DWRF_U32(ctx->code_size); /* Machine code length. */
+                     DWRF_U8(0); /* Augmentation data. */
+#if defined(__aarch64__) && defined(__AARCH64EL__) && !defined(__ILP32__)
+                     /* The return address is in the link register. */
+                     DWRF_U8(DWRF_CFA_def_cfa_offset); DWRF_UV(0);
+                     DWRF_U8(DWRF_CFA_same_value); DWRF_UV(DWRF_REG_RA);
+#endif
+                     DWRF_ALIGNNOP(sizeof(uintptr_t));)
+        ctx->p = p;
+        return;
+    }
+
     /* Emit DWARF EH FDE. */
     DWRF_SECTION(FDE, DWRF_U32((uint32_t)(p - framep)); /* Offset to CIE. */
                  DWRF_U32(-0x30); /* Machine code offset relative to .text. */
@@ -495,17 +530,9 @@ elf_init_ehframe(ELFObjectContext* ctx)
     ctx->p = p;
 }
 
-static void perf_map_jit_write_entry(void *state, const void *code_addr,
-                         unsigned int code_size, PyCodeObject *co)
+static char *
+perf_map_jit_entry_name(const char *prefix, PyCodeObject *co)
 {
-
-    if (perf_jit_map_state.perf_map == NULL) {
-        void* ret = perf_map_jit_init();
-        if(ret == NULL){
-            return;
-        }
-    }
-
     const char *entry = "";
     if (co->co_qualname != NULL) {
         entry = PyUnicode_AsUTF8(co->co_qualname);
@@ -515,14 +542,19 @@ static void perf_map_jit_write_entry(void *state, const void *code_addr,
         filename = PyUnicode_AsUTF8(co->co_filename);
     }
 
-
-    size_t perf_map_entry_size = snprintf(NULL, 0, "py::%s:%s", entry, filename) + 1;
+    size_t perf_map_entry_size = snprintf(NULL, 0, "%s%s:%s", prefix, entry, filename) + 1;
     char* perf_map_entry = (char*) PyMem_RawMalloc(perf_map_entry_size);
     if (perf_map_entry == NULL) {
-        return;
+        return NULL;
     }
-    snprintf(perf_map_entry, perf_map_entry_size, "py::%s:%s", entry, filename);
+    snprintf(perf_map_entry, perf_map_entry_size, "%s%s:%s", prefix, entry, filename);
+    return perf_map_entry;
+}
 
+static void
+perf_map_jit_write_code(const void *code_addr, unsigned int code_size,
+                        const char *perf_map_entry, int frameless)
+{
     const size_t name_length = strlen(perf_map_entry);
     uword base = (uword)code_addr;
     uword size = code_size;
@@ -533,6 +565,7 @@ static void perf_map_jit_write_entry(void *state, const void *code_addr,
     ELFObjectContext ctx;
     char buffer[1024];
     ctx.code_size = code_size;
+    ctx.frameless = frameless;
     ctx.startp = ctx.p = (uint8_t*)buffer;
     elf_init_ehframe(&ctx);
     int eh_frame_size = ctx.p - ctx.startp;
@@ -586,7 +619,85 @@ static void perf_map_jit_write_entry(void *state, const void *code_addr,
     perf_map_jit_write_fully(&ev, sizeof(ev));
     perf_map_jit_write_fully(perf_map_entry, name_length+1);
     perf_map_jit_write_fully((void*)(base), size);
-    return;
+}
+
+static void perf_map_jit_write_entry(void *state, const void *code_addr,
+                         unsigned int code_size, PyCodeObject *co)
+{
+
+    if (perf_jit_map_state.perf_map == NULL) {
+        void* ret = perf_map_jit_init();
+        if(ret == NULL){
+            return;
+        }
+    }
+
+    char *perf_map_entry = perf_map_jit_entry_name("py::", co);
+    if (perf_map_entry == NULL) {
+        return;
+    }
+    perf_map_jit_write_code(code_addr, code_size, perf_map_entry, 0);
+    PyMem_RawFree(perf_map_entry);
+}
+
+static const char *
+perf_map_jit_filename(PyCodeObject *co)
+{
+    const char *filename = NULL;
+    if (co != NULL && co->co_filename != NULL) {
+        filename = PyUnicode_AsUTF8(co->co_filename);
+        if (filename == NULL) {
+            PyErr_Clear();
+        }
+    }
+    return filename != NULL ? filename : "";
+}
+
+static void
+perf_map_jit_write_jit_code(void *state, const void *code_addr,
+                            unsigned int code_size, PyCodeObject *co,
+                            const _PyPerf_JitLineEntry *lines,
+                            Py_ssize_t nlines)
+{
+    if (perf_jit_map_state.perf_map == NULL) {
+        void* ret = perf_map_jit_init();
+        if(ret == NULL){
+            return;
+        }
+    }
+
+    char *perf_map_entry = perf_map_jit_entry_name("py::jit::", co);
+    if (perf_map_entry == NULL) {
+        return;
+    }
+
+    // The debug info event must precede the code load event it applies to.
+    if (nlines > 0) {
+        DebugInfoEvent ev;
+        size_t size = sizeof(ev);
+        for (Py_ssize_t i = 0; i < nlines; i++) {
+            size += sizeof(DebugEntry);
+            size += strlen(perf_map_jit_filename(lines[i].code)) + 1;
+        }
+        ev.base.event = PerfDebugInfo;
+        ev.base.size = size;
+        ev.base.time_stamp = get_current_monotonic_ticks();
+        ev.code_address = (uword)code_addr;
+        ev.nr_entry = nlines;
+        perf_map_jit_write_fully(&ev, sizeof(ev));
+        for (Py_ssize_t i = 0; i < nlines; i++) {
+            const char *filename = perf_map_jit_filename(lines[i].code);
+            DebugEntry entry;
+            entry.code_address = (uword)lines[i].code_addr;
+            entry.line = lines[i].lineno;
+            entry.discriminator = 0;
+            perf_map_jit_write_fully(&entry, sizeof(entry));
+            perf_map_jit_write_fully(filename, strlen(filename) + 1);
+        }
+    }
+
+    perf_map_jit_write_code(code_addr, code_size, perf_map_entry, 1);
+    PyMem_RawFree(perf_map_entry);
 }
 
 static int perf_map_jit_fini(void* state) {
@@ -611,6 +722,7 @@ _PyPerf_Callbacks _Py_perfmap_jit_callbacks = {
     &perf_map_jit_init,
     &perf_map_jit_write_entry,
     &perf_map_jit_fini,
+    &perf_map_jit_write_jit_code,
 };
 
 #endif
@@ -225,6 +225,31 @@ perf_map_write_entry(void *state, const void *code_addr,
     PyMem_RawFree(perf_map_entry);
 }
 
+static void
+perf_map_write_jit_code(void *state, const void *code_addr,
+                        unsigned int code_size, PyCodeObject *co,
+                        const _PyPerf_JitLineEntry *lines, Py_ssize_t nlines)
+{
+    // The perf map format has no line tables: the whole executor is
+    // reported as a single symbol, named after the code it starts in.
+    const char *entry = "";
+    if (co->co_qualname != NULL) {
+        entry = PyUnicode_AsUTF8(co->co_qualname);
+    }
+    const char *filename = "";
+    if (co->co_filename != NULL) {
+        filename = PyUnicode_AsUTF8(co->co_filename);
+    }
+    size_t perf_map_entry_size = snprintf(NULL, 0, "py::jit::%s:%s", entry, filename) + 1;
+    char* perf_map_entry = (char*) PyMem_RawMalloc(perf_map_entry_size);
+    if (perf_map_entry == NULL) {
+        return;
+    }
+    snprintf(perf_map_entry, perf_map_entry_size, "py::jit::%s:%s", entry, filename);
+    PyUnstable_WritePerfMapEntry(code_addr, code_size, perf_map_entry);
+    PyMem_RawFree(perf_map_entry);
+}
+
 static void*
 perf_map_init_state(void)
 {
@@ -245,6 +270,7 @@ _PyPerf_Callbacks _Py_perfmap_callbacks = {
     &perf_map_init_state,
     &perf_map_write_entry,
     &perf_map_free_state,
+    &perf_map_write_jit_code,
 };
 
 
@@ -449,6 +475,7 @@ _PyPerfTrampoline_GetCallbacks(_PyPerf_Callbacks *callbacks)
     callbacks->init_state = trampoline_api.init_state;
     callbacks->write_state = trampoline_api.write_state;
     callbacks->free_state = trampoline_api.free_state;
+    callbacks->write_jit_code = trampoline_api.write_jit_code;
 #endif
     return;
 }
@@ -466,6 +493,7 @@ _PyPerfTrampoline_SetCallbacks(_PyPerf_Callbacks *callbacks)
     trampoline_api.init_state = callbacks->init_state;
     trampoline_api.write_state = callbacks->write_state;
     trampoline_api.free_state = callbacks->free_state;
+    trampoline_api.write_jit_code = callbacks->write_jit_code;
     trampoline_api.state = NULL;
 #endif
     return 0;
@@ -526,6 +554,31 @@ _PyPerfTrampoline_Fini(void)
     return 0;
 }
 
+int
+_PyPerfTrampoline_IsTrackingJitCode(void)
+{
+#ifdef PY_HAVE_PERF_TRAMPOLINE
+    return (perf_status == PERF_STATUS_OK &&
+            trampoline_api.write_jit_code != NULL);
+#endif
+    return 0;
+}
+
+void
+_PyPerfTrampoline_WriteJitCode(const void *code_addr, unsigned int code_size,
+                               PyCodeObject *co,
+                               const _PyPerf_JitLineEntry *lines,
+                               Py_ssize_t nlines)
+{
+#ifdef PY_HAVE_PERF_TRAMPOLINE
+    if (_PyPerfTrampoline_IsTrackingJitCode()) {
+        trampoline_api.write_jit_code(trampoline_api.state, code_addr,
+                                      code_size, co, lines, nlines);
+    }
+#endif
+    return;
+}
+
 void _PyPerfTrampoline_FreeArenas(void) {
 #ifdef PY_HAVE_PERF_TRAMPOLINE
     free_code_arenas();
@@ -813,6 +813,7 @@ interpreter_clear(PyInterpreterState *interp, PyThreadState *tstate)
         // XXX Eliminate the need to do this.
         tstate->_status.cleared = 0;
     }
+    _PyLockContention_Fini(interp);
 
 #ifdef _Py_TIER2
     _PyOptimizerObject *old = _Py_SetOptimizer(interp, NULL);
@@ -1419,6 +1420,10 @@ tstate_is_alive(PyThreadState *tstate)
 
 /* Minimum size of data stack chunk */
 #define DATA_STACK_CHUNK_SIZE (16*1024)
+/* Number of popped chunks kept by each thread for reuse */
+#define DATA_STACK_MAX_SPARE 2
+/* Chunks don't grow beyond this size unless a single frame needs it */
+#define DATA_STACK_MAX_CHUNK_SIZE (DATA_STACK_CHUNK_SIZE << 6)
 
 static _PyStackChunk*
 allocate_chunk(int size_in_bytes, _PyStackChunk* previous)
@@ -1443,6 +1448,9 @@ alloc_threadstate(void)
 static void
 free_threadstate(_PyThreadStateImpl *tstate)
 {
+    PyMem_RawFree(tstate->exec_stats);
+    // Moved to the interpreter by PyThreadState_Clear()
+    assert(tstate->lock_contention == NULL);
     // The initial thread state of the interpreter is allocated
     // as part of the interpreter state so should not be freed.
     if (tstate == &tstate->base.interp->_initial_thread) {
@@ -1510,6 +1518,7 @@ init_threadstate(_PyThreadStateImpl *_tstate,
     tstate->dict_global_version = 0;
 
     _tstate->asyncio_running_loop = NULL;
+    _tstate->asyncio_running_task = NULL;
 
     tstate->delete_later = NULL;
 
@@ -1551,9 +1560,31 @@ new_threadstate(PyInterpreterState *interp, int whence)
     if (new_tstate == NULL) {
         return NULL;
     }
+    // Likewise, allocate the execution stats counters if gathering them
+    // looks enabled.  The flag is checked again with the lock held.
+    _PyExecStats *exec_stats = NULL;
+    if (_Py_atomic_load_int_relaxed(&interp->exec_stats.enabled)) {
+        exec_stats = PyMem_RawCalloc(1, sizeof(_PyExecStats));
+        if (exec_stats == NULL) {
+            PyMem_RawFree(new_tstate);
+            return NULL;
+        }
+    }
+    // And the lock contention table if profiling looks enabled.
+    _PyLockContentionTable *lock_contention = NULL;
+    if (_Py_atomic_load_int_relaxed(&interp->lock_contention.enabled)) {
+        lock_contention = PyMem_RawCalloc(1, sizeof(_PyLockContentionTable));
+        if (lock_contention == NULL) {
+            PyMem_RawFree(exec_stats);
+            PyMem_RawFree(new_tstate);
+            return NULL;
+        }
+    }
 #ifdef Py_GIL_DISABLED
     Py_ssize_t qsbr_idx = _Py_qsbr_reserve(interp);
     if (qsbr_idx < 0) {
+        PyMem_RawFree(lock_contention);
+        PyMem_RawFree(exec_stats);
         PyMem_RawFree(new_tstate);
         return NULL;
     }
@@ -1586,9 +1617,21 @@ new_threadstate(PyInterpreterState *interp, int whence)
     }
 
     init_threadstate(tstate, interp, id, whence);
+    if (interp->exec_stats.enabled) {
+        tstate->exec_stats = exec_stats;
+        exec_stats = NULL;
+    }
+    if (interp->lock_contention.enabled) {
+        tstate->lock_contention = lock_contention;
+        lock_contention = NULL;
+    }
     add_threadstate(interp, (PyThreadState *)tstate, old_head);
 
     HEAD_UNLOCK(runtime);
+    // Not NULL if gathering was turned off while we were waiting for the
+    // lock.  If it was turned on instead, this thread is not counted.
+    PyMem_RawFree(exec_stats);
+    PyMem_RawFree(lock_contention);
     if (!used_newtstate) {
         // Must be called with lock unlocked to avoid re-entrancy deadlock.
         PyMem_RawFree(new_tstate);
@@ -1649,10 +1692,8 @@ _PyThreadState_Init(PyThreadState *tstate)
 
 
 static void
-clear_datastack(PyThreadState *tstate)
+free_chunks(_PyStackChunk *chunk)
 {
-    _PyStackChunk *chunk = tstate->datastack_chunk;
-    tstate->datastack_chunk = NULL;
     while (chunk != NULL) {
         _PyStackChunk *prev = chunk->previous;
         _PyObject_VirtualFree(chunk, chunk->size);
@@ -1660,6 +1701,17 @@ clear_datastack(PyThreadState *tstate)
     }
 }
 
+static void
+clear_datastack(PyThreadState *tstate)
+{
+    _PyThreadStateImpl *impl = (_PyThreadStateImpl *)tstate;
+    free_chunks(tstate->datastack_chunk);
+    tstate->datastack_chunk = NULL;
+    free_chunks(impl->datastack.spare);
+    impl->datastack.spare = NULL;
+    impl->datastack.nspare = 0;
+}
+
 void
 PyThreadState_Clear(PyThreadState *tstate)
 {
@@ -1709,6 +1761,7 @@ PyThreadState_Clear(PyThreadState *tstate)
     Py_CLEAR(tstate->threading_local_sentinel);
 
     Py_CLEAR(((_PyThreadStateImpl *)tstate)->asyncio_running_loop);
+    Py_CLEAR(((_PyThreadStateImpl *)tstate)->asyncio_running_task);
 
     Py_CLEAR(tstate->dict);
     Py_CLEAR(tstate->async_exc);
@@ -1739,6 +1792,9 @@ PyThreadState_Clear(PyThreadState *tstate)
 
     Py_CLEAR(tstate->context);
 
+    // Merge our lock contention profile into the interpreter's.
+    _PyLockContention_ClearThread(tstate);
+
 #ifdef Py_GIL_DISABLED
     // Each thread should clear own freelists in free-threading builds.
     struct _Py_freelists *freelists = _Py_freelists_GET();
@@ -1809,6 +1865,9 @@ tstate_delete_common(PyThreadState *tstate, int release_gil)
     assert(tstate_impl->refcounts.values == NULL);
 #endif
 
+    // Add our execution stats to the interpreter's totals.
+    _PyExecStats_MergeThread(interp, ((_PyThreadStateImpl *)tstate)->exec_stats);
+
     HEAD_UNLOCK(runtime);
 
     // XXX Unbind in PyThreadState_Clear(), or earlier
@@ -2121,6 +2180,14 @@ _PyThreadState_Attach(PyThreadState *tstate)
         _PyCriticalSection_Resume(tstate);
     }
 
+    _PyThreadStateImpl *impl = (_PyThreadStateImpl *)tstate;
+    if (impl->gil_wait_start != 0) {
+        _PyLockContention_RecordWait(tstate, _Py_LOCK_CONTENTION_GIL,
+                                     tstate->interp->ceval.gil, NULL,
+                                     impl->gil_wait_start);
+        impl->gil_wait_start = 0;
+    }
+
 #if defined(Py_DEBUG)
     errno = err;
 #endif
@@ -2920,6 +2987,62 @@ _PyInterpreterState_HasFeature(PyInterpreterState *interp, unsigned long feature
 
 #define MINIMUM_OVERHEAD 1000
 
+/* Return a chunk of at least 'size' bytes, preferably one of the spare
+   chunks.  Chunks are at least datastack.max_size bytes, which grows when the
+   stack of the thread oscillates over more chunks than can be kept, so that a
+   recursion which repeatedly goes deep ends up allocating nothing.  A spare
+   which is too small is freed. */
+static _PyStackChunk *
+get_chunk(PyThreadState *tstate, int size)
+{
+    _PyThreadStateImpl *impl = (_PyThreadStateImpl *)tstate;
+    if (size < impl->datastack.max_size) {
+        size = impl->datastack.max_size;
+    }
+    _PyStackChunk *chunk = impl->datastack.spare;
+    if (chunk != NULL) {
+        impl->datastack.spare = chunk->previous;
+        impl->datastack.nspare--;
+        if ((int)chunk->size >= size) {
+            impl->datastack.reused++;
+            chunk->previous = tstate->datastack_chunk;
+            chunk->top = 0;
+            return chunk;
+        }
+        impl->datastack.freed++;
+        _PyObject_VirtualFree(chunk, chunk->size);
+    }
+    chunk = allocate_chunk(size, tstate->datastack_chunk);
+    if (chunk == NULL) {
+        return NULL;
+    }
+    impl->datastack.allocated++;
+    if (size > impl->datastack.max_size) {
+        impl->datastack.max_size = size;
+    }
+    return chunk;
+}
+
+/* Keep a popped chunk for reuse, or free it if there are enough spares. */
+static void
+release_chunk(PyThreadState *tstate, _PyStackChunk *chunk)
+{
+    _PyThreadStateImpl *impl = (_PyThreadStateImpl *)tstate;
+    if (impl->datastack.nspare < DATA_STACK_MAX_SPARE) {
+        chunk->previous = impl->datastack.spare;
+        impl->datastack.spare = chunk;
+        impl->datastack.nspare++;
+        return;
+    }
+    impl->datastack.freed++;
+    _PyObject_VirtualFree(chunk, chunk->size);
+    // The stack is deeper than the chunks which can be kept: use larger
+    // chunks from now on.
+    if (impl->datastack.max_size < DATA_STACK_MAX_CHUNK_SIZE) {
+        impl->datastack.max_size *= 2;
+    }
+}
+
 static PyObject **
 push_chunk(PyThreadState *tstate, int size)
 {
@@ -2927,7 +3050,7 @@ push_chunk(PyThreadState *tstate, int size)
     while (allocate_size < (int)sizeof(PyObject*)*(size + MINIMUM_OVERHEAD)) {
         allocate_size *= 2;
     }
-    _PyStackChunk *new = allocate_chunk(allocate_size, tstate->datastack_chunk);
+    _PyStackChunk *new = get_chunk(tstate, allocate_size);
     if (new == NULL) {
         return NULL;
     }
@@ -2936,7 +3059,7 @@ push_chunk(PyThreadState *tstate, int size)
                                        &tstate->datastack_chunk->data[0];
     }
     tstate->datastack_chunk = new;
-    tstate->datastack_limit = (PyObject **)(((char *)new) + allocate_size);
+    tstate->datastack_limit = (PyObject **)(((char *)new) + new->size);
     // When new is the "root" chunk (i.e. new->previous == NULL), we can keep
     // _PyThreadState_PopFrame from freeing it later by "skipping" over the
     // first element:
@@ -2969,7 +3092,7 @@ _PyThreadState_PopFrame(PyThreadState *tstate, _PyInterpreterFrame * frame)
         assert(previous);
         tstate->datastack_top = &previous->data[previous->top];
         tstate->datastack_chunk = previous;
-        _PyObject_VirtualFree(chunk, chunk->size);
+        release_chunk(tstate, chunk);
         tstate->datastack_limit = (PyObject **)(((char *)previous) + previous->size);
     }
     else {
@@ -24,6 +24,53 @@ extern const char *_PyUOpName(int index);
  * ./adaptive.md
  */
 
+/* Open a new file in the directory read by Tools/scripts/summarize_stats.py.
+   Return NULL on failure, without setting an exception. */
+static FILE *
+open_stats_file(void)
+{
+# ifdef MS_WINDOWS
+    const char *dirname = "c:\\temp\\py_stats\\";
+# else
+    const char *dirname = "/tmp/py_stats/";
+# endif
+    /* Use random 160 bit number as file name,
+    * to avoid both accidental collisions and
+    * symlink attacks. */
+    unsigned char rand[20];
+    char hex_name[41];
+    _PyOS_URandomNonblock(rand, 20);
+    for (int i = 0; i < 20; i++) {
+        hex_name[2*i] = Py_hexdigits[rand[i]&15];
+        hex_name[2*i+1] = Py_hexdigits[(rand[i]>>4)&15];
+    }
+    hex_name[40] = '\0';
+    char buf[64];
+    assert(strlen(dirname) + 40 + strlen(".txt") < 64);
+    sprintf(buf, "%s%s.txt", dirname, hex_name);
+    return fopen(buf, "w");
+}
+
+/* Families reported as specializable in the stats */
+static int
+is_specializable_for_stats(int opcode)
+{
+    if (!_PyOpcode_Caches[opcode]) {
+        return 0;
+    }
+    /* Ignore jumps as they cannot be specialized */
+    switch (opcode) {
+        case POP_JUMP_IF_FALSE:
+        case POP_JUMP_IF_TRUE:
+        case POP_JUMP_IF_NONE:
+        case POP_JUMP_IF_NOT_NONE:
+        case JUMP_BACKWARD:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
 #ifdef Py_STATS
 GCStats _py_gc_stats[NUM_GENERATIONS] = { 0 };
 static PyStats _Py_stats_struct = { .gc_stats = _py_gc_stats };
@@ -144,18 +191,8 @@ print_spec_stats(FILE *out, OpcodeStats *stats)
     fprintf(out, "opcode[BINARY_SLICE].specializable : 1\n");
     fprintf(out, "opcode[STORE_SLICE].specializable : 1\n");
     for (int i = 0; i < 256; i++) {
-        if (_PyOpcode_Caches[i]) {
-            /* Ignore jumps as they cannot be specialized */
-            switch (i) {
-                case POP_JUMP_IF_FALSE:
-                case POP_JUMP_IF_TRUE:
-                case POP_JUMP_IF_NONE:
-                case POP_JUMP_IF_NOT_NONE:
-                case JUMP_BACKWARD:
-                    break;
-                default:
-                    fprintf(out, "opcode[%s].specializable : 1\n", _PyOpcode_OpName[i]);
-            }
+        if (is_specializable_for_stats(i)) {
+            fprintf(out, "opcode[%s].specializable : 1\n", _PyOpcode_OpName[i]);
         }
         PRINT_STAT(i, specialization.success);
         PRINT_STAT(i, specialization.failure);
@@ -388,26 +425,7 @@ _Py_PrintSpecializationStats(int to_file)
     FILE *out = stderr;
     if (to_file) {
         /* Write to a file instead of stderr. */
-# ifdef MS_WINDOWS
-        const char *dirname = "c:\\temp\\py_stats\\";
-# else
-        const char *dirname = "/tmp/py_stats/";
-# endif
-        /* Use random 160 bit number as file name,
-        * to avoid both accidental collisions and
-        * symlink attacks. */
-        unsigned char rand[20];
-        char hex_name[41];
-        _PyOS_URandomNonblock(rand, 20);
-        for (int i = 0; i < 20; i++) {
-            hex_name[2*i] = Py_hexdigits[rand[i]&15];
-            hex_name[2*i+1] = Py_hexdigits[(rand[i]>>4)&15];
-        }
-        hex_name[40] = '\0';
-        char buf[64];
-        assert(strlen(dirname) + 40 + strlen(".txt") < 64);
-        sprintf(buf, "%s%s.txt", dirname, hex_name);
-        FILE *fout = fopen(buf, "w");
+        FILE *fout = open_stats_file();
         if (fout) {
             out = fout;
         }
@@ -432,6 +450,284 @@ do { \
 #endif  // Py_STATS
 
 
+/* Execution stats, see pycore_exec_stats.h */
+
+static void
+exec_stats_add(_PyExecStats *total, const _PyExecStats *stats)
+{
+    for (int i = 0; i < 256; i++) {
+        _PyExecSpecializationStats *dst = &total->opcode[i];
+        const _PyExecSpecializationStats *src = &stats->opcode[i];
+        dst->success += src->success;
+        dst->failure += src->failure;
+        dst->hit += src->hit;
+        dst->miss += src->miss;
+        dst->deopt += src->deopt;
+    }
+    total->optimization_attempts += stats->optimization_attempts;
+    total->executors_created += stats->executors_created;
+    total->executors_invalidated += stats->executors_invalidated;
+    total->executor_entries += stats->executor_entries;
+    total->executor_exits += stats->executor_exits;
+}
+
+static void
+exec_stats_zero(_PyExecStats *stats)
+{
+    _PyExecStats *next = stats->next;
+    memset(stats, 0, sizeof(*stats));
+    stats->next = next;
+}
+
+void
+_PyExecStats_MergeThread(PyInterpreterState *interp, _PyExecStats *stats)
+{
+    if (stats != NULL) {
+        exec_stats_add(&interp->exec_stats.retired, stats);
+    }
+}
+
+int
+_PyExecStats_IsEnabled(PyInterpreterState *interp)
+{
+    _PyRuntimeState *runtime = interp->runtime;
+    HEAD_LOCK(runtime);
+    int enabled = interp->exec_stats.enabled;
+    HEAD_UNLOCK(runtime);
+    return enabled;
+}
+
+int
+_PyExecStats_Enable(PyInterpreterState *interp)
+{
+    _PyRuntimeState *runtime = interp->runtime;
+
+    // Allocate the counters before stopping the world: the memory
+    // allocator must not be called with HEAD_LOCK held.
+    Py_ssize_t nthreads = 0;
+    HEAD_LOCK(runtime);
+    if (interp->exec_stats.enabled) {
+        HEAD_UNLOCK(runtime);
+        return 0;
+    }
+    for (PyThreadState *t = interp->threads.head; t != NULL; t = t->next) {
+        nthreads++;
+    }
+    HEAD_UNLOCK(runtime);
+
+    _PyExecStats *pool = NULL;
+    for (Py_ssize_t i = 0; i < nthreads; i++) {
+        _PyExecStats *stats = PyMem_RawCalloc(1, sizeof(_PyExecStats));
+        if (stats == NULL) {
+            while (pool != NULL) {
+                _PyExecStats *next = pool->next;
+                PyMem_RawFree(pool);
+                pool = next;
+            }
+            PyErr_NoMemory();
+            return -1;
+        }
+        stats->next = pool;
+        pool = stats;
+    }
+
+    _PyEval_StopTheWorld(interp);
+    HEAD_LOCK(runtime);
+    if (!interp->exec_stats.enabled) {
+        // Threads started in the meantime already have their counters if
+        // gathering got enabled, otherwise they are left out.
+        for (PyThreadState *t = interp->threads.head;
+             t != NULL && pool != NULL; t = t->next)
+        {
+            _PyThreadStateImpl *impl = (_PyThreadStateImpl *)t;
+            if (impl->exec_stats == NULL) {
+                impl->exec_stats = pool;
+                pool = pool->next;
+                impl->exec_stats->next = NULL;
+            }
+        }
+        _Py_atomic_store_int_relaxed(&interp->exec_stats.enabled, 1);
+    }
+    HEAD_UNLOCK(runtime);
+    _PyEval_StartTheWorld(interp);
+
+    while (pool != NULL) {
+        _PyExecStats *next = pool->next;
+        PyMem_RawFree(pool);
+        pool = next;
+    }
+    return 0;
+}
+
+void
+_PyExecStats_Disable(PyInterpreterState *interp)
+{
+    _PyRuntimeState *runtime = interp->runtime;
+    _PyExecStats *detached = NULL;
+
+    _PyEval_StopTheWorld(interp);
+    HEAD_LOCK(runtime);
+    for (PyThreadState *t = interp->threads.head; t != NULL; t = t->next) {
+        _PyThreadStateImpl *impl = (_PyThreadStateImpl *)t;
+        _PyExecStats *stats = impl->exec_stats;
+        if (stats != NULL) {
+            exec_stats_add(&interp->exec_stats.retired, stats);
+            impl->exec_stats = NULL;
+            stats->next = detached;
+            detached = stats;
+        }
+    }
+    _Py_atomic_store_int_relaxed(&interp->exec_stats.enabled, 0);
+    HEAD_UNLOCK(runtime);
+    _PyEval_StartTheWorld(interp);
+
+    while (detached != NULL) {
+        _PyExecStats *next = detached->next;
+        PyMem_RawFree(detached);
+        detached = next;
+    }
+}
+
+void
+_PyExecStats_Clear(PyInterpreterState *interp)
+{
+    _PyRuntimeState *runtime = interp->runtime;
+
+    _PyEval_StopTheWorld(interp);
+    HEAD_LOCK(runtime);
+    exec_stats_zero(&interp->exec_stats.retired);
+    for (PyThreadState *t = interp->threads.head; t != NULL; t = t->next) {
+        _PyExecStats *stats = ((_PyThreadStateImpl *)t)->exec_stats;
+        if (stats != NULL) {
+            exec_stats_zero(stats);
+        }
+    }
+    HEAD_UNLOCK(runtime);
+    _PyEval_StartTheWorld(interp);
+}
+
+/* Return the sum of the counters of all threads, or NULL on memory error.
+   The result must be released with PyMem_RawFree(). */
+static _PyExecStats *
+exec_stats_collect(PyInterpreterState *interp)
+{
+    _PyRuntimeState *runtime = interp->runtime;
+    _PyExecStats *total = PyMem_RawCalloc(1, sizeof(_PyExecStats));
+    if (total == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    _PyEval_StopTheWorld(interp);
+    HEAD_LOCK(runtime);
+    exec_stats_add(total, &interp->exec_stats.retired);
+    for (PyThreadState *t = interp->threads.head; t != NULL; t = t->next) {
+        _PyExecStats *stats = ((_PyThreadStateImpl *)t)->exec_stats;
+        if (stats != NULL) {
+            exec_stats_add(total, stats);
+        }
+    }
+    HEAD_UNLOCK(runtime);
+    _PyEval_StartTheWorld(interp);
+    return total;
+}
+
+#define EXEC_STATS_OPCODE_FIELDS(V) \
+    V(success) V(failure) V(hit) V(miss) V(deopt)
+
+#define EXEC_STATS_OPTIMIZATION_FIELDS(V) \
+    V("Optimization attempts", optimization_attempts) \
+    V("Optimization traces created", executors_created) \
+    V("Optimization traces entered", executor_entries) \
+    V("Optimization traces exited", executor_exits) \
+    V("Executors invalidated", executors_invalidated)
+
+static int
+exec_stats_set_item(PyObject *dict, const char *key, uint64_t value)
+{
+    PyObject *v = PyLong_FromUnsignedLongLong(value);
+    if (v == NULL) {
+        return -1;
+    }
+    int res = PyDict_SetItemString(dict, key, v);
+    Py_DECREF(v);
+    return res;
+}
+
+static int
+exec_stats_fill_dict(PyObject *dict, const _PyExecStats *stats)
+{
+    char key[128];
+    for (int i = 0; i < 256; i++) {
+        const char *name = _PyOpcode_OpName[i];
+        if (name == NULL) {
+            continue;
+        }
+        if (is_specializable_for_stats(i)) {
+            PyOS_snprintf(key, sizeof(key), "opcode[%s].specializable", name);
+            if (exec_stats_set_item(dict, key, 1) < 0) {
+                return -1;
+            }
+        }
+#define SET_OPCODE_FIELD(FIELD) \
+        if (stats->opcode[i].FIELD) { \
+            PyOS_snprintf(key, sizeof(key), \
+                          "opcode[%s].specialization." #FIELD, name); \
+            if (exec_stats_set_item(dict, key, stats->opcode[i].FIELD) < 0) { \
+                return -1; \
+            } \
+        }
+        EXEC_STATS_OPCODE_FIELDS(SET_OPCODE_FIELD)
+#undef SET_OPCODE_FIELD
+    }
+#define SET_OPTIMIZATION_FIELD(KEY, FIELD) \
+    if (exec_stats_set_item(dict, KEY, stats->FIELD) < 0) { \
+        return -1; \
+    }
+    EXEC_STATS_OPTIMIZATION_FIELDS(SET_OPTIMIZATION_FIELD)
+#undef SET_OPTIMIZATION_FIELD
+    return 0;
+}
+
+PyObject *
+_PyExecStats_AsDict(PyInterpreterState *interp)
+{
+    _PyExecStats *stats = exec_stats_collect(interp);
+    if (stats == NULL) {
+        return NULL;
+    }
+    PyObject *dict = PyDict_New();
+    if (dict != NULL && exec_stats_fill_dict(dict, stats) < 0) {
+        Py_CLEAR(dict);
+    }
+    PyMem_RawFree(stats);
+    return dict;
+}
+
+int
+_PyExecStats_Dump(PyInterpreterState *interp)
+{
+    PyObject *dict = _PyExecStats_AsDict(interp);
+    if (dict == NULL) {
+        return -1;
+    }
+    FILE *out = open_stats_file();
+    if (out == NULL) {
+        Py_DECREF(dict);
+        return 0;
+    }
+    Py_ssize_t pos = 0;
+    PyObject *key, *value;
+    while (PyDict_Next(dict, &pos, &key, &value)) {
+        fprintf(out, "%s : %llu\n", PyUnicode_AsUTF8(key),
+                PyLong_AsUnsignedLongLong(value));
+    }
+    fclose(out);
+    Py_DECREF(dict);
+    return 1;
+}
+
+
 #ifndef SPECIALIZATION_FAIL
 #  define SPECIALIZATION_FAIL(opcode, kind) ((void)0)
 #endif
@@ -24,6 +24,7 @@ static const char* _Py_stdlib_module_names[] = {
 "_compat_pickle",
 "_compression",
 "_contextvars",
+"_coverage",
 "_crc",
 "_csv",
 "_ctypes",
@@ -69,6 +70,8 @@ static const char* _Py_stdlib_module_names[] = {
 "_pyrepl",
 "_queue",
 "_random",
+"_remotesampler",
+"_sampleprof",
 "_scproxy",
 "_sha1",
 "_sha2",
@@ -18,8 +18,10 @@ Data members:
 #include "pycore_call.h"          // _PyObject_CallNoArgs()
 #include "pycore_ceval.h"         // _PyEval_SetAsyncGenFinalizer()
 #include "pycore_dict.h"          // _PyDict_GetItemWithError()
+#include "pycore_exec_stats.h"    // _PyExecStats_Enable()
 #include "pycore_frame.h"         // _PyInterpreterFrame
 #include "pycore_initconfig.h"    // _PyStatus_EXCEPTION()
+#include "pycore_lock_contention.h" // _PyLockContention_Enable()
 #include "pycore_long.h"          // _PY_LONG_MAX_STR_DIGITS_THRESHOLD
 #include "pycore_modsupport.h"    // _PyModule_CreateInitialized()
 #include "pycore_namespace.h"     // _PyNamespace_New()
@@ -2258,6 +2260,203 @@ sys__stats_dump_impl(PyObject *module)
 #endif   // Py_STATS
 
 
+/*[clinic input]
+sys._exec_stats_on
+
+Turns on gathering of the execution stats (off by default).
+
+The execution stats count specialization attempts, hits, misses and
+deoptimizations per instruction, and the tier 2 executors which are created,
+entered and exited.  They are available in all builds.
+[clinic start generated code]*/
+
+static PyObject *
+sys__exec_stats_on_impl(PyObject *module)
+/*[clinic end generated code: output=9c723b3ff918ace0 input=8df95cb6af53f2f1]*/
+{
+    if (_PyExecStats_Enable(_PyInterpreterState_GET()) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._exec_stats_off
+
+Turns off gathering of the execution stats.
+
+The counts gathered so far are kept.
+[clinic start generated code]*/
+
+static PyObject *
+sys__exec_stats_off_impl(PyObject *module)
+/*[clinic end generated code: output=3f7fa3f07da5700c input=6ec48e862951700f]*/
+{
+    _PyExecStats_Disable(_PyInterpreterState_GET());
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._exec_stats_clear
+
+Clears the execution stats.
+[clinic start generated code]*/
+
+static PyObject *
+sys__exec_stats_clear_impl(PyObject *module)
+/*[clinic end generated code: output=c16f5197bdc5734f input=b70fde10686a708b]*/
+{
+    _PyExecStats_Clear(_PyInterpreterState_GET());
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._get_exec_stats
+
+Return the execution stats as a dict.
+
+The keys are the same as in the files written by sys._exec_stats_dump().
+[clinic start generated code]*/
+
+static PyObject *
+sys__get_exec_stats_impl(PyObject *module)
+/*[clinic end generated code: output=fa47d8c5452aad1d input=0fa29dc82d358d68]*/
+{
+    return _PyExecStats_AsDict(_PyInterpreterState_GET());
+}
+
+/*[clinic input]
+sys._exec_stats_dump -> bool
+
+Dump the execution stats to file, and clear them.
+
+The file is written in the pystats directory, in the format read by
+Tools/scripts/summarize_stats.py.  Return False if the file could not be
+created.
+[clinic start generated code]*/
+
+static int
+sys__exec_stats_dump_impl(PyObject *module)
+/*[clinic end generated code: output=da3bfd7c6dbdad96 input=38bdba47567d333b]*/
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    int res = _PyExecStats_Dump(interp);
+    if (res < 0) {
+        return -1;
+    }
+    _PyExecStats_Clear(interp);
+    return res;
+}
+
+
+/*[clinic input]
+sys._lock_contention_on
+
+Turns on the lock contention profile (off by default).
+
+The profile records how long threads wait for the locks of the runtime,
+the locks of the critical sections of the free-threaded build and the GIL,
+and where.  Only contended acquisitions are recorded.
+[clinic start generated code]*/
+
+static PyObject *
+sys__lock_contention_on_impl(PyObject *module)
+/*[clinic end generated code: output=d424b0a9e91d085b input=3c58ef955c015a7b]*/
+{
+    if (_PyLockContention_Enable(_PyInterpreterState_GET()) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._lock_contention_off
+
+Turns off the lock contention profile.
+
+The waits recorded so far are kept.
+[clinic start generated code]*/
+
+static PyObject *
+sys__lock_contention_off_impl(PyObject *module)
+/*[clinic end generated code: output=0afda425ade6e68a input=742406a9d96f3686]*/
+{
+    _PyLockContention_Disable(_PyInterpreterState_GET());
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._lock_contention_clear
+
+Clears the lock contention profile.
+[clinic start generated code]*/
+
+static PyObject *
+sys__lock_contention_clear_impl(PyObject *module)
+/*[clinic end generated code: output=325530a1ea388b68 input=b9a1f6242cfb1fd8]*/
+{
+    if (_PyLockContention_Clear(_PyInterpreterState_GET()) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._get_lock_contention
+
+Return the lock contention profile as a dict.
+
+'sites' is a list of dicts, one per contended lock, sorted by decreasing
+total wait time, and 'dropped' counts the waits which could not be
+recorded.  Each site has the keys:
+
+* 'kind': 'mutex', 'critical_section' or 'gil';
+* 'lock': the address of the lock;
+* 'type': the type of the object of a critical section, or None;
+* 'count', 'total_ns' and 'max_ns': the number of contended acquisitions,
+  and the total and longest wait times in nanoseconds;
+* 'histogram': a tuple of counts of waits shorter than 1 us, then in
+  [2**(i-1), 2**i) us for the i-th item; the last item also counts longer
+  waits;
+* 'waiter' and 'holder': the innermost frames of the first thread which
+  waited for the lock, and of the first one which released it while threads
+  were waiting, as (filename, lineno, qualname) tuples.
+[clinic start generated code]*/
+
+static PyObject *
+sys__get_lock_contention_impl(PyObject *module)
+/*[clinic end generated code: output=fce6476e01a5880f input=8c74ee84f9564f52]*/
+{
+    return _PyLockContention_AsDict(_PyInterpreterState_GET());
+}
+
+
+/*[clinic input]
+sys._get_datastack_stats
+
+Return a dict of counters about the data stack of the current thread.
+
+The data stack holds the frames of the Python functions which are executing.
+It grows by chunks: 'allocated' and 'freed' count the chunks which were
+allocated and freed, 'reused' the chunks taken from the 'spare' chunks which
+are kept after being popped, and 'chunk_size' is the size in bytes of the
+largest chunk.
+[clinic start generated code]*/
+
+static PyObject *
+sys__get_datastack_stats_impl(PyObject *module)
+/*[clinic end generated code: output=4cb1524706f6153c input=55f5d39a5b681cae]*/
+{
+    _PyThreadStateImpl *tstate = (_PyThreadStateImpl *)_PyThreadState_GET();
+    return Py_BuildValue("{sKsKsKsisi}",
+                         "allocated", (unsigned long long)tstate->datastack.allocated,
+                         "freed", (unsigned long long)tstate->datastack.freed,
+                         "reused", (unsigned long long)tstate->datastack.reused,
+                         "spare", tstate->datastack.nspare,
+                         "chunk_size", tstate->datastack.max_size);
+}
+
+
 #ifdef ANDROID_API_LEVEL
 /*[clinic input]
 sys.getandroidapilevel
@@ -2609,6 +2808,16 @@ static PyMethodDef sys_methods[] = {
     SYS_GET_INT_MAX_STR_DIGITS_METHODDEF
     SYS_SET_INT_MAX_STR_DIGITS_METHODDEF
     SYS__BASEREPL_METHODDEF
+    SYS__EXEC_STATS_ON_METHODDEF
+    SYS__EXEC_STATS_OFF_METHODDEF
+    SYS__EXEC_STATS_CLEAR_METHODDEF
+    SYS__EXEC_STATS_DUMP_METHODDEF
+    SYS__GET_EXEC_STATS_METHODDEF
+    SYS__LOCK_CONTENTION_ON_METHODDEF
+    SYS__LOCK_CONTENTION_OFF_METHODDEF
+    SYS__LOCK_CONTENTION_CLEAR_METHODDEF
+    SYS__GET_LOCK_CONTENTION_METHODDEF
+    SYS__GET_DATASTACK_STATS_METHODDEF
 #ifdef Py_STATS
     SYS__STATS_ON_METHODDEF
     SYS__STATS_OFF_METHODDEF
@@ -7,7 +7,9 @@
 #include "pycore_call.h"          // _PyObject_CallMethodFormat()
 #include "pycore_fileutils.h"     // _Py_BEGIN_SUPPRESS_IPH
 #include "pycore_frame.h"         // _PyFrame_GetCode()
+#include "pycore_freelist.h"      // _Py_FREELIST_POP()
 #include "pycore_interp.h"        // PyInterpreterState.gc
+#include "pycore_object.h"        // _PyObject_GC_TRACK()
 #include "pycore_parser.h"        // _PyParser_ASTFromString
 #include "pycore_pyarena.h"       // _PyArena_Free()
 #include "pycore_pyerrors.h"      // _PyErr_GetRaisedException()
@@ -258,6 +260,338 @@ _PyTraceBack_FromFrame(PyObject *tb_next, PyFrameObject *frame)
 }
 
 
+/* Lazy tracebacks
+
+   Raising and catching an exception within a single frame is common, and
+   most handlers never look at the traceback.  Instead of creating a frame
+   object and a traceback object for every frame the exception passes
+   through, the interpreter appends (frame, instruction offset) entries to
+   a compact array.  Entries that refer to a frame that is still executing
+   only hold a borrowed pointer to the _PyInterpreterFrame.  Before such a
+   frame is cleared, _PyTraceBack_ReleaseFrame() replaces the pointer with
+   the frame object, so that locals stay reachable from the traceback
+   exactly as if it had been created eagerly.
+
+   Lazy tracebacks with such entries are kept in a per-interpreter list
+   protected by the GIL.  In the free-threaded build, frames can be cleared
+   concurrently, so tracebacks are captured eagerly. */
+
+#define LAZY_TB_SMALL 4
+
+/* Maximum number of lazy tracebacks that refer to executing frames.  When
+   the limit is reached, the oldest one creates its frame objects, so that
+   clearing a frame never scans a long list. */
+#define LAZY_TB_MAXLIVE 32
+
+typedef struct {
+    PyFrameObject *frame;   /* NULL if the entry refers to live_frame */
+    int lasti;
+} lazy_tb_entry;
+
+typedef struct _PyLazyTraceBack {
+    PyObject_HEAD
+    /* The traceback extended by the entries, or NULL */
+    PyObject *base;
+    /* The executing frame of the entries without a frame object, or NULL.
+       Such entries always are at the end of the array. */
+    _PyInterpreterFrame *live_frame;
+    /* Links in the list of lazy tracebacks with a live frame */
+    struct _PyLazyTraceBack *prev;
+    struct _PyLazyTraceBack *next;
+    /* Entries from the innermost frame to the outermost one */
+    Py_ssize_t size;
+    Py_ssize_t allocated;
+    lazy_tb_entry *entries;
+    lazy_tb_entry small[LAZY_TB_SMALL];
+} PyLazyTraceBackObject;
+
+static void
+lazy_tb_unlink(struct _Py_exc_state *state, PyLazyTraceBackObject *lt)
+{
+    assert(lt->live_frame != NULL);
+    if (lt->prev != NULL) {
+        lt->prev->next = lt->next;
+    }
+    else {
+        state->lazy_tb_head = lt->next;
+    }
+    if (lt->next != NULL) {
+        lt->next->prev = lt->prev;
+    }
+    else {
+        state->lazy_tb_tail = lt->prev;
+    }
+    lt->prev = lt->next = NULL;
+    lt->live_frame = NULL;
+    state->lazy_tb_count--;
+}
+
+/* Store the frame object of the executing frame in the entries that
+   refer to it.  The current exception must have been saved by the caller.
+   On failure, drop these entries, set an exception and return -1. */
+static int
+lazy_tb_resolve(struct _Py_exc_state *state, PyLazyTraceBackObject *lt)
+{
+    _PyInterpreterFrame *frame = lt->live_frame;
+    lazy_tb_unlink(state, lt);
+    PyFrameObject *f = _PyFrame_GetFrameObject(frame);
+    Py_ssize_t i = lt->size;
+    while (i > 0 && lt->entries[i - 1].frame == NULL) {
+        i--;
+        if (f == NULL) {
+            lt->size = i;
+        }
+        else {
+            lt->entries[i].frame = (PyFrameObject *)Py_NewRef(f);
+        }
+    }
+    if (f == NULL) {
+        return -1;
+    }
+    if (!_PyObject_GC_IS_TRACKED(lt)) {
+        _PyObject_GC_TRACK(lt);
+    }
+    return 0;
+}
+
+#ifndef Py_GIL_DISABLED
+static void
+lazy_tb_link(struct _Py_exc_state *state, PyLazyTraceBackObject *lt,
+             _PyInterpreterFrame *frame)
+{
+    assert(lt->live_frame == NULL);
+    lt->live_frame = frame;
+    lt->prev = NULL;
+    lt->next = state->lazy_tb_head;
+    if (state->lazy_tb_head != NULL) {
+        state->lazy_tb_head->prev = lt;
+    }
+    else {
+        state->lazy_tb_tail = lt;
+    }
+    state->lazy_tb_head = lt;
+    state->lazy_tb_count++;
+    frame->lazy_tb = 1;
+}
+
+/* Create a lazy traceback extending base.  Steal a reference to base on
+   success. */
+static PyLazyTraceBackObject *
+lazy_tb_new(PyObject *base)
+{
+    PyLazyTraceBackObject *lt;
+    lt = _Py_FREELIST_POP(PyLazyTraceBackObject, lazy_tracebacks);
+    if (lt == NULL) {
+        lt = PyObject_GC_New(PyLazyTraceBackObject, &_PyLazyTraceBack_Type);
+        if (lt == NULL) {
+            return NULL;
+        }
+    }
+    lt->base = base;
+    lt->live_frame = NULL;
+    lt->prev = lt->next = NULL;
+    lt->size = 0;
+    lt->allocated = LAZY_TB_SMALL;
+    lt->entries = lt->small;
+    if (base != NULL) {
+        _PyObject_GC_TRACK(lt);
+    }
+    return lt;
+}
+
+static int
+lazy_tb_append(PyLazyTraceBackObject *lt, int lasti)
+{
+    if (lt->size == lt->allocated) {
+        Py_ssize_t allocated = lt->allocated * 2;
+        lazy_tb_entry *entries;
+        if (lt->entries == lt->small) {
+            entries = PyMem_New(lazy_tb_entry, allocated);
+            if (entries != NULL) {
+                memcpy(entries, lt->small, sizeof(lt->small));
+            }
+        }
+        else if ((size_t)allocated <= PY_SSIZE_T_MAX / sizeof(lazy_tb_entry)) {
+            entries = PyMem_Realloc(lt->entries,
+                                    allocated * sizeof(lazy_tb_entry));
+        }
+        else {
+            entries = NULL;
+        }
+        if (entries == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        lt->entries = entries;
+        lt->allocated = allocated;
+    }
+    lt->entries[lt->size].frame = NULL;
+    lt->entries[lt->size].lasti = lasti;
+    lt->size++;
+    return 0;
+}
+#endif
+
+static void
+lazy_tb_clear_entries(PyLazyTraceBackObject *lt)
+{
+    if (lt->live_frame != NULL) {
+        lazy_tb_unlink(&_PyInterpreterState_GET()->exc_state, lt);
+    }
+    Py_ssize_t size = lt->size;
+    lt->size = 0;
+    for (Py_ssize_t i = 0; i < size; i++) {
+        Py_XDECREF(lt->entries[i].frame);
+    }
+}
+
+static void
+lazy_tb_dealloc(PyLazyTraceBackObject *lt)
+{
+    if (_PyObject_GC_IS_TRACKED(lt)) {
+        _PyObject_GC_UNTRACK(lt);
+    }
+    lazy_tb_clear_entries(lt);
+    Py_XDECREF(lt->base);
+    if (lt->entries != lt->small) {
+        PyMem_Free(lt->entries);
+    }
+    _Py_FREELIST_FREE(lazy_tracebacks, lt, PyObject_GC_Del);
+}
+
+static int
+lazy_tb_traverse(PyLazyTraceBackObject *lt, visitproc visit, void *arg)
+{
+    Py_VISIT(lt->base);
+    for (Py_ssize_t i = 0; i < lt->size; i++) {
+        Py_VISIT(lt->entries[i].frame);
+    }
+    return 0;
+}
+
+static int
+lazy_tb_clear(PyLazyTraceBackObject *lt)
+{
+    lazy_tb_clear_entries(lt);
+    Py_CLEAR(lt->base);
+    return 0;
+}
+
+PyTypeObject _PyLazyTraceBack_Type = {
+    PyVarObject_HEAD_INIT(&PyType_Type, 0)
+    .tp_name = "lazy_traceback",
+    .tp_basicsize = sizeof(PyLazyTraceBackObject),
+    .tp_dealloc = (destructor)lazy_tb_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_traverse = (traverseproc)lazy_tb_traverse,
+    .tp_clear = (inquiry)lazy_tb_clear,
+};
+
+int
+_PyTraceBack_AddFrame(PyThreadState *tstate, _PyInterpreterFrame *frame)
+{
+#ifdef Py_GIL_DISABLED
+    PyFrameObject *f = _PyFrame_GetFrameObject(frame);
+    if (f == NULL) {
+        return -1;
+    }
+    return PyTraceBack_Here(f);
+#else
+    PyObject *exc = _PyErr_GetRaisedException(tstate);
+    assert(PyExceptionInstance_Check(exc));
+    PyBaseExceptionObject *base_exc = (PyBaseExceptionObject *)exc;
+    struct _Py_exc_state *state = &tstate->interp->exc_state;
+    PyLazyTraceBackObject *lt;
+    if (base_exc->traceback != NULL &&
+        _PyLazyTraceBack_Check(base_exc->traceback))
+    {
+        lt = (PyLazyTraceBackObject *)base_exc->traceback;
+        if (lt->live_frame != NULL && lt->live_frame != frame) {
+            if (lazy_tb_resolve(state, lt) < 0) {
+                goto error;
+            }
+        }
+    }
+    else {
+        lt = lazy_tb_new(base_exc->traceback);
+        if (lt == NULL) {
+            goto error;
+        }
+        base_exc->traceback = (PyObject *)lt;
+    }
+    int lasti = _PyInterpreterFrame_LASTI(frame) * sizeof(_Py_CODEUNIT);
+    if (lazy_tb_append(lt, lasti) < 0) {
+        goto error;
+    }
+    if (lt->live_frame == NULL) {
+        if (state->lazy_tb_count >= LAZY_TB_MAXLIVE) {
+            if (lazy_tb_resolve(state, state->lazy_tb_tail) < 0) {
+                _PyErr_Clear(tstate);
+            }
+        }
+        lazy_tb_link(state, lt, frame);
+    }
+    _PyErr_SetRaisedException(tstate, exc);
+    return 0;
+
+error:
+    _PyErr_ChainExceptions1(exc);
+    return -1;
+#endif
+}
+
+PyObject *
+_PyTraceBack_Materialize(PyObject *lazy_tb)
+{
+    assert(_PyLazyTraceBack_Check(lazy_tb));
+    PyLazyTraceBackObject *lt = (PyLazyTraceBackObject *)lazy_tb;
+    PyObject *tb = Py_XNewRef(lt->base);
+    for (Py_ssize_t i = 0; i < lt->size; i++) {
+        PyFrameObject *frame = lt->entries[i].frame;
+        if (frame == NULL) {
+            assert(lt->live_frame != NULL);
+            frame = _PyFrame_GetFrameObject(lt->live_frame);
+            if (frame == NULL) {
+                Py_XDECREF(tb);
+                return NULL;
+            }
+        }
+        PyObject *next = tb;
+        tb = tb_create_raw((PyTracebackObject *)next, frame,
+                           lt->entries[i].lasti, -1);
+        Py_XDECREF(next);
+        if (tb == NULL) {
+            return NULL;
+        }
+    }
+    if (tb == NULL) {
+        Py_RETURN_NONE;
+    }
+    return tb;
+}
+
+void
+_PyTraceBack_ReleaseFrame(_PyInterpreterFrame *frame)
+{
+    assert(frame->lazy_tb);
+    frame->lazy_tb = 0;
+    struct _Py_exc_state *state = &_PyInterpreterState_GET()->exc_state;
+    if (state->lazy_tb_head == NULL) {
+        return;
+    }
+    PyObject *exc = PyErr_GetRaisedException();
+    PyLazyTraceBackObject *lt = state->lazy_tb_head;
+    while (lt != NULL) {
+        PyLazyTraceBackObject *next = lt->next;
+        if (lt->live_frame == frame && lazy_tb_resolve(state, lt) < 0) {
+            PyErr_Clear();
+        }
+        lt = next;
+    }
+    PyErr_SetRaisedException(exc);
+}
+
+
 int
 PyTraceBack_Here(PyFrameObject *frame)
 {
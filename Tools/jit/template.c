@@ -38,6 +38,12 @@
 #undef ENABLE_SPECIALIZATION
 #define ENABLE_SPECIALIZATION (0)
 
+// Tier 1 stats are not gathered in Tier 2
+#undef STAT_INC
+#define STAT_INC(opname, name) ((void)0)
+#undef STAT_DEC
+#define STAT_DEC(opname, name) ((void)0)
+
 #undef GOTO_ERROR
 #define GOTO_ERROR(LABEL)        \
     do {                         \
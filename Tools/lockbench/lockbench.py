@@ -2,6 +2,17 @@
 # with short critical sections.
 #
 # Usage: python Tools/lockbench/lockbench.py [CRITICAL_SECTION_LENGTH]
+#        python Tools/lockbench/lockbench.py --contention
+#        python Tools/lockbench/lockbench.py --rwlock
+#
+# With --rwlock, threads take _PyRWMutex or _PyBRLock for reading, and the
+# first thread also takes it for writing 10 times per million reads.
+#
+# With --contention, Python threads append to and pop from a shared list,
+# contending for its critical section in `--disable-gil` builds and for the
+# GIL otherwise.  The benchmark runs with the lock contention profile off and
+# on (sys._lock_contention_on()) to measure its overhead, then prints the
+# most contended locks.
 #
 # How to interpret the results:
 #
@@ -18,8 +29,10 @@
 # lock.
 # See https://en.wikipedia.org/wiki/Fairness_measure#Jain's_fairness_index
 
-from _testinternalcapi import benchmark_locks
+from _testinternalcapi import benchmark_locks, benchmark_rwlocks
 import sys
+import threading
+import time
 
 # Max number of threads to test
 MAX_THREADS = 10
@@ -47,7 +60,75 @@ def main():
             print(f"{lock_type: <20}{num_threads: <18}{acquisitions: >5.0f}{fairness: >20.2f}")
 
 
+def benchmark_list(num_threads, time_s=0.5):
+    items = []
+    thread_iters = [0] * num_threads
+    stop = False
+
+    def worker(index):
+        iters = 0
+        while not stop:
+            items.append(index)
+            items.pop()
+            iters += 1
+        thread_iters[index] = iters
+
+    threads = [threading.Thread(target=worker, args=(i,))
+               for i in range(num_threads)]
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    time.sleep(time_s)
+    stop = True
+    for t in threads:
+        t.join()
+    return sum(thread_iters) / (time.perf_counter() - start), thread_iters
+
+
+def main_contention():
+    print("Threads   Off (kHz)    On (kHz)   Overhead   Fairness (on)")
+    for num_threads in range(1, MAX_THREADS + 1):
+        off, _ = benchmark_list(num_threads)
+        sys._lock_contention_on()
+        try:
+            on, thread_iters = benchmark_list(num_threads)
+        finally:
+            sys._lock_contention_off()
+        overhead = (off - on) / off * 100
+        print(f"{num_threads: <10}{off / 1000: >9.0f}{on / 1000: >12.0f}"
+              f"{overhead: >10.1f}%{jains_fairness(thread_iters): >16.2f}")
+
+    profile = sys._get_lock_contention()
+    sys._lock_contention_clear()
+    print()
+    print("Kind                Type        Count    Total (ms)  Max (us)  Waiter")
+    for site in profile["sites"][:5]:
+        type_name = site["type"].__name__ if site["type"] else "-"
+        waiter = site["waiter"][0] if site["waiter"] else ("-", 0, "-")
+        print(f"{site['kind']: <20}{type_name: <10}{site['count']: >7}"
+              f"{site['total_ns'] / 1e6: >14.1f}{site['max_ns'] / 1e3: >10.0f}"
+              f"  {waiter[2]} ({waiter[0]}:{waiter[1]})")
+
+
+def main_rwlock():
+    print("Lock Type           Threads           Reads (kHz)          Fairness")
+    for lock_type in ["_PyRWMutex", "_PyBRLock"]:
+        use_brlock = (lock_type == "_PyBRLock")
+        for num_threads in [1, 2, 4, 8, 16, 32, 64]:
+            reads, thread_iters = benchmark_rwlocks(num_threads, use_brlock)
+
+            reads /= 1000  # report in kHz for readability
+            fairness = jains_fairness(thread_iters)
+
+            print(f"{lock_type: <20}{num_threads: <18}{reads: >5.0f}{fairness: >20.2f}")
+
+
 if __name__ == "__main__":
-    if len(sys.argv) > 1:
-        CRITICAL_SECTION_LENGTH = int(sys.argv[1])
-    main()
+    if sys.argv[1:] == ["--contention"]:
+        main_contention()
+    elif sys.argv[1:] == ["--rwlock"]:
+        main_rwlock()
+    else:
+        if len(sys.argv) > 1:
+            CRITICAL_SECTION_LENGTH = int(sys.argv[1])
+        main()
@@ -0,0 +1,154 @@
+'Compare the iterations of SelectorEventLoop and FastSelectorEventLoop.'
+
+# Every benchmark runs a fresh event loop and reports the time per
+# operation: per callback, per timer, per task step or per echoed message.
+# The loops are interleaved and the best of several runs is kept, to limit
+# the noise.
+
+import asyncio
+import selectors
+import socket
+import sys
+import time
+
+callbacks = 100_000
+timers = 20_000
+task_steps = 50_000
+messages = 20_000
+idle_connections = 500
+
+
+def call_soon(loop):
+    def cb(n):
+        if n:
+            loop.call_soon(cb, n - 1)
+        else:
+            loop.stop()
+    loop.call_soon(cb, callbacks)
+    loop.run_forever()
+    return callbacks
+
+
+def call_later(loop):
+    remaining = timers
+    def cb():
+        nonlocal remaining
+        remaining -= 1
+        if not remaining:
+            loop.stop()
+    for i in range(timers):
+        loop.call_later((i % 100) * 1e-5, cb)
+    loop.run_forever()
+    return timers
+
+
+def cancelled_timers(loop):
+    handles = [loop.call_later(3600, lambda: None) for i in range(timers)]
+    for handle in handles:
+        handle.cancel()
+    loop.call_later(0.0, loop.stop)
+    loop.run_forever()
+    return timers
+
+
+def task_wakeup(loop):
+    async def worker(n):
+        for i in range(n):
+            await asyncio.sleep(0)
+
+    async def main():
+        await asyncio.gather(*[worker(task_steps // 100)
+                               for i in range(100)])
+    loop.run_until_complete(main())
+    return task_steps
+
+
+def future_callbacks(loop):
+    async def main():
+        for i in range(task_steps):
+            fut = loop.create_future()
+            loop.call_soon(fut.set_result, None)
+            await fut
+    loop.run_until_complete(main())
+    return task_steps
+
+
+class Echo(asyncio.Protocol):
+    def connection_made(self, transport):
+        self.transport = transport
+
+    def data_received(self, data):
+        self.transport.write(data)
+
+
+class Client(asyncio.Protocol):
+    def __init__(self, done):
+        self.done = done
+        self.remaining = messages
+
+    def connection_made(self, transport):
+        self.transport = transport
+        transport.write(b'x' * 64)
+
+    def data_received(self, data):
+        self.remaining -= 1
+        if self.remaining:
+            self.transport.write(data)
+        elif not self.done.done():
+            self.done.set_result(None)
+
+
+def echo(loop, idle=0):
+    async def main():
+        socks = [socket.socketpair() for i in range(idle)]
+        idle_transports = []
+        for a, b in socks:
+            for sock in a, b:
+                tr, _ = await loop.connect_accepted_socket(
+                    asyncio.Protocol, sock)
+                idle_transports.append(tr)
+        a, b = socket.socketpair()
+        server, _ = await loop.connect_accepted_socket(Echo, a)
+        done = loop.create_future()
+        client, _ = await loop.connect_accepted_socket(
+            lambda: Client(done), b)
+        await done
+        for tr in (client, server, *idle_transports):
+            tr.close()
+        await asyncio.sleep(0)
+    loop.run_until_complete(main())
+    return messages
+
+
+def echo_with_idle(loop):
+    return echo(loop, idle_connections)
+
+
+def measure(factory, bench):
+    loop = factory()
+    try:
+        t0 = time.perf_counter()
+        n = bench(loop)
+        return (time.perf_counter() - t0) / n
+    finally:
+        loop.close()
+
+
+if __name__ == '__main__':
+
+    factories = {'py': asyncio.SelectorEventLoop,
+                 'c': asyncio.FastSelectorEventLoop}
+    if asyncio.FastSelectorEventLoop is asyncio.SelectorEventLoop:
+        sys.exit('the _asyncio module is not available')
+    selector = selectors.DefaultSelector.__name__
+
+    print(f'{selector}, best of 5 interleaved runs')
+    print(f'{"":28s}{"py":>10s}{"c":>10s}')
+    for bench in [call_soon, call_later, cancelled_timers,
+                  task_wakeup, future_callbacks, echo, echo_with_idle]:
+        best = {name: float('inf') for name in factories}
+        for i in range(5):
+            for name, factory in factories.items():
+                best[name] = min(best[name], measure(factory, bench))
+        print('{:28s}{:7.0f} ns{:7.0f} ns'.format(
+            bench.__name__, best['py'] * 1e9, best['c'] * 1e9))
@@ -0,0 +1,144 @@
+'Show the cost of raising and catching exceptions in common patterns.'
+
+# Every function performs ``steps_per_trial`` raise/catch pairs per trial,
+# so the reported time is the cost of a single raise and catch.  The
+# "inspect" variants touch ``__traceback__`` and measure the cost of
+# building the traceback objects on demand.
+
+trials = [None] * 500
+steps_per_trial = 5
+
+empty = {}
+
+def raise_here():
+    raise ValueError
+
+def raise_deep(n):
+    if n:
+        raise_deep(n - 1)
+    raise ValueError
+
+def get(d, key):
+    try:
+        return d[key]
+    except KeyError:
+        return None
+
+def keyerror_same_frame(trials=trials, d=empty):
+    for t in trials:
+        try: d['a']
+        except KeyError: pass
+        try: d['a']
+        except KeyError: pass
+        try: d['a']
+        except KeyError: pass
+        try: d['a']
+        except KeyError: pass
+        try: d['a']
+        except KeyError: pass
+
+def keyerror_in_helper(trials=trials, d=empty, get=get):
+    for t in trials:
+        get(d, 'a'); get(d, 'a'); get(d, 'a'); get(d, 'a'); get(d, 'a')
+
+def raise_same_frame(trials=trials):
+    for t in trials:
+        try: raise ValueError
+        except ValueError: pass
+        try: raise ValueError
+        except ValueError: pass
+        try: raise ValueError
+        except ValueError: pass
+        try: raise ValueError
+        except ValueError: pass
+        try: raise ValueError
+        except ValueError: pass
+
+def raise_in_callee(trials=trials, f=raise_here):
+    for t in trials:
+        try: f()
+        except ValueError: pass
+        try: f()
+        except ValueError: pass
+        try: f()
+        except ValueError: pass
+        try: f()
+        except ValueError: pass
+        try: f()
+        except ValueError: pass
+
+def raise_five_frames_deep(trials=trials, f=raise_deep):
+    for t in trials:
+        try: f(4)
+        except ValueError: pass
+        try: f(4)
+        except ValueError: pass
+        try: f(4)
+        except ValueError: pass
+        try: f(4)
+        except ValueError: pass
+        try: f(4)
+        except ValueError: pass
+
+def catch_as_name(trials=trials):
+    for t in trials:
+        try: raise ValueError
+        except ValueError as e: e
+        try: raise ValueError
+        except ValueError as e: e
+        try: raise ValueError
+        except ValueError as e: e
+        try: raise ValueError
+        except ValueError as e: e
+        try: raise ValueError
+        except ValueError as e: e
+
+def inspect_traceback(trials=trials):
+    for t in trials:
+        try: raise ValueError
+        except ValueError as e: e.__traceback__
+        try: raise ValueError
+        except ValueError as e: e.__traceback__
+        try: raise ValueError
+        except ValueError as e: e.__traceback__
+        try: raise ValueError
+        except ValueError as e: e.__traceback__
+        try: raise ValueError
+        except ValueError as e: e.__traceback__
+
+def inspect_callee_traceback(trials=trials, f=raise_here):
+    for t in trials:
+        try: f()
+        except ValueError as e: e.__traceback__
+        try: f()
+        except ValueError as e: e.__traceback__
+        try: f()
+        except ValueError as e: e.__traceback__
+        try: f()
+        except ValueError as e: e.__traceback__
+        try: f()
+        except ValueError as e: e.__traceback__
+
+def loop_overhead(trials=trials):
+    for t in trials:
+        pass
+
+
+if __name__=='__main__':
+
+    from timeit import Timer
+
+    for f in [
+            'Raise and catch:',
+            keyerror_same_frame, keyerror_in_helper, raise_same_frame,
+            raise_in_callee, raise_five_frames_deep, catch_as_name,
+            '\nRaise, catch and inspect the traceback:',
+            inspect_traceback, inspect_callee_traceback,
+            '\nTiming loop overhead:',
+            loop_overhead]:
+        if isinstance(f, str):
+            print(f)
+            continue
+        timing = min(Timer(f).repeat(7, 20))
+        timing *= 1000000000 / (20 * len(trials) * steps_per_trial)
+        print('{:6.1f} ns\t{}'.format(timing, f.__name__))
@@ -0,0 +1,84 @@
+'Compare the throughput and latency of queue.Queue and queue.FastQueue.'
+
+# Throughput is the time per item when the same number of producer and
+# consumer threads share one bounded queue.  Latency is the time of a round
+# trip between two threads through a pair of queues.  The queue classes are
+# interleaved and the best of several runs is kept, to limit the noise.
+
+import queue
+import sys
+import threading
+import time
+
+items = 100_000
+round_trips = 10_000
+maxsize = 1000
+thread_counts = [1, 2, 4, 8, 16, 32]
+
+
+def throughput(factory, nthreads):
+    q = factory(maxsize)
+    count = items // nthreads
+    barrier = threading.Barrier(2 * nthreads + 1)
+
+    def produce():
+        barrier.wait()
+        for i in range(count):
+            q.put(i)
+
+    def consume():
+        barrier.wait()
+        for i in range(count):
+            q.get()
+
+    threads = [threading.Thread(target=f)
+               for f in [produce, consume] * nthreads]
+    for thread in threads:
+        thread.start()
+    barrier.wait()
+    t0 = time.perf_counter()
+    for thread in threads:
+        thread.join()
+    return (time.perf_counter() - t0) / (count * nthreads)
+
+
+def latency(factory):
+    ping = factory(maxsize)
+    pong = factory(maxsize)
+
+    def echo():
+        while (item := ping.get()) is not None:
+            pong.put(item)
+
+    thread = threading.Thread(target=echo)
+    thread.start()
+    t0 = time.perf_counter()
+    for i in range(round_trips):
+        ping.put(i)
+        pong.get()
+    t1 = time.perf_counter()
+    ping.put(None)
+    thread.join()
+    return (t1 - t0) / round_trips
+
+
+if __name__ == '__main__':
+
+    factories = {'Queue': queue.Queue, 'FastQueue': queue.FastQueue}
+    if queue.FastQueue is queue.Queue:
+        sys.exit('the _queue module is not available')
+    gil = 'GIL' if getattr(sys, '_is_gil_enabled', lambda: True)() else 'no GIL'
+
+    print(f'{gil}, maxsize={maxsize}, best of 5 interleaved runs')
+    print(f'{"":28s}{"Queue":>10s}{"FastQueue":>12s}')
+    benchmarks = [(f'throughput, {n}+{n} threads',
+                   lambda factory, n=n: throughput(factory, n))
+                  for n in thread_counts]
+    benchmarks.append(('round trip latency', latency))
+    for title, bench in benchmarks:
+        best = {name: float('inf') for name in factories}
+        for i in range(5):
+            for name, factory in factories.items():
+                best[name] = min(best[name], bench(factory))
+        print('{:28s}{:7.0f} ns{:9.0f} ns'.format(
+            title, best['Queue'] * 1e9, best['FastQueue'] * 1e9))
@@ -446,20 +446,23 @@ def get_optimization_stats(self) -> dict[str, tuple[int, int | None]]:
         if "Optimization attempts" not in self._data:
             return {}
 
-        attempts = self._data["Optimization attempts"]
-        created = self._data["Optimization traces created"]
-        executed = self._data["Optimization traces executed"]
-        uops = self._data["Optimization uops executed"]
-        trace_stack_overflow = self._data["Optimization trace stack overflow"]
-        trace_stack_underflow = self._data["Optimization trace stack underflow"]
-        trace_too_long = self._data["Optimization trace too long"]
-        trace_too_short = self._data["Optimization trace too short"]
-        inner_loop = self._data["Optimization inner loop"]
-        recursive_call = self._data["Optimization recursive call"]
-        low_confidence = self._data["Optimization low confidence"]
-        executors_invalidated = self._data["Executors invalidated"]
-
-        return {
+        attempts = self._data.get("Optimization attempts")
+        created = self._data.get("Optimization traces created")
+        executed = self._data.get("Optimization traces executed")
+        uops = self._data.get("Optimization uops executed")
+        trace_stack_overflow = self._data.get("Optimization trace stack overflow")
+        trace_stack_underflow = self._data.get("Optimization trace stack underflow")
+        trace_too_long = self._data.get("Optimization trace too long")
+        trace_too_short = self._data.get("Optimization trace too short")
+        inner_loop = self._data.get("Optimization inner loop")
+        recursive_call = self._data.get("Optimization recursive call")
+        low_confidence = self._data.get("Optimization low confidence")
+        executors_invalidated = self._data.get("Executors invalidated")
+        # Only gathered by the execution stats (sys._exec_stats_dump())
+        entered = self._data.get("Optimization traces entered")
+        exited = self._data.get("Optimization traces exited")
+
+        rows = {
             Doc(
                 "Optimization attempts",
                 "The number of times a potential trace is identified.  Specifically, this "
@@ -513,16 +516,30 @@ def get_optimization_stats(self) -> dict[str, tuple[int, int | None]]:
                 uops,
                 executed,
             ),
+            Doc(
+                "Traces entered",
+                "The number of times a trace was entered from Tier 1.",
+            ): (entered, None),
+            Doc(
+                "Traces exited",
+                "The number of times a trace returned to Tier 1, including "
+                "errors.",
+            ): (exited, entered),
+        }
+        # Skip the stats which are missing from the input, e.g. when it was
+        # written by sys._exec_stats_dump().
+        return {
+            doc: (value, den) for doc, (value, den) in rows.items() if value is not None
         }
 
     def get_optimizer_stats(self) -> dict[str, tuple[int, int | None]]:
-        attempts = self._data["Optimization optimizer attempts"]
-        successes = self._data["Optimization optimizer successes"]
-        no_memory = self._data["Optimization optimizer failure no memory"]
-        builtins_changed = self._data["Optimizer remove globals builtins changed"]
-        incorrect_keys = self._data["Optimizer remove globals incorrect keys"]
+        attempts = self._data.get("Optimization optimizer attempts")
+        successes = self._data.get("Optimization optimizer successes")
+        no_memory = self._data.get("Optimization optimizer failure no memory")
+        builtins_changed = self._data.get("Optimizer remove globals builtins changed")
+        incorrect_keys = self._data.get("Optimizer remove globals incorrect keys")
 
-        return {
+        rows = {
             Doc(
                 "Optimizer attempts",
                 "The number of times the trace optimizer (_Py_uop_analyze_and_optimize) was run.",
@@ -544,6 +561,9 @@ def get_optimizer_stats(self) -> dict[str, tuple[int, int | None]]:
                 "The keys in the globals dictionary aren't what was expected",
             ): (incorrect_keys, attempts),
         }
+        return {
+            doc: (value, den) for doc, (value, den) in rows.items() if value is not None
+        }
 
     def get_histogram(self, prefix: str) -> list[tuple[int, int]]:
         rows = []
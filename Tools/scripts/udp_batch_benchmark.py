@@ -0,0 +1,129 @@
+'Compare per-datagram socket calls with recvmmsg_into() and sendmmsg().'
+
+# Datagrams are exchanged on the loopback interface and the time per
+# datagram is reported, for the socket methods and for an asyncio datagram
+# endpoint receiving with and without batches.  The best of several runs is kept, to
+# limit the noise.
+
+import array
+import asyncio
+import socket
+import sys
+import time
+
+datagrams = 100_000
+batch = 32
+size = 64
+runs = 5
+
+
+def udp_pair():
+    rsock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    rsock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4 * 1024 * 1024)
+    rsock.bind(('127.0.0.1', 0))
+    wsock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    wsock.connect(rsock.getsockname())
+    return rsock, wsock
+
+
+def single(rsock, wsock):
+    data = b'x' * size
+    for i in range(0, datagrams, batch):
+        t0 = time.perf_counter()
+        for j in range(batch):
+            wsock.send(data)
+        t1 = time.perf_counter()
+        for j in range(batch):
+            rsock.recvfrom(size)
+        t2 = time.perf_counter()
+        yield t1 - t0, t2 - t1
+
+
+def batched(rsock, wsock):
+    data = [b'x' * size] * batch
+    buffers = [bytearray(size) for i in range(batch)]
+    sizes = array.array('i', [0] * batch)
+    for i in range(0, datagrams, batch):
+        t0 = time.perf_counter()
+        sent = 0
+        while sent < batch:
+            sent += wsock.sendmmsg(data[sent:])
+        t1 = time.perf_counter()
+        received = 0
+        while received < batch:
+            received += rsock.recvmmsg_into(buffers, sizes, 0, [])
+        t2 = time.perf_counter()
+        yield t1 - t0, t2 - t1
+
+
+def measure_socket(bench):
+    rsock, wsock = udp_pair()
+    with rsock, wsock:
+        send = recv = 0.0
+        for dt_send, dt_recv in bench(rsock, wsock):
+            send += dt_send
+            recv += dt_recv
+        return send / datagrams, recv / datagrams
+
+
+class Receiver(asyncio.DatagramProtocol):
+    def __init__(self, loop, mmsg):
+        self.done = loop.create_future()
+        self.mmsg = mmsg
+        self.received = 0
+
+    def connection_made(self, transport):
+        transport._mmsg = transport._mmsg and self.mmsg
+
+    def datagram_received(self, data, addr):
+        self.received += 1
+        if self.received == datagrams and not self.done.done():
+            self.done.set_result(None)
+
+
+def measure_asyncio(mmsg):
+    loop = asyncio.new_event_loop()
+
+    async def main():
+        rsock, wsock = udp_pair()
+        transport, protocol = await loop.create_datagram_endpoint(
+            lambda: Receiver(loop, mmsg), sock=rsock)
+        data = [b'x' * size] * batch
+        t0 = time.perf_counter()
+        sent = 0
+        while not protocol.done.done():
+            # Keep a few batches in flight, without overflowing the
+            # receive buffer.
+            while sent < datagrams and sent - protocol.received < 8 * batch:
+                sent += wsock.sendmmsg(data)
+            await asyncio.sleep(0)
+        dt = time.perf_counter() - t0
+        transport.close()
+        wsock.close()
+        return dt / datagrams
+
+    try:
+        return loop.run_until_complete(main())
+    finally:
+        loop.close()
+
+
+if __name__ == '__main__':
+    if not hasattr(socket.socket, 'recvmmsg_into'):
+        sys.exit('socket.recvmmsg_into() is not available')
+
+    print(f'{datagrams} datagrams of {size} bytes in batches of {batch}, '
+          f'best of {runs} runs')
+    print(f'{"":28s}{"single":>10s}{"batched":>10s}')
+    best = {}
+    for i in range(runs):
+        for name, bench in (('single', single), ('batched', batched)):
+            send, recv = measure_socket(bench)
+            best[name, 'send'] = min(best.get((name, 'send'), send), send)
+            best[name, 'recv'] = min(best.get((name, 'recv'), recv), recv)
+        for name, mmsg in (('single', False), ('batched', True)):
+            dt = measure_asyncio(mmsg)
+            best[name, 'asyncio'] = min(best.get((name, 'asyncio'), dt), dt)
+    for what in ('send', 'recv', 'asyncio'):
+        print('{:28s}{:7.0f} ns{:7.0f} ns'.format(
+            what, best['single', what] * 1e9, best['batched', what] * 1e9))